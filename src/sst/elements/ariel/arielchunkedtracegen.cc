@@ -0,0 +1,76 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <sst/core/output.h>
+
+#include "arielchunkedtracegen.h"
+
+using namespace SST::ArielComponent;
+
+std::mutex ArielChunkedTraceGenerator::registryLock;
+std::map<std::string, std::weak_ptr<ArielChunkedTraceGenerator::SharedTrace>> ArielChunkedTraceGenerator::registry;
+
+ArielChunkedTraceGenerator::ArielChunkedTraceGenerator(Params& params) :
+    ArielTraceGenerator() {
+
+    const std::string tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    const uint32_t chunkRecords = params.find<uint32_t>("chunk_records", 65536);
+    const int level = params.find<int>("compression_level", 1);
+
+    trace = openTrace(tracePrefix + ".ctrace", chunkRecords, level);
+    coreID = 0;
+}
+
+ArielChunkedTraceGenerator::~ArielChunkedTraceGenerator() {
+    std::lock_guard<std::mutex> guard(registryLock);
+
+    // The last generator of the file closes it and writes the index
+    trace.reset();
+}
+
+std::shared_ptr<ArielChunkedTraceGenerator::SharedTrace> ArielChunkedTraceGenerator::openTrace(
+        const std::string& path, const uint32_t chunkRecords, const int level) {
+
+    std::lock_guard<std::mutex> guard(registryLock);
+
+    std::shared_ptr<SharedTrace> shared = registry[path].lock();
+
+    if(!shared) {
+        shared = std::make_shared<SharedTrace>(path, chunkRecords, level);
+
+        if(!shared->writer.isOpen()) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1, "Ariel: unable to open chunked trace file %s\n", path.c_str());
+        }
+
+        registry[path] = shared;
+    }
+
+    return shared;
+}
+
+void ArielChunkedTraceGenerator::publishEntry(const uint64_t picoS,
+        const uint64_t physAddr,
+        const uint32_t reqLength,
+        const ArielTraceEntryOperation op) {
+
+    std::lock_guard<std::mutex> guard(trace->lock);
+    trace->writer.append(coreID, picoS, physAddr, reqLength, READ == op);
+}
+
+void ArielChunkedTraceGenerator::setCoreID(const uint32_t core) {
+    coreID = core;
+}
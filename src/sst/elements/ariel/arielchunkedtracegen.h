@@ -0,0 +1,86 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_CHUNKED_TRACE_GEN
+#define _H_SST_ARIEL_CHUNKED_TRACE_GEN
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <sst/core/params.h>
+#include "arieltracegen.h"
+#include "sst/elements/prospero/prostraceformat.h"
+
+namespace SST {
+namespace ArielComponent {
+
+// Writes the accesses of all cores to a single chunked trace (see
+// prospero/prostraceformat.h), one stream per core.  The generators
+// of the cores share the writer of the file, the index is written
+// when the last of them is destroyed.
+class ArielChunkedTraceGenerator : public ArielTraceGenerator {
+
+    public:
+
+        SST_ELI_REGISTER_MODULE(
+            SST::ArielComponent::ArielChunkedTraceGenerator,
+            "ariel",
+            "ChunkedTraceGenerator",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Provides tracing of all cores to one chunked, indexed and seekable compressed file",
+            SST::ArielComponent::ArielTraceGenerator
+        )
+
+        SST_ELI_DOCUMENT_PARAMS(
+            { "trace_prefix", "Sets the prefix for the trace file, the file is <prefix>.ctrace", "ariel-core" },
+            { "chunk_records", "Number of records compressed together, the granularity of seeking", "65536" },
+            { "compression_level", "zlib compression level, 1 (fastest) to 9 (smallest)", "1" }
+        )
+
+        ArielChunkedTraceGenerator(Params& params);
+
+        ~ArielChunkedTraceGenerator();
+
+        void publishEntry(const uint64_t picoS, const uint64_t physAddr,
+                const uint32_t reqLength, const ArielTraceEntryOperation op);
+
+        void setCoreID(const uint32_t core);
+
+    private:
+        struct SharedTrace {
+            SharedTrace(const std::string& path, const uint32_t chunkRecords, const int level) :
+                writer(path, chunkRecords, level) {}
+
+            SST::Prospero::ChunkedTraceWriter writer;
+            std::mutex lock;
+        };
+
+        static std::shared_ptr<SharedTrace> openTrace(const std::string& path,
+                const uint32_t chunkRecords, const int level);
+
+        static std::mutex registryLock;
+        static std::map<std::string, std::weak_ptr<SharedTrace>> registry;
+
+        std::shared_ptr<SharedTrace> trace;
+        uint32_t coreID;
+
+};
+
+}
+}
+
+#endif
@@ -17,6 +17,8 @@
 
 #include "arielgzbintracegen.h"
 
+#include <algorithm>
+
 using namespace SST::ArielComponent;
 
 ArielCompressedBinaryTraceGenerator::ArielCompressedBinaryTraceGenerator(Params& params) :
@@ -24,12 +26,19 @@ ArielCompressedBinaryTraceGenerator::ArielCompressedBinaryTraceGenerator(Params&
 
     tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
     coreID = 0;
+    traceFile = NULL;
 
-    buffer = (char*) malloc(sizeof(uint64_t) + sizeof(uint64_t) + sizeof(char) + sizeof(uint32_t));
+    // Records are gathered and handed to zlib in large writes
+    bufferRecords = std::max(params.find<uint32_t>("buffer_records", 4096), (uint32_t) 1);
+    bufferedRecords = 0;
+    buffer = (char*) malloc((size_t) bufferRecords * ARIEL_BINARY_RECORD_LENGTH);
 }
 
 ArielCompressedBinaryTraceGenerator::~ArielCompressedBinaryTraceGenerator() {
-    gzclose(traceFile);
+    if(NULL != traceFile) {
+        flush();
+        gzclose(traceFile);
+    }
     free(buffer);
 }
 
@@ -39,13 +48,25 @@ void ArielCompressedBinaryTraceGenerator::publishEntry(const uint64_t picoS,
         const ArielTraceEntryOperation op) {
 
     const char op_type = (READ == op) ? 'R' : 'W';
+    char* record = &buffer[(size_t) bufferedRecords * ARIEL_BINARY_RECORD_LENGTH];
 
-    copy(&buffer[0], &picoS, sizeof(uint64_t));
-    copy(&buffer[sizeof(uint64_t)], &op_type, sizeof(char));
-    copy(&buffer[sizeof(uint64_t) + sizeof(char)], &physAddr, sizeof(uint64_t));
-    copy(&buffer[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t)], &reqLength, sizeof(uint32_t));
+    copy(&record[0], &picoS, sizeof(uint64_t));
+    copy(&record[sizeof(uint64_t)], &op_type, sizeof(char));
+    copy(&record[sizeof(uint64_t) + sizeof(char)], &physAddr, sizeof(uint64_t));
+    copy(&record[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t)], &reqLength, sizeof(uint32_t));
 
-    gzwrite(traceFile, buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t));
+    bufferedRecords++;
+
+    if(bufferRecords == bufferedRecords) {
+        flush();
+    }
+}
+
+void ArielCompressedBinaryTraceGenerator::flush() {
+    if(bufferedRecords > 0) {
+        gzwrite(traceFile, buffer, (unsigned int) (bufferedRecords * ARIEL_BINARY_RECORD_LENGTH));
+        bufferedRecords = 0;
+    }
 }
 
 void ArielCompressedBinaryTraceGenerator::setCoreID(const uint32_t core) {
@@ -55,6 +76,7 @@ void ArielCompressedBinaryTraceGenerator::setCoreID(const uint32_t core) {
     snprintf(tracePath, size, "%s-%" PRIu32 ".trace.gz", tracePrefix.c_str(), core);
 
     traceFile = gzopen(tracePath, "wb");
+    gzbuffer(traceFile, 1024 * 1024);
 
     free(tracePath);
 }
@@ -26,6 +26,9 @@
 namespace SST {
 namespace ArielComponent {
 
+// cycles (8 bytes), type ('R' or 'W'), address (8 bytes), length (4 bytes)
+#define ARIEL_BINARY_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
 class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
 
     public:
@@ -40,7 +43,8 @@ class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
         )
 
         SST_ELI_DOCUMENT_PARAMS(
-            { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" }
+            { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" },
+            { "buffer_records", "Number of records gathered before they are handed to zlib", "4096" }
         )
 
         ArielCompressedBinaryTraceGenerator(Params& params);
@@ -54,11 +58,14 @@ class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
 
     private:
         void copy(char* dest, const void* src, const size_t length);
+        void flush();
 
         gzFile traceFile;
         std::string tracePrefix;
         uint32_t coreID;
         char* buffer;
+        uint32_t bufferRecords;
+        uint32_t bufferedRecords;
 
 };
 
@@ -41,6 +41,9 @@
 using namespace SST;
 using namespace SST::CramSim;
 
+static_assert(static_cast<unsigned>(e_BankCommandType::PDE) + 1 == 11,
+              "c_BankInfo command cycle tables must cover every e_BankCommandType");
+
 c_BankInfo::c_BankInfo() :
         m_bankState(new c_BankStateIdle(nullptr)) {
 
@@ -98,30 +101,32 @@ void c_BankInfo::print() {
     default:
         break;
     }
-    str << "m_nextCommandCycleMap: " << std::endl;
-    for (auto l_mapEntry : m_nextCommandCycleMap) {
-        str << m_cmdToString[l_mapEntry.first] << ":" << std::dec
-                << l_mapEntry.second << std::endl;
+    str << "m_nextCommandCycle: " << std::endl;
+    for (unsigned l_i = 0; l_i < k_numCommandTypes; ++l_i) {
+        if (!m_isTrackedCommand[l_i])
+            continue;
+        str << m_cmdToString[static_cast<e_BankCommandType>(l_i)] << ":" << std::dec
+                << m_nextCommandCycle[l_i] << std::endl;
     }
     Output::getDefaultObject().output("%s", str.str().c_str());
 }
 
 void c_BankInfo::reset() {
-    m_lastCommandCycleMap = { {e_BankCommandType::ACT,0},
-        {    e_BankCommandType::READ,0},
-        {    e_BankCommandType::READA,0},
-        {    e_BankCommandType::WRITE,0},
-        {    e_BankCommandType::WRITEA,0},
-        {    e_BankCommandType::PRE,0},
-        {    e_BankCommandType::REF,0}};
-
-    m_nextCommandCycleMap = { {e_BankCommandType::ACT,0},
-        {    e_BankCommandType::READ,0},
-        {    e_BankCommandType::READA,0},
-        {    e_BankCommandType::WRITE,0},
-        {    e_BankCommandType::WRITEA,0},
-        {    e_BankCommandType::PRE,0},
-        {    e_BankCommandType::REF, 0}};
+    const e_BankCommandType l_trackedCmds[] = { e_BankCommandType::ACT,
+        e_BankCommandType::READ,
+        e_BankCommandType::READA,
+        e_BankCommandType::WRITE,
+        e_BankCommandType::WRITEA,
+        e_BankCommandType::PRE,
+        e_BankCommandType::REF };
+
+    for (unsigned l_i = 0; l_i < k_numCommandTypes; ++l_i) {
+        m_lastCommandCycle[l_i] = 0;
+        m_nextCommandCycle[l_i] = 0;
+        m_isTrackedCommand[l_i] = false;
+    }
+    for (auto l_cmd : l_trackedCmds)
+        m_isTrackedCommand[static_cast<unsigned>(l_cmd)] = true;
 
     m_cmdToString[e_BankCommandType::ERR] = "ERR";
     m_cmdToString[e_BankCommandType::ACT] = "ACT";
@@ -136,10 +141,9 @@ void c_BankInfo::reset() {
 
 void c_BankInfo::handleCommand(c_BankCommand* x_bankCommandPtr,
                                SimTime_t x_simCycle) {
+    assert(m_isTrackedCommand[static_cast<unsigned>(x_bankCommandPtr->getCommandMnemonic())]);
     assert(
-            m_nextCommandCycleMap.end() != m_nextCommandCycleMap.find(x_bankCommandPtr->getCommandMnemonic()));
-    assert(
-            x_simCycle >= m_nextCommandCycleMap[x_bankCommandPtr->getCommandMnemonic()]);
+            x_simCycle >= m_nextCommandCycle[static_cast<unsigned>(x_bankCommandPtr->getCommandMnemonic())]);
 
 
     m_bankState->handleCommand(this, x_bankCommandPtr,x_simCycle);
@@ -154,6 +158,14 @@ void c_BankInfo::clockTic(SimTime_t x_cycle) {
 
 }
 
+void c_BankInfo::skipCycles(SimTime_t x_cycles) {
+    assert(m_bankState->isQuiescent());
+
+    m_autoPrechargeTimer = (m_autoPrechargeTimer > x_cycles) ? m_autoPrechargeTimer - x_cycles : 0;
+
+    m_bankState->skipCycles(x_cycles);
+}
+
 std::list<e_BankCommandType> c_BankInfo::getAllowedCommands() {
     return m_bankState->getAllowedCommands();
 }
@@ -164,8 +176,9 @@ bool c_BankInfo::isCommandAllowed(c_BankCommand* x_cmdPtr,
     assert(nullptr != m_bankState);
 
     if (m_bankState->isCommandAllowed(x_cmdPtr, this)) {
-        assert(m_nextCommandCycleMap.find(x_cmdPtr->getCommandMnemonic()) != m_nextCommandCycleMap.end());
-        if (m_nextCommandCycleMap.find(x_cmdPtr->getCommandMnemonic())->second <= x_simCycle)
+        unsigned l_cmd = static_cast<unsigned>(x_cmdPtr->getCommandMnemonic());
+        assert(m_isTrackedCommand[l_cmd]);
+        if (m_nextCommandCycle[l_cmd] <= x_simCycle)
             l_canAccept = true;
 
 
@@ -181,24 +194,24 @@ void c_BankInfo::changeState(c_BankState* x_newState) {
 
 void c_BankInfo::setNextCommandCycle(const e_BankCommandType x_cmd,
         const SimTime_t x_cycle) {
-    assert(m_nextCommandCycleMap.end() != m_nextCommandCycleMap.find(x_cmd));
-    m_nextCommandCycleMap[x_cmd] = x_cycle;
+    assert(m_isTrackedCommand[static_cast<unsigned>(x_cmd)]);
+    m_nextCommandCycle[static_cast<unsigned>(x_cmd)] = x_cycle;
 }
 
 SimTime_t c_BankInfo::getNextCommandCycle(e_BankCommandType x_cmd) {
-    assert(m_nextCommandCycleMap.end() != m_nextCommandCycleMap.find(x_cmd));
-    return (m_nextCommandCycleMap[x_cmd]);
+    assert(m_isTrackedCommand[static_cast<unsigned>(x_cmd)]);
+    return (m_nextCommandCycle[static_cast<unsigned>(x_cmd)]);
 }
 
 void c_BankInfo::setLastCommandCycle(e_BankCommandType x_cmd,
                                      SimTime_t x_lastCycle) {
-    assert(m_lastCommandCycleMap.end() != m_lastCommandCycleMap.find(x_cmd));
-    m_lastCommandCycleMap[x_cmd] = x_lastCycle;
+    assert(m_isTrackedCommand[static_cast<unsigned>(x_cmd)]);
+    m_lastCommandCycle[static_cast<unsigned>(x_cmd)] = x_lastCycle;
 }
 
 SimTime_t c_BankInfo::getLastCommandCycle(e_BankCommandType x_cmd) {
-    assert(m_lastCommandCycleMap.end() != m_lastCommandCycleMap.find(x_cmd));
-    return m_lastCommandCycleMap[x_cmd];
+    assert(m_isTrackedCommand[static_cast<unsigned>(x_cmd)]);
+    return m_lastCommandCycle[static_cast<unsigned>(x_cmd)];
 }
 
 void c_BankInfo::acceptBankGroup(c_BankGroup* x_bankGroupPtr) {
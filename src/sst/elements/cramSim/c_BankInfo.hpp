@@ -57,6 +57,16 @@ public:
 
     void clockTic(SimTime_t x_cycle);
 
+    // true if clockTic would only count down timers, i.e. the bank has no command in flight
+    bool isQuiescent() {
+        return (m_bankState->isQuiescent());
+    }
+    // advance a quiescent bank by x_cycles without ticking it cycle by cycle
+    void skipCycles(SimTime_t x_cycles);
+    SimTime_t getMaxSkipCycles() {
+        return (m_bankState->getMaxSkipCycles());
+    }
+
     std::list<e_BankCommandType> getAllowedCommands();
 
     bool isCommandAllowed(c_BankCommand* x_cmdPtr, SimTime_t x_simCycle);
@@ -121,8 +131,13 @@ private:
     c_BankGroup* m_bankGroupPtr;
 
     std::map<std::string, unsigned>* m_bankParams;
-    std::map<e_BankCommandType, SimTime_t> m_lastCommandCycleMap;
-    std::map<e_BankCommandType, SimTime_t> m_nextCommandCycleMap;
+
+    // per-command cycle tables, indexed by e_BankCommandType. These are looked up for every
+    // candidate command every cycle, so they are flat arrays rather than maps.
+    enum { k_numCommandTypes = 11 };
+    SimTime_t m_lastCommandCycle[k_numCommandTypes];
+    SimTime_t m_nextCommandCycle[k_numCommandTypes];
+    bool m_isTrackedCommand[k_numCommandTypes];
 
     //TESTING -- DELETE
     std::map<e_BankCommandType, std::string> m_cmdToString;
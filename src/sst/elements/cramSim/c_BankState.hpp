@@ -33,6 +33,7 @@
 
 // C++ includes
 #include <memory>
+#include <limits>
 #include <list>
 #include <map>
 
@@ -72,6 +73,21 @@ public:
     virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
             c_BankInfo* x_bankPtr) = 0;
 
+    // A state is quiescent when clockTic has nothing left to do but count down its timer,
+    // so the controller may stop clocking the bank and fast-forward it with skipCycles.
+    // Transitory states (ACTNG, READ, WRITE, PRE, REF, ...) are never quiescent.
+    virtual bool isQuiescent() {
+        return false;
+    }
+
+    virtual void skipCycles(SimTime_t x_cycles) {
+    }
+
+    // upper bound for skipCycles, so that no timer passes a value at which clockTic acts
+    virtual SimTime_t getMaxSkipCycles() {
+        return std::numeric_limits<SimTime_t>::max();
+    }
+
     e_BankState getCurrentState() {
         return m_currentState;
     }
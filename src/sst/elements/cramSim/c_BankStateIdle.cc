@@ -175,3 +175,24 @@ bool c_BankStateIdle::isCommandAllowed(c_BankCommand* x_cmdPtr,
     return false;
 
 }
+
+bool c_BankStateIdle::isQuiescent() {
+    // the timer only triggers work when a command has been received (or at 2, on its way to 1)
+    return (nullptr == m_receivedCommandPtr) && (2 != m_timer);
+}
+
+void c_BankStateIdle::skipCycles(SimTime_t x_cycles) {
+    assert(x_cycles <= getMaxSkipCycles());
+
+    // clockTic decrements unconditionally in this state, wrapping below zero
+    m_timer -= x_cycles;
+}
+
+SimTime_t c_BankStateIdle::getMaxSkipCycles() {
+    // the tick that moves the timer from 2 to 1 marks the previous command's response ready,
+    // so it has to be a real clock tick
+    if (2 < m_timer)
+        return m_timer - 2;
+
+    return std::numeric_limits<SimTime_t>::max();
+}
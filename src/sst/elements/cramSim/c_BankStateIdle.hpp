@@ -60,6 +60,10 @@ public:
     virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
             c_BankInfo* x_bankPtr);
 
+    virtual bool isQuiescent();
+    virtual void skipCycles(SimTime_t x_cycles);
+    virtual SimTime_t getMaxSkipCycles();
+
 private:
 
 
@@ -154,3 +154,26 @@ unsigned c_CmdScheduler::getToken(const c_HashedAddress &x_addr)
     return k_numCmdQEntries-m_cmdQueues[l_ch].at(l_bank).size();
 
 }
+
+
+bool c_CmdScheduler::isIdle()
+{
+    for (auto &l_chQueues : m_cmdQueues)
+        for (auto &l_cmdQueue : l_chQueues)
+            if (!l_cmdQueue.empty())
+                return false;
+    return true;
+}
+
+
+void c_CmdScheduler::skipCycles(SimTime_t x_cycles)
+{
+    for(unsigned l_ch=0;l_ch<m_numChannels;l_ch++) {
+        if(m_schedulingPolicy==e_SchedulingPolicy::BANK)
+            m_nextCmdQIdx.at(l_ch)=(m_nextCmdQIdx.at(l_ch)+x_cycles%m_numBanksPerChannel)%m_numBanksPerChannel;
+        else if(m_schedulingPolicy==e_SchedulingPolicy::RANK) {
+            SimTime_t l_mod = m_numBanksPerChannel-1;
+            m_nextCmdQIdx.at(l_ch)=(m_nextCmdQIdx.at(l_ch)+(x_cycles%l_mod)*m_numBanksPerRank)%l_mod;
+        }
+    }
+}
@@ -72,6 +72,8 @@ namespace SST{
             void run(SimTime_t simCycle);
             bool push(c_BankCommand* x_cmd);
             unsigned getToken(const c_HashedAddress &x_addr);
+            bool isIdle();
+            void skipCycles(SimTime_t x_cycles); // advance the round-robin pointers as if x_cycles empty cycles had run
 
 
         private:
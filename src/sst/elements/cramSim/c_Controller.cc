@@ -27,6 +27,8 @@
 
 #include "sst_config.h"
 
+#include <limits>
+
 #include "c_Controller.hpp"
 #include "c_TxnReqEvent.hpp"
 #include "c_TxnResEvent.hpp"
@@ -116,16 +118,20 @@ c_Controller::c_Controller(ComponentId_t id, Params &params) :
         output->output("boolEnableQuickRes param value is missing... disabled\n");
     }
 
+    k_enableCycleSkipping = (uint32_t)params.find<uint32_t>("boolEnableCycleSkipping", 0, l_found);
+
     // get configured clock frequency
     k_controllerClockFreqStr = (std::string)params.find<std::string>("strControllerClockFrequency", "1GHz", l_found);
 
+    //set our clock
+    m_clockHandler = new Clock::Handler2<c_Controller,&c_Controller::clockTic>(this);
+    m_clockTC = registerClock(k_controllerClockFreqStr, m_clockHandler);
+    m_clockIsOn = true;
+    m_lastClockCycle = 0;
+
     //configure SST link
     configure_link();
 
-    //set our clock
-    registerClock(k_controllerClockFreqStr,
-                  new Clock::Handler2<c_Controller,&c_Controller::clockTic>(this));
-
 
 
 }
@@ -145,6 +151,11 @@ void c_Controller::configure_link() {
     // Controller <-> Device (Cmd)
     m_memLink = configureLink("memLink",
                               new Event::Handler2<c_Controller,&c_Controller::handleInDeviceResPtrEvent>(this));
+    // Controller -> Controller (refresh wakeup while the clock is off)
+    m_wakeupLink = nullptr;
+    if (k_enableCycleSkipping)
+        m_wakeupLink = configureSelfLink("wakeupLink", m_clockTC,
+                                         new Event::Handler2<c_Controller,&c_Controller::handleWakeup>(this));
 }
 
 
@@ -152,6 +163,7 @@ void c_Controller::configure_link() {
 bool c_Controller::clockTic(SST::Cycle_t clock) {
 
     m_simCycle++;
+    m_lastClockCycle = clock;
 
     sendResponse();
 
@@ -217,11 +229,61 @@ bool c_Controller::clockTic(SST::Cycle_t clock) {
     // 6. run device driver
     m_deviceDriver->run();
 
+    if (k_enableCycleSkipping && isIdle())
+        return turnClockOff();
 
     return false;
 }
 
 
+bool c_Controller::isIdle() {
+    return m_ReqQ.empty() && m_ResQ.empty()
+        && m_txnScheduler->isIdle()
+        && m_txnConverter->isIdle()
+        && m_cmdScheduler->isIdle()
+        && m_deviceDriver->isIdle();
+}
+
+
+// Stop the clock if there are enough idle cycles ahead to be worth it. Returns the value for clockTic.
+bool c_Controller::turnClockOff() {
+    SimTime_t l_maxSkip = m_deviceDriver->getMaxSkipCycles();
+    if (l_maxSkip < 2)
+        return false;
+
+    // wake up one cycle early so that the refresh is created by a real clock tick
+    if (l_maxSkip != std::numeric_limits<SimTime_t>::max())
+        m_wakeupLink->send(l_maxSkip - 1, nullptr);
+
+    m_clockIsOn = false;
+    return true;
+}
+
+
+// Restart the clock and fast-forward every subcomponent over the cycles that were skipped
+void c_Controller::turnClockOn() {
+    if (m_clockIsOn)
+        return;
+
+    SST::Cycle_t l_nextCycle = reregisterClock(m_clockTC, m_clockHandler);
+    SimTime_t l_skipped = l_nextCycle - m_lastClockCycle - 1;
+    // a stale wakeup can never let us skip past a refresh, but be defensive
+    l_skipped = std::min(l_skipped, m_deviceDriver->getMaxSkipCycles());
+
+    m_simCycle += l_skipped;
+    m_cmdScheduler->skipCycles(l_skipped);
+    m_txnConverter->skipCycles(l_skipped);
+    m_deviceDriver->skipCycles(l_skipped);
+
+    m_clockIsOn = true;
+}
+
+
+void c_Controller::handleWakeup(SST::Event *ev) {
+    turnClockOn();
+}
+
+
 void c_Controller::sendCommand(c_BankCommand* cmd)
 {
      c_CmdReqEvent *l_cmdReqEventPtr = new c_CmdReqEvent();
@@ -273,6 +335,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
         newTxn->print(debug,"[c_Controller.handleIncommingTransaction]",m_simCycle);
         #endif
 
+        turnClockOn();
+
         m_ReqQ.push_back(newTxn);
         m_ResQ.push_back(newTxn);
 
@@ -287,6 +351,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
 void c_Controller::handleInDeviceResPtrEvent(SST::Event *ev){
     c_CmdResEvent* l_cmdResEventPtr = dynamic_cast<c_CmdResEvent*>(ev);
     if (l_cmdResEventPtr) {
+        turnClockOn();
+
         ulong l_resSeqNum = l_cmdResEventPtr->m_payload->getSeqNum();
         // need to find which txn matches the command seq number in the txnResQ
         c_Transaction* l_txnRes = nullptr;
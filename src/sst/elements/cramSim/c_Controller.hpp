@@ -65,7 +65,8 @@ namespace SST {
 
             SST_ELI_DOCUMENT_PARAMS(
                 {"verbose", "Output verbosity", "0"},
-                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" }
+                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" },
+                {"boolEnableCycleSkipping", "Stop the controller clock while there is no outstanding work and fast-forward over the idle cycles (waking for refresh)", "0" }
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -101,6 +102,12 @@ namespace SST {
 
             virtual bool clockTic(SST::Cycle_t); // called every cycle
 
+            // cycle skipping
+            bool isIdle();
+            bool turnClockOff();
+            void turnClockOn();
+            void handleWakeup(SST::Event *ev);
+
 
             void sendResponse();
             void sendRequest();
@@ -128,9 +135,16 @@ namespace SST {
 
             // params for system configuration
             int k_enableQuickResponse;
+            bool k_enableCycleSkipping;
 
             // clock frequency
             std::string k_controllerClockFreqStr;
+            TimeConverter m_clockTC;
+            Clock::HandlerBase *m_clockHandler;
+            bool m_clockIsOn;
+            SST::Cycle_t m_lastClockCycle;
+            // wakes the controller for the next refresh while its clock is off
+            SST::Link *m_wakeupLink;
 
             // Transaction Generator <-> Controller Links
             SST::Link *m_txngenLink;
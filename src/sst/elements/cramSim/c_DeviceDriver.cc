@@ -33,6 +33,7 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <limits>
 #include <assert.h>
 
 // CramSim includes
@@ -337,8 +338,9 @@ void c_DeviceDriver::build(Params& params) {
     m_lastChannel=0;
 
     // reset command bus
-    m_blockColCmd.resize(k_numChannels);
-    m_blockRowCmd.resize(k_numChannels);
+    m_blockColCmd.resize(k_numChannels, 0);
+    m_blockRowCmd.resize(k_numChannels, 0);
+    m_numOccupiedCmdBus = 0;
 
     //init per-rank FAW tracker
     initACTFAWTracker();
@@ -459,11 +461,7 @@ void c_DeviceDriver::update(SimTime_t simCycle) {
         // m_banks.at(l_i)->printState();
     }
     //update ACTFAWTracker info
-    for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
-        m_cmdACTFAWtrackers[l_rankNum].push_back(
-                m_isACTIssued[l_rankNum] ? static_cast<unsigned>(1) : static_cast<unsigned>(0));
-        m_cmdACTFAWtrackers[l_rankNum].pop_front();
-    }
+    updateACTFAWTracker();
 
     // do the member var setup up before calling any req sending policy function
     if (m_inflightWrites.size() > 0)
@@ -477,6 +475,86 @@ void c_DeviceDriver::update(SimTime_t simCycle) {
 }
 
 
+/*!
+ * The driver has no work if no commands are queued or waiting for a response, no refresh is
+ * pending, and every bank is quiescent
+ */
+bool c_DeviceDriver::isIdle() {
+    if (!m_inputQ.empty() || !m_outputQ.empty())
+        return false;
+
+    for (auto &l_cmdQ : m_refreshCmdQ)
+        if (!l_cmdQ.empty())
+            return false;
+
+    for (auto &l_bank : m_banks)
+        if (!l_bank->isQuiescent())
+            return false;
+
+    return true;
+}
+
+/*!
+ * run() creates refresh commands for a rank once its REFI counter reaches zero, so an idle
+ * driver can be skipped ahead until the first counter would expire or a bank timer would
+ * reach a transition
+ */
+SimTime_t c_DeviceDriver::getMaxSkipCycles() {
+    SimTime_t l_maxSkip = std::numeric_limits<SimTime_t>::max();
+
+    for (auto &l_bank : m_banks)
+        l_maxSkip = std::min(l_maxSkip, l_bank->getMaxSkipCycles());
+
+    if (k_useRefresh)
+        for (auto &l_count : m_currentREFICount)
+            l_maxSkip = std::min(l_maxSkip, (SimTime_t) l_count);
+
+    return l_maxSkip;
+}
+
+/*!
+ *
+ * @param x_cycles
+ */
+void c_DeviceDriver::skipCycles(SimTime_t x_cycles) {
+    assert(isIdle());
+    assert(x_cycles <= getMaxSkipCycles());
+
+    if (x_cycles == 0)
+        return;
+
+    m_simCycle += x_cycles;
+
+    for (auto &l_bank : m_banks)
+        l_bank->skipCycles(x_cycles);
+
+    // the first skipped cycle records any ACT issued in the last active cycle, the rest are empty
+    if (x_cycles <= k_FAWWindow) {
+        updateACTFAWTracker();
+        std::fill(m_isACTIssued.begin(), m_isACTIssued.end(), false);
+        for (SimTime_t l_i = 1; l_i < x_cycles; l_i++)
+            updateACTFAWTracker();
+    } else {
+        std::fill(m_cmdACTFAWtrackers.begin(), m_cmdACTFAWtrackers.end(), 0);
+        std::fill(m_numACTinFAW.begin(), m_numACTinFAW.end(), 0);
+        std::fill(m_isACTIssued.begin(), m_isACTIssued.end(), false);
+    }
+
+    if (k_useRefresh)
+        for (auto &l_count : m_currentREFICount)
+            l_count -= x_cycles;
+
+    // command bus occupancy is at most two cycles and is released twice per cycle
+    for (auto &l_bus : m_blockColCmd)
+        setCommandBus(l_bus, 0);
+    for (auto &l_bus : m_blockRowCmd)
+        setCommandBus(l_bus, 0);
+
+    m_inflightWrites.clear();
+    std::fill(m_blockBank.begin(), m_blockBank.end(), false);
+}
+
+
 
 
 /*!
@@ -554,15 +632,6 @@ c_BankInfo* c_DeviceDriver::getBankInfo(unsigned x_bankId)
  */
 void c_DeviceDriver::sendRequest() {
 
-    // get count of ACT cmds issued in the FAW
-    std::vector<unsigned> l_numACTIssuedInFAW;
-    l_numACTIssuedInFAW.clear();
-    for(int l_rankId=0;l_rankId<m_numRanks;l_rankId++)
-    {
-        l_numACTIssuedInFAW.push_back(getNumIssuedACTinFAW(l_rankId));
-    }
-
-
     for (auto l_cmdPtrItr = m_inputQ.begin(); l_cmdPtrItr != m_inputQ.end();)  {
 
         bool l_proceed = true;
@@ -590,7 +659,7 @@ void c_DeviceDriver::sendRequest() {
         if ((l_cmdPtr)->getCommandMnemonic() == e_BankCommandType::REF)
             break;
 
-        if ((e_BankCommandType::ACT == ((l_cmdPtr))->getCommandMnemonic()) && (l_numACTIssuedInFAW[l_rankNum] >= 4))
+        if ((e_BankCommandType::ACT == ((l_cmdPtr))->getCommandMnemonic()) && (getNumIssuedACTinFAW(l_rankNum) >= 4))
         {
             l_proceed = false;
         }
@@ -758,23 +827,17 @@ bool c_DeviceDriver::occupyCommandBus(c_BankCommand *l_cmdPtr) {
     //Occupy the command bus
     if (k_useDualCommandBus) {
         if (l_cmdPtr->isColCommand())
-            m_blockColCmd.at(l_ChannelNum) = l_cmdCycle;
+            setCommandBus(m_blockColCmd.at(l_ChannelNum), l_cmdCycle);
         else
-            m_blockRowCmd.at(l_ChannelNum) = l_cmdCycle;
+            setCommandBus(m_blockRowCmd.at(l_ChannelNum), l_cmdCycle);
     }
     else {
-        m_blockColCmd.at(l_ChannelNum) = 1;
-        m_blockRowCmd.at(l_ChannelNum) = 1;
+        setCommandBus(m_blockColCmd.at(l_ChannelNum), 1);
+        setCommandBus(m_blockRowCmd.at(l_ChannelNum), 1);
     }
 
     //Check whether all command buses are occupied
-    for(auto & value: m_blockColCmd)
-        if(value == 0)
-            l_NumAvailableBus++;
-
-    for(auto & value: m_blockRowCmd)
-        if(value == 0)
-            l_NumAvailableBus++;
+    l_NumAvailableBus = m_blockColCmd.size() + m_blockRowCmd.size() - m_numOccupiedCmdBus;
 
     if(l_NumAvailableBus>0) {
         return false;
@@ -788,17 +851,31 @@ bool c_DeviceDriver::occupyCommandBus(c_BankCommand *l_cmdPtr) {
  *
  */
 void c_DeviceDriver::releaseCommandBus() {
+    if (m_numOccupiedCmdBus == 0)
+        return;
+
     for(auto & value: m_blockColCmd)
     {
-        if(value>0) value--;
+        if(value>0) setCommandBus(value, value - 1);
     }
 
     for(auto & value: m_blockRowCmd)
     {
-        if(value>0) value--;
+        if(value>0) setCommandBus(value, value - 1);
     }
 }
 
+/**
+ * Set a command bus occupancy counter, keeping m_numOccupiedCmdBus in step
+ */
+void c_DeviceDriver::setCommandBus(unsigned &x_bus, unsigned x_cycles) {
+    if (x_bus == 0 && x_cycles > 0)
+        m_numOccupiedCmdBus++;
+    else if (x_bus > 0 && x_cycles == 0)
+        m_numOccupiedCmdBus--;
+    x_bus = x_cycles;
+}
+
 
 /*!
  *
@@ -876,14 +953,31 @@ bool c_DeviceDriver::sendCommand(c_BankCommand* x_bankCommandPtr,
  */
 void c_DeviceDriver::initACTFAWTracker()
 {
+    // the window covers the nFAW-1 cycles before the current one
+    k_FAWWindow = m_bankParams.at("nFAW") > 0 ? m_bankParams.at("nFAW") - 1 : 0;
+    m_FAWHead = 0;
     m_cmdACTFAWtrackers.clear();
-    for(int i=0; i<m_numRanks;i++)
-    {
-        std::list<unsigned> l_cmdACTFAWTracker;
-        l_cmdACTFAWTracker.clear();
-        l_cmdACTFAWTracker.resize(m_bankParams.at("nFAW")-1, 0);
-        m_cmdACTFAWtrackers.push_back(l_cmdACTFAWTracker);
+    m_cmdACTFAWtrackers.resize(m_numRanks * k_FAWWindow, 0);
+    m_numACTinFAW.clear();
+    m_numACTinFAW.resize(m_numRanks, 0);
+}
+
+/*!
+ * Shift this cycle's ACT flags into each rank's tFAW window, dropping the oldest cycle
+ */
+void c_DeviceDriver::updateACTFAWTracker()
+{
+    if (k_FAWWindow == 0)
+        return;
+
+    for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
+        uint8_t &l_slot = m_cmdACTFAWtrackers[l_rankNum * k_FAWWindow + m_FAWHead];
+        uint8_t l_issued = m_isACTIssued[l_rankNum] ? 1 : 0;
+        m_numACTinFAW[l_rankNum] += l_issued;
+        m_numACTinFAW[l_rankNum] -= l_slot;
+        l_slot = l_issued;
     }
+    m_FAWHead = (m_FAWHead + 1 == k_FAWWindow) ? 0 : m_FAWHead + 1;
 }
 
 /*!
@@ -914,11 +1008,7 @@ unsigned c_DeviceDriver::getNumIssuedACTinFAW(unsigned x_rankid) {
     assert(x_rankid<m_numRanks);
 
     // get count of ACT cmds issued in the FAW
-    unsigned l_cmdACTIssuedInFAW = 0;
-    assert(m_cmdACTFAWtrackers[x_rankid].size() == m_bankParams.at("nFAW")-1);
-    for(auto& l_issued : m_cmdACTFAWtrackers[x_rankid])
-        l_cmdACTIssuedInFAW += l_issued;
-    return l_cmdACTIssuedInFAW;
+    return m_numACTinFAW[x_rankid];
 }
 
 /*!
@@ -137,6 +137,13 @@ public:
     virtual c_BankInfo* getBankInfo(unsigned x_bankId);
     void update(SimTime_t simCycle);
 
+    /// true if nothing is queued or in flight and every bank is quiescent
+    bool isIdle();
+    /// how many cycles may be skipped from an idle state before the next refresh or bank timer transition is due
+    SimTime_t getMaxSkipCycles();
+    /// advance an idle driver by x_cycles, as if update() and run() had been called for each of them
+    void skipCycles(SimTime_t x_cycles);
+
     unsigned getNumChannel(){return k_numChannels;}
     unsigned getNumPChPerChannel(){return k_numPChannelsPerChannel;}
     unsigned getNumRanksPerChannel(){return k_numRanksPerChannel;}
@@ -160,10 +167,12 @@ private:
     bool occupyCommandBus(c_BankCommand *x_cmdPtr);
     ///Release the occupancy of command bus
     void releaseCommandBus();
+    void setCommandBus(unsigned &x_bus, unsigned x_cycles);
 
     void initACTFAWTracker();
     void initRefresh();
     unsigned getNumIssuedACTinFAW(unsigned x_rankid);
+    void updateACTFAWTracker();
     void createRefreshCmds(unsigned x_rank);
     bool isRefreshing(const c_HashedAddress *x_addr);
 
@@ -173,8 +182,9 @@ private:
     std::deque<c_BankCommand*> m_outputQ;
     std::vector<bool> m_blockBank;
     std::set<unsigned> m_inflightWrites; // track inflight write commands
-    std::deque<unsigned> m_blockRowCmd; //command bus occupancy info
-    std::deque<unsigned> m_blockColCmd; //command bus occupancy info
+    std::vector<unsigned> m_blockRowCmd; //command bus occupancy info
+    std::vector<unsigned> m_blockColCmd; //command bus occupancy info
+    unsigned m_numOccupiedCmdBus; //number of non-zero entries in m_blockRowCmd and m_blockColCmd
 
     std::vector<unsigned> m_currentREFICount; //per rank REFICounter
     std::vector<std::vector<c_BankCommand*>> m_refreshCmdQ; //per rank refresh commandQ
@@ -184,7 +194,13 @@ private:
     e_BankCommandType m_lastDataCmdType;
     unsigned m_lastChannel;
     unsigned m_lastPseudoChannel;
-    std::vector<std::list<unsigned>> m_cmdACTFAWtrackers; // FIXME: change this to a circular buffer for speed. Could also implement as shift register.
+    // per-rank record of the cycles in the last tFAW window that issued an ACT. Each rank owns
+    // k_FAWWindow consecutive entries used as a circular buffer; every rank advances once per
+    // cycle, so they share a single head. m_numACTinFAW keeps the running sum of each rank's window.
+    std::vector<uint8_t> m_cmdACTFAWtrackers;
+    std::vector<unsigned> m_numACTinFAW;
+    unsigned m_FAWHead;
+    unsigned k_FAWWindow;
     std::vector<bool> m_isACTIssued;
     bool m_issuedACT;
 
@@ -32,6 +32,7 @@
 
 // std includes
 #include <iostream>
+#include <algorithm>
 #include <assert.h>
 
 // local includes
@@ -224,7 +225,9 @@ c_Transaction* c_TxnScheduler::getNextTxn(TxnQueue& x_queue, int x_ch)
 
 void c_TxnScheduler::popTxn(TxnQueue &x_txnQ, c_Transaction* x_Txn)
 {
-    x_txnQ.remove(x_Txn);
+    TxnQueue::iterator l_it = std::find(x_txnQ.begin(), x_txnQ.end(), x_Txn);
+    if (l_it != x_txnQ.end())
+        x_txnQ.erase(l_it);
 }
 
 bool c_TxnScheduler::push(c_Transaction* newTxn)
@@ -261,6 +264,22 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
 }
 
 
+//Check if all transaction queues are empty
+bool c_TxnScheduler::isIdle()
+{
+    for (auto &l_queue : m_txnQ)
+        if (!l_queue.empty())
+            return false;
+    for (auto &l_queue : m_txnReadQ)
+        if (!l_queue.empty())
+            return false;
+    for (auto &l_queue : m_txnWriteQ)
+        if (!l_queue.empty())
+            return false;
+    return true;
+}
+
+
 //Check if read transactions get data from the transaction queue
 bool c_TxnScheduler::isHit(c_Transaction* x_txn)
 {
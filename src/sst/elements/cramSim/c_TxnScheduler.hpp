@@ -31,6 +31,8 @@
 #ifndef C_TXNSCHEDULER_HPP
 #define C_TXNSCHEDULER_HPP
 
+#include <deque>
+
 #include "c_Transaction.hpp"
 #include "c_TxnConverter.hpp"
 #include "c_Controller.hpp"
@@ -43,7 +45,8 @@ namespace SST {
         class c_Controller;
 
         enum class e_txnSchedulingPolicy {FCFS, FRFCFS};
-        typedef std::list<c_Transaction*> TxnQueue;
+        // bounded by numTxnQEntries, so a contiguous deque beats a node-per-entry list
+        typedef std::deque<c_Transaction*> TxnQueue;
 
         class c_TxnScheduler: public SubComponent{
         public:
@@ -80,6 +83,7 @@ namespace SST {
             virtual void run(SimTime_t simCycle);
             virtual bool push(c_Transaction* newTxn);
             virtual bool isHit(c_Transaction* newTxn);
+            virtual bool isIdle();
 
 
         private:
@@ -72,9 +72,15 @@ class testcase_cramSim_Component(SSTTestCase):
     def test_cramSim_6_W(self):
         self.cramSim_test_template("6_W")
 
+    def test_cramSim_1_RW_cycle_skipping(self):
+        self.cramSim_test_template("1_RW", skipCycles=True)
+
+    def test_cramSim_4_W_cycle_skipping(self):
+        self.cramSim_test_template("4_W", skipCycles=True)
+
 #####
 
-    def cramSim_test_template(self, testcase):
+    def cramSim_test_template(self, testcase, skipCycles=False):
 
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -90,6 +96,9 @@ class testcase_cramSim_Component(SSTTestCase):
         testDataFileName="test_cramSim_{0}".format(testcase)
 
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        if skipCycles:
+            # Same trace and reference file, with idle cycles skipped by the controller
+            testDataFileName="test_cramSim_{0}_cycle_skipping".format(testcase)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
@@ -105,9 +114,26 @@ class testcase_cramSim_Component(SSTTestCase):
             sdlfile = "{0}/test_txntrace4.py".format(self.testcramSimTestsDir)
             otherargs = '--model-options=\"--configfile={0} --traceFile={1}\"'.format(configfile, tracefile)
 
+        if skipCycles:
+            # Detailed run of the same trace for the skipping run to match
+            detailedfile = "{0}/{1}_detailed.out".format(outdir, testDataFileName)
+            detailederrfile = "{0}/{1}_detailed.err".format(outdir, testDataFileName)
+            self.run_sst(sdlfile, detailedfile, detailederrfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+            otherargs = '--model-options=\"--configfile={0} --traceFile={1} boolEnableCycleSkipping=1\"'.format(configfile, tracefile)
+
         # Run SST
         self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
 
+        if skipCycles:
+            # Everything but the echo of the override must match the detailed run
+            filteredfile = "{0}/{1}_filtered.out".format(tmpdir, testDataFileName)
+            with open(outfile) as fin, open(filteredfile, "w") as fout:
+                for line in fin:
+                    if "boolEnableCycleSkipping" not in line:
+                        fout.write(line)
+            cmp_result = testing_compare_diff(testDataFileName, filteredfile, detailedfile)
+            self.assertTrue(cmp_result, "Output file {0} with cycle skipping does not match the detailed run {1}".format(outfile, detailedfile))
+
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
         #       DEVELOPER AGAINST THE LATEST VERSION OF SST TO SEE IF THE
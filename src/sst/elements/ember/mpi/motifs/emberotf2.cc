@@ -78,71 +78,221 @@ static OTF2_CallbackCode EmberOTF2LeaveRegion(
 	return OTF2_CALLBACK_SUCCESS;
 }
 
+// While a program is compiled the calls below record an instruction
+// instead of queueing an event.  The trace callbacks always pass a null
+// payload, GroupWorld and SUM, so the program does not store them.
+
 void EmberOTF2Generator::compute(Queue& q, uint64_t time)
 {
-	enQ_compute(q, time);
+	if (m_programWriter) {
+		m_programWriter->emit(EMBER_OTF2_OP_COMPUTE, 0, 0, 0, 0, time);
+		return;
+	}
+
+	enQ_compute(q, scaleCompute(time));
 }
 
 void EmberOTF2Generator::send(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID dest, uint32_t tag, Communicator group)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_SEND, dtype, dest, tag, 0, count);
+        return;
+    }
+
     enQ_send(q, payload, count, dtype, dest, tag, group);
 }
 
 void EmberOTF2Generator::isend(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID dest, uint32_t tag, Communicator group, MessageRequest* req)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_ISEND, dtype, dest, tag, m_programWriter->acquireSlot(req), count);
+        return;
+    }
+
     enQ_isend(q, payload, count, dtype, dest, tag, group, req);
 }
 
 void EmberOTF2Generator::recv(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID src, uint32_t tag, Communicator group, MessageResponse* resp = NULL )
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_RECV, dtype, src, tag, 0, count);
+        return;
+    }
+
     enQ_recv(q, payload, count, dtype, src, tag, group, resp);
 }
 
 void EmberOTF2Generator::irecv(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID src, uint32_t tag, Communicator group, MessageRequest* req )
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_IRECV, dtype, src, tag, m_programWriter->acquireSlot(req), count);
+        return;
+    }
+
     enQ_irecv(q, payload, count, dtype, src, tag, group, req);
 }
 
 void EmberOTF2Generator::wait(Queue& q, MessageRequest* req, MessageResponse* resp = NULL)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_WAIT, 0, 0, 0, m_programWriter->releaseSlot(req), 0);
+
+        // Nothing is queued, so the request the callback allocated is done with
+        delete req;
+        return;
+    }
+
     enQ_wait(q, req, resp);
 }
 
 void EmberOTF2Generator::barrier(Queue& q, Communicator comm)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_BARRIER, 0, 0, 0, 0, 0);
+        return;
+    }
+
     enQ_barrier(q, comm);
 }
 
 void EmberOTF2Generator::bcast(Queue& q, const Hermes::MemAddr& mydata, uint32_t count, PayloadDataType dtype, int root, Communicator group)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_BCAST, dtype, root, 0, 0, count);
+        return;
+    }
+
     enQ_bcast(q, mydata, count, dtype, root, group);
 }
 
 void EmberOTF2Generator::allreduce( Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count, PayloadDataType dtype, ReductionOperation op, Communicator group )
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_ALLREDUCE, dtype, 0, 0, 0, count);
+        return;
+    }
+
     enQ_allreduce(q, mydata, result, count, dtype, op, group);
 }
 
 void EmberOTF2Generator::reduce(Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count, PayloadDataType dtype, ReductionOperation op, int root, Communicator group )
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_REDUCE, dtype, root, 0, 0, count);
+        return;
+    }
+
     enQ_reduce(q, mydata, result, count, dtype, op,root, group);
 }
 
 void EmberOTF2Generator::scatter(Queue& q, const Hermes::MemAddr& mydata, uint32_t count_send, PayloadDataType dtype_send, const Hermes::MemAddr& result, uint32_t count_recv, PayloadDataType dtype_recv, int root, Communicator group)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_SCATTER, dtype_send, root, count_recv, 0, count_send, dtype_recv);
+        return;
+    }
+
     enQ_scatter(q, mydata, count_send, dtype_send, result, count_recv, dtype_recv, root, group);
 }
 
 void EmberOTF2Generator::allgather(Queue& q, const Hermes::MemAddr& mydata, uint32_t count_send, PayloadDataType dtype_send, const Hermes::MemAddr& result, uint32_t count_recv, PayloadDataType dtype_recv, Communicator group)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_ALLGATHER, dtype_send, 0, count_recv, 0, count_send, dtype_recv);
+        return;
+    }
+
     enQ_allgather(q, mydata, count_send, dtype_send, result, count_recv, dtype_recv, group);
 }
 
 void EmberOTF2Generator::alltoall(Queue& q, const Hermes::MemAddr& mydata, uint32_t count_send, PayloadDataType dtype_send, const Hermes::MemAddr& result, uint32_t count_recv, PayloadDataType dtype_recv, Communicator group)
 {
+    if (m_programWriter) {
+        m_programWriter->emit(EMBER_OTF2_OP_ALLTOALL, dtype_send, 0, count_recv, 0, count_send, dtype_recv);
+        return;
+    }
+
     enQ_alltoall(q, mydata, count_send, dtype_send, result, count_recv, dtype_recv, group);
 }
 
+MessageRequest* EmberOTF2Generator::requestSlot(const EmberOTF2Instruction& ins)
+{
+	if( ins.slot >= m_requestSlots.size() ) {
+		fatal( CALL_INFO, -1, "Error: event program on rank %d uses request slot %" PRIu32 " but has only %" PRIu64 "\n",
+			rank(), ins.slot, static_cast<uint64_t>(m_requestSlots.size()) );
+	}
+
+	return &m_requestSlots[ins.slot];
+}
+
+void EmberOTF2Generator::executeInstruction(Queue& q, const EmberOTF2Instruction& ins)
+{
+	const PayloadDataType dtype = static_cast<PayloadDataType>(ins.dtype);
+	const PayloadDataType dtypeRecv = static_cast<PayloadDataType>(ins.dtypeRecv);
+	const uint32_t count = static_cast<uint32_t>(ins.value);
+
+	switch( ins.opcode ) {
+	case EMBER_OTF2_OP_COMPUTE:
+		if( m_addCompute ) {
+			enQ_compute(q, scaleCompute(ins.value));
+		}
+		break;
+
+	case EMBER_OTF2_OP_SEND:
+		enQ_send(q, 0, count, dtype, ins.peer, ins.tag, GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_RECV:
+		enQ_recv(q, 0, count, dtype, ins.peer, ins.tag, GroupWorld, NULL);
+		break;
+
+	case EMBER_OTF2_OP_ISEND:
+		enQ_isend(q, 0, count, dtype, ins.peer, ins.tag, GroupWorld, requestSlot(ins));
+		break;
+
+	case EMBER_OTF2_OP_IRECV:
+		enQ_irecv(q, 0, count, dtype, ins.peer, ins.tag, GroupWorld, requestSlot(ins));
+		break;
+
+	case EMBER_OTF2_OP_WAIT:
+		enQ_wait(q, requestSlot(ins), NULL);
+		break;
+
+	case EMBER_OTF2_OP_BARRIER:
+		enQ_barrier(q, GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_BCAST:
+		enQ_bcast(q, 0, count, dtype, static_cast<int>(ins.peer), GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_ALLREDUCE:
+		enQ_allreduce(q, 0, 0, count, dtype, SUM, GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_REDUCE:
+		enQ_reduce(q, 0, 0, count, dtype, SUM, static_cast<int>(ins.peer), GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_SCATTER:
+		enQ_scatter(q, 0, count, dtype, 0, ins.tag, dtypeRecv, static_cast<int>(ins.peer), GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_ALLGATHER:
+		enQ_allgather(q, 0, count, dtype, 0, ins.tag, dtypeRecv, GroupWorld);
+		break;
+
+	case EMBER_OTF2_OP_ALLTOALL:
+		enQ_alltoall(q, 0, count, dtype, 0, ins.tag, dtypeRecv, GroupWorld);
+		break;
+
+	default:
+		fatal( CALL_INFO, -1, "Error: event program on rank %d contains unknown opcode %" PRIu32 "\n",
+			rank(), static_cast<uint32_t>(ins.opcode) );
+		break;
+	}
+}
+
 static OTF2_CallbackCode EmberOTF2MPISend(
 	OTF2_LocationRef location,
 	OTF2_TimeStamp time,
@@ -415,17 +565,50 @@ static OTF2_CallbackCode EmberOTF2GlobalString( void* userData,
 
 EmberOTF2Generator::EmberOTF2Generator(SST::ComponentId_t id, Params& params) :
 	EmberMessagePassingGenerator(id, params, "OTF2"),
-	traceLocationCount(0), currentLocation(0), currentTime(0), m_timerResolution(0), m_inMPI(false)
+	traceReader(NULL), traceLocationCount(0), currentLocation(0), currentTime(0), m_timerResolution(0), m_inMPI(false),
+	m_programWriter(NULL), m_replayProgram(false)
 {
     m_size = size();
     std::string tracePrefix = params.find<std::string>("arg.tracePrefix", "");
+    std::string programPrefix = params.find<std::string>("arg.eventProgram", "");
     m_addCompute = params.find<bool>("arg.addCompute", false);
+    m_computeScale = params.find<double>("arg.computeScale", 1.0);
     m_readGlobalStrings = params.find<bool>("arg.readGlobalStringDefinitions", false);
 
 	if( "" == tracePrefix ) {
 		fatal( CALL_INFO, -1, "Error: no trace was specified by the \"tracePrefix\" parameter.\n" );
 	}
 
+	if( m_computeScale < 0.0 ) {
+		fatal( CALL_INFO, -1, "Error: \"computeScale\" must not be negative.\n" );
+	}
+
+	if( "" == programPrefix ) {
+		openTrace( tracePrefix );
+		return;
+	}
+
+	const std::string programPath = programPrefix + "." + std::to_string( rank() );
+	EmberOTF2TraceStamp stamp;
+
+	if( ! EmberOTF2TraceStamp::read( tracePrefix, stamp ) ) {
+		fatal( CALL_INFO, -1, "Error: unable to load trace at: %s\n", tracePrefix.c_str() );
+	}
+
+	if( m_program.map( programPath, static_cast<uint32_t>( rank() ), stamp ) ) {
+		verbose( CALL_INFO, 1, 0, "Replaying event program %s, %" PRIu64 " instructions.\n",
+			programPath.c_str(), m_program.size() );
+	} else {
+		openTrace( tracePrefix );
+		compileProgram( programPath, stamp );
+		closeTrace();
+	}
+
+	m_requestSlots.resize( m_program.getRequestSlots(), NULL );
+	m_replayProgram = true;
+}
+
+void EmberOTF2Generator::openTrace(const std::string& tracePrefix) {
 	verbose( CALL_INFO, 2, 0, "Opening: %s as trace prefix...\n", tracePrefix.c_str() );
 
 	traceReader = OTF2_Reader_Open( tracePrefix.c_str() );
@@ -585,7 +768,58 @@ EmberOTF2Generator::EmberOTF2Generator(SST::ComponentId_t id, Params& params) :
 	OTF2_GlobalEvtReader_SetCallbacks( traceGlobalEvtReader, traceGlobalEvtCallbacks, this );
 }
 
+void EmberOTF2Generator::closeTrace() {
+	if( NULL != traceReader ) {
+		OTF2_Reader_CloseEvtFiles( traceReader );
+		OTF2_Reader_Close( traceReader );
+		traceReader = NULL;
+	}
+}
+
+// Runs the whole event stream of this rank through the callbacks with
+// the program writer installed, then stores the program next to the
+// other ranks' programs.  If it cannot be stored this run replays it
+// from memory.
+void EmberOTF2Generator::compileProgram(const std::string& path, const EmberOTF2TraceStamp& stamp) {
+	EmberOTF2ProgramWriter writer;
+	std::queue<EmberEvent*> unused;
+
+	setEventQueue( &unused );
+	m_programWriter = &writer;
+
+	uint64_t eventsRead = 0;
+	if( OTF2_SUCCESS != OTF2_Reader_ReadAllGlobalEvents( traceReader, traceGlobalEvtReader, &eventsRead ) ) {
+		fatal( CALL_INFO, -1, "Error reading global events on rank %d\n", rank() );
+	}
+
+	m_programWriter = NULL;
+	setEventQueue( NULL );
+
+	verbose( CALL_INFO, 1, 0, "Compiled %" PRIu64 " trace events on rank %d into %" PRIu64 " instructions.\n",
+		eventsRead, rank(), writer.size() );
+
+	if( writer.write( path, static_cast<uint32_t>( rank() ), stamp ) &&
+		m_program.map( path, static_cast<uint32_t>( rank() ), stamp ) ) {
+
+		verbose( CALL_INFO, 1, 0, "Wrote event program %s\n", path.c_str() );
+	} else {
+		verbose( CALL_INFO, 1, 0, "Warning: unable to store event program %s, replaying it from memory.\n",
+			path.c_str() );
+		m_program.adopt( writer );
+	}
+}
+
 bool EmberOTF2Generator::generate( std::queue<EmberEvent*>& evQ ) {
+	if( m_replayProgram ) {
+		const EmberOTF2Instruction* ins;
+
+		while( evQ.empty() && (NULL != (ins = m_program.next())) ) {
+			executeInstruction( evQ, *ins );
+		}
+
+		return m_program.atEnd();
+	}
+
 	setEventQueue( &evQ );
 
 	uint64_t eventsRead = 0;
@@ -652,8 +886,7 @@ EmberOTF2Generator::~EmberOTF2Generator() {
 	verbose( CALL_INFO, 1, 0, "Completed generator, closing down trace handlers." );
 
 //	OTF2_Reader_CloseGlobalEvtReader( traceReader, traceEvtReader );
-	OTF2_Reader_CloseEvtFiles( traceReader );
-	OTF2_Reader_Close( traceReader );
+	closeTrace();
 
 	traceLocations.clear();
 }
@@ -21,6 +21,7 @@
 
 #include "mpi/embermpigen.h"
 #include "otf2/otf2.h"
+#include "emberotf2program.h"
 
 namespace SST {
 namespace Ember {
@@ -45,7 +46,10 @@ public:
 
 	SST_ELI_DOCUMENT_PARAMS(
         	{   "arg.tracePrefix",       "Sets the location of the trace" },
-        	{   "arg.addCompute",        "Add compute time to try to match trace timestamps",  "false" }
+        	{   "arg.addCompute",        "Add compute time to try to match trace timestamps",  "false" },
+        	{   "arg.computeScale",      "Factor applied to the compute time added between trace events", "1.0" },
+        	{   "arg.eventProgram",      "Prefix of the compiled event program files, one per rank. A rank replays its program "
+        	                             "instead of decoding the trace, and compiles it from the trace when missing or stale", "" }
 	)
 
 	SST_ELI_DOCUMENT_STATISTICS(
@@ -83,7 +87,8 @@ public:
 	void setCurrentTime( const OTF2_TimeStamp t, bool addCompute ) {
 		verbose( CALL_INFO, 4, 0, "Setting current timestamp to %" PRIu64 "\n", t );
 
-		if (addCompute && m_addCompute) {
+		// Compiled programs always record compute, replay decides whether to add it
+		if (addCompute && (m_addCompute || NULL != m_programWriter)) {
 			compute(*eventQ, (t-currentTime)*1e9/m_timerResolution);
 		}
 		currentTime = t;
@@ -153,6 +158,16 @@ public:
     }
 
 private:
+    void openTrace(const std::string& tracePrefix);
+    void closeTrace();
+    void compileProgram(const std::string& path, const EmberOTF2TraceStamp& stamp);
+    void executeInstruction(Queue& q, const EmberOTF2Instruction& ins);
+    MessageRequest* requestSlot(const EmberOTF2Instruction& ins);
+
+    uint64_t scaleCompute(uint64_t time) {
+        return (1.0 == m_computeScale) ? time : static_cast<uint64_t>(time * m_computeScale);
+    }
+
     OTF2_DefReader* traceLocalDefReader;
     OTF2_GlobalDefReader* traceGlobalDefReader;
     OTF2_GlobalDefReaderCallbacks* traceGlobalDefCallbacks;
@@ -180,6 +195,14 @@ private:
     bool m_inMPI;
     bool m_addCompute;
     bool m_readGlobalStrings;
+    double m_computeScale;
+
+    // Set while the trace is compiled into an event program
+    EmberOTF2ProgramWriter* m_programWriter;
+
+    bool m_replayProgram;
+    EmberOTF2Program m_program;
+    std::vector<MessageRequest> m_requestSlots;
 };
 
 }
@@ -0,0 +1,209 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "emberotf2program.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Ember;
+
+static const char     EMBER_OTF2_PROGRAM_MAGIC[8] = { 'E', 'M', 'B', 'O', 'T', 'F', '2', 'P' };
+static const uint32_t EMBER_OTF2_PROGRAM_VERSION  = 1;
+
+bool EmberOTF2TraceStamp::read(const std::string& tracePath, EmberOTF2TraceStamp& stamp) {
+	struct stat traceStat;
+
+	if(0 != stat(tracePath.c_str(), &traceStat)) {
+		return false;
+	}
+
+	stamp.size = (uint64_t) traceStat.st_size;
+	stamp.modified = (int64_t) traceStat.st_mtime;
+	return true;
+}
+
+void EmberOTF2ProgramWriter::emit(const EmberOTF2Opcode opcode, const uint32_t dtype, const uint32_t peer,
+	const uint32_t tag, const uint32_t slot, const uint64_t value, const uint32_t dtypeRecv) {
+
+	EmberOTF2Instruction ins;
+	ins.opcode = opcode;
+	ins.dtype = (uint8_t) dtype;
+	ins.dtypeRecv = (uint8_t) dtypeRecv;
+	ins.reserved = 0;
+	ins.peer = peer;
+	ins.tag = tag;
+	ins.slot = slot;
+	ins.value = value;
+
+	instructions.push_back(ins);
+}
+
+uint32_t EmberOTF2ProgramWriter::acquireSlot(const void* request) {
+	auto found = activeSlots.find(request);
+
+	if(found != activeSlots.end()) {
+		return found->second;
+	}
+
+	uint32_t slot;
+
+	if(freeSlots.empty()) {
+		slot = slotCount++;
+	} else {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+
+	activeSlots.insert(std::make_pair(request, slot));
+	return slot;
+}
+
+uint32_t EmberOTF2ProgramWriter::releaseSlot(const void* request) {
+	const uint32_t slot = acquireSlot(request);
+
+	// Replay waits on a slot before anything later can reuse it
+	activeSlots.erase(request);
+	freeSlots.push_back(slot);
+
+	return slot;
+}
+
+bool EmberOTF2ProgramWriter::write(const std::string& path, const uint32_t rank, const EmberOTF2TraceStamp& stamp) const {
+	EmberOTF2ProgramHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, EMBER_OTF2_PROGRAM_MAGIC, sizeof(header.magic));
+	header.version = EMBER_OTF2_PROGRAM_VERSION;
+	header.rank = rank;
+	header.traceSize = stamp.size;
+	header.traceModified = stamp.modified;
+	header.instructionCount = instructions.size();
+	header.requestSlots = slotCount;
+
+	// Written aside and renamed so a reader never maps a partial program
+	const std::string tempPath = path + ".tmp." + std::to_string((long long) getpid());
+	FILE* programFile = fopen(tempPath.c_str(), "wb");
+
+	if(NULL == programFile) {
+		return false;
+	}
+
+	bool written = (1 == fwrite(&header, sizeof(header), 1, programFile));
+
+	if(written && !instructions.empty()) {
+		written = (instructions.size() == fwrite(instructions.data(), sizeof(EmberOTF2Instruction),
+			instructions.size(), programFile));
+	}
+
+	written = (0 == fclose(programFile)) && written;
+
+	if(!written || 0 != rename(tempPath.c_str(), path.c_str())) {
+		unlink(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+EmberOTF2Program::EmberOTF2Program() :
+	programFD(-1), mapBase(NULL), mapLength(0), instructions(NULL),
+	instructionCount(0), nextInstruction(0), requestSlots(0) {}
+
+EmberOTF2Program::~EmberOTF2Program() {
+	unmap();
+}
+
+void EmberOTF2Program::unmap() {
+	if(NULL != mapBase) {
+		munmap(mapBase, mapLength);
+		mapBase = NULL;
+		mapLength = 0;
+	}
+
+	if(programFD >= 0) {
+		close(programFD);
+		programFD = -1;
+	}
+}
+
+bool EmberOTF2Program::map(const std::string& path, const uint32_t rank, const EmberOTF2TraceStamp& stamp) {
+	unmap();
+
+	programFD = open(path.c_str(), O_RDONLY);
+
+	if(programFD < 0) {
+		return false;
+	}
+
+	struct stat programStat;
+	if(0 != fstat(programFD, &programStat) || (size_t) programStat.st_size < sizeof(EmberOTF2ProgramHeader)) {
+		unmap();
+		return false;
+	}
+
+	mapLength = (size_t) programStat.st_size;
+	void* mapping = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, programFD, 0);
+
+	if(MAP_FAILED == mapping) {
+		mapLength = 0;
+		unmap();
+		return false;
+	}
+
+	mapBase = mapping;
+
+	const EmberOTF2ProgramHeader* header = (const EmberOTF2ProgramHeader*) mapBase;
+
+	if(0 != memcmp(header->magic, EMBER_OTF2_PROGRAM_MAGIC, sizeof(header->magic)) ||
+		EMBER_OTF2_PROGRAM_VERSION != header->version ||
+		rank != header->rank ||
+		stamp.size != header->traceSize ||
+		stamp.modified != header->traceModified ||
+		mapLength != sizeof(EmberOTF2ProgramHeader) + header->instructionCount * sizeof(EmberOTF2Instruction)) {
+
+		unmap();
+		return false;
+	}
+
+	madvise(mapBase, mapLength, MADV_SEQUENTIAL);
+
+	owned.clear();
+	instructions = (const EmberOTF2Instruction*) ((const char*) mapBase + sizeof(EmberOTF2ProgramHeader));
+	instructionCount = header->instructionCount;
+	nextInstruction = 0;
+	requestSlots = header->requestSlots;
+
+	return true;
+}
+
+void EmberOTF2Program::adopt(EmberOTF2ProgramWriter& writer) {
+	unmap();
+
+	owned.swap(writer.instructions);
+	writer.instructions.clear();
+
+	instructions = owned.data();
+	instructionCount = owned.size();
+	nextInstruction = 0;
+	requestSlots = writer.slotCount;
+}
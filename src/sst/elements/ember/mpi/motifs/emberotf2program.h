@@ -0,0 +1,149 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_OTF2_PROGRAM
+#define _H_EMBER_OTF2_PROGRAM
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Ember {
+
+// An event program is one rank's OTF2 event stream compiled down to the
+// Ember calls the trace callbacks make, one fixed size instruction per
+// call.  Request IDs from the trace are renumbered into a small set of
+// request slots, so replay needs neither the OTF2 reader nor a request
+// map.  Compute instructions hold unscaled nanoseconds, scaling is left
+// to the replay.
+
+enum EmberOTF2Opcode : uint8_t {
+    EMBER_OTF2_OP_COMPUTE = 0,
+    EMBER_OTF2_OP_SEND,
+    EMBER_OTF2_OP_RECV,
+    EMBER_OTF2_OP_ISEND,
+    EMBER_OTF2_OP_IRECV,
+    EMBER_OTF2_OP_WAIT,
+    EMBER_OTF2_OP_BARRIER,
+    EMBER_OTF2_OP_BCAST,
+    EMBER_OTF2_OP_ALLREDUCE,
+    EMBER_OTF2_OP_REDUCE,
+    EMBER_OTF2_OP_SCATTER,
+    EMBER_OTF2_OP_ALLGATHER,
+    EMBER_OTF2_OP_ALLTOALL,
+    EMBER_OTF2_OP_COUNT
+};
+
+struct EmberOTF2Instruction {
+    uint8_t  opcode;
+    uint8_t  dtype;
+    uint8_t  dtypeRecv; // receive type of SCATTER, ALLGATHER and ALLTOALL
+    uint8_t  reserved;
+    uint32_t peer;      // destination, source or root
+    uint32_t tag;       // tag, or receive count of SCATTER, ALLGATHER and ALLTOALL
+    uint32_t slot;      // request slot of ISEND, IRECV and WAIT
+    uint64_t value;     // element count, or nanoseconds for COMPUTE
+};
+
+static_assert(sizeof(EmberOTF2Instruction) == 24, "EmberOTF2Instruction must stay 24 bytes, it is stored in program files");
+
+// Identifies the trace a program was compiled from, a program whose
+// stamp does not match the trace is recompiled
+struct EmberOTF2TraceStamp {
+    uint64_t size;
+    int64_t  modified;
+
+    static bool read(const std::string& tracePath, EmberOTF2TraceStamp& stamp);
+};
+
+struct EmberOTF2ProgramHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t rank;
+    uint64_t traceSize;
+    int64_t  traceModified;
+    uint64_t instructionCount;
+    uint32_t requestSlots;
+    uint32_t reserved;
+};
+
+class EmberOTF2ProgramWriter {
+
+public:
+    EmberOTF2ProgramWriter() : slotCount(0) {}
+
+    void emit(const EmberOTF2Opcode opcode, const uint32_t dtype, const uint32_t peer,
+        const uint32_t tag, const uint32_t slot, const uint64_t value, const uint32_t dtypeRecv = 0);
+
+    // Request slots are keyed by the request the trace callbacks allocated
+    uint32_t acquireSlot(const void* request);
+    uint32_t releaseSlot(const void* request);
+
+    bool write(const std::string& path, const uint32_t rank, const EmberOTF2TraceStamp& stamp) const;
+
+    uint64_t size() const { return instructions.size(); }
+
+private:
+    friend class EmberOTF2Program;
+
+    std::vector<EmberOTF2Instruction> instructions;
+    std::unordered_map<const void*, uint32_t> activeSlots;
+    std::vector<uint32_t> freeSlots;
+    uint32_t slotCount;
+};
+
+// Replays a program, either memory mapped from its file or taken over
+// from the writer that compiled it
+class EmberOTF2Program {
+
+public:
+    EmberOTF2Program();
+    ~EmberOTF2Program();
+
+    // Returns false if the file is missing, corrupt, or compiled for a
+    // different rank or trace
+    bool map(const std::string& path, const uint32_t rank, const EmberOTF2TraceStamp& stamp);
+    void adopt(EmberOTF2ProgramWriter& writer);
+
+    const EmberOTF2Instruction* next() {
+        return (nextInstruction < instructionCount) ? &instructions[nextInstruction++] : NULL;
+    }
+
+    bool atEnd() const { return nextInstruction >= instructionCount; }
+    uint64_t size() const { return instructionCount; }
+    uint32_t getRequestSlots() const { return requestSlots; }
+
+private:
+    void unmap();
+
+    int programFD;
+    void* mapBase;
+    size_t mapLength;
+    std::vector<EmberOTF2Instruction> owned;
+
+    const EmberOTF2Instruction* instructions;
+    uint64_t instructionCount;
+    uint64_t nextInstruction;
+    uint32_t requestSlots;
+};
+
+}
+}
+
+#endif
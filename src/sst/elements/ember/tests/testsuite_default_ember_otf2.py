@@ -26,6 +26,13 @@ class testcase_EmberOTF2(SSTTestCase):
         otherargs = '--exit-after=20s --model-options \'--topo=fattree --shape=4,4:1 --cmdLine=\"Init\" --cmdLine=\"OTF2 tracePrefix={0}\" --cmdLine=\"Fini\" \' '
         self.Ember_test_template("test_emberotf2", otherargs = otherargs, testoutput = True)
 
+    @unittest.skipIf(not otf2_support, "Ember: Requires OTF2, but sst-elements was not compiled with OTF2 support.")
+    def test_Ember_OTF2_eventProgram(self):
+        # The first run compiles the event programs, the second replays them
+        otherargs = '--exit-after=20s --model-options \'--topo=fattree --shape=4,4:1 --cmdLine=\"Init\" --cmdLine=\"OTF2 tracePrefix={0} eventProgram=otf2program\" --cmdLine=\"Fini\" \' '
+        self.Ember_test_template("test_emberotf2", otherargs = otherargs, testoutput = True)
+        self.Ember_test_template("test_emberotf2", otherargs = otherargs, testoutput = True)
+
 #####
 
     def Ember_test_template(self, testcase, otherargs, testoutput):
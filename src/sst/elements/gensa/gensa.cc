@@ -36,6 +36,7 @@ gensa::gensa (ComponentId_t id, Params & params)
     neuronIndex    = -1;
     synapseIndex   = -1;
     syncSent       = false;
+    stepStarted    = false;
     numFirings     = 0;
     numDeliveries  = 0;
 
@@ -45,7 +46,7 @@ gensa::gensa (ComponentId_t id, Params & params)
     // get parameters
     modelPath       = params.find<string>("modelPath",       "model");
     steps           = params.find<int>   ("steps",           1000);
-    Neuron::dt      = params.find<float> ("dt",              1);  // In seconds. Don't bother with UnitAlgebra because this is usually specified by wrapper script.
+    Neurons::dt     = params.find<float> ("dt",              1);  // In seconds. Don't bother with UnitAlgebra because this is usually specified by wrapper script.
     maxRequestDepth = params.find<int>   ("maxRequestDepth", 2);
 
     //set our clock
@@ -86,7 +87,6 @@ gensa::gensa ()
 
 gensa::~gensa ()
 {
-    for (auto n : neurons) delete n;
     while (! networkRequests.empty ())
     {
         delete networkRequests.front ();
@@ -117,6 +117,7 @@ gensa::init (unsigned int phase)
     ifstream ifs (modelPath.c_str());
     if (! ifs.good()) cerr << "Failed to open file: " << modelPath << endl;
     int countLinks = 0;
+    int maxDelay   = 0;
     string line;
     while (ifs.good()) {
         getline(ifs, line);
@@ -124,9 +125,9 @@ gensa::init (unsigned int phase)
 
         char * piece = strtok(const_cast<char *>(line.c_str()), ",");
         int id = atoi(piece);
-        while (neurons.size () <= id) neurons.push_back(nullptr);
+        neurons.resize (id + 1);
 
-        Neuron * n;
+        Neurons::Input * input = nullptr;
         piece = strtok(0, ",");
         if (piece) {
             float Vinit = atof(piece);
@@ -138,9 +139,9 @@ gensa::init (unsigned int phase)
             float leak = 1 - atof(piece);  // The parameter in the file is the portion of voltage to get rid of each cycle. It's simpler for us to compute with (1-decay).
             piece = strtok(0, ",");  // Actually, there should only be one piece left, with no more commas.
             float p = atof(piece);
-            n = neurons[id] = new NeuronLIF(Vinit, Vthreshold, Vreset, leak, p);
+            neurons.setLIF (id, Vinit, Vthreshold, Vreset, leak, p);
         } else {
-            n = neurons[id] = new NeuronInput();
+            input = &neurons.setInput (id);
         }
 
         // Scan indented lines
@@ -156,12 +157,12 @@ gensa::init (unsigned int phase)
             if (c == 'r') {  // spike raster
                 int count = line.size();
                 for (int i = 2; i < count; i++) {
-                    if (line[i] == '1') ((NeuronInput *) n)->spikes.push_back(i - 2);
+                    if (line[i] == '1') input->spikes.push_back(i - 2);
                 }
             } else if (c == 't') {  // spike time list
                 char * piece = strtok(const_cast<char *>(line.c_str() + 2), ",");
                 while (piece) {
-                    ((NeuronInput *) n)->spikes.push_back(atoi(piece));
+                    input->spikes.push_back(atoi(piece));
                     piece = strtok(0, ",");
                 }
             } else if (c == 'o') {  // output
@@ -195,16 +196,15 @@ gensa::init (unsigned int phase)
                     col = buffer;
                 }
 
-                map<string,OutputHolder *>::iterator it = Neuron::outputs.find(f);
-                if (it == Neuron::outputs.end()) {
+                map<string,OutputHolder *>::iterator it = Neurons::outputs.find(f);
+                if (it == Neurons::outputs.end()) {
                     OutputHolder * h = new OutputHolder(f);
-                    it = Neuron::outputs.insert(make_pair(f, h)).first;
+                    it = Neurons::outputs.insert(make_pair(f, h)).first;
                 }
                 OutputHolder * h = it->second;
 
                 Trace * t = new Trace;
-                t->next = n->traces;
-                n->traces = t;
+                neurons.addTrace (id, t);
                 t->holder = h;
                 t->column = col;
                 if (! m.empty()) t->mode = strdup(m.c_str());
@@ -212,7 +212,7 @@ gensa::init (unsigned int phase)
                 else          t->probe = 0;
             } else {  // synapse
                 // In this pass, just determine memory requirements for each neuron.
-                n->synapseCount++;
+                neurons.synapseCount[id]++;
                 countLinks++;
             }
         }
@@ -230,7 +230,8 @@ gensa::init (unsigned int phase)
 
         char * piece = strtok (const_cast<char *>(line.c_str()), ",");
         int id = atoi(piece);
-        Neuron * n = neurons[id];
+        uint64_t & synapseBase  = neurons.synapseBase[id];
+        uint32_t & synapseCount = neurons.synapseCount[id];
 
         // Scan indented lines
         while (ifs.good()) {
@@ -250,15 +251,16 @@ gensa::init (unsigned int phase)
             float weight = atof(piece);
             piece = strtok(0, ",");
             int delay = atoi(piece);
+            if (delay > maxDelay) maxDelay = delay;
 
-            if (n->synapseBase == 0)
+            if (synapseBase == 0)
             {
-                n->synapseBase = startAddr;  // This implies that startAddr must begin higher than 0
-                startAddr += sizeof(Synapse) * n->synapseCount;
-                n->synapseCount = 0;
+                synapseBase = startAddr;  // This implies that startAddr must begin higher than 0
+                startAddr += sizeof(Synapse) * synapseCount;
+                synapseCount = 0;
             }
             vector<uint8_t> data(sizeof(Synapse), 0);
-            uint64_t reqAddr = n->synapseBase + sizeof(Synapse) * n->synapseCount++;
+            uint64_t reqAddr = synapseBase + sizeof(Synapse) * synapseCount++;
             using namespace Interfaces;
             StandardMem::Write * req = new StandardMem::Write(reqAddr, sizeof(Synapse), data);
             Synapse * synapse = (Synapse *) &req->data[0];
@@ -269,6 +271,7 @@ gensa::init (unsigned int phase)
         }
     }
 
+    neurons.finalize (maxDelay);
     int numNeurons = neurons.size ();
     printf("Constructed %d neurons with %d links\n", numNeurons, countLinks);
 }
@@ -292,7 +295,7 @@ gensa::finish ()
 {
 	memory->finish ();
 	link  ->finish ();
-    for (auto i : Neuron::outputs) delete i.second;  // flushes last row
+    for (auto i : Neurons::outputs) delete i.second;  // flushes last row
 
 	printf ("Completed %d neuron firings\n", numFirings);
     printf ("Completed %d spike deliveries\n", numDeliveries);
@@ -314,6 +317,13 @@ gensa::clockTic (Cycle_t t)
         if (link->send (req, 0)) networkRequests.pop ();
     }
 
+    // The whole LIF pass is charged to the first cycle of the step. The walk below only models collecting firing events.
+    if (! stepStarted)
+    {
+        neurons.update (now);
+        stepStarted = true;
+    }
+
     if (synapseIndex < 0)  // Ready for next neuron.
     {
         int count = neurons.size ();
@@ -338,11 +348,10 @@ gensa::clockTic (Cycle_t t)
         neuronIndex++;
         if (neuronIndex < count)
         {
-            Neuron * n = neurons[neuronIndex];
-            if (n->update (now))
+            if (neurons.fired[neuronIndex])
             {
                 numFirings++;
-                if (n->synapseCount) synapseIndex = 0;  // Start iterating through synapses.
+                if (neurons.synapseCount[neuronIndex]) synapseIndex = 0;  // Start iterating through synapses.
             }
         }
     }
@@ -352,14 +361,13 @@ gensa::clockTic (Cycle_t t)
         if (networkRequests.size () >= maxRequestDepth) return false;
         if (memoryRequests.size () >= maxRequestDepth) return false;
 
-        Neuron * n = neurons[neuronIndex];
-        uint64_t address = n->synapseBase + synapseIndex * sizeof (Synapse);
+        uint64_t address = neurons.synapseBase[neuronIndex] + synapseIndex * sizeof (Synapse);
         StandardMem::Read * req = new StandardMem::Read (address, sizeof (Synapse));
         memory->send (req);  // Unlike network, it seems that memory has unlimited capacity for requests.
         memoryRequests.insert (address);  // But we still limit the number of outstanding requests.
 
         synapseIndex++;
-        if (synapseIndex >= n->synapseCount) synapseIndex = -1;
+        if (synapseIndex >= neurons.synapseCount[neuronIndex]) synapseIndex = -1;
     }
 
     return false;  // keep going
@@ -397,13 +405,17 @@ gensa::handleNetwork (int vn)
         if (SpikeEvent * spike = dynamic_cast<SpikeEvent *> (event))
         {
             if (spike->neuron >= neurons.size ()) out.fatal (CALL_INFO, -1, "Invalid Neuron Address\n");
-            neurons[spike->neuron]->deliverSpike (spike->weight, spike->delay+now);
+            // The LIF pass for the current step has already consumed its row of the wheel, so the earliest arrival is next step.
+            uint32_t delay = spike->delay ? spike->delay : 1;
+            neurons.wheel.grow (now, delay);
+            neurons.deliverSpike (spike->neuron, spike->weight, delay+now);
             numDeliveries++;
         }
         else if (SyncEvent * sync = dynamic_cast<SyncEvent *> (event))
         {
             now++;
             neuronIndex = -1;
+            stepStarted = false;
             if (now >= steps) primaryComponentOKToEndSim ();
         }
         delete req;
@@ -72,9 +72,10 @@ public:
     int         neuronIndex;     ///< Current neuron being processed in current cycle
     int         synapseIndex;    ///< Current downstream synapse (associated with current neuron) being sent a spike
     bool        syncSent;
+    bool        stepStarted;     ///< LIF pass has run for the current step
     uint32_t    maxRequestDepth; ///< Shared by memory and network. Should be a pretty small number like 2 or 3.
 
-    std::vector<Neuron*> neurons;
+    Neurons neurons;
 
     TimeConverter *             clockTC;
     Interfaces::StandardMem *   memory;
@@ -17,6 +17,8 @@
 #include <sst_config.h>
 #include "neuron.h"
 
+#include <algorithm>
+
 using namespace SST::gensaComponent;
 using namespace std;
 
@@ -34,108 +36,185 @@ Trace::~Trace()
 }
 
 
-// class Neuron --------------------------------------------------------------
-
-std::map<std::string,OutputHolder *> Neuron::outputs;
-float                                Neuron::dt;
+// class TimingWheel ---------------------------------------------------------
 
-Neuron::Neuron()
+TimingWheel::TimingWheel ()
 {
-    synapseBase  = 0;
-    synapseCount = 0;
-    traces       = 0;
+    count = 0;
+    slots = 0;
+    mask  = 0;
 }
 
-Neuron::~Neuron()
+void TimingWheel::resize (uint32_t count, uint32_t maxDelay)
 {
-    Trace * t = traces;
-    while (t) {
-        Trace * next = t->next;
-        delete t;
-        t = next;
-    }
+    this->count = count;
+    slots = 1;
+    while (slots <= maxDelay) slots <<= 1;  // Spikes arrive up to maxDelay steps after the current one, so need maxDelay+1 rows.
+    mask = slots - 1;
+    buffer.assign ((size_t) slots * count, 0);
 }
 
-void Neuron::deliverSpike(float str, uint when)
+void TimingWheel::grow (uint32_t now, uint32_t maxDelay)
 {
-    // Do nothing
+    if (maxDelay < slots) return;
+
+    vector<float> old;
+    old.swap (buffer);
+    uint32_t oldSlots = slots;
+    uint32_t oldMask  = mask;
+    resize (count, maxDelay);
+    // Rows now through now+oldSlots-1 may hold pending input. Rehome each under the new mask.
+    for (uint32_t i = 0; i < oldSlots; i++)
+    {
+        uint32_t when = now + i;
+        float * from = &old[(size_t) (when & oldMask) * count];
+        float * to   = row (when);
+        for (uint32_t j = 0; j < count; j++) to[j] = from[j];
+    }
 }
 
 
-// NeuronLIF -----------------------------------------------------------------
+// class Neurons -------------------------------------------------------------
 
-SST::RNG::MarsagliaRNG NeuronLIF::rng(1,13);
+map<string,OutputHolder *> Neurons::outputs;
+float                      Neurons::dt;
+SST::RNG::MarsagliaRNG     Neurons::rng(1,13);
 
-NeuronLIF::NeuronLIF(float Vinit, float Vthreshold, float Vreset, float leak, float p)
-:   V          (Vinit),
-    Vthreshold (Vthreshold),
-    Vreset     (Vreset),
-    leak       (leak),
-    p          (p)
+Neurons::~Neurons ()
 {
+    for (auto t : traces) {
+        while (t) {
+            Trace * next = t->next;
+            delete t;
+            t = next;
+        }
+    }
 }
 
-void NeuronLIF::deliverSpike(float str, uint when)
+void Neurons::resize (uint32_t count)
 {
-    temporalBuffer[when] += str;
+    if (count <= size ()) return;
+    kind        .resize (count, NONE);
+    V           .resize (count, 0);
+    Vthreshold  .resize (count, 1);
+    Vreset      .resize (count, 0);
+    leak        .resize (count, 1);
+    p           .resize (count, 1);
+    fired       .resize (count, 0);
+    synapseBase .resize (count, 0);
+    synapseCount.resize (count, 0);
+    traces      .resize (count, nullptr);
 }
 
-bool NeuronLIF::update(const uint now)
+void Neurons::setLIF (uint32_t index, float Vinit, float Vthreshold, float Vreset, float leak, float p)
 {
-    // Add inputs
-    temporalBuffer_t::iterator i = temporalBuffer.find(now);
-    if (i != temporalBuffer.end()) {
-        V += i->second;
-        temporalBuffer.erase(i);
-    }
-
-    // Check for spike
-    bool spiked = false;
-    if (V > Vthreshold) {
-        if (p >= 1  ||  p > 0  &&  rng.nextUniform() <= p) {
-            V = Vreset;
-            spiked = true;
-        }
-    } else {
-        V *= leak;
-    }
+    resize (index + 1);
+    kind            [index] = LIF;
+    V               [index] = Vinit;
+    this->Vthreshold[index] = Vthreshold;
+    this->Vreset    [index] = Vreset;
+    this->leak      [index] = leak;
+    this->p         [index] = p;
+}
 
-    // Outputs
-    Trace * t = traces;
-    while (t) {
-        if (t->probe == 0) {
-            if (spiked) t->holder->trace (now*dt, t->column, 1, t->mode);
-        } else if (t->probe == 1) {
-            t->holder->trace(now*dt, t->column, V, t->mode);
-        }
-        t = t->next;
-    }
+Neurons::Input & Neurons::setInput (uint32_t index)
+{
+    resize (index + 1);
+    kind[index] = INPUT;
+    inputs.push_back (Input ());
+    Input & result = inputs.back ();
+    result.index     = index;
+    result.nextSpike = 0;
+    return result;
+}
 
-    return spiked;
+void Neurons::addTrace (uint32_t index, Trace * t)
+{
+    t->next = traces[index];
+    traces[index] = t;
 }
 
+void Neurons::finalize (uint32_t maxDelay)
+{
+    // Inputs and traces are discovered in file order, which need not be index order.
+    sort (inputs.begin (), inputs.end (), [](const Input & a, const Input & b) {return a.index < b.index;});
+    traced.clear ();
+    uint32_t count = size ();
+    for (uint32_t i = 0; i < count; i++) if (traces[i]) traced.push_back (i);
 
-// class NeuronInput ---------------------------------------------------------
+    wheel.resize (count, maxDelay);
+}
 
-NeuronInput::NeuronInput()
+void Neurons::deliverSpike (uint32_t index, float str, uint32_t when)
 {
-    nextSpike = 0;
+    if (kind[index] != LIF) return;
+    wheel.deliver (index, str, when);
 }
 
-bool NeuronInput::update(const uint now)
+uint32_t Neurons::update (const uint32_t now)
 {
-    if (nextSpike >= spikes.size()) return false;
-    if (spikes[nextSpike] > now)    return false;
-    nextSpike++;
+    uint32_t count = size ();
+    float *   input = wheel.row (now);
+    float *   v     = V.data ();
+    float *   th    = Vthreshold.data ();
+    float *   lk    = leak.data ();
+    uint8_t * f     = fired.data ();
+
+    // Add inputs and leak. Straight-line code over contiguous arrays, so the compiler can vectorize it.
+    // Neurons over threshold retain V until the firing decision below.
+    // Non-LIF neurons accumulate nothing, since deliverSpike() drops their input.
+    for (uint32_t i = 0; i < count; i++)
+    {
+        float x = v[i] + input[i];
+        input[i] = 0;  // Free this row for step now+slots.
+        bool over = x > th[i];
+        f[i] = over;
+        v[i] = over ? x : x * lk[i];
+    }
+
+    // Check for spike. Draws from rng in neuron order, same as a serial walk would.
+    uint32_t result = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (! f[i]) continue;
+        if (kind[i] != LIF) {
+            f[i] = 0;
+            continue;
+        }
+        float pi = p[i];
+        if (pi >= 1  ||  pi > 0  &&  rng.nextUniform() <= pi) {
+            v[i] = Vreset[i];
+            result++;
+        } else {
+            f[i] = 0;
+        }
+    }
+
+    for (auto & in : inputs)
+    {
+        if (in.nextSpike >= in.spikes.size ()) continue;
+        if (in.spikes[in.nextSpike] > now)     continue;
+        in.nextSpike++;
+        f[in.index] = 1;
+        result++;
+    }
 
     // Outputs
-    Trace * t = traces;
-    while (t) {
-        if (t->probe == 0) t->holder->trace(now*dt, t->column, 1, t->mode);
-        t = t->next;
+    for (auto i : traced)
+    {
+        bool spiked = f[i];
+        Trace * t = traces[i];
+        while (t) {
+            if (t->probe == 0) {
+                if (spiked) t->holder->trace (now*dt, t->column, 1, t->mode);
+            } else if (t->probe == 1  &&  kind[i] == LIF) {
+                t->holder->trace (now*dt, t->column, V[i], t->mode);
+            }
+            t = t->next;
+        }
     }
 
-    return true;
+    return result;
 }
 
 
@@ -17,6 +17,7 @@
 #define _NEURON_H
 
 #include <map>
+#include <vector>
 #include <cstdint>
 
 #include <sst/core/interfaces/stdMem.h>  // supplies type uint
@@ -45,50 +46,69 @@ struct Trace {
     ~Trace();
 };
 
-class Neuron {
+/// Circular buffer of pending synaptic input, indexed by arrival step.
+/// Row (when & mask) holds one accumulator per neuron, so the LIF pass for a
+/// step reads a single contiguous row and clears it for reuse.
+class TimingWheel {
 public:
-    uint64_t synapseBase;  // address in memory of synapse list
-    uint32_t synapseCount; // number of entries in synapse list
+    std::vector<float> buffer;  ///< slots * count entries, row-major by slot
+    uint32_t           count;   ///< number of neurons (row length)
+    uint32_t           slots;   ///< always a power of 2
+    uint32_t           mask;    ///< slots - 1
 
-    static float dt;
-    static std::map<std::string,OutputHolder *> outputs;
-    Trace * traces;
-
-    Neuron();
-    virtual ~Neuron();
+    TimingWheel ();
 
-    virtual void deliverSpike(float str, uint32_t when);
-    virtual bool update      (const uint32_t now) = 0;  ///< performs Leaky Integrate and Fire. Returns true if fired.
+    void   resize  (uint32_t count, uint32_t maxDelay);
+    void   grow    (uint32_t now, uint32_t maxDelay);  ///< Enlarge to cover maxDelay while preserving pending input.
+    float* row     (uint32_t when) {return &buffer[(size_t) (when & mask) * count];}
+    void   deliver (uint32_t index, float str, uint32_t when) {buffer[(size_t) (when & mask) * count + index] += str;}
 };
 
-class NeuronLIF : public Neuron {
+/// Structure-of-arrays state for all neurons on this core.
+/// LIF state is updated for the whole population in one pass per step, and
+/// the results are left in "fired" for the serial synapse walk in gensa::clockTic().
+class Neurons {
 public:
-    float V;          // "voltage"; generally in the normal range [0,1]
-    float Vthreshold; // value of V which triggers a spike
-    float Vreset;     // value of V immediately after a spike
-    float leak;       // fraction of V to retain after present cycle, in [0,1]
-    float p;          // probability of firing when over threshold, in [0,1]
+    enum Kind : uint8_t {NONE, LIF, INPUT};
+
+    // Per-neuron state. All vectors have the same length.
+    std::vector<uint8_t>  kind;
+    std::vector<float>    V;            ///< "voltage"; generally in the normal range [0,1]
+    std::vector<float>    Vthreshold;   ///< value of V which triggers a spike
+    std::vector<float>    Vreset;       ///< value of V immediately after a spike
+    std::vector<float>    leak;         ///< fraction of V to retain after present cycle, in [0,1]
+    std::vector<float>    p;            ///< probability of firing when over threshold, in [0,1]
+    std::vector<uint8_t>  fired;        ///< Result of most recent update()
+    std::vector<uint64_t> synapseBase;  ///< address in memory of synapse list
+    std::vector<uint32_t> synapseCount; ///< number of entries in synapse list
+    std::vector<Trace *>  traces;       ///< Null for most neurons.
+
+    /// Input neurons are rare, so they are kept in a separate list rather than widening every neuron.
+    struct Input {
+        uint32_t              index;
+        std::vector<uint16_t> spikes;  ///< Times when we should spike, in ascending order.
+        int                   nextSpike;
+    };
+    std::vector<Input>    inputs;
+    std::vector<uint32_t> traced;  ///< Indices of neurons with traces, in ascending order.
+
+    TimingWheel wheel;
 
+    static float dt;
+    static std::map<std::string,OutputHolder *> outputs;
     static SST::RNG::MarsagliaRNG rng;
 
-    // temporal buffer
-    typedef std::map<const uint, float> temporalBuffer_t;
-    temporalBuffer_t temporalBuffer;
-
-    NeuronLIF (float Vinit = 0, float Vthreshold = 1, float Vreset = 0, float leak = 1, float p = 1);
-
-    virtual void deliverSpike(float str, uint32_t when);
-    virtual bool update      (const uint32_t now);
-};
-
-class NeuronInput : public Neuron {
-public:
-    std::vector<uint16_t> spikes;  // If we are an input neuron, then this is a list of times when we should spike. List is in ascending order.
-    int nextSpike;
+    ~Neurons ();
 
-    NeuronInput();
+    uint32_t size () const {return kind.size ();}
+    void     resize (uint32_t count);  ///< Extends arrays to hold count neurons. New entries have kind NONE.
+    void     setLIF (uint32_t index, float Vinit, float Vthreshold, float Vreset, float leak, float p);
+    Input &  setInput (uint32_t index);
+    void     addTrace (uint32_t index, Trace * t);
+    void     finalize (uint32_t maxDelay);  ///< Call once after all neurons are loaded.
 
-    virtual bool update(const uint32_t now);
+    void     deliverSpike (uint32_t index, float str, uint32_t when);
+    uint32_t update (const uint32_t now);  ///< Performs Leaky Integrate and Fire for all neurons. Returns number fired.
 };
 
 class SpikeEvent : public SST::Event
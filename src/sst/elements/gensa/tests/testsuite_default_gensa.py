@@ -17,12 +17,42 @@ class testcase_gensa_Component(SSTTestCase):
 #####
 
     def test_gensa_1(self):
-        self.gensa_test_template("1")
+        expected = {
+             "0" : [1,1,0,0],
+             "1" : [1,1,1,0],
+             "2" : [0,1,0,0],
+             "3" : [0,0,1,0],
+             "4" : [1,0,0,0],
+             "5" : [0,1,0,0],
+             "6" : [0,0,0,1],
+             "7" : [0,0,1,0],
+             "8" : [0,0,0,1],
+             "9" : [0,1,0,0],
+            "10" : [1,0,0,0],
+            "11" : [0,0,1,0],
+            "12" : [0,1,0,0],
+            "13" : [1,1,1,0],
+            "14" : [1,1,0,0],
+        }
+        self.gensa_test_template("1", "model", 20, "out", expected)
+
+    # Delays of 0 to 7 steps wrap around the timing wheel, and neuron 3 only
+    # holds its threshold if the row consumed at step 6 is cleared for step 14.
+    def test_gensa_timing_wheel(self):
+        spikes = {
+            "0" : [0, 3, 10],
+            "1" : [5, 8, 15],
+            "2" : [4],
+            "3" : [12, 22],
+        }
+        expected = {}
+        for column, times in spikes.items():
+            expected[column] = [int(r in times) for r in range(24)]
+        self.gensa_test_template("timing_wheel", "model_wheel", 24, "wheel", expected)
 
 #####
 
-    def gensa_test_template(self, testcase):
-        # Note: testcase param is ignored for now
+    def gensa_test_template(self, testcase, model, steps, outputFile, expected):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -31,13 +61,13 @@ class testcase_gensa_Component(SSTTestCase):
         # Set the various file paths
         testDataFileName="test_gensa_{0}".format(testcase)
 
-        sdlfile = "{0}/{1}.py".format(test_path, testDataFileName)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        sdlfile = "{0}/test_gensa_1.py".format(test_path)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options "--neurons={0}/{1} --steps={2}"'.format(test_path, model, steps)
 
-        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
 
         testing_remove_component_warning_from_file(outfile)
 
@@ -52,28 +82,14 @@ class testcase_gensa_Component(SSTTestCase):
         import OutputParser
         from OutputParser import OutputParser
         o = OutputParser()
-        o.parse(outdir + "/out")
-        if not self.checkColumn(o,  "0", [1,1,0,0]): cmp_result = False
-        if not self.checkColumn(o,  "1", [1,1,1,0]): cmp_result = False
-        if not self.checkColumn(o,  "2", [0,1,0,0]): cmp_result = False
-        if not self.checkColumn(o,  "3", [0,0,1,0]): cmp_result = False
-        if not self.checkColumn(o,  "4", [1,0,0,0]): cmp_result = False
-        if not self.checkColumn(o,  "5", [0,1,0,0]): cmp_result = False
-        if not self.checkColumn(o,  "6", [0,0,0,1]): cmp_result = False
-        if not self.checkColumn(o,  "7", [0,0,1,0]): cmp_result = False
-        if not self.checkColumn(o,  "8", [0,0,0,1]): cmp_result = False
-        if not self.checkColumn(o,  "9", [0,1,0,0]): cmp_result = False
-        if not self.checkColumn(o, "10", [1,0,0,0]): cmp_result = False
-        if not self.checkColumn(o, "11", [0,0,1,0]): cmp_result = False
-        if not self.checkColumn(o, "12", [0,1,0,0]): cmp_result = False
-        if not self.checkColumn(o, "13", [1,1,1,0]): cmp_result = False
-        if not self.checkColumn(o, "14", [1,1,0,0]): cmp_result = False
-        self.assertTrue(cmp_result, "Output file {0}/out does not contain expected spike pattern".format(outdir))
+        o.parse(outdir + "/" + outputFile)
+        for column, pattern in expected.items():
+            if not self.checkColumn(o, column, pattern): cmp_result = False
+        self.assertTrue(cmp_result, "Output file {0}/{1} does not contain expected spike pattern".format(outdir, outputFile))
         o.close()
 
     def checkColumn(self, o, index, pattern):
         c = o.getColumn(index)
-        for r in range(4):
+        for r in range(len(pattern)):
             if c.get(r) != pattern[r]: return False
         return True
-
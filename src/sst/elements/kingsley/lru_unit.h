@@ -17,6 +17,8 @@
 #ifndef COMPONENTS_KINGSLEY_LRU_UNIT_H
 #define COMPONENTS_KINGSLEY_LRU_UNIT_H
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 using namespace SST;
@@ -33,6 +35,7 @@ class lru_unit {
     T* unsat_list;
     bool finalized;
     int current;
+    uint64_t entry_mask;
 
 
     void init_lists() {
@@ -46,7 +49,7 @@ class lru_unit {
     }
 
 public:
-    lru_unit() : finalized(false), current(0)
+    lru_unit() : finalized(false), current(0), entry_mask(0)
     {
     }
 
@@ -56,6 +59,9 @@ public:
         priority[1].resize(priority[0].size());
         current = 1;
         init_lists();
+        for ( size_t i = 0; i < priority[0].size(); ++i ) {
+            entry_mask |= uint64_t(1) << priority[0][i];
+        }
     }
 
     void insert(T data) {
@@ -92,6 +98,47 @@ public:
         return priority[0].size();
     }
 
+    // Runs a full pass over the entries in priority order, equivalent
+    // to calling top() and satisfied() size() times.  The entries must
+    // be integers below 64 and active has a bit set for every entry
+    // that has something to arbitrate.  Inactive entries are
+    // unsatisfied without calling func, for the others func(entry)
+    // returns whether the entry was satisfied.  A pass in which every
+    // entry is unsatisfied leaves the order as it was, so a pass with
+    // no active entries returns straight away and the entries after
+    // the last active one are copied in one go.
+    template<typename F>
+    void arbitrate(uint64_t active, F func) {
+        if ( !finalized ) throw std::string("lru_unit: Attempt to call arbitrate() before finalizing unit.\n");
+        active &= entry_mask;
+        if ( active == 0 ) return;
+
+        while ( true ) {
+            T entry = *current_list;
+            bool sat = false;
+            if ( active & (uint64_t(1) << entry) ) {
+                active &= ~(uint64_t(1) << entry);
+                sat = func(entry);
+            }
+            if ( sat ) {
+                *sat_list = entry;
+                sat_list--;
+            }
+            else {
+                *unsat_list = entry;
+                unsat_list++;
+            }
+            current_list++;
+            if ( sat_list < unsat_list ) break;
+            if ( active == 0 ) {
+                // The rest are all unsatisfied and keep their order
+                std::copy(current_list, current_list + (sat_list - unsat_list + 1), unsat_list);
+                break;
+            }
+        }
+        init_lists();
+    }
+
     // void print() {
     //     for ( unsigned int i = 0; i < priority[current].size(); ++i ) {
     //         std::cout << priority[current][i] << std::endl;
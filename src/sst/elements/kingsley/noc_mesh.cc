@@ -51,6 +51,9 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
 {
     // Get the options for the router
     local_ports = params.find<int>("local_ports",1);
+    if ( local_port_start + local_ports > 64 ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh supports at most %d local ports\n", 64 - local_port_start);
+    }
 
     use_dense_map = params.find<bool>("use_dense_map",false);
 
@@ -157,10 +160,11 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
 
     // Allocate space for all the input buffers
     port_queues = new port_queue_t[local_port_start + local_ports];
-    port_busy = new int[local_port_start + local_ports];
+    port_busy = new Cycle_t[local_port_start + local_ports];
     for ( int i = 0; i < local_port_start + local_ports; ++i ) {
         port_busy[i] = 0;
     }
+    occupied_ports = 0;
 
     port_credits = new int[local_port_start + local_ports];
     for ( int i = 0; i < local_port_start + local_ports; ++i ) {
@@ -238,6 +242,7 @@ noc_mesh::handle_input_r2r(Event* ev, int port)
 
         // Put the event into the proper queue
         port_queues[port].push(event);
+        occupied_ports |= uint64_t(1) << port;
         if (clock_is_off)
             clock_wakeup();
         break;
@@ -331,6 +336,7 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
 
         // Need to put the event into the proper queue
         port_queues[port].push(event);
+        occupied_ports |= uint64_t(1) << port;
         if (clock_is_off)
             clock_wakeup();
         break;
@@ -352,21 +358,10 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
 // }
 
 void noc_mesh::clock_wakeup() {
-    Cycle_t time = reregisterClock(clock_tc, my_clock_handler);
-    Cycle_t cyclesOff = time - last_time - 1;
-    // Update busy values
-    for ( int i = 0; i < local_port_start + local_ports; ++i) {
-        port_busy[i] = (port_busy[i] < cyclesOff) ? 0 : port_busy[i] - cyclesOff;
-    }
-
-    // unsigned int local_progress = (cyclesOff * local_lru.size()) % (local_lru.size() * 2);
-    // unsigned int mesh_progress = (cyclesOff * mesh_lru.size()) % (mesh_lru.size() * 2);
-    // // Update lru info
-    // for (unsigned int i = 0; i < local_progress; i++)
-    //     local_lru.satisfied(false);
-
-    // for (unsigned int i = 0; i < mesh_progress; i++)
-    //     mesh_lru.satisfied(false);
+    // The port busy times are absolute cycles and a pass with no
+    // queued events leaves the lru_units as they were, so nothing has
+    // to catch up on the cycles the clock was off
+    reregisterClock(clock_tc, my_clock_handler);
     clock_is_off = false;
 }
 
@@ -375,94 +370,77 @@ noc_mesh::clock_handler(Cycle_t cycle)
 {
     last_time = cycle;
     // TraceFunction trace(CALL_INFO);
-    // Decrement all the busy values
-    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
-        port_busy[i]--;
-        if (port_busy[i] < 0) port_busy[i] = 0;
-    }
-
-    bool keepClockOn = false;
-    // Progress all the messages
 
+    // Progress all the messages.  Only the ports with queued events are
+    // looked at, the lru_units pass over the others.
 
     // Prioirty goes in order of the lru_units list.  First entry has
     // highest priority, second has second highest, etc
     for ( auto& lru : lru_units ) {
-        for ( unsigned int i = 0; i < lru.size(); i++ ) {
-            int lru_port = lru.top();
-            if ( !port_queues[lru_port].empty() ) {
-                // noc_mesh_event* event = port_queues[local_port_start + i].front();
-                noc_mesh_event* event = port_queues[lru_port].front();
-
-                // Get the next port
-                int port = event->next_port;
-
-                // Check to see if the port is busy
-                if ( port_busy[port] > 0 ) {
-                    xbar_stalls[port]->addData(1);
-                    lru.satisfied(false);
-                    keepClockOn = true;
-                    continue;
-                }
+        lru.arbitrate(occupied_ports, [this, cycle](int lru_port) -> bool {
+            noc_mesh_event* event = port_queues[lru_port].front();
 
-                // Check to see if there are enough credits to send on
-                // that port
-                if ( port_credits[port] >= event->encap_ev->getSizeInFlits() ) {
-                    int trace_id = event->encap_ev->request->getTraceID();
-                    int vn = event->encap_ev->vn;
-                    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
-                    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
-                    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
-                    int flits = event->encap_ev->getSizeInFlits();
-
-                    // port_queues[local_port_start + i].pop();
-                    port_queues[lru_port].pop();
-                    port_credits[port] -= event->encap_ev->getSizeInFlits();
-                    port_busy[port] = event->encap_ev->getSizeInFlits();
-                    if ( edge_status & ( 1 << port) ) {
-                        ports[port]->send(event->encap_ev);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                        event->encap_ev = NULL;
-                        delete event;
-                    }
-                    else {
-                        ports[port]->send(event);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                    }
-                    if ( ttype == SimpleNetwork::Request::FULL ) {
-                        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
-                                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
-                                      trace_id,
-                                      getCurrentSimTimeNano(),
-                                      my_x, my_y,
-                                      getName().c_str(),
-                                      vn,
-                                      src,
-                                      dest);
-                    }
-                    // Need to send credit event back to last router
-                    credit_event* cr_ev = new credit_event(0, flits);
-                    // ports[local_port_start + i]->send(cr_ev);
-                    ports[lru_port]->send(cr_ev);
-                    lru.satisfied(true);
-                }
-                else {
-                    output_port_stalls[port]->addData(1);
-                    lru.satisfied(false);
-                }
-                if (!port_queues[lru_port].empty())
-                    keepClockOn = true;
+            // Get the next port
+            int port = event->next_port;
+
+            // Check to see if the port is busy
+            if ( port_busy[port] > cycle ) {
+                xbar_stalls[port]->addData(1);
+                return false;
+            }
+
+            // Check to see if there are enough credits to send on
+            // that port
+            if ( port_credits[port] < event->encap_ev->getSizeInFlits() ) {
+                output_port_stalls[port]->addData(1);
+                return false;
+            }
+
+            int trace_id = event->encap_ev->request->getTraceID();
+            int vn = event->encap_ev->vn;
+            SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
+            SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
+            SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
+            int flits = event->encap_ev->getSizeInFlits();
+
+            port_queues[lru_port].pop();
+            if ( port_queues[lru_port].empty() ) {
+                occupied_ports &= ~(uint64_t(1) << lru_port);
+            }
+            port_credits[port] -= flits;
+            port_busy[port] = cycle + flits;
+            if ( edge_status & ( 1 << port) ) {
+                ports[port]->send(event->encap_ev);
+                send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
+                event->encap_ev = NULL;
+                delete event;
             }
             else {
-                lru.satisfied(false);
+                ports[port]->send(event);
+                send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
             }
-        }
+            if ( ttype == SimpleNetwork::Request::FULL ) {
+                output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
+                              " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
+                              trace_id,
+                              getCurrentSimTimeNano(),
+                              my_x, my_y,
+                              getName().c_str(),
+                              vn,
+                              src,
+                              dest);
+            }
+            // Need to send credit event back to last router
+            credit_event* cr_ev = new credit_event(0, flits);
+            ports[lru_port]->send(cr_ev);
+            return true;
+        });
     }
 
-    // }
+    // Stay on the clock list as long as there are queued events
+    bool keepClockOn = occupied_ports != 0;
     clock_is_off = !keepClockOn;
 
-    // Stay on clock list
     return !keepClockOn;
 }
 
@@ -1346,7 +1324,7 @@ noc_mesh::printStatus(Output& out)
     for ( auto& pinfo : vec ) {
         out.output("  %s port:\n", pinfo.first.c_str());
         if ( ports[pinfo.second] != NULL ) {
-            out.output("    Port busy = %d\n",port_busy[pinfo.second]);
+            out.output("    Port busy = %d\n",port_busy[pinfo.second] > last_time ? (int)(port_busy[pinfo.second] - last_time) : 0);
             out.output("    Port credits = %d\n",port_credits[pinfo.second]);
             out.output("    Input queue total packets = %lu, head packet info:\n",port_queues[pinfo.second].size());
             if ( port_queues[pinfo.second].empty() ) {
@@ -121,7 +121,12 @@ private:
 
     Link** ports;
     port_queue_t* port_queues;
-    int* port_busy;
+    // Cycle at which each output port is done sending, so nothing
+    // needs to count down while the clock is on or catch up after it
+    // was off
+    Cycle_t* port_busy;
+    // Bit per port with events in its input queue
+    uint64_t occupied_ports;
     int* port_credits;
     int local_ports;
     bool use_dense_map;
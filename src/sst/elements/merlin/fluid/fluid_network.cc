@@ -0,0 +1,804 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+#include "fluid/fluid_network.h"
+
+#include <sst/core/params.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <string>
+#include <tuple>
+
+#include "merlin.h"
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+
+static UnitAlgebra getBitsParam(Params& params, const std::string& name)
+{
+    std::string value = params.find<std::string>(name);
+    if ( value == "" ) {
+        merlin_abort.fatal(CALL_INFO, -1, "fluid_network requires %s to be specified\n", name.c_str());
+    }
+
+    UnitAlgebra ua(value);
+    // If units were in Bytes, convert to bits
+    if ( ua.hasUnits("B") || ua.hasUnits("B/s") ) {
+        ua *= UnitAlgebra("8b/B");
+    }
+    return ua;
+}
+
+static SimTime_t getPicoseconds(Params& params, const std::string& name, const std::string& default_val)
+{
+    UnitAlgebra ua(params.find<std::string>(name, default_val));
+    if ( !ua.hasUnits("s") ) {
+        merlin_abort.fatal(CALL_INFO, -1, "fluid_network: %s must be specified in units of s\n", name.c_str());
+    }
+    return (ua / UnitAlgebra("1ps")).getRoundedValue();
+}
+
+static RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, int rtr, int port)
+{
+    if ( nullptr == ev || static_cast<BaseRtrEvent*>(ev)->getType() != BaseRtrEvent::INITIALIZATION ||
+         static_cast<RtrInitEvent*>(ev)->command != command ) {
+        merlin_abort.fatal(CALL_INFO, 1, "fluid_network: error during initialization on port %d of router %d.  "
+                           "The most likely cause of this is connecting an endpoint to a router port expecting "
+                           "to be connected to another router.\n", port, rtr);
+    }
+    return static_cast<RtrInitEvent*>(ev);
+}
+
+
+BasicFluidRouter::BasicFluidRouter(ComponentId_t cid, Params& params, FluidNetwork* network) :
+    FluidRouter(cid),
+    network(network)
+{
+    id = params.find<int>("id",-1);
+    if ( id == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "fluid_router requires id to be specified\n");
+    }
+
+    num_ports = params.find<int>("num_ports",-1);
+    if ( num_ports == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "fluid_router requires num_ports to be specified\n");
+    }
+
+    int num_vns = network->getNumVNs();
+    topo = loadUserSubComponent<SST::Merlin::Topology>
+        ("topology", ComponentInfo::SHARE_NONE, num_ports, id, num_vns);
+
+    if ( !topo ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "fluid_router requires topology to be specified in input file\n");
+    }
+
+    std::vector<int> vcs_per_vn(num_vns);
+    topo->getVCsPerVN(vcs_per_vn);
+    int num_vcs = 0;
+    for ( int vcs : vcs_per_vn ) num_vcs += vcs;
+
+    // The fluid model has no per-VC buffers, so adaptive routing
+    // always sees empty output queues
+    credit_array.assign(num_ports * num_vcs, network->getBufferCredits());
+    queue_length_array.assign(num_ports * num_vcs, 0);
+    topo->setOutputBufferCreditArray(credit_array.data(), num_vcs);
+    topo->setOutputQueueLengthsArray(queue_length_array.data(), num_vcs);
+
+    ports.resize(num_ports);
+    for ( int i = 0; i < num_ports; i++ ) {
+        std::string port_name("port");
+        port_name = port_name + std::to_string(i);
+        ports[i] = configureLink(port_name, "1ps",
+                                 new Event::Handler2<BasicFluidRouter,&BasicFluidRouter::handle_input,int>(this,i));
+    }
+}
+
+BasicFluidRouter::~BasicFluidRouter()
+{
+    delete topo;
+}
+
+void
+BasicFluidRouter::handle_input(Event* ev, int port)
+{
+    network->handleInput(ev, id, port);
+}
+
+
+FluidNetwork::~FluidNetwork()
+{
+    for ( auto& entry : flows ) {
+        for ( RtrEvent* ev : entry.second->packets ) delete ev;
+        delete entry.second;
+    }
+    for ( EndpointInfo& ep : endpoints ) {
+        for ( auto& queue : ep.waiting ) {
+            for ( RtrEvent* ev : queue ) delete ev;
+        }
+    }
+    for ( FluidRouter* rtr : routers ) {
+        delete rtr;
+    }
+}
+
+FluidNetwork::FluidNetwork(ComponentId_t cid, Params& params) :
+    Component(cid),
+    output(getSimulationOutput()),
+    num_active(0),
+    update_pending(false),
+    update_mark(0),
+    next_finish_tag(0)
+{
+    num_vns = params.find<int>("num_vns",2);
+    max_hops = params.find<int>("max_hops",256);
+
+    link_bw = getBitsParam(params, "link_bw");
+    flit_size = getBitsParam(params, "flit_size");
+    UnitAlgebra input_buf_size = getBitsParam(params, "input_buf_size");
+    buffer_credits = (input_buf_size / flit_size).getRoundedValue();
+    if ( buffer_credits <= 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "fluid_network: input_buf_size must hold at least one flit\n");
+    }
+
+    link_latency = getPicoseconds(params, "link_latency", "0ns");
+    router_latency = getPicoseconds(params, "router_latency", "0ns");
+
+    // Instance the routers.  Router ids must match their slot number.
+    SubComponentSlotInfo* slots = getSubComponentSlotInfo("router");
+    if ( !slots ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "fluid_network requires routers to be specified in input file\n");
+    }
+
+    int num_routers = slots->getMaxPopulatedSlotNumber() + 1;
+    routers.resize(num_routers);
+    channel_base.resize(num_routers);
+
+    int num_channels = 0;
+    for ( int i = 0; i < num_routers; i++ ) {
+        if ( !slots->isPopulated(i) ) {
+            merlin_abort.fatal(CALL_INFO, -1, "fluid_network: no router in slot %d, routers must be numbered 0 to %d\n",
+                               i, num_routers - 1);
+        }
+        routers[i] = slots->create<FluidRouter>(i, ComponentInfo::SHARE_NONE, this);
+        if ( routers[i]->getId() != i ) {
+            merlin_abort.fatal(CALL_INFO, -1, "fluid_network: router in slot %d has id %d\n", i, routers[i]->getId());
+        }
+
+        channel_base[i] = num_channels;
+        num_channels += routers[i]->getNumPorts();
+    }
+
+    // Every router output port is a channel with a bandwidth of link_bw
+    channel_capacity.assign(num_channels, link_bw.getDoubleValue() / 1.0e12);
+    wiring.assign(num_channels, std::make_pair(-1,-1));
+    channel_flows.resize(num_channels);
+    channel_dirty.assign(num_channels, false);
+    channel_left.resize(num_channels);
+    channel_unfrozen.resize(num_channels);
+    channel_version.assign(num_channels, 0);
+    channel_mark.assign(num_channels, 0);
+
+    // Find where all the endpoints are
+    for ( int r = 0; r < num_routers; r++ ) {
+        Topology* topo = routers[r]->getTopology();
+        for ( int p = 0; p < routers[r]->getNumPorts(); p++ ) {
+            if ( topo->getPortState(p) != Topology::R2N ) continue;
+
+            int ep_id = topo->getEndpointID(p);
+            if ( ep_id < 0 ) continue;
+            if ( ep_id >= (int)endpoints.size() ) {
+                endpoints.resize(ep_id + 1);
+            }
+
+            EndpointInfo& ep = endpoints[ep_id];
+            ep.rtr = r;
+            ep.port = p;
+            ep.link = routers[r]->getPortLink(p);
+            ep.credits.assign(num_vns, 0);
+            ep.waiting.resize(num_vns);
+        }
+    }
+
+    ps_tc = getTimeConverter("1ps");
+    wakeup_link = configureSelfLink("fluid_wakeup", "1ps",
+                                    new Event::Handler2<FluidNetwork,&FluidNetwork::handle_wakeup>(this));
+    update_link = configureSelfLink("fluid_update", "1ps",
+                                    new Event::Handler2<FluidNetwork,&FluidNetwork::handle_update>(this));
+    delivery_link = configureSelfLink("fluid_delivery", "1ps",
+                                      new Event::Handler2<FluidNetwork,&FluidNetwork::handle_delivery>(this));
+
+    send_bit_count = registerStatistic<uint64_t>("send_bit_count");
+    send_packet_count = registerStatistic<uint64_t>("send_packet_count");
+    rate_updates = registerStatistic<uint64_t>("rate_updates");
+    active_flow_count = registerStatistic<uint64_t>("active_flows");
+    recomputed_flows = registerStatistic<uint64_t>("recomputed_flows");
+    ejection_stalls = registerStatistic<uint64_t>("ejection_stalls");
+}
+
+void
+FluidNetwork::initPort(unsigned int phase, int rtr, int port)
+{
+    Link* link = routers[rtr]->getPortLink(port);
+    if ( nullptr == link ) return;
+
+    Topology* topo = routers[rtr]->getTopology();
+    bool host_port = topo->isHostPort(port);
+    RtrInitEvent* init_ev;
+    Event* ev;
+
+    switch ( phase ) {
+    case 0:
+        if ( host_port ) {
+            // Same protocol as the host ports of PortControl
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_BW;
+            init_ev->ua_value = link_bw;
+            link->sendUntimedData(init_ev);
+
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_FLIT_SIZE;
+            init_ev->ua_value = flit_size;
+            link->sendUntimedData(init_ev);
+
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_ID;
+            init_ev->int_value = topo->getEndpointID(port);
+            link->sendUntimedData(init_ev);
+        }
+        else {
+            // Tell the router on the other side where this link goes
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_ID;
+            init_ev->int_value = rtr;
+            link->sendUntimedData(init_ev);
+
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_PORT;
+            init_ev->int_value = port;
+            link->sendUntimedData(init_ev);
+        }
+        break;
+    case 1:
+        if ( host_port ) {
+            // The ejection channel runs at the slower of the two sides
+            ev = link->recvUntimedData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_BW, rtr, port);
+            if ( link_bw > init_ev->ua_value ) {
+                channel_capacity[getChannel(rtr,port)] = init_ev->ua_value.getDoubleValue() / 1.0e12;
+            }
+            delete ev;
+
+            ev = link->recvUntimedData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REQUEST_VNS, rtr, port);
+            int req_vns = init_ev->int_value;
+            delete ev;
+
+            if ( req_vns > num_vns ) {
+                merlin_abort.fatal(CALL_INFO, -1, "fluid_network: endpoint %d requested %d VNs, but the network only has %d\n",
+                                   topo->getEndpointID(port), req_vns, num_vns);
+            }
+
+            // Report the number of VNs, then the (identity) VN mapping
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REQUEST_VNS;
+            init_ev->int_value = num_vns;
+            link->sendUntimedData(init_ev);
+
+            for ( int i = 0; i < req_vns; ++i ) {
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REQUEST_VNS;
+                init_ev->int_value = i;
+                link->sendUntimedData(init_ev);
+            }
+        }
+        else {
+            int chan = getChannel(rtr,port);
+
+            ev = link->recvUntimedData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_ID, rtr, port);
+            wiring[chan].first = init_ev->int_value;
+            delete ev;
+
+            ev = link->recvUntimedData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_PORT, rtr, port);
+            wiring[chan].second = init_ev->int_value;
+            delete ev;
+        }
+        break;
+    case 2:
+        if ( host_port ) {
+            for ( int i = 0; i < num_vns; ++i ) {
+                link->sendUntimedData(new credit_event(i,buffer_credits));
+            }
+        }
+        // fall through
+    default:
+        while ( ( ev = link->recvUntimedData() ) != nullptr ) {
+            BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+            switch ( bev->getType() ) {
+            case BaseRtrEvent::CREDIT:
+            {
+                credit_event* ce = static_cast<credit_event*>(ev);
+                endpoints[topo->getEndpointID(port)].credits[ce->vc] += ce->credits;
+                delete ev;
+            }
+            break;
+            case BaseRtrEvent::PACKET:
+                routeUntimedData(ev, rtr, port);
+                break;
+            default:
+                delete ev;
+                break;
+            }
+        }
+        break;
+    }
+}
+
+void
+FluidNetwork::routeUntimedData(Event* ev, int rtr, int port)
+{
+    RtrEvent* rev = static_cast<RtrEvent*>(ev);
+    nid_t dest = rev->getDest();
+
+    if ( dest == UNTIMED_BROADCAST_ADDR ) {
+        // Everyone but the sender
+        int src = routers[rtr]->getTopology()->getEndpointID(port);
+        for ( int i = 0; i < (int)endpoints.size(); i++ ) {
+            if ( i == src || nullptr == endpoints[i].link ) continue;
+            endpoints[i].link->sendUntimedData(rev->clone());
+        }
+        delete rev;
+    }
+    else if ( dest >= 0 && dest < (nid_t)endpoints.size() && nullptr != endpoints[dest].link ) {
+        endpoints[dest].link->sendUntimedData(rev);
+    }
+    else {
+        delete rev;
+    }
+}
+
+void
+FluidNetwork::init(unsigned int phase)
+{
+    for ( int r = 0; r < (int)routers.size(); r++ ) {
+        for ( int p = 0; p < routers[r]->getNumPorts(); p++ ) {
+            initPort(phase, r, p);
+        }
+    }
+}
+
+void
+FluidNetwork::complete(unsigned int phase)
+{
+    for ( int r = 0; r < (int)routers.size(); r++ ) {
+        for ( int p = 0; p < routers[r]->getNumPorts(); p++ ) {
+            Link* link = routers[r]->getPortLink(p);
+            if ( nullptr == link ) continue;
+
+            Event* ev;
+            while ( ( ev = link->recvUntimedData() ) != nullptr ) {
+                if ( static_cast<BaseRtrEvent*>(ev)->getType() == BaseRtrEvent::PACKET ) {
+                    routeUntimedData(ev, r, p);
+                }
+                else {
+                    delete ev;
+                }
+            }
+        }
+    }
+}
+
+void
+FluidNetwork::setup()
+{
+    // Every connected router to router port must have found its peer
+    for ( int r = 0; r < (int)routers.size(); r++ ) {
+        Topology* topo = routers[r]->getTopology();
+        for ( int p = 0; p < routers[r]->getNumPorts(); p++ ) {
+            if ( nullptr == routers[r]->getPortLink(p) || topo->getPortState(p) != Topology::R2R ) continue;
+            if ( wiring[getChannel(r,p)].first == -1 ) {
+                merlin_abort.fatal(CALL_INFO, -1, "fluid_network: port %d of router %d is not connected to another fluid_router\n", p, r);
+            }
+        }
+    }
+}
+
+void
+FluidNetwork::finish()
+{
+}
+
+void
+FluidNetwork::handleInput(Event* ev, int rtr, int port)
+{
+    BaseRtrEvent* base_event = static_cast<BaseRtrEvent*>(ev);
+
+    switch ( base_event->getType() ) {
+    case BaseRtrEvent::CREDIT:
+    {
+        // Endpoint freed space in its input buffer
+        credit_event* ce = static_cast<credit_event*>(ev);
+        EndpointInfo& ep = endpoints[routers[rtr]->getTopology()->getEndpointID(port)];
+        ep.credits[ce->vc] += ce->credits;
+
+        std::deque<RtrEvent*>& waiting = ep.waiting[ce->vc];
+        while ( !waiting.empty() && ep.credits[ce->vc] >= waiting.front()->getSizeInFlits() ) {
+            ep.credits[ce->vc] -= waiting.front()->getSizeInFlits();
+            ep.link->send(waiting.front());
+            waiting.pop_front();
+        }
+        delete ce;
+    }
+    break;
+    case BaseRtrEvent::PACKET:
+    {
+        RtrEvent* event = static_cast<RtrEvent*>(ev);
+        nid_t src = event->getTrustedSrc();
+        nid_t dest = event->getDest();
+        int vn = event->getRouteVN();
+
+        if ( dest < 0 || dest >= (nid_t)endpoints.size() || nullptr == endpoints[dest].link ) {
+            merlin_abort.fatal(CALL_INFO, -1, "fluid_network: packet from %" PRI_NID " sent to unknown endpoint %" PRI_NID "\n",
+                               src, dest);
+        }
+
+        send_bit_count->addData(event->getSizeInBits());
+        send_packet_count->addData(1);
+
+        Flow*& flow = flows[flowKey(src, dest, vn)];
+        if ( nullptr == flow ) {
+            flow = new Flow();
+            flow->src = src;
+            flow->dest = dest;
+            flow->vn = vn;
+            flow->mark = 0;
+        }
+        flow->packets.push_back(event);
+
+        // Packets behind the head of the flow wait for it to finish
+        if ( flow->packets.size() == 1 ) {
+            startFlow(flow);
+            requestUpdate();
+        }
+    }
+    break;
+    case BaseRtrEvent::CTRL:
+        // No congestion management in the fluid model
+    default:
+        delete ev;
+        break;
+    }
+}
+
+void
+FluidNetwork::startFlow(Flow* flow)
+{
+    tracePath(flow);
+
+    RtrEvent* head = flow->packets.front();
+    flow->remaining = (double)head->getSizeInFlits() * flit_size.getDoubleValue();
+    flow->updated = getCurrentSimTime(ps_tc);
+    flow->rate = 0;
+    flow->finish_tag = 0;
+
+    for ( int chan : flow->channels ) {
+        channel_flows[chan].push_back(flow);
+    }
+    markChannels(flow);
+    num_active++;
+}
+
+void
+FluidNetwork::finishFlow(Flow* flow, SimTime_t now)
+{
+    for ( int chan : flow->channels ) {
+        std::vector<Flow*>& chan_flows = channel_flows[chan];
+        auto entry = std::find(chan_flows.begin(), chan_flows.end(), flow);
+        *entry = chan_flows.back();
+        chan_flows.pop_back();
+    }
+    markChannels(flow);
+    flow->finish_tag = 0;
+    num_active--;
+
+    RtrEvent* event = flow->packets.front();
+    flow->packets.pop_front();
+
+    // The packet has left the input buffer, so give the sender its
+    // credits back, then deliver it once it has crossed the path.  A
+    // packet routed on a faster path than the one before it waits
+    // for it, so the flow is delivered in order.
+    endpoints[flow->src].link->send(new credit_event(flow->vn, event->getSizeInFlits()));
+
+    uint64_t key = flowKey(flow->src, flow->dest, flow->vn);
+    SimTime_t& deliver_at = delivery_time[key];
+    deliver_at = std::max(deliver_at, now + flow->latency);
+    delivery_link->send(deliver_at - now, event);
+
+    if ( flow->packets.empty() ) {
+        flows.erase(key);
+        delete flow;
+    }
+    else {
+        startFlow(flow);
+    }
+}
+
+void
+FluidNetwork::markChannels(Flow* flow)
+{
+    for ( int chan : flow->channels ) {
+        if ( channel_dirty[chan] ) continue;
+        channel_dirty[chan] = true;
+        dirty_channels.push_back(chan);
+    }
+}
+
+void
+FluidNetwork::requestUpdate()
+{
+    // Every change at this timestamp is picked up by one update
+    if ( update_pending ) return;
+    update_pending = true;
+    update_link->send(0, nullptr);
+}
+
+void
+FluidNetwork::tracePath(Flow* flow)
+{
+    // Walk the packet through the topology objects of each router on
+    // its path, just as the hr_routers would route it
+    RtrEvent* head = flow->packets.front();
+    EndpointInfo& src = endpoints[flow->src];
+
+    int rtr = src.rtr;
+    int port = src.port;
+    Topology* topo = routers[rtr]->getTopology();
+    internal_router_event* ire = topo->process_input(head);
+
+    flow->channels.clear();
+    int router_hops = 0;
+    int link_hops = 0;
+
+    while ( true ) {
+        topo->route_packet(port, ire->getVC(), ire);
+        int out_port = ire->getNextPort();
+        int chan = getChannel(rtr,out_port);
+
+        flow->channels.push_back(chan);
+        router_hops++;
+
+        if ( topo->getPortState(out_port) == Topology::R2N ) {
+            if ( topo->getEndpointID(out_port) != flow->dest ) {
+                merlin_abort.fatal(CALL_INFO, -1, "fluid_network: packet from %" PRI_NID " to %" PRI_NID " was delivered to endpoint %d\n",
+                                   flow->src, flow->dest, topo->getEndpointID(out_port));
+            }
+            break;
+        }
+
+        if ( wiring[chan].first == -1 ) {
+            merlin_abort.fatal(CALL_INFO, -1, "fluid_network: packet from %" PRI_NID " to %" PRI_NID " routed to unconnected port %d of router %d\n",
+                               flow->src, flow->dest, out_port, rtr);
+        }
+        if ( router_hops >= max_hops ) {
+            merlin_abort.fatal(CALL_INFO, -1, "fluid_network: packet from %" PRI_NID " to %" PRI_NID " did not reach its destination in %d hops\n",
+                               flow->src, flow->dest, max_hops);
+        }
+
+        rtr = wiring[chan].first;
+        port = wiring[chan].second;
+        topo = routers[rtr]->getTopology();
+        link_hops++;
+    }
+
+    // The packet itself stays with the flow
+    ire->setEncapsulatedEvent(nullptr);
+    delete ire;
+
+    flow->latency = router_hops * router_latency + link_hops * link_latency;
+}
+
+void
+FluidNetwork::computeRates(SimTime_t now)
+{
+    // Rates can only change for the flows connected to a changed
+    // channel through a chain of shared channels.  Collect that
+    // component; no flow outside it crosses its channels, so
+    // recomputing it alone gives the same max-min solution as
+    // recomputing every flow.
+    update_mark++;
+    touched_channels.clear();
+    touched_flows.clear();
+
+    for ( int chan : dirty_channels ) {
+        channel_dirty[chan] = false;
+        if ( channel_mark[chan] == update_mark ) continue;
+        channel_mark[chan] = update_mark;
+        touched_channels.push_back(chan);
+    }
+    dirty_channels.clear();
+
+    for ( size_t i = 0; i < touched_channels.size(); i++ ) {
+        for ( Flow* flow : channel_flows[touched_channels[i]] ) {
+            if ( flow->mark == update_mark ) continue;
+            flow->mark = update_mark;
+            touched_flows.push_back(flow);
+
+            for ( int other : flow->channels ) {
+                if ( channel_mark[other] == update_mark ) continue;
+                channel_mark[other] = update_mark;
+                touched_channels.push_back(other);
+            }
+        }
+    }
+
+    // Bring the flows up to date at their old rates
+    for ( Flow* flow : touched_flows ) {
+        flow->remaining -= flow->rate * (double)(now - flow->updated);
+        if ( flow->remaining < 0 ) flow->remaining = 0;
+        flow->updated = now;
+        flow->frozen = false;
+    }
+
+    // Max-min fair share by progressive filling: repeatedly find the
+    // channel with the smallest equal share left for its unfixed
+    // flows, fix those flows at that share and take their bandwidth
+    // out of every other channel they cross.
+    typedef std::tuple<double,uint32_t,int> share_t;
+    std::priority_queue<share_t, std::vector<share_t>, std::greater<share_t>> shares;
+
+    for ( int chan : touched_channels ) {
+        channel_left[chan] = channel_capacity[chan];
+        channel_unfrozen[chan] = channel_flows[chan].size();
+        if ( channel_unfrozen[chan] > 0 ) {
+            shares.emplace(channel_left[chan] / channel_unfrozen[chan], ++channel_version[chan], chan);
+        }
+    }
+
+    while ( !shares.empty() ) {
+        int chan = std::get<2>(shares.top());
+        bool stale = std::get<1>(shares.top()) != channel_version[chan];
+        shares.pop();
+        if ( stale || channel_unfrozen[chan] == 0 ) continue;
+
+        double share = channel_left[chan] / channel_unfrozen[chan];
+        for ( Flow* flow : channel_flows[chan] ) {
+            if ( flow->frozen ) continue;
+            flow->rate = share;
+            flow->frozen = true;
+
+            for ( int other : flow->channels ) {
+                channel_left[other] -= share;
+                if ( channel_left[other] < 0 ) channel_left[other] = 0;
+                channel_unfrozen[other]--;
+                if ( other != chan && channel_unfrozen[other] > 0 ) {
+                    shares.emplace(channel_left[other] / channel_unfrozen[other], ++channel_version[other], other);
+                }
+            }
+        }
+    }
+
+    // New finish times, rounded up to the next picosecond.  The
+    // entries for the old rates become stale.
+    for ( Flow* flow : touched_flows ) {
+        if ( flow->rate <= 0 ) {
+            flow->finish_tag = 0;
+            continue;
+        }
+
+        SimTime_t delay = (SimTime_t)std::ceil(flow->remaining / flow->rate);
+        if ( delay == 0 ) delay = 1;
+
+        flow->finish_tag = ++next_finish_tag;
+        finish_heap.emplace(now + delay, flow->finish_tag,
+                            flowKey(flow->src, flow->dest, flow->vn));
+    }
+
+    rate_updates->addData(1);
+    active_flow_count->addData(num_active);
+    recomputed_flows->addData(touched_flows.size());
+}
+
+FluidNetwork::Flow*
+FluidNetwork::lookupFinish(const finish_t& entry)
+{
+    auto found = flows.find(std::get<2>(entry));
+    if ( found == flows.end() || found->second->finish_tag != std::get<1>(entry) ) return nullptr;
+    return found->second;
+}
+
+void
+FluidNetwork::scheduleWakeup(SimTime_t now)
+{
+    while ( !finish_heap.empty() && nullptr == lookupFinish(finish_heap.top()) ) {
+        finish_heap.pop();
+    }
+    if ( finish_heap.empty() ) return;
+
+    // A wakeup already in flight at or before the next finish will
+    // handle it, so only an earlier finish needs a new one
+    SimTime_t next = std::get<0>(finish_heap.top());
+    if ( !wakeups.empty() && wakeups.front() <= next ) return;
+
+    SimTime_t delay = next > now ? next - now : 1;
+    wakeups.push_front(now + delay);
+    wakeup_link->send(delay, nullptr);
+}
+
+void
+FluidNetwork::handle_wakeup(Event* ev)
+{
+    SimTime_t now = getCurrentSimTime(ps_tc);
+
+    // Wakeups arrive in time order, so this is the earliest in flight
+    wakeups.pop_front();
+
+    bool finished = false;
+    while ( !finish_heap.empty() && std::get<0>(finish_heap.top()) <= now ) {
+        Flow* flow = lookupFinish(finish_heap.top());
+        finish_heap.pop();
+        if ( nullptr == flow ) continue;
+
+        finishFlow(flow, now);
+        finished = true;
+    }
+
+    if ( finished ) requestUpdate();
+    scheduleWakeup(now);
+}
+
+void
+FluidNetwork::handle_update(Event* ev)
+{
+    SimTime_t now = getCurrentSimTime(ps_tc);
+    update_pending = false;
+
+    computeRates(now);
+    scheduleWakeup(now);
+}
+
+void
+FluidNetwork::handle_delivery(Event* ev)
+{
+    RtrEvent* event = static_cast<RtrEvent*>(ev);
+
+    // Forget the flow once its last packet in flight has arrived
+    auto last = delivery_time.find(flowKey(event->getTrustedSrc(), event->getDest(), event->getRouteVN()));
+    if ( last != delivery_time.end() && last->second <= getCurrentSimTime(ps_tc) ) {
+        delivery_time.erase(last);
+    }
+
+    deliver(endpoints[event->getDest()], event);
+}
+
+void
+FluidNetwork::deliver(EndpointInfo& ep, RtrEvent* ev)
+{
+    int vn = ev->getRouteVN();
+    std::deque<RtrEvent*>& waiting = ep.waiting[vn];
+
+    if ( waiting.empty() && ep.credits[vn] >= ev->getSizeInFlits() ) {
+        ep.credits[vn] -= ev->getSizeInFlits();
+        ep.link->send(ev);
+    }
+    else {
+        waiting.push_back(ev);
+        ejection_stalls->addData(1);
+    }
+}
@@ -0,0 +1,314 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLUID_NETWORK_H
+#define COMPONENTS_MERLIN_FLUID_NETWORK_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/subcomponent.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <sst/core/statapi/stataccumulator.h>
+
+#include <deque>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+namespace Merlin {
+
+class FluidNetwork;
+
+// A router of a fluid_network.  The routers are subcomponents of the
+// network so that the topology python scripts can instance them, wire
+// them together and load a Topology into them exactly as they do with
+// hr_router.  They only hold the links and the Topology object; all
+// the modeling is done by the parent FluidNetwork.
+class FluidRouter : public SubComponent {
+public:
+
+    // Parameter is the parent network
+    SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Merlin::FluidRouter, FluidNetwork*)
+
+    FluidRouter(ComponentId_t cid) :
+        SubComponent(cid)
+    {}
+
+    virtual ~FluidRouter() {}
+
+    virtual int getId() const = 0;
+    virtual int getNumPorts() const = 0;
+    virtual Topology* getTopology() = 0;
+    // Returns nullptr if nothing is connected to the port
+    virtual Link* getPortLink(int port) = 0;
+};
+
+
+class BasicFluidRouter : public FluidRouter {
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        BasicFluidRouter,
+        "merlin",
+        "fluid_router",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Router of a merlin.fluid_network.  Holds the ports and topology of one router; does no timing itself.",
+        SST::Merlin::FluidRouter)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"id",                 "ID of the router."},
+        {"num_ports",          "Number of ports that the router has"}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.credit_event", "merlin.RtrInitEvent" } }
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology object to control routing", "SST::Merlin::Topology" }
+    )
+
+    BasicFluidRouter(ComponentId_t cid, Params& params, FluidNetwork* network);
+    ~BasicFluidRouter();
+
+    int getId() const override { return id; }
+    int getNumPorts() const override { return num_ports; }
+    Topology* getTopology() override { return topo; }
+    Link* getPortLink(int port) override { return ports[port]; }
+
+private:
+    FluidNetwork* network;
+    int id;
+    int num_ports;
+    Topology* topo;
+    std::vector<Link*> ports;
+
+    // Full credit arrays handed to the topology for adaptive routing
+    std::vector<int> credit_array;
+    std::vector<int> queue_length_array;
+
+    void handle_input(Event* ev, int port);
+};
+
+
+// Flow-level network model.  Instead of moving flits through the
+// routers, every packet in the network is a flow over the channels
+// (router output ports) on its path and the channels are shared
+// between the active flows using max-min fairness.  Rates are only
+// recomputed when a flow starts or finishes, and only for the flows
+// connected to it through shared channels, so the cost is
+// proportional to the number of packets rather than the number of
+// flits times the number of hops.  All the starts and finishes at
+// one timestamp are batched into a single update, and finish times
+// are kept in a heap.
+//
+// The path of each packet is found by calling the Topology objects of
+// the routers, so any merlin topology and routing algorithm can be
+// used.  Packets between the same source, destination and VN are
+// served in order, one at a time, and are never delivered before an
+// earlier packet of the same flow, so delivery order is preserved
+// even when adaptive routing gives them paths of different latency.
+// Endpoints connect with the normal LinkControl and see the same
+// init protocol and credit flow control they would with hr_router.
+class FluidNetwork : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        FluidNetwork,
+        "merlin",
+        "fluid_network",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Flow-level (fluid) network model using max-min fair bandwidth sharing.  Drop-in replacement for a network of hr_routers.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"num_vns",            "Number of VNs.","2"},
+        {"link_bw",            "Bandwidth of the links specified in either b/s or B/s (can include SI prefix)."},
+        {"flit_size",          "Flit size specified in either b or B (can include SI prefix)."},
+        {"input_buf_size",     "Size of the router input buffers specified in b or B (can include SI prefix).  Sets the credits given to each endpoint."},
+        {"link_latency",       "Latency of a router to router link.  Specified in s (can include SI prefix).","0ns"},
+        {"router_latency",     "Latency through a router.  Specified in s (can include SI prefix).","0ns"},
+        {"max_hops",           "Maximum number of routers a packet may traverse before routing is considered broken.","256"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "send_bit_count",     "Count number of bits sent into the network", "bits", 1},
+        { "send_packet_count",  "Count number of packets sent into the network", "packets", 1},
+        { "rate_updates",       "Number of times the flow rates were recomputed", "updates", 1},
+        { "active_flows",       "Number of active flows each time the rates were recomputed", "flows", 1},
+        { "recomputed_flows",   "Number of flows whose rates were recomputed in each update", "flows", 1},
+        { "ejection_stalls",    "Number of packets that had to wait for credits at the destination", "packets", 1}
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"router", "Routers of the network, one per slot indexed by router id", "SST::Merlin::FluidRouter" }
+    )
+
+    FluidNetwork(ComponentId_t cid, Params& params);
+    ~FluidNetwork();
+
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void setup();
+    void finish();
+
+    int getNumVNs() const { return num_vns; }
+    int getBufferCredits() const { return buffer_credits; }
+
+    void handleInput(Event* ev, int rtr, int port);
+
+private:
+    typedef SST::Interfaces::SimpleNetwork::nid_t nid_t;
+
+    struct Flow {
+        nid_t src;
+        nid_t dest;
+        int vn;
+
+        // Packets waiting to be sent, the head is the one in flight
+        std::deque<RtrEvent*> packets;
+
+        // State of the head packet
+        std::vector<int> channels;
+        SimTime_t latency;
+        double remaining;     // bits, as of updated
+        SimTime_t updated;
+        double rate;          // bits/ps
+        bool frozen;          // rate fixed in current max-min pass
+        uint32_t mark;        // update that last visited the flow
+        uint64_t finish_tag;  // tag of the valid finish_heap entry, 0 if none
+    };
+
+    // (finish time, tag, flow key).  Entries whose tag no longer
+    // matches their flow are stale and skipped.
+    typedef std::tuple<SimTime_t,uint64_t,uint64_t> finish_t;
+
+    struct EndpointInfo {
+        int rtr = -1;
+        int port = -1;
+        Link* link = nullptr;
+        // credits for each VN in the endpoint's input buffers
+        std::vector<int> credits;
+        // packets waiting for credits, per VN
+        std::vector<std::deque<RtrEvent*>> waiting;
+    };
+
+    Output& output;
+
+    int num_vns;
+    int buffer_credits;
+    int max_hops;
+    UnitAlgebra link_bw;
+    UnitAlgebra flit_size;
+    SimTime_t link_latency;
+    SimTime_t router_latency;
+
+    std::vector<FluidRouter*> routers;
+
+    // Channel numbering: channel_base[rtr] + output port
+    std::vector<int> channel_base;
+    std::vector<double> channel_capacity;    // bits/ps
+
+    // (router, port) on the other end of each router to router
+    // port, indexed like the channels.  Filled in during init.
+    std::vector<std::pair<int,int>> wiring;
+
+    std::vector<EndpointInfo> endpoints;
+
+    std::unordered_map<uint64_t, Flow*> flows;
+    uint64_t num_active;
+
+    // Active flows crossing each channel
+    std::vector<std::vector<Flow*>> channel_flows;
+
+    // Channels whose flows changed since the last update
+    std::vector<int> dirty_channels;
+    std::vector<bool> channel_dirty;
+    bool update_pending;
+
+    // Scratch state for the max-min computation
+    std::vector<double> channel_left;
+    std::vector<int> channel_unfrozen;
+    std::vector<uint32_t> channel_version;
+    std::vector<uint32_t> channel_mark;
+    std::vector<int> touched_channels;
+    std::vector<Flow*> touched_flows;
+    uint32_t update_mark;
+
+    std::priority_queue<finish_t, std::vector<finish_t>, std::greater<finish_t>> finish_heap;
+    uint64_t next_finish_tag;
+
+    // Times of the wakeups in flight, earliest first
+    std::deque<SimTime_t> wakeups;
+
+    // Latest delivery time of each flow with packets in flight to the
+    // destination
+    std::unordered_map<uint64_t, SimTime_t> delivery_time;
+
+    TimeConverter ps_tc;
+    Link* wakeup_link;
+    Link* update_link;
+    Link* delivery_link;
+
+    Statistic<uint64_t>* send_bit_count;
+    Statistic<uint64_t>* send_packet_count;
+    Statistic<uint64_t>* rate_updates;
+    Statistic<uint64_t>* active_flow_count;
+    Statistic<uint64_t>* recomputed_flows;
+    Statistic<uint64_t>* ejection_stalls;
+
+    uint64_t flowKey(nid_t src, nid_t dest, int vn) const {
+        return ((uint64_t)src * endpoints.size() + dest) * num_vns + vn;
+    }
+
+    int getChannel(int rtr, int port) const { return channel_base[rtr] + port; }
+
+    void initPort(unsigned int phase, int rtr, int port);
+    void routeUntimedData(Event* ev, int rtr, int port);
+
+    void startFlow(Flow* flow);
+    void finishFlow(Flow* flow, SimTime_t now);
+    void tracePath(Flow* flow);
+    void markChannels(Flow* flow);
+    void requestUpdate();
+    void computeRates(SimTime_t now);
+    // Returns nullptr for a stale entry
+    Flow* lookupFinish(const finish_t& entry);
+    void scheduleWakeup(SimTime_t now);
+
+    void handle_wakeup(Event* ev);
+    void handle_update(Event* ev);
+    void handle_delivery(Event* ev);
+    void deliver(EndpointInfo& ep, RtrEvent* ev);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLUID_NETWORK_H
@@ -20,6 +20,8 @@
 
 #include <sst/core/output.h>
 
+#include <algorithm>
+
 #include "merlin.h"
 
 namespace SST {
@@ -66,6 +68,9 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     }
     if ( outbuf_size.hasUnits("B") ) outbuf_size *= UnitAlgebra("8b/B");
 
+    max_train_flits = params.find<int>("max_train_flits",0);
+    train_buffer_flits.initialize(TRAIN_BUFFER_FLITS_SHM);
+
     // Configure the links
     // For now give it a fake timebase.  Will give it the real timebase during init
 
@@ -168,6 +173,26 @@ void LinkControl::setup()
         delete init_events.front();
         init_events.pop_front();
     }
+
+    // A train is forwarded as a single event, so it has to fit in
+    // every buffer on its path, including the input buffer of the
+    // destination endpoint.  The path isn't known here, so use the
+    // smallest buffer in the network.  A train larger than that could
+    // never be forwarded and would stall its VN.
+    if ( max_train_flits > 0 ) {
+        int buffer_flits = max_train_flits;
+        for ( int i = 0; i < used_vns; ++i ) {
+            buffer_flits = std::min(buffer_flits, router_credits[output_queues[i].vn]);
+        }
+        if ( !train_buffer_flits.empty() ) {
+            buffer_flits = std::min(buffer_flits, *train_buffer_flits.begin());
+        }
+        if ( buffer_flits < max_train_flits ) {
+            output.verbose(CALL_INFO, 1, 0, "%s: max_train_flits (%d) is larger than the smallest buffer in the network, "
+                           "limiting trains to %d flits\n", getName().c_str(), max_train_flits, buffer_flits);
+            max_train_flits = buffer_flits;
+        }
+    }
 }
 
 RtrInitEvent* LinkControl::checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func)
@@ -304,6 +329,11 @@ void LinkControl::init(unsigned int phase)
             }
         }
 
+        // Trains sent to me by other endpoints have to fit in my
+        // input buffer
+        train_buffer_flits.insert((inbuf_size / flit_size_ua).getRoundedValue());
+        train_buffer_flits.publish();
+
         // Instance the output queues
         int count = 0;
         vn_remap_out = new output_queue_bundle_t*[req_vns];
@@ -599,33 +629,46 @@ void LinkControl::handle_input(Event* ev)
     }
     else {
         RtrEvent* event = static_cast<RtrEvent*>(ev);
-        // Simply put the event into the right virtual network queue
-        // int orig_vn = event->getOriginalVN();
-        int vn = event->getLogicalVN();
-        // event->request->vn = orig_vn;
-
-        input_queues[vn].push(event);
-        if (is_idle) {
-            idle_time->addData(getCurrentSimCycle() - idle_start);
-            is_idle = false;
+        if ( event->isTrain() ) {
+            // Trains are received as the packets they were built from
+            std::vector<RtrEvent*> train = event->takeTrain();
+            handle_packet(event);
+            for ( RtrEvent* next : train ) handle_packet(next);
         }
-        if ( event->getTraceType() == SimpleNetwork::Request::FULL ) {
-            output.output("TRACE(%d): %" PRIu64 " ns: Received and event on LinkControl in NIC: %s"
-                          " on VN %d from src %" PRIu64 "\n",
-                          event->getTraceID(),
-                          getCurrentSimTimeNano(),
-                          getName().c_str(),
-                          event->getRouteVN(),
-                          event->getTrustedSrc());
+        else {
+            handle_packet(event);
         }
+    }
+}
 
-        SimTime_t lat = getCurrentSimTimeNano() - event->getInjectionTime();
-        // recv_bit_count->addData(event->getSizeInBits());
-        packet_latency->addData(lat);
-        if ( receiveFunctor != nullptr ) {
-            bool keep = (*receiveFunctor)(vn);
-            if ( !keep) receiveFunctor = nullptr;
-        }
+void LinkControl::handle_packet(RtrEvent* event)
+{
+    // Simply put the event into the right virtual network queue
+    // int orig_vn = event->getOriginalVN();
+    int vn = event->getLogicalVN();
+    // event->request->vn = orig_vn;
+
+    input_queues[vn].push(event);
+    if (is_idle) {
+        idle_time->addData(getCurrentSimCycle() - idle_start);
+        is_idle = false;
+    }
+    if ( event->getTraceType() == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Received and event on LinkControl in NIC: %s"
+                      " on VN %d from src %" PRIu64 "\n",
+                      event->getTraceID(),
+                      getCurrentSimTimeNano(),
+                      getName().c_str(),
+                      event->getRouteVN(),
+                      event->getTrustedSrc());
+    }
+
+    SimTime_t lat = getCurrentSimTimeNano() - event->getInjectionTime();
+    // recv_bit_count->addData(event->getSizeInBits());
+    packet_latency->addData(lat);
+    if ( receiveFunctor != nullptr ) {
+        bool keep = (*receiveFunctor)(vn);
+        if ( !keep) receiveFunctor = nullptr;
     }
 }
 
@@ -697,6 +740,21 @@ void LinkControl::handle_output(Event* ev)
     }
     // If we found an event to send, go ahead and send it
     if ( found ) {
+        // In train mode, packets queued right behind this one for the
+        // same destination go to the router with it as one event
+        if ( max_train_flits > 0 && !found_has_throttle ) {
+            network_queue_t& queue = output_queues[vn_to_send].queue;
+            int credits = router_credits[output_queues[vn_to_send].vn];
+            while ( !queue.empty() ) {
+                RtrEvent* next = queue.front();
+                int train_size = send_event->getSizeInFlits() + next->getSizeInFlits();
+                if ( next->getDest() != send_event->getDest() || train_size > max_train_flits || train_size > credits ) break;
+                next->setInjectionTime(getCurrentSimTimeNano());
+                send_event->addToTrain(next);
+                queue.pop();
+            }
+        }
+
         // Need to return credits to the output buffer
         int size = send_event->getSizeInFlits();
         output_queues[vn_to_send].credits += size;
@@ -26,6 +26,7 @@
 
 #include <sst/core/statapi/statbase.h>
 #include <sst/core/shared/sharedArray.h>
+#include <sst/core/shared/sharedSet.h>
 
 #include "sst/elements/merlin/router.h"
 
@@ -69,6 +70,9 @@ public:
         {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
         {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
         {"vn_remap",           "Remap VNs onto/off of the network.  If empty, no vn remapping is done", "" },
+        {"max_train_flits",    "If greater than zero, packets queued back to back for the same destination on the same VN are sent "
+                               "to the router as a single train of up to this many flits.  Limited to the smallest input or output "
+                               "buffer of any router port or endpoint in the network.", "0" },
 
     )
 
@@ -113,6 +117,12 @@ private:
     UnitAlgebra outbuf_size;
     int flit_size; // in bits
     UnitAlgebra flit_size_ua;
+    // Largest train of packets to send as one router event, 0 if
+    // train mode is off
+    int max_train_flits;
+    // Buffer sizes in flits of every router port and endpoint in the
+    // network.  Trains are limited to the smallest one.
+    Shared::SharedSet<int> train_buffer_flits;
 
     // Initialization events received from network
     std::deque<RtrEvent*> init_events;
@@ -265,6 +275,7 @@ private:
     bool network_initialized;
 
     void handle_input(Event* ev);
+    void handle_packet(RtrEvent* ev);
     void handle_output(Event* ev);
     void handle_congestion(Event* ev);
 
@@ -534,6 +534,13 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
         port_out_credits[i] = 0;
     }
 
+    // A packet train is forwarded as a single event, so it has to fit
+    // in every buffer it passes through
+    train_buffer_flits.initialize(TRAIN_BUFFER_FLITS_SHM);
+    train_buffer_flits.insert(ibs.getRoundedValue());
+    train_buffer_flits.insert(obs.getRoundedValue());
+    train_buffer_flits.publish();
+
 
     // Need to start the timer for links that never send data
     idle_start = getCurrentSimCycle();
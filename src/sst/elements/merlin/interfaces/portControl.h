@@ -26,6 +26,7 @@
 #include <sst/core/timeConverter.h>
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/shared/sharedArray.h>
+#include <sst/core/shared/sharedSet.h>
 
 #include <sst/core/statapi/stataccumulator.h>
 
@@ -122,6 +123,10 @@ private:
     int vn_remap_shm_size;
     Shared::SharedArray<int> vn_remap;
 
+    // Buffer sizes in flits of every connected port, used by
+    // LinkControl to limit the size of packet trains
+    Shared::SharedSet<int> train_buffer_flits;
+
 	int max_link_width;
 	int cur_link_width;
 
@@ -599,7 +599,7 @@ class TemplateBase(_AttributeManager):
 class Topology(TemplateBase):
     def __init__(self):
         TemplateBase.__init__(self)
-        self._declareClassVariables(["network_name","endPointLinks","built","router"])
+        self._declareClassVariables(["network_name","endPointLinks","built","router","partition_ranks","_partition_domains"])
 
         self.network_name = ""
         self._setCallbackOnWrite("network_name",self._network_name_callback)
@@ -615,6 +615,7 @@ class Topology(TemplateBase):
 
         self.endPointLinks = []
         self.built = False
+        self._partition_domains = None
 
     def _network_name_callback(self, variable_name, value):
         self._lockVariable(variable_name)
@@ -632,7 +633,11 @@ class Topology(TemplateBase):
     # build() function.
     def build(self, endpoint):
         sst.pushNamePrefix(self.network_name)
+        self._startPartition()
+        self.router._startBuild(self)
         self._build_impl(endpoint)
+        self.router._finishBuild(self)
+        Buildable._partition_topology = None
         sst.popNamePrefix()
     def _build_impl(self, endpoint):
         pass
@@ -645,7 +650,83 @@ class Topology(TemplateBase):
     def findRouterById(self,rtr_id):
         return sst.findComponentByName(self.getRouterNameForId(rtr_id))
     def _instanceRouter(self,radix,rtr_id):
-        return self.router.instanceRouter(self.getRouterNameForId(rtr_id), radix, rtr_id)
+        rtr = self.router.instanceRouter(self.getRouterNameForId(rtr_id), radix, rtr_id)
+        if self._partition_domains:
+            self.router._setRouterRank(rtr, self.getRankForRouter(rtr_id))
+        return rtr
+
+    # Partition hints for parallel runs.  Topologies that can be cut
+    # into domains that only talk to each other over a subset of the
+    # router to router links (dragonfly groups, fat tree pods, hyperx
+    # planes, ...) override the three functions below.  When
+    # partition_ranks is set, every router is given a rank so that
+    # whole domains land on the same rank, and the links that stay
+    # within a domain (including host links) are marked as not
+    # cuttable so that endpoints follow their router with any
+    # partitioner.  Only the links between domains cross ranks, so
+    # those set the lookahead.  Links to routers that are not in any
+    # domain (fat tree top level routers) are always left cuttable.
+    # The ranks are only used as given with the sst.self partitioner
+    # (--partitioner=sst.self).
+
+    # Returns the number of domains, or None if not supported
+    def _getNumPartitionDomains(self):
+        return None
+    # Returns the domain of a router, or None if the router does not
+    # belong to a domain (e.g. fat tree core routers)
+    def _getPartitionDomain(self,rtr_id):
+        return None
+    # Returns the id of the router an endpoint is attached to
+    def _getRouterForNode(self,nid):
+        return None
+
+    def _startPartition(self):
+        self._partition_domains = None
+        Buildable._partition_topology = None
+        if not self.partition_ranks:
+            return
+
+        num_domains = self._getNumPartitionDomains()
+        if not num_domains:
+            print("WARNING: %s topology does not support partition hints, partition_ranks will be ignored"%self.getName())
+            return
+        if not self.router._supportsPartitionHints():
+            print("WARNING: router type does not support partition hints, partition_ranks will be ignored")
+            return
+        if num_domains < int(self.partition_ranks):
+            print("WARNING: %s topology only has %d partition domains, %d of the %d ranks will be empty"%
+                  (self.getName(), num_domains, int(self.partition_ranks) - num_domains, int(self.partition_ranks)))
+
+        self._partition_domains = num_domains
+        Buildable._partition_topology = self
+
+    def getRankForRouter(self,rtr_id):
+        ranks = int(self.partition_ranks)
+        num_domains = self._partition_domains
+        domain = self._getPartitionDomain(rtr_id)
+        if domain is None:
+            # Spread routers that are not in a domain evenly
+            return rtr_id % min(ranks, num_domains)
+        if num_domains < ranks:
+            return domain
+        # Contiguous blocks of domains per rank
+        return domain * ranks // num_domains
+
+    def getRankForNode(self,nid):
+        return self.getRankForRouter(self._getRouterForNode(nid))
+
+    # Called for host links and router to router links.  Links that
+    # stay within a partition domain are marked as not cuttable.
+    # Links between domains, or to a router outside of any domain,
+    # are left cuttable.  other_rtr_id is None for host links.
+    def _partitionLink(self,link,rtr_id,other_rtr_id=None):
+        if not self._partition_domains:
+            return
+        if other_rtr_id is not None:
+            domain = self._getPartitionDomain(rtr_id)
+            if domain is None or domain != self._getPartitionDomain(other_rtr_id):
+                return
+        link.setNoCut()
 
 class NetworkInterface(TemplateBase):
     def __init__(self):
@@ -763,6 +844,16 @@ class Buildable(TemplateBase):
     def build(self, nID, extraKeys, link=None):
         return None
 
+    # Topology currently being built with partition hints enabled
+    _partition_topology = None
+
+    # Endpoints call this on the components they create so that they
+    # are put on the same rank as the router they attach to when the
+    # topology was asked for partition hints
+    def _applyPartitionHint(self, comp, nID):
+        if Buildable._partition_topology:
+            comp.setRank(Buildable._partition_topology.getRankForNode(nID))
+
 
     # Convenience function to load a Buildable in a backward
     # compatibile manner.  Adheres to the rules for backward
@@ -817,6 +908,16 @@ class RouterTemplate(TemplateBase):
         pass
     def getDefaultNetworkInterface(self):
         pass
+    # Called by Topology.build() before and after the routers are
+    # instanced
+    def _startBuild(self, topology):
+        pass
+    def _finishBuild(self, topology):
+        pass
+    def _supportsPartitionHints(self):
+        return True
+    def _setRouterRank(self, rtr, rank):
+        rtr.setRank(rank)
 
 class hr_router(RouterTemplate):
     _instance_num = 0
@@ -858,6 +959,58 @@ class hr_router(RouterTemplate):
     def getTopologySlotName(self):
         return "topology"
 
+# Flow-level model of the whole network.  Each router is a
+# merlin.fluid_router subcomponent of a single merlin.fluid_network
+# component, so topologies instance and wire them exactly as they do
+# hr_routers.
+class fluid_network(RouterTemplate):
+    def __init__(self):
+        RouterTemplate.__init__(self)
+        self._declareClassVariables(["_network"])
+        self._declareParams("params",["link_bw","flit_size","input_buf_size","num_vns","link_latency","router_latency","max_hops"])
+        self._network = None
+
+        self._subscribeToPlatformParamSet("router")
+
+
+    def getDefaultNetworkInterface(self):
+        module_name, class_name = hr_router._default_linkcontrol.rsplit(".", 1)
+        return getattr(import_module(module_name), class_name)()
+
+    def _startBuild(self, topology):
+        self._network = sst.Component("fluid_network", "merlin.fluid_network")
+        self._applyStatisticsSettings(self._network)
+        self._network.addParams(self._getGroupParams("params"))
+        # Unless set explicitly, router to router links have the
+        # latency the topology would have given them
+        if not self.link_latency:
+            try:
+                link_latency = topology.link_latency
+            except KeyError:
+                link_latency = None
+            if link_latency:
+                self._network.addParam("link_latency", link_latency)
+
+    def _finishBuild(self, topology):
+        self._network = None
+
+    # The whole network is a single component
+    def _supportsPartitionHints(self):
+        return False
+
+    def instanceRouter(self, name, radix, rtr_id):
+        if not self._network:
+            print("ERROR: fluid_network routers can only be instanced from Topology.build()")
+            sst.exit()
+
+        rtr = self._network.setSubComponent("router", "merlin.fluid_router", rtr_id)
+        rtr.addParam("num_ports",radix)
+        rtr.addParam("id",rtr_id)
+        return rtr
+
+    def getTopologySlotName(self):
+        return "topology"
+
 class SystemEndpoint(Buildable):
     def __init__(self,system):
         Buildable.__init__(self)
@@ -920,6 +1073,7 @@ class EmptyJob(Job):
 
     def build(self, nID, extraKeys, link=None):
         nic = sst.Component("empty_node_%d"%nID, "merlin.simple_patterns.empty")
+        self._applyPartitionHint(nic, nID)
         id = self._nid_map[nID]
 
         #  Add the linkcontrol
@@ -30,6 +30,7 @@ class TestJob(Job):
 
     def build(self, nID, extraKeys, link = None):
         nic = sst.Component("testNic_%d"%nID, "merlin.test_nic")
+        self._applyPartitionHint(nic, nID)
         self._applyStatisticsSettings(nic)
         nic.addParams(self._getGroupParams("main"))
         nic.addParams(extraKeys)
@@ -55,6 +56,7 @@ class OfferedLoadJob(Job):
 
     def build(self, nID, extraKeys):
         nic = sst.Component("offered_load_%d"%nID, "merlin.offered_load")
+        self._applyPartitionHint(nic, nID)
         self._applyStatisticsSettings(nic)
         nic.addParams(self._getGroupParams("main"))
         nic.addParams(extraKeys)
@@ -82,6 +84,7 @@ class IncastJob(Job):
 
     def build(self, nID, extraKeys):
         nic = sst.Component("incast_%d"%nID, "merlin.simple_patterns.incast")
+        self._applyPartitionHint(nic, nID)
         self._applyStatisticsSettings(nic)
         nic.addParams(self._getGroupParams("main"))
         nic.addParams(extraKeys)
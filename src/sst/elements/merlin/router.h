@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -38,6 +39,10 @@ namespace Merlin {
 const int INIT_BROADCAST_ADDR = -1;
 const int UNTIMED_BROADCAST_ADDR = -1;
 
+// Name of the shared set every router port and endpoint adds its
+// buffer sizes (in flits) to, used to bound LinkControl packet trains
+const std::string TRAIN_BUFFER_FLITS_SHM = "merlin_train_buffer_flits";
+
 class TopologyEvent;
 class CtrlRtrEvent;
 class internal_router_event;
@@ -116,7 +121,8 @@ public:
 
     RtrEvent() :
         BaseRtrEvent(BaseRtrEvent::PACKET),
-        injectionTime(0)
+        injectionTime(0),
+        train_bits(0)
     {}
 
     RtrEvent(SST::Interfaces::SimpleNetwork::Request* req, SST::Interfaces::SimpleNetwork::nid_t trusted_src, int route_vn) :
@@ -124,13 +130,15 @@ public:
         request(req),
         trusted_src(trusted_src),
         route_vn(route_vn),
-        injectionTime(0)
+        injectionTime(0),
+        train_bits(0)
     {}
 
 
     ~RtrEvent()
     {
         if (request) delete request;
+        for ( RtrEvent* ev : train ) delete ev;
     }
 
     inline void setInjectionTime(SimTime_t time) {injectionTime = time;}
@@ -139,6 +147,32 @@ public:
     virtual RtrEvent* clone(void)  override {
         RtrEvent *ret = new RtrEvent(*this);
         ret->request = this->request->clone();
+        for ( size_t i = 0; i < train.size(); ++i ) {
+            ret->train[i] = train[i]->clone();
+        }
+        return ret;
+    }
+
+    // Packets sent back to back behind this one by a LinkControl in
+    // train mode.  The routers treat the whole train as one packet of
+    // the combined size; the receiving LinkControl splits it up again.
+    // Trains are never split inside the network, so router arbitration
+    // and input buffer credits work at train granularity: other
+    // traffic can only interleave between trains, and every input
+    // buffer on the path must hold a whole train.
+    inline void addToTrain(RtrEvent* ev) {
+        train.push_back(ev);
+        size_in_flits += ev->size_in_flits;
+        train_bits += ev->getSizeInBits();
+    }
+    inline bool isTrain() const { return !train.empty(); }
+    // Removes the rest of the train, leaving this event as a single
+    // packet.  Returned events are in the order they were added.
+    std::vector<RtrEvent*> takeTrain() {
+        std::vector<RtrEvent*> ret;
+        ret.swap(train);
+        for ( RtrEvent* ev : ret ) size_in_flits -= ev->size_in_flits;
+        train_bits = 0;
         return ret;
     }
 
@@ -148,7 +182,7 @@ public:
 
     inline void computeSizeInFlits(int flit_size ) {size_in_flits = (request->size_in_bits + flit_size - 1) / flit_size; }
     inline int getSizeInFlits() { return size_in_flits; }
-    inline int getSizeInBits() { return request->size_in_bits; }
+    inline int getSizeInBits() { return request->size_in_bits + train_bits; }
 
     inline SST::Interfaces::SimpleNetwork::nid_t getDest() const {return request->dest;}
 
@@ -175,6 +209,8 @@ public:
         SST_SER(route_vn);
         SST_SER(size_in_flits);
         SST_SER(injectionTime);
+        SST_SER(train);
+        SST_SER(train_bits);
     }
 
 private:
@@ -185,6 +221,9 @@ private:
     SimTime_t injectionTime;
     int size_in_flits;
 
+    std::vector<RtrEvent*> train;
+    int train_bits;
+
     ImplementSerializable(SST::Merlin::RtrEvent)
 
 };
@@ -13,6 +13,8 @@ except:
     pass
 
 
+have_mpi = sst_core_config_include_file_get_value(define="SST_CONFIG_HAVE_MPI", type=int, default=0, disable_warning=True)
+
 class testcase_merlin_Component(SSTTestCase):
 
     def setUp(self):
@@ -62,6 +64,19 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128_deferred(self):
         self.merlin_test_template("dragon_128_test_deferred")
 
+    # Same network as dragon_128_test, split over two ranks by the
+    # topology's partition hints, so it has to match the serial output
+    @unittest.skipIf(not have_mpi, "merlin: test_merlin_dragon_128_partition requires SST built with MPI")
+    def test_merlin_dragon_128_partition(self):
+        self.merlin_test_template("dragon_128_partition_test", reftestcase="dragon_128_test", num_ranks=2,
+                                  other_args="--partitioner=sst.self")
+
+    def test_merlin_dragon_72_fluid(self):
+        self.merlin_fluid_test_template("dragon_72_fluid_test")
+
+    def test_merlin_torus_16_train(self):
+        self.merlin_train_test_template("torus_16_train_test", 15 * 100)
+
 
     @unittest.skipIf(not(('sympy.polys.galoistools' in sys.modules) and ('sympy.polys.domains' in sys.modules)), "Polarfly construction requires sympy")
     def test_merlin_polarfly_455(self):
@@ -74,7 +89,7 @@ class testcase_merlin_Component(SSTTestCase):
 
 #####
 
-    def merlin_test_template(self, testcase, cwd=False):
+    def merlin_test_template(self, testcase, cwd=False, reftestcase=None, num_ranks=None, other_args=""):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -84,15 +99,17 @@ class testcase_merlin_Component(SSTTestCase):
         testDataFileName="test_merlin_{0}".format(testcase)
 
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        reffile = "{0}/refFiles/test_merlin_{1}.out".format(test_path, reftestcase if reftestcase else testcase)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
         if cwd:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=test_path)
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=test_path,
+                         num_ranks=num_ranks, other_args=other_args)
         else:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
+                         num_ranks=num_ranks, other_args=other_args)
 
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
@@ -108,3 +125,62 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    def merlin_fluid_test_template(self, testcase):
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        # Set the various file paths
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # The fluid model is not cycle accurate, so only check that
+        # every endpoint sent and received all of its packets, not
+        # when it did
+        filters = [ StartsWithFilter("Nic "),
+                    StartsWithFilter("Simulation is complete"),
+                    RemoveRegexFromLineFilter("^[0-9]+: +") ]
+        cmp_result = testing_compare_filtered_diff(testcase, outfile, reffile, sort=True, filters=filters)
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Filtered Output file {0} does not match Reference File {1}".format(outfile, reffile))
+
+    def merlin_train_test_template(self, testcase, expected_packets):
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        # Set the various file paths
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # Trains change when packets arrive, so there is no reference
+        # output.  A train larger than a buffer on its path would stall
+        # its VN, so check that every packet made it to the target.
+        with open(outfile, 'r') as f:
+            lines = [line.strip() for line in f]
+        self.assertIn("Total packets recieved = {0}".format(expected_packets), lines,
+                      "Output file {0} does not show all {1} packets received".format(outfile, expected_packets))
+        self.assertTrue(any(line.startswith("Simulation is complete") for line in lines),
+                        "Output file {0} does not show the simulation completing".format(outfile))
@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+if __name__ == "__main__":
+
+
+    ### Setup the topology
+    topo = topoTorus()
+    topo.shape = "4x4"
+    topo.width = "1x1"
+    topo.local_ports = 1
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "4kB"
+    # Larger than every buffer in the network, so trains get limited
+    # to the 128 flit input buffer of the target endpoint
+    networkif.max_train_flits = 1024
+
+    # Every other node sends to node 0, so each sender has a queue of
+    # packets for the same destination to build trains from
+    ep = IncastJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.target_nids = [0]
+    ep.packets_to_send = 100
+    ep.packet_size = "64B"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
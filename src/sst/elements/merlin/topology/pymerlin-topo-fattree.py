@@ -112,6 +112,34 @@ class topoFatTree(Topology):
         return sst.findComponentByName(self.getRouterNameForLocation(location));
 
 
+    # The groups one level below the top are the partition domains
+    # (pods), so only the links to the top level routers cross ranks.
+    # The top level routers are spread over the ranks.  They connect
+    # to every pod, so they are not in a domain and the links to them
+    # are left cuttable.  Those links set the lookahead.
+    def _getNumPartitionDomains(self):
+        if not self._ups:
+            return None
+        return self._groups_per_level[len(self._ups) - 1]
+
+    def _getPartitionDomain(self,rtr_id):
+        pod_level = len(self._ups) - 1
+        level = 0
+        while level < pod_level and rtr_id >= self._start_ids[level+1]:
+            level = level + 1
+        if rtr_id >= self._start_ids[pod_level] + self._routers_per_level[pod_level]:
+            return None
+
+        routers_per_group = self._routers_per_level[level] // self._groups_per_level[level]
+        group = (rtr_id - self._start_ids[level]) // routers_per_group
+        for l in range(level + 1, pod_level + 1):
+            group = group // self._downs[l]
+        return group
+
+    def _getRouterForNode(self,nid):
+        return nid // self._downs[0]
+
+
 
     def _build_impl(self, endpoint):
 
@@ -134,6 +162,7 @@ class topoFatTree(Topology):
                         hlink = sst.Link("hostlink_%d"%node_id)
                         if self.bundleEndpoints:
                            hlink.setNoCut()
+                        self._partitionLink(hlink, id)
                         ep.addLink(hlink, port_name, self.host_link_latency)
                         host_links.append(hlink)
 
@@ -156,7 +185,10 @@ class topoFatTree(Topology):
             rtr_links = [ [] for index in range(rtrs_in_group) ]
             for i in range(rtrs_in_group):
                 for j in range(self._downs[level]):
-                    rtr_links[i].append(sst.Link("link_l%d_g%d_r%d_p%d"%(level,group,i,j)));
+                    link = sst.Link("link_l%d_g%d_r%d_p%d"%(level,group,i,j))
+                    # Both ends are in the same pod
+                    self._partitionLink(link, id + i)
+                    rtr_links[i].append(link)
 
             # Now create group links to pass to lower level groups from router down links
             group_links = [ [] for index in range(self._downs[level]) ]
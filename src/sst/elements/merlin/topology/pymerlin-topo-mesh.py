@@ -97,6 +97,12 @@ class _topoMeshBase(Topology):
         foo.reverse()
         return foo
 
+    def _locToId(self,location):
+        rtr_id = 0
+        for i in range(self._num_dims - 1, -1, -1):
+            rtr_id = rtr_id * self._dim_size[i] + location[i]
+        return rtr_id
+
     def getRouterNameForId(self,rtr_id):
         return self.getRouterNameForLocation(self._idToLoc(rtr_id))
 
@@ -106,6 +112,20 @@ class _topoMeshBase(Topology):
     def findRouterByLocation(self,location):
         return sst.findComponentByName(self.getRouterNameForLocation(location))
 
+    # Each plane of routers with the same location in the last
+    # dimension is a partition domain, so only the links in the last
+    # dimension cross ranks
+    def _getNumPartitionDomains(self):
+        if self._num_dims < 2:
+            return None
+        return self._dim_size[-1]
+
+    def _getPartitionDomain(self,rtr_id):
+        return self._idToLoc(rtr_id)[-1]
+
+    def _getRouterForNode(self,nid):
+        return nid // int(self.local_ports)
+
     def _build_impl(self, endpoint):
         if self.host_link_latency is None:
             self.host_link_latency = self.link_latency
@@ -155,8 +175,11 @@ class _topoMeshBase(Topology):
                 if mydims[dim]+1 < self._dim_size[dim] or self._includeWrapLinks():
                     theirdims[dim] = (mydims[dim] +1 ) % self._dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
+                    their_id = self._locToId(theirdims)
                     for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                        link = getLink(mylocstr, theirlocstr, num)
+                        self._partitionLink(link, i, their_id)
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
                         port = port+1
                 else:
                     port += self._dim_width[dim]
@@ -165,8 +188,11 @@ class _topoMeshBase(Topology):
                 if mydims[dim] > 0 or self._includeWrapLinks():
                     theirdims[dim] = ((mydims[dim] -1) + self._dim_size[dim]) % self._dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
+                    their_id = self._locToId(theirdims)
                     for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(theirlocstr, mylocstr, num), "port%d"%port, self.link_latency)
+                        link = getLink(theirlocstr, mylocstr, num)
+                        self._partitionLink(link, i, their_id)
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
                         port = port+1
                 else:
                     port += self._dim_width[dim]
@@ -178,6 +204,7 @@ class _topoMeshBase(Topology):
                     nicLink = sst.Link("nic.%d:%d"%(i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
+                    self._partitionLink(nicLink, i)
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
                 port = port+1
 
@@ -149,7 +149,9 @@ Messier::Messier(SST::ComponentId_t id, SST::Params& params): Component(id) {
         event_link->setDefaultTimeBase(tc);
 
 
-    registerClock( cpu_clock, new Clock::Handler2<Messier,&Messier::tick>(this) );
+    // The DIMM unregisters the clock while it is idle and registers it again on the next request
+    Clock::HandlerBase * clock_handler = new Clock::Handler2<Messier,&Messier::tick>(this);
+    DIMM->setClock(registerClock( cpu_clock, clock_handler ), clock_handler);
 
 }
 
@@ -162,7 +164,5 @@ Messier::Messier() : Component(-1)
 bool Messier::tick(SST::Cycle_t x)
 {
     // We tick the MMU hierarchy of each core
-    DIMM->tick();
-
-    return false;
+    return DIMM->tick();
 }
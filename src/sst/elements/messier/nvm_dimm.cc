@@ -17,7 +17,7 @@
 #include <sst/core/link.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 
-#include <map>
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <list>
@@ -88,6 +88,16 @@ NVM_DIMM::NVM_DIMM(ComponentId_t id, NVM_PARAMS par) : ComponentExtension(id)
 
     curr_reads = 0;
     curr_writes = 0;
+    outstanding = 0;
+
+    ready_at_NVM.resize(params->num_ranks * params->num_banks);
+    ready_count = 0;
+
+    bank_hist.assign(params->num_banks, 0);
+
+    clock_on = true;
+    clock_handler = NULL;
+    last_clock_cycle = 0;
 
     gs = params->group_size;
     lg = group_locked;
@@ -126,24 +136,29 @@ bool NVM_DIMM::tick()
 
 
     if(!enabled)
-        return false;
+    {
+        // Nothing has arrived yet, the first request registers the clock again
+        clock_on = false;
+        return true;
+    }
 
 
     // Incrementing the cycles count
 
     cycles++;
+    last_clock_cycle = getCurrentSimTime(clock_tc);
 
 
-    if(READS_COMPLETE.find(cycles)!=READS_COMPLETE.end())
+    while(!READS_COMPLETE.empty() && READS_COMPLETE.top() <= cycles)
     {
-        curr_reads = curr_reads - READS_COMPLETE[cycles];
-        READS_COMPLETE.erase(cycles);
+        curr_reads--;
+        READS_COMPLETE.pop();
     }
 
-    if(WRITES_COMPLETE.find(cycles)!=WRITES_COMPLETE.end())
+    while(!WRITES_COMPLETE.empty() && WRITES_COMPLETE.top() <= cycles)
     {
-        curr_writes = curr_writes - WRITES_COMPLETE[cycles];
-        WRITES_COMPLETE.erase(cycles);
+        curr_writes--;
+        WRITES_COMPLETE.pop();
     }
 
 
@@ -209,6 +224,13 @@ bool NVM_DIMM::tick()
     }
 
 
+    // With no requests waiting, no data ready and an empty write buffer the ticks have no effect until the next event,
+    // so the clock is unregistered and the skipped cycles are accounted for by sync_cycles()
+    if(idle())
+    {
+        clock_on = false;
+        return true;
+    }
 
     return false;
 
@@ -216,52 +238,79 @@ bool NVM_DIMM::tick()
 }
 
 
-void NVM_DIMM::schedule_delivery()
+bool NVM_DIMM::idle()
 {
+    return transactions.empty() && WB->empty() && (ready_count == 0);
+}
 
-    auto st_1 = ready_at_NVM.begin();
-    auto en_1 = ready_at_NVM.end();
 
-    while (st_1 != en_1)
-    {
+void NVM_DIMM::sync_cycles()
+{
+    if(clock_on || !enabled)
+        return;
 
-        bool ready = false;
+    SimTime_t now = getCurrentSimTime(clock_tc);
+    SimTime_t skipped = now - last_clock_cycle;
 
-        if(st_1->second <= cycles)
-        {
+    cycles += skipped;
 
+    // An idle tick in modulo mode still advances the read count
+    if(params->modulo)
+        read_count += skipped;
 
-            bool ready = false;
-            // Check if the bank and rank are free to submit the command there
-            long long int add = (st_1->first)->Address;
-            if (getRank(add)->getBusyUntil() < cycles)
-            {
-                if(getBank(add)->getBusyUntil() < cycles)
-                    ready = true;
-            }
+    last_clock_cycle = now;
+}
 
-            if(ready) // This means that the request is ready and the data is ready to be ready by internal controller
-            {
 
-                // Occuping the rank and back for reading the ready data
-                getRank(add)->setBusyUntil(cycles + params->tCMD + params->tCL + params->tBURST);
-                (getBank(add))->setBusyUntil(cycles + params->tCMD + params->tCL + params->tBURST);
-                (getBank(add))->set_last(true);
-                ready_trans[st_1->first] = cycles + params->tCMD + params->tCL + params->tBURST;
-                (st_1->first)->meta_data = EventType::READ_COMPLETION;
-                                m_EventChan->send(params->tCMD + params->tCL + params->tBURST, new MessierEvent(st_1->first, EventType::READ_COMPLETION));
-                ready_at_NVM.erase(st_1);
-                break;
-            }
+void NVM_DIMM::wake()
+{
+    if(clock_on || idle())
+        return;
 
-        }
+    clock_on = true;
+    reregisterClock(clock_tc, clock_handler);
+}
+
+
+void NVM_DIMM::schedule_delivery()
+{
 
-        if(!ready)
-            st_1++;
+    if(ready_count == 0)
+        return;
 
+    // Of the banks whose rank and bank are free, the ready request with the lowest ID is read out
+    std::vector<NVM_Request *> * best = NULL;
+
+    for(auto & queue : ready_at_NVM)
+    {
+        if(queue.empty())
+            continue;
+
+        NVM_Request * head = queue.front();
+
+        if((best == NULL) || (head->req_ID < best->front()->req_ID))
+        {
+            // Check if the bank and rank are free to submit the command there
+            if((getRank(head->Address)->getBusyUntil() < cycles) && (getBank(head->Address)->getBusyUntil() < cycles))
+                best = &queue;
+        }
     }
 
+    if(best == NULL)
+        return;
+
+    NVM_Request * req = best->front();
+    best->erase(best->begin());
+    ready_count--;
+
+    long long int add = req->Address;
 
+    // Occuping the rank and back for reading the ready data
+    getRank(add)->setBusyUntil(cycles + params->tCMD + params->tCL + params->tBURST);
+    (getBank(add))->setBusyUntil(cycles + params->tCMD + params->tCL + params->tBURST);
+    (getBank(add))->set_last(true);
+    req->meta_data = EventType::READ_COMPLETION;
+    m_EventChan->send(params->tCMD + params->tCL + params->tBURST, new MessierEvent(req, EventType::READ_COMPLETION));
 
 }
 
@@ -295,9 +344,9 @@ bool NVM_DIMM::try_flush_wb()
     {
 
 
-        std::list<NVM_Request *> writes_list = WB->getList();
+        const std::list<NVM_Request *> & writes_list = WB->getList();
 
-        std::list<NVM_Request *>::iterator st_wl, en_wl;
+        std::list<NVM_Request *>::const_iterator st_wl, en_wl;
 
         st_wl = writes_list.begin();
         en_wl = writes_list.end();
@@ -342,7 +391,7 @@ bool NVM_DIMM::try_flush_wb()
                 temp_bank->set_last(false); // setting it to write
                 temp_bank->set_last_address(temp->Address);
                 curr_writes++;
-                WRITES_COMPLETE[cycles + params->tCMD + params->tCL_W + params->tBURST]++;
+                WRITES_COMPLETE.push(cycles + params->tCMD + params->tCL_W + params->tBURST);
 
                 delete temp;
 
@@ -376,7 +425,6 @@ bool NVM_DIMM::find_in_wb(NVM_Request * temp)
         {
 
             m_memChan->send(respEvent); //(SST::Event *)NVM_EVENT_MAP[temp]);
-            TIME_STAMP.erase(temp);
 
 
         }
@@ -444,13 +492,13 @@ bool NVM_DIMM::pop_optimal()
 
         RANK * corresp_rank = getRank(temp->Address);
         BANK * corresp_bank = getBank(temp->Address);
-        if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) &&  (HOLD.find(temp->req_ID)==HOLD.end()) && temp->Read && (corresp_rank->getBusyUntil() < cycles) && (corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked() && (outstanding.size() < params->max_outstanding))
+        if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) &&  (HOLD.find(temp->req_ID)==HOLD.end()) && temp->Read && (corresp_rank->getBusyUntil() < cycles) && (corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked() && (outstanding < params->max_outstanding))
         {
 
             if ( row_buffer_hit(temp->Address, corresp_bank->getRB()))
             {
                 time_ready = cycles + 1;
-                outstanding.push_back(temp);
+                outstanding++;
                 transactions.erase(st);
                 // Lock the bank so no other request comes in and try to activate another row while waiting for the activation
 
@@ -565,7 +613,7 @@ bool NVM_DIMM::submit_request_opt()
                     BANK * corresp_bank = getBank(temp->Address);
 
                     // Check if the rank is not busy
-                    if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) && (HOLD.find(temp->req_ID)==HOLD.end()) &&   (corresp_rank->getBusyUntil() < cycles) && (((corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked()) || (params->write_cancel && !WB->flush() && !corresp_bank->read() &&(corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))) && (outstanding.size() < params->max_outstanding))
+                    if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) && (HOLD.find(temp->req_ID)==HOLD.end()) &&   (corresp_rank->getBusyUntil() < cycles) && (((corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked()) || (params->write_cancel && !WB->flush() && !corresp_bank->read() &&(corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))) && (outstanding < params->max_outstanding))
                     {
 
 
@@ -604,13 +652,13 @@ bool NVM_DIMM::submit_request_opt()
                             corresp_bank->set_last(true);
                             time_ready = cycles + params->tRCD + params->tCMD;
                             curr_reads++;
-                            READS_COMPLETE[cycles + params->tRCD + params->tCMD]++;
+                            READS_COMPLETE.push(cycles + params->tRCD + params->tCMD);
                             corresp_bank->setRB(temp->Address/params->row_buffer_size);
                             issued = true;
                         }
                         if(issued)
                         {
-                            outstanding.push_back(temp);
+                            outstanding++;
                             transactions.erase(st);
                             removed=true;
                             // Lock the bank so no other request comes in and try to activate another row while waiting for the activation
@@ -658,7 +706,7 @@ NVM_Request * NVM_DIMM::pop_request()
 void NVM_DIMM::handleEvent( SST::Event* e )
 {
 
-
+    sync_cycles();
 
     MessierEvent * temp_ptr =  dynamic_cast<MessierComponent::MessierEvent*> (e);
 
@@ -679,8 +727,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
         {
             NVM_Request * temp = req;
 
-            histogram_idle->addData((cycles - TIME_STAMP[temp])/1000);
-            TIME_STAMP.erase(temp);
+            histogram_idle->addData((cycles - temp->time_stamp)/1000);
             if(SQUASHED.find(temp->req_ID)==SQUASHED.end())
             {
                 MemRespEvent *respEvent = new MemRespEvent(
@@ -747,8 +794,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
                 }
 
             (getBank(req->Address))->setLocked(false, cycles);
-            ready_trans.erase(req);
-            outstanding.remove(req);
+            outstanding--;
             delete req;
 
         }
@@ -758,7 +804,11 @@ void NVM_DIMM::handleEvent( SST::Event* e )
     {
 
         NVM_Request * req = tmp.getReq();
-        ready_at_NVM[req] = cycles;
+        std::vector<NVM_Request *> & queue = ready_at_NVM[WhichRank(req->Address) * params->num_banks + WhichBank(req->Address)];
+
+        queue.insert(std::upper_bound(queue.begin(), queue.end(), req,
+                    [](const NVM_Request * a, const NVM_Request * b) { return a->req_ID < b->req_ID; }), req);
+        ready_count++;
         delete e;
 
     }
@@ -789,7 +839,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
                 if(params->cache_persistent)
                     HOLD.erase(temp->req_ID);
 
-                SQUASHED[temp->req_ID] = 1;
+                SQUASHED.insert(temp->req_ID);
 
 
             }
@@ -904,6 +954,8 @@ void NVM_DIMM::handleEvent( SST::Event* e )
         delete e;
     }
 
+    wake();
+
 }
 
 
@@ -911,7 +963,13 @@ void NVM_DIMM::handleEvent( SST::Event* e )
 void NVM_DIMM::handleRequest(SST::Event* e)
 {
 
-    enabled = true;
+    if(!enabled)
+    {
+        enabled = true;
+        last_clock_cycle = getCurrentSimTime(clock_tc);
+    }
+    else
+        sync_cycles();
 
 
     MessierComponent::MemReqEvent *event  = dynamic_cast<MessierComponent::MemReqEvent*>(e);
@@ -978,7 +1036,7 @@ void NVM_DIMM::handleRequest(SST::Event* e)
         {
             // Hold servicing the request till we check the cache!
             if(params->cache_persistent)
-                HOLD[tmp2->req_ID] = 1;
+                HOLD.insert(tmp2->req_ID);
 
             tmp2->meta_data = EventType::HIT_MISS;
             m_EventChan->send(params->cache_latency, new MessierEvent(tmp2, EventType::HIT_MISS));
@@ -991,6 +1049,8 @@ void NVM_DIMM::handleRequest(SST::Event* e)
     // If write and the cache is peristent, just put it directly in the cache
     if(!(params->cache_persistent && (cache!=NULL) && (!tmp->Read)))
         push_request(tmp); // Push the request
+
+    wake();
 }
 
 #if ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
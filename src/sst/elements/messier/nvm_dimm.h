@@ -20,8 +20,12 @@
 #include <sst/core/link.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 
-#include <map>
+#include <functional>
 #include <list>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "rank.h"
 #include "writeBuffer.h"
@@ -51,27 +55,18 @@ namespace MessierComponent{
         // This is the requests buffer, where all transactions are buffered before being processed by the controller
         std::list<NVM_Request *> transactions;
 
-        // This tracks the currently outstanding requests
-        std::list<NVM_Request *> outstanding;
+        // This tracks the number of currently outstanding requests
+        unsigned int outstanding;
 
-        // This is used to quickly track the number of writes complete at a specific cycle to remove them from the currently executed writes
-        std::map<long long int, int> WRITES_COMPLETE;
+        // Min-heaps of the cycles at which the currently executed writes and reads complete
+        std::priority_queue<long long int, std::vector<long long int>, std::greater<long long int> > WRITES_COMPLETE;
+        std::priority_queue<long long int, std::vector<long long int>, std::greater<long long int> > READS_COMPLETE;
 
-        // This is used to quickly track the number of reads complete at a specific cycle to remove them from the currently executed reads
-        std::map<long long int, int> READS_COMPLETE;
+        // The requests whose data is ready at the NVM chips, one queue per bank (indexed by rank * num_banks + bank) kept in request ID order
+        std::vector<std::vector<NVM_Request *> > ready_at_NVM;
 
-                // Deterministic sort function for NVM_Request pointers
-                struct NVMReqPtrCompare {
-                    bool operator()(const NVM_Request* ptrA, const NVM_Request* ptrB) const {
-                        return (ptrA->req_ID < ptrB->req_ID);
-                    }
-                };
-
-        // This is the queue of the ready requests
-        std::map<NVM_Request *, long long int, NVMReqPtrCompare> ready_trans;
-
-        // This tracks if a request is expected to be ready at the PCM
-        std::map<NVM_Request *, long long int, NVMReqPtrCompare> ready_at_NVM;
+        // The number of requests in all the ready_at_NVM queues
+        int ready_count;
 
         // This determines the completed requests and when they are completed
         std::list<NVM_Request *> completed_requests;
@@ -98,31 +93,49 @@ namespace MessierComponent{
 
         SST::Link * m_EventChan;
 
-        std::map<long long int, MemReqEvent *> NVM_EVENT_MAP;
-
-        std::map<NVM_Request *, long long int, NVMReqPtrCompare> TIME_STAMP;
+        std::unordered_map<long long int, MemReqEvent *> NVM_EVENT_MAP;
 
         // This keeps track of the squashed requests, as they hit in the cache
-        std::map<long long int, int> SQUASHED;
+        std::unordered_set<long long int> SQUASHED;
 
         // This structure prevents returning data before checking the cache, to avoid any inconsistency issues
-        std::map<long long int, int> HOLD;
+        std::unordered_set<long long int> HOLD;
 
         // This defines the internal cache of the NVM-based DIMM
         NVM_CACHE * cache;
 
-        std::map<int, int> bank_hist;
+        // The number of requests in the controller for each bank
+        std::vector<int> bank_hist;
 
         int group_locked;
 
+        // The clock is unregistered while the controller has nothing to do, see tick()
+        bool clock_on;
+        TimeConverter clock_tc;
+        Clock::HandlerBase * clock_handler;
+
+        // The clock cycle of the last tick, or the last time cycles was brought up to date while the clock was off
+        SimTime_t last_clock_cycle;
+
+        // Brings cycles up to date with the ticks skipped while the clock was off
+        void sync_cycles();
+
+        // Registers the clock again if there is work for the controller
+        void wake();
+
+        bool idle();
+
         public:
 
         // This is the constructor for the NVM-based DIMM
         NVM_DIMM(SST::ComponentId_t id, NVM_PARAMS par);
 
-        // This is the clock of the near memory controller
+        // This is the clock of the near memory controller, returns true when the controller is idle and the clock can be unregistered
         bool tick();
 
+        // The clock the controller is ticked by, used to register it again after idling
+        void setClock(TimeConverter tc, Clock::HandlerBase * handler) { clock_tc = tc; clock_handler = handler; }
+
         void finish(){}
 
         RANK * getRank(long long int add){ return ranks[WhichRank(add)]; }
@@ -139,7 +152,7 @@ namespace MessierComponent{
 
         //bool push_request(NVM_Request * req) { if(transactions.size() >= params->max_requests) return false; else {transactions.push_back(req); return true; }}
 
-        bool push_request(NVM_Request * req) { transactions.push_back(req);  if(req->Read) TIME_STAMP[req]= cycles; return true;}
+        bool push_request(NVM_Request * req) { transactions.push_back(req);  if(req->Read) req->time_stamp = cycles; return true;}
 
         // This is the optimized version that basiclly tries to find out if there is any possibility to achieve a row buffer hit from the current transactions
         bool submit_request_opt();
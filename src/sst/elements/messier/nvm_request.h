@@ -36,13 +36,15 @@ namespace MessierComponent{
 class NVM_Request
 {
     public:
-        NVM_Request() {}
-        NVM_Request(uint64_t id, bool R, int size, uint64_t Add) { req_ID = id; Read = R; Size = size; Address = Add;}
+        NVM_Request() { time_stamp = 0; }
+        NVM_Request(uint64_t id, bool R, int size, uint64_t Add) { req_ID = id; Read = R; Size = size; Address = Add; time_stamp = 0;}
         uint64_t req_ID;
         bool Read;
         int Size;
         uint64_t Address;
         int meta_data;
+        // The cycle a read request arrived at the controller
+        long long int time_stamp;
 };
 
 }
@@ -64,10 +64,12 @@ NVM_Request * NVM_WRITE_BUFFER::find_entry(long long int address)
 {
 
     // Fast path: note that this is the common case where there is no entry in WB, hence speeding up SST time
-    if(ADD_REQ.find(address/entry_size) == ADD_REQ.end())
+    std::unordered_map<long long int, NVM_Request *>::iterator it = ADD_REQ.find(address/entry_size);
+
+    if(it == ADD_REQ.end())
         return NULL;
     else
-        return ADD_REQ[address/entry_size];
+        return it->second;
 
 }
 
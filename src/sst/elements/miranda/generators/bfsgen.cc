@@ -0,0 +1,162 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/bfsgen.h>
+
+using namespace SST::Miranda;
+
+#define BFS_UNVISITED UINT32_MAX
+
+BFSGenerator::BFSGenerator( ComponentId_t id, Params& params ) :
+	GraphGenerator(id, params, "BFSGenerator") {
+
+	const uint64_t vertexCount = graph->getVertexCount();
+	const uint32_t source = params.find<uint32_t>("source", 0);
+
+	if(source >= vertexCount) {
+		out->fatal(CALL_INFO, -1, "Source vertex %" PRIu32 " is not in the graph (%" PRIu64 " vertices)\n",
+			source, vertexCount);
+	}
+
+	parentAddr      = allocateArray(vertexCount, propertyWidth);
+	frontierAddr[0] = allocateArray(vertexCount, vertexWidth);
+	frontierAddr[1] = allocateArray(vertexCount, vertexWidth);
+	currentFrontier = 0;
+
+	parent.assign(vertexCount, BFS_UNVISITED);
+	parent[source] = source;
+	frontier.push_back(source);
+	nextFrontier.reserve(vertexCount);
+
+	position = 0;
+	inVertex = false;
+	vertex = 0;
+	edge = 0;
+	level = 0;
+	finished = false;
+
+	partition(frontier.size(), [this](const uint64_t i) { return graph->getDegree(frontier[i]); });
+
+	out->verbose(CALL_INFO, 1, 0, "Search starts from vertex %" PRIu32 "\n", source);
+}
+
+BFSGenerator::~BFSGenerator() {
+}
+
+void BFSGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	MemoryOpRequest* readStart = NULL;
+	MemoryOpRequest* readEnd = NULL;
+
+	while(!inVertex) {
+		if(position == frontier.size()) {
+			endLevel(q);
+			return;
+		}
+
+		vertex = frontier[position];
+		edge = graph->getOffset(vertex);
+
+		if(ownsPosition(position)) {
+			MemoryOpRequest* readFrontier = pushRead(q, frontierAddr[currentFrontier] + position * vertexWidth, vertexWidth);
+
+			readStart = pushRead(q, offsetsAddr + vertex * offsetWidth, offsetWidth);
+			readEnd   = pushRead(q, offsetsAddr + (vertex + 1) * offsetWidth, offsetWidth);
+			readStart->addDependency(readFrontier->getRequestID());
+			readEnd->addDependency(readFrontier->getRequestID());
+
+			inVertex = true;
+		} else {
+			// Another thread expands this vertex, keep the search in step
+			visitEdges(NULL, edge + graph->getDegree(vertex), NULL, NULL);
+			position++;
+		}
+	}
+
+	const uint64_t vertexEnd = graph->getOffset(vertex) + graph->getDegree(vertex);
+	visitEdges(q, std::min(edge + edgeChunk, vertexEnd), readStart, readEnd);
+
+	if(edge == vertexEnd) {
+		inVertex = false;
+		position++;
+	}
+}
+
+// Visits the edges of vertex up to endEdge, generating requests when q
+// is set.  The offsets reads are only set for the first chunk of edges.
+void BFSGenerator::visitEdges(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t endEdge,
+	MemoryOpRequest* readStart, MemoryOpRequest* readEnd) {
+
+	for(; edge < endEdge; ++edge) {
+		const uint32_t neighbor = graph->getNeighbor(edge);
+		const bool discovered = (BFS_UNVISITED == parent[neighbor]);
+
+		if(discovered) {
+			parent[neighbor] = vertex;
+		}
+
+		if(NULL != q) {
+			MemoryOpRequest* readEdge = pushRead(q, edgesAddr + edge * vertexWidth, vertexWidth);
+
+			if(NULL != readStart) {
+				readEdge->addDependency(readStart->getRequestID());
+				readEdge->addDependency(readEnd->getRequestID());
+			}
+
+			MemoryOpRequest* readParent = pushRead(q, parentAddr + neighbor * propertyWidth, propertyWidth);
+			readParent->addDependency(readEdge->getRequestID());
+
+			if(discovered) {
+				MemoryOpRequest* writeParent = pushWrite(q, parentAddr + neighbor * propertyWidth, propertyWidth);
+				writeParent->addDependency(readParent->getRequestID());
+
+				MemoryOpRequest* writeFrontier = pushWrite(q,
+					frontierAddr[1 - currentFrontier] + nextFrontier.size() * vertexWidth, vertexWidth);
+				writeFrontier->addDependency(readParent->getRequestID());
+			}
+		}
+
+		if(discovered) {
+			nextFrontier.push_back(neighbor);
+		}
+	}
+}
+
+void BFSGenerator::endLevel(MirandaRequestQueue<GeneratorRequest*>* q) {
+	out->verbose(CALL_INFO, 2, 0, "Level %" PRIu64 " done, next frontier has %" PRIu64 " vertices\n",
+		level, (uint64_t) nextFrontier.size());
+
+	q->push_back(new FenceOpRequest());
+
+	frontier.swap(nextFrontier);
+	nextFrontier.clear();
+	currentFrontier = 1 - currentFrontier;
+	position = 0;
+	level++;
+
+	partition(frontier.size(), [this](const uint64_t i) { return graph->getDegree(frontier[i]); });
+
+	finished = frontier.empty();
+}
+
+bool BFSGenerator::isFinished() {
+	return finished;
+}
+
+void BFSGenerator::completed() {
+	out->verbose(CALL_INFO, 1, 0, "Search completed after %" PRIu64 " levels\n", level);
+}
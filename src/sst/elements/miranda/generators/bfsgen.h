@@ -0,0 +1,80 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_BFS_GEN
+#define _H_SST_MIRANDA_BFS_GEN
+
+#include <sst/elements/miranda/generators/graphgen.h>
+
+namespace SST {
+namespace Miranda {
+
+// Level synchronous, top-down breadth first search.  For each entry of
+// the frontier the thread owns: read the frontier entry, the offsets of
+// the vertex, each edge and the parent of each neighbour; unvisited
+// neighbours get their parent written and are appended to the next
+// frontier.
+class BFSGenerator : public GraphGenerator {
+
+public:
+	BFSGenerator( ComponentId_t id, Params& params );
+	~BFSGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		BFSGenerator,
+		"miranda",
+		"BFSGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the access pattern of a breadth first search over a CSR graph",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		MIRANDA_GRAPH_ELI_PARAMS,
+		{ "source",           "Vertex the search starts from", "0" }
+	)
+
+private:
+	void visitEdges(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t endEdge,
+		MemoryOpRequest* readStart, MemoryOpRequest* readEnd);
+	void endLevel(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	std::vector<uint32_t> parent;
+	std::vector<uint32_t> frontier;
+	std::vector<uint32_t> nextFrontier;
+
+	uint64_t parentAddr;
+	uint64_t frontierAddr[2];
+	uint32_t currentFrontier;
+
+	// Frontier entry being expanded
+	uint64_t position;
+	bool inVertex;
+	uint32_t vertex;
+	uint64_t edge;
+
+	uint64_t level;
+	bool finished;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,317 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/core/rng/marsaglia.h>
+#include <sst/elements/miranda/generators/graphgen.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Miranda;
+
+MirandaCSRGraph::MirandaCSRGraph() :
+	vertexCount(0), edgeCount(0), offsets(NULL), neighbors(NULL),
+	graphFD(-1), mapBase(NULL), mapLength(0) {
+
+	offsetStore.assign(1, 0);
+	offsets = offsetStore.data();
+}
+
+MirandaCSRGraph::~MirandaCSRGraph() {
+	if(NULL != mapBase) {
+		munmap(mapBase, mapLength);
+	}
+
+	if(graphFD >= 0) {
+		close(graphFD);
+	}
+}
+
+bool MirandaCSRGraph::load(const std::string& path, std::string& error) {
+	graphFD = open(path.c_str(), O_RDONLY);
+
+	if(graphFD < 0) {
+		error = "unable to open file";
+		return false;
+	}
+
+	struct stat graphStat;
+	if(0 != fstat(graphFD, &graphStat) || (size_t) graphStat.st_size < 2 * sizeof(uint64_t)) {
+		error = "file is too short for a CSR header";
+		return false;
+	}
+
+	mapLength = (size_t) graphStat.st_size;
+	mapBase = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, graphFD, 0);
+
+	if(MAP_FAILED == mapBase) {
+		mapBase = NULL;
+		error = "unable to memory map file";
+		return false;
+	}
+
+	const uint64_t* header = (const uint64_t*) mapBase;
+	const uint64_t fileVertices = header[0];
+	const uint64_t fileEdges = header[1];
+
+	// Bound the counts first so the expected length cannot overflow
+	if(fileVertices > mapLength / sizeof(uint64_t) || fileEdges > mapLength / sizeof(uint32_t) ||
+		mapLength != (2 + fileVertices + 1) * sizeof(uint64_t) + fileEdges * sizeof(uint32_t)) {
+		error = "file length does not match the vertex and edge counts in its header";
+		return false;
+	}
+
+	if(fileVertices > ((uint64_t) 1) << 32) {
+		error = "vertex count does not fit the 32 bit neighbour IDs";
+		return false;
+	}
+
+	const uint64_t* fileOffsets = header + 2;
+	const uint32_t* fileNeighbors = (const uint32_t*) (fileOffsets + fileVertices + 1);
+
+	if(0 != fileOffsets[0]) {
+		error = "first offset is not zero";
+		return false;
+	}
+
+	for(uint64_t v = 0; v < fileVertices; ++v) {
+		if(fileOffsets[v + 1] < fileOffsets[v]) {
+			error = "offsets of vertex " + std::to_string(v) + " are not monotonic";
+			return false;
+		}
+	}
+
+	if(fileOffsets[fileVertices] != fileEdges) {
+		error = "last offset does not match the edge count";
+		return false;
+	}
+
+	for(uint64_t e = 0; e < fileEdges; ++e) {
+		if(fileNeighbors[e] >= fileVertices) {
+			error = "neighbour " + std::to_string(fileNeighbors[e]) + " of edge " + std::to_string(e) +
+				" is not less than the vertex count";
+			return false;
+		}
+	}
+
+	vertexCount = fileVertices;
+	edgeCount = fileEdges;
+	offsets = fileOffsets;
+	neighbors = fileNeighbors;
+
+	return true;
+}
+
+// Graph 500 R-MAT generator with A = 0.57, B = C = 0.19.  Edges are
+// made undirected, self loops and duplicates are removed.
+void MirandaCSRGraph::generateKronecker(const uint32_t scale, const uint32_t edgeFactor,
+	const uint64_t seedA, const uint64_t seedB) {
+
+	const double probA = 0.57;
+	const double probB = 0.19;
+	const double probC = 0.19;
+
+	SST::RNG::MarsagliaRNG rng(seedA, seedB);
+
+	vertexCount = ((uint64_t) 1) << scale;
+	const uint64_t generated = vertexCount * edgeFactor;
+
+	std::vector<std::pair<uint32_t, uint32_t>> edges;
+	edges.reserve(2 * generated);
+
+	for(uint64_t i = 0; i < generated; ++i) {
+		uint32_t src = 0;
+		uint32_t dst = 0;
+
+		for(uint32_t level = 0; level < scale; ++level) {
+			const double r = rng.nextUniform();
+
+			src <<= 1;
+			dst <<= 1;
+
+			if(r < probA) {
+				// top left quadrant
+			} else if(r < probA + probB) {
+				dst |= 1;
+			} else if(r < probA + probB + probC) {
+				src |= 1;
+			} else {
+				src |= 1;
+				dst |= 1;
+			}
+		}
+
+		if(src != dst) {
+			edges.push_back(std::make_pair(src, dst));
+			edges.push_back(std::make_pair(dst, src));
+		}
+	}
+
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+	edgeCount = edges.size();
+	offsetStore.assign(vertexCount + 1, 0);
+	neighborStore.resize(edgeCount);
+
+	for(uint64_t i = 0; i < edgeCount; ++i) {
+		offsetStore[edges[i].first + 1]++;
+		neighborStore[i] = edges[i].second;
+	}
+
+	for(uint64_t v = 0; v < vertexCount; ++v) {
+		offsetStore[v + 1] += offsetStore[v];
+	}
+
+	offsets = offsetStore.data();
+	neighbors = neighborStore.data();
+}
+
+std::mutex GraphGenerator::graphCacheLock;
+std::map<std::string, std::weak_ptr<const MirandaCSRGraph>> GraphGenerator::graphCache;
+
+GraphGenerator::GraphGenerator( ComponentId_t id, Params& params, const char* name ) :
+	RequestGenerator(id, params) {
+
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output(std::string(name) + "[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	graph = openGraph(params, out);
+
+	out->verbose(CALL_INFO, 1, 0, "Graph has %" PRIu64 " vertices and %" PRIu64 " directed edges\n",
+		graph->getVertexCount(), graph->getEdgeCount());
+
+	threadID    = params.find<uint32_t>("thread_id", 0);
+	threadCount = std::max(params.find<uint32_t>("num_threads", 1), (uint32_t) 1);
+	edgeChunk   = std::max(params.find<uint64_t>("edge_chunk", 64), (uint64_t) 1);
+
+	if(threadID >= threadCount) {
+		out->fatal(CALL_INFO, -1, "thread_id %" PRIu32 " must be less than num_threads %" PRIu32 "\n",
+			threadID, threadCount);
+	}
+
+	const std::string partitionName = params.find<std::string>("partition", "block");
+	if("block" == partitionName) {
+		partitionMode = PARTITION_BLOCK;
+	} else if("cyclic" == partitionName) {
+		partitionMode = PARTITION_CYCLIC;
+	} else if("edge" == partitionName) {
+		partitionMode = PARTITION_EDGE;
+	} else {
+		out->fatal(CALL_INFO, -1, "Unknown partition: %s, use block, cyclic or edge\n", partitionName.c_str());
+	}
+
+	vertexWidth   = params.find<uint64_t>("vertex_width", 4);
+	offsetWidth   = params.find<uint64_t>("offset_width", 8);
+	propertyWidth = params.find<uint64_t>("property_width", 8);
+	nextArrayAddr = params.find<uint64_t>("start_address", 0);
+
+	offsetsAddr = allocateArray(graph->getVertexCount() + 1, offsetWidth);
+	edgesAddr   = allocateArray(graph->getEdgeCount(), vertexWidth);
+
+	partStart = 0;
+	partEnd = 0;
+
+	out->verbose(CALL_INFO, 1, 0, "Thread %" PRIu32 " of %" PRIu32 ", partition %s\n",
+		threadID, threadCount, partitionName.c_str());
+}
+
+GraphGenerator::~GraphGenerator() {
+	{
+		std::lock_guard<std::mutex> guard(graphCacheLock);
+
+		// The last generator using the graph releases it
+		graph.reset();
+	}
+
+	delete out;
+}
+
+std::shared_ptr<const MirandaCSRGraph> GraphGenerator::openGraph(Params& params, Output* out) {
+	const std::string graphFile = params.find<std::string>("graph_file", "");
+	const uint32_t scale = params.find<uint32_t>("scale", 16);
+	const uint32_t edgeFactor = params.find<uint32_t>("edge_factor", 16);
+	const uint64_t seedA = params.find<uint64_t>("seed_a", 11);
+	const uint64_t seedB = params.find<uint64_t>("seed_b", 31);
+
+	const std::string key = ("" != graphFile) ? ("file:" + graphFile) :
+		("kronecker:" + std::to_string(scale) + ":" + std::to_string(edgeFactor) + ":" +
+		std::to_string(seedA) + ":" + std::to_string(seedB));
+
+	// Held while loading so concurrent threads build the graph once
+	std::lock_guard<std::mutex> guard(graphCacheLock);
+
+	std::shared_ptr<const MirandaCSRGraph> shared = graphCache[key].lock();
+
+	if(shared) {
+		out->verbose(CALL_INFO, 1, 0, "Sharing graph %s\n", key.c_str());
+		return shared;
+	}
+
+	std::shared_ptr<MirandaCSRGraph> created = std::make_shared<MirandaCSRGraph>();
+
+	if("" != graphFile) {
+		std::string error;
+
+		if(!created->load(graphFile, error)) {
+			out->fatal(CALL_INFO, -1, "Unable to read CSR graph %s: %s\n", graphFile.c_str(), error.c_str());
+		}
+
+		out->verbose(CALL_INFO, 1, 0, "Mapped CSR graph %s\n", graphFile.c_str());
+	} else {
+		if(scale > 31) {
+			out->fatal(CALL_INFO, -1, "Kronecker scale %" PRIu32 " is too large, vertex IDs are 32 bits\n", scale);
+		}
+
+		created->generateKronecker(scale, edgeFactor, seedA, seedB);
+
+		out->verbose(CALL_INFO, 1, 0, "Generated Kronecker graph, scale %" PRIu32 ", edge factor %" PRIu32 "\n",
+			scale, edgeFactor);
+	}
+
+	graphCache[key] = created;
+	return created;
+}
+
+// Arrays start on a 64 byte boundary
+uint64_t GraphGenerator::allocateArray(const uint64_t count, const uint64_t width) {
+	const uint64_t addr = nextArrayAddr;
+
+	nextArrayAddr += count * width;
+	nextArrayAddr = (nextArrayAddr + 63) & ~((uint64_t) 63);
+
+	return addr;
+}
+
+MemoryOpRequest* GraphGenerator::pushRead(MirandaRequestQueue<GeneratorRequest*>* q,
+	const uint64_t addr, const uint64_t width) {
+
+	MemoryOpRequest* req = new MemoryOpRequest(addr, width, READ);
+	q->push_back(req);
+	return req;
+}
+
+MemoryOpRequest* GraphGenerator::pushWrite(MirandaRequestQueue<GeneratorRequest*>* q,
+	const uint64_t addr, const uint64_t width) {
+
+	MemoryOpRequest* req = new MemoryOpRequest(addr, width, WRITE);
+	q->push_back(req);
+	return req;
+}
@@ -0,0 +1,222 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_GRAPH_GEN
+#define _H_SST_MIRANDA_GRAPH_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+// Graph in compressed sparse row form.  Either read from a file, which
+// is memory mapped, or an undirected Kronecker (Graph 500 R-MAT) graph
+// generated in memory.
+//
+// CSR file layout: uint64 vertex count V, uint64 edge count E, V + 1
+// uint64 offsets, E uint32 neighbour IDs.
+class MirandaCSRGraph {
+public:
+	MirandaCSRGraph();
+	~MirandaCSRGraph();
+
+	// Return false and set error on failure, including offsets that
+	// are not monotonic and neighbour IDs out of range
+	bool load(const std::string& path, std::string& error);
+	void generateKronecker(const uint32_t scale, const uint32_t edgeFactor,
+		const uint64_t seedA, const uint64_t seedB);
+
+	uint64_t getVertexCount() const { return vertexCount; }
+	uint64_t getEdgeCount() const { return edgeCount; }
+	uint64_t getOffset(const uint64_t vertex) const { return offsets[vertex]; }
+	uint64_t getDegree(const uint64_t vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+	uint32_t getNeighbor(const uint64_t edge) const { return neighbors[edge]; }
+
+private:
+	uint64_t vertexCount;
+	uint64_t edgeCount;
+	const uint64_t* offsets;
+	const uint32_t* neighbors;
+
+	// Generated graph
+	std::vector<uint64_t> offsetStore;
+	std::vector<uint32_t> neighborStore;
+
+	// Mapped graph
+	int graphFD;
+	void* mapBase;
+	size_t mapLength;
+};
+
+#define MIRANDA_GRAPH_ELI_PARAMS \
+	{ "verbose",          "Sets the verbosity output of the generator", "0" }, \
+	{ "graph_file",       "CSR graph to read, if empty a Kronecker graph is generated", "" }, \
+	{ "scale",            "Kronecker graph has 2^scale vertices", "16" }, \
+	{ "edge_factor",      "Kronecker graph has edge_factor * 2^scale undirected edges before duplicates are removed", "16" }, \
+	{ "seed_a",           "Sets the seed-a for the Kronecker graph", "11" }, \
+	{ "seed_b",           "Sets the seed-b for the Kronecker graph", "31" }, \
+	{ "thread_id",        "Thread this generator models, 0 to num_threads - 1", "0" }, \
+	{ "num_threads",      "Number of threads the work is divided between, one generator per thread", "1" }, \
+	{ "partition",        "Division of vertices (or frontier entries) between threads: block, cyclic or edge (blocks of equal edge count)", "block" }, \
+	{ "edge_chunk",       "Maximum number of edges of a vertex generated at a time", "64" }, \
+	{ "start_address",    "Address of the first array, the arrays follow each other", "0" }, \
+	{ "vertex_width",     "Width of a vertex ID in the edge and frontier arrays", "4" }, \
+	{ "offset_width",     "Width of an entry of the offsets array", "8" }, \
+	{ "property_width",   "Width of an entry of the per-vertex property arrays", "8" }
+
+// Common part of the graph kernel generators.  Every generator models
+// one thread: it runs the whole kernel functionally, so all threads
+// agree on frontiers and array positions, but only generates the
+// requests for the vertices it owns.  Threads are not synchronized
+// with each other; a fence ends each level or iteration.
+class GraphGenerator : public RequestGenerator {
+
+public:
+	GraphGenerator( ComponentId_t id, Params& params, const char* name );
+	~GraphGenerator();
+
+protected:
+	typedef enum {
+		PARTITION_BLOCK,
+		PARTITION_CYCLIC,
+		PARTITION_EDGE
+	} PartitionMode;
+
+	// Returns the address of a new array of count entries
+	uint64_t allocateArray(const uint64_t count, const uint64_t width);
+
+	// Divides the items 0 to count - 1 of a list between the threads,
+	// getDegree(i) gives the number of edges of item i
+	template<typename DegreeFunc>
+	void partition(const uint64_t count, const DegreeFunc& getDegree);
+	bool ownsPosition(const uint64_t position) const;
+	// First owned position at or after position, count if none
+	uint64_t nextOwnedPosition(const uint64_t position, const uint64_t count) const;
+
+	MemoryOpRequest* pushRead(MirandaRequestQueue<GeneratorRequest*>* q,
+		const uint64_t addr, const uint64_t width);
+	MemoryOpRequest* pushWrite(MirandaRequestQueue<GeneratorRequest*>* q,
+		const uint64_t addr, const uint64_t width);
+
+	Output* out;
+	std::shared_ptr<const MirandaCSRGraph> graph;
+
+	uint32_t threadID;
+	uint32_t threadCount;
+	PartitionMode partitionMode;
+	uint64_t edgeChunk;
+
+	uint64_t vertexWidth;
+	uint64_t offsetWidth;
+	uint64_t propertyWidth;
+	uint64_t offsetsAddr;
+	uint64_t edgesAddr;
+
+	// Positions owned in the current partition
+	uint64_t partStart;
+	uint64_t partEnd;
+
+private:
+	// The graph is read only, so the generators of all threads share
+	// one instance keyed by the parameters that define it
+	static std::shared_ptr<const MirandaCSRGraph> openGraph(Params& params, Output* out);
+
+	static std::mutex graphCacheLock;
+	static std::map<std::string, std::weak_ptr<const MirandaCSRGraph>> graphCache;
+
+	uint64_t nextArrayAddr;
+
+};
+
+template<typename DegreeFunc>
+void GraphGenerator::partition(const uint64_t count, const DegreeFunc& getDegree) {
+	switch(partitionMode) {
+	case PARTITION_CYCLIC:
+		partStart = 0;
+		partEnd = count;
+		break;
+
+	case PARTITION_EDGE:
+		{
+			uint64_t totalEdges = 0;
+			for(uint64_t i = 0; i < count; ++i) {
+				totalEdges += getDegree(i);
+			}
+
+			// Thread t owns the items in which edge t * total / threads
+			// up to (t + 1) * total / threads start
+			const uint64_t firstEdge = (totalEdges * threadID) / threadCount;
+			const uint64_t endEdge = (totalEdges * (threadID + 1)) / threadCount;
+
+			partStart = count;
+			partEnd = count;
+
+			uint64_t edge = 0;
+			for(uint64_t i = 0; i < count; ++i) {
+				if(edge >= firstEdge && partStart == count) {
+					partStart = i;
+				}
+				if(edge >= endEdge && (threadID + 1) < threadCount) {
+					partEnd = i;
+					break;
+				}
+				edge += getDegree(i);
+			}
+
+			partEnd = std::max(partStart, partEnd);
+		}
+		break;
+
+	default:
+		partStart = (count * threadID) / threadCount;
+		partEnd = (count * (threadID + 1)) / threadCount;
+		break;
+	}
+}
+
+inline bool GraphGenerator::ownsPosition(const uint64_t position) const {
+	if(PARTITION_CYCLIC == partitionMode) {
+		return (position % threadCount) == threadID;
+	}
+
+	return position >= partStart && position < partEnd;
+}
+
+inline uint64_t GraphGenerator::nextOwnedPosition(const uint64_t position, const uint64_t count) const {
+	if(PARTITION_CYCLIC == partitionMode) {
+		const uint64_t next = position + (threadCount + threadID - (position % threadCount)) % threadCount;
+		return std::min(next, count);
+	}
+
+	if(position >= partEnd) {
+		return count;
+	}
+
+	return std::max(position, partStart);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,144 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/pagerankgen.h>
+
+using namespace SST::Miranda;
+
+PageRankGenerator::PageRankGenerator( ComponentId_t id, Params& params ) :
+	GraphGenerator(id, params, "PageRankGenerator") {
+
+	const uint64_t vertexCount = graph->getVertexCount();
+
+	iterations  = params.find<uint64_t>("iterations", 10);
+	rankAddr    = allocateArray(vertexCount, propertyWidth);
+	contribAddr = allocateArray(vertexCount, propertyWidth);
+
+	gathering = false;
+	position = 0;
+	inVertex = false;
+	edge = 0;
+	iteration = 0;
+
+	partition(vertexCount, [this](const uint64_t v) { return graph->getDegree(v); });
+	position = nextOwnedPosition(0, vertexCount);
+
+	out->verbose(CALL_INFO, 1, 0, "Will perform %" PRIu64 " iterations\n", iterations);
+}
+
+PageRankGenerator::~PageRankGenerator() {
+}
+
+void PageRankGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	const uint64_t vertexCount = graph->getVertexCount();
+
+	if(position == vertexCount) {
+		endPhase(q);
+		return;
+	}
+
+	if(!gathering) {
+		// contrib[v] = rank[v] / degree(v)
+		MemoryOpRequest* readRank  = pushRead(q, rankAddr + position * propertyWidth, propertyWidth);
+		MemoryOpRequest* readStart = pushRead(q, offsetsAddr + position * offsetWidth, offsetWidth);
+		MemoryOpRequest* readEnd   = pushRead(q, offsetsAddr + (position + 1) * offsetWidth, offsetWidth);
+		MemoryOpRequest* writeContrib = pushWrite(q, contribAddr + position * propertyWidth, propertyWidth);
+
+		writeContrib->addDependency(readRank->getRequestID());
+		writeContrib->addDependency(readStart->getRequestID());
+		writeContrib->addDependency(readEnd->getRequestID());
+
+		position = nextOwnedPosition(position + 1, vertexCount);
+		return;
+	}
+
+	// rank[v] = base + damping * sum of contrib[u] over the neighbours
+	MemoryOpRequest* readStart = NULL;
+	MemoryOpRequest* readEnd = NULL;
+
+	if(!inVertex) {
+		readStart = pushRead(q, offsetsAddr + position * offsetWidth, offsetWidth);
+		readEnd   = pushRead(q, offsetsAddr + (position + 1) * offsetWidth, offsetWidth);
+		edge = graph->getOffset(position);
+		inVertex = true;
+	}
+
+	const uint64_t vertexEnd = graph->getOffset(position) + graph->getDegree(position);
+	const uint64_t chunkEnd = std::min(edge + edgeChunk, vertexEnd);
+	const bool lastChunk = (chunkEnd == vertexEnd);
+
+	chunkReads.clear();
+
+	for(; edge < chunkEnd; ++edge) {
+		const uint32_t neighbor = graph->getNeighbor(edge);
+
+		MemoryOpRequest* readEdge = pushRead(q, edgesAddr + edge * vertexWidth, vertexWidth);
+
+		if(NULL != readStart) {
+			readEdge->addDependency(readStart->getRequestID());
+			readEdge->addDependency(readEnd->getRequestID());
+		}
+
+		MemoryOpRequest* readContrib = pushRead(q, contribAddr + neighbor * propertyWidth, propertyWidth);
+		readContrib->addDependency(readEdge->getRequestID());
+
+		if(lastChunk) {
+			chunkReads.push_back(readContrib->getRequestID());
+		}
+	}
+
+	if(lastChunk) {
+		// The sum waits for the contributions read in this call, those
+		// of earlier chunks have been folded in already
+		MemoryOpRequest* writeRank = pushWrite(q, rankAddr + position * propertyWidth, propertyWidth);
+
+		for(const uint64_t reqID : chunkReads) {
+			writeRank->addDependency(reqID);
+		}
+
+		if(NULL != readStart) {
+			writeRank->addDependency(readStart->getRequestID());
+			writeRank->addDependency(readEnd->getRequestID());
+		}
+
+		inVertex = false;
+		position = nextOwnedPosition(position + 1, vertexCount);
+	}
+}
+
+void PageRankGenerator::endPhase(MirandaRequestQueue<GeneratorRequest*>* q) {
+	const uint64_t vertexCount = graph->getVertexCount();
+
+	q->push_back(new FenceOpRequest());
+
+	if(gathering) {
+		out->verbose(CALL_INFO, 2, 0, "Iteration %" PRIu64 " done\n", iteration);
+		iteration++;
+	}
+
+	gathering = !gathering;
+	position = nextOwnedPosition(0, vertexCount);
+}
+
+bool PageRankGenerator::isFinished() {
+	return iteration == iterations;
+}
+
+void PageRankGenerator::completed() {
+	out->verbose(CALL_INFO, 1, 0, "PageRank completed %" PRIu64 " iterations\n", iteration);
+}
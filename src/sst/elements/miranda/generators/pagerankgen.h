@@ -0,0 +1,75 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_PAGERANK_GEN
+#define _H_SST_MIRANDA_PAGERANK_GEN
+
+#include <sst/elements/miranda/generators/graphgen.h>
+
+namespace SST {
+namespace Miranda {
+
+// Pull based PageRank.  Each iteration has two phases over the vertices
+// the thread owns: the contribution of each vertex is computed from its
+// rank and degree, then each vertex sums the contributions of its
+// neighbours into its new rank.  The graph is taken to be undirected
+// (as the generated Kronecker graphs are), so the CSR neighbours are
+// also the in-neighbours.
+class PageRankGenerator : public GraphGenerator {
+
+public:
+	PageRankGenerator( ComponentId_t id, Params& params );
+	~PageRankGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		PageRankGenerator,
+		"miranda",
+		"PageRankGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the access pattern of pull based PageRank over a CSR graph",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		MIRANDA_GRAPH_ELI_PARAMS,
+		{ "iterations",       "Number of PageRank iterations", "10" }
+	)
+
+private:
+	void endPhase(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	uint64_t rankAddr;
+	uint64_t contribAddr;
+
+	// Vertex being gathered
+	bool gathering;
+	uint64_t position;
+	bool inVertex;
+	uint64_t edge;
+	std::vector<uint64_t> chunkReads;
+
+	uint64_t iteration;
+	uint64_t iterations;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,195 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/ssspgen.h>
+
+using namespace SST::Miranda;
+
+#define SSSP_INFINITY UINT64_MAX
+
+SSSPGenerator::SSSPGenerator( ComponentId_t id, Params& params ) :
+	GraphGenerator(id, params, "SSSPGenerator") {
+
+	const uint64_t vertexCount = graph->getVertexCount();
+	const uint32_t source = params.find<uint32_t>("source", 0);
+
+	if(source >= vertexCount) {
+		out->fatal(CALL_INFO, -1, "Source vertex %" PRIu32 " is not in the graph (%" PRIu64 " vertices)\n",
+			source, vertexCount);
+	}
+
+	maxWeight   = std::max(params.find<uint64_t>("max_weight", 255), (uint64_t) 1);
+	weightWidth = params.find<uint64_t>("weight_width", 4);
+
+	weightsAddr     = allocateArray(graph->getEdgeCount(), weightWidth);
+	distanceAddr    = allocateArray(vertexCount, propertyWidth);
+	frontierAddr[0] = allocateArray(vertexCount, vertexWidth);
+	frontierAddr[1] = allocateArray(vertexCount, vertexWidth);
+	currentFrontier = 0;
+
+	distance.assign(vertexCount, SSSP_INFINITY);
+	distance[source] = 0;
+	inNextFrontier.assign(vertexCount, false);
+	frontier.push_back(source);
+	nextFrontier.reserve(vertexCount);
+
+	position = 0;
+	inVertex = false;
+	vertex = 0;
+	edge = 0;
+	round = 0;
+	finished = false;
+
+	partition(frontier.size(), [this](const uint64_t i) { return graph->getDegree(frontier[i]); });
+
+	out->verbose(CALL_INFO, 1, 0, "Paths start from vertex %" PRIu32 "\n", source);
+}
+
+SSSPGenerator::~SSSPGenerator() {
+}
+
+// Same weight for an edge in every thread and every run
+uint64_t SSSPGenerator::getWeight(const uint64_t edgeIndex) const {
+	uint64_t hash = edgeIndex * 0x9E3779B97F4A7C15ULL;
+	hash ^= hash >> 29;
+
+	return 1 + (hash % maxWeight);
+}
+
+void SSSPGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	MemoryOpRequest* readStart = NULL;
+	MemoryOpRequest* readEnd = NULL;
+	MemoryOpRequest* readDistance = NULL;
+
+	while(!inVertex) {
+		if(position == frontier.size()) {
+			endRound(q);
+			return;
+		}
+
+		vertex = frontier[position];
+		edge = graph->getOffset(vertex);
+
+		if(ownsPosition(position)) {
+			MemoryOpRequest* readFrontier = pushRead(q, frontierAddr[currentFrontier] + position * vertexWidth, vertexWidth);
+
+			readDistance = pushRead(q, distanceAddr + vertex * propertyWidth, propertyWidth);
+			readStart    = pushRead(q, offsetsAddr + vertex * offsetWidth, offsetWidth);
+			readEnd      = pushRead(q, offsetsAddr + (vertex + 1) * offsetWidth, offsetWidth);
+			readDistance->addDependency(readFrontier->getRequestID());
+			readStart->addDependency(readFrontier->getRequestID());
+			readEnd->addDependency(readFrontier->getRequestID());
+
+			inVertex = true;
+		} else {
+			// Another thread relaxes this vertex, keep the distances in step
+			relaxEdges(NULL, edge + graph->getDegree(vertex), NULL, NULL, NULL);
+			position++;
+		}
+	}
+
+	const uint64_t vertexEnd = graph->getOffset(vertex) + graph->getDegree(vertex);
+	relaxEdges(q, std::min(edge + edgeChunk, vertexEnd), readStart, readEnd, readDistance);
+
+	if(edge == vertexEnd) {
+		inVertex = false;
+		position++;
+	}
+}
+
+// Relaxes the edges of vertex up to endEdge, generating requests when
+// q is set.  The vertex reads are only set for the first chunk.
+void SSSPGenerator::relaxEdges(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t endEdge,
+	MemoryOpRequest* readStart, MemoryOpRequest* readEnd, MemoryOpRequest* readDistance) {
+
+	for(; edge < endEdge; ++edge) {
+		const uint32_t neighbor = graph->getNeighbor(edge);
+		const uint64_t newDistance = distance[vertex] + getWeight(edge);
+		const bool shorter = newDistance < distance[neighbor];
+		const bool appended = shorter && !inNextFrontier[neighbor];
+
+		if(shorter) {
+			distance[neighbor] = newDistance;
+		}
+
+		if(NULL != q) {
+			MemoryOpRequest* readEdge = pushRead(q, edgesAddr + edge * vertexWidth, vertexWidth);
+			MemoryOpRequest* readWeight = pushRead(q, weightsAddr + edge * weightWidth, weightWidth);
+
+			if(NULL != readStart) {
+				readEdge->addDependency(readStart->getRequestID());
+				readEdge->addDependency(readEnd->getRequestID());
+				readWeight->addDependency(readStart->getRequestID());
+				readWeight->addDependency(readEnd->getRequestID());
+			}
+
+			MemoryOpRequest* readNeighbor = pushRead(q, distanceAddr + neighbor * propertyWidth, propertyWidth);
+			readNeighbor->addDependency(readEdge->getRequestID());
+
+			if(shorter) {
+				MemoryOpRequest* writeDistance = pushWrite(q, distanceAddr + neighbor * propertyWidth, propertyWidth);
+				writeDistance->addDependency(readNeighbor->getRequestID());
+				writeDistance->addDependency(readWeight->getRequestID());
+
+				if(NULL != readDistance) {
+					writeDistance->addDependency(readDistance->getRequestID());
+				}
+
+				if(appended) {
+					MemoryOpRequest* writeFrontier = pushWrite(q,
+						frontierAddr[1 - currentFrontier] + nextFrontier.size() * vertexWidth, vertexWidth);
+					writeFrontier->addDependency(readNeighbor->getRequestID());
+				}
+			}
+		}
+
+		if(appended) {
+			inNextFrontier[neighbor] = true;
+			nextFrontier.push_back(neighbor);
+		}
+	}
+}
+
+void SSSPGenerator::endRound(MirandaRequestQueue<GeneratorRequest*>* q) {
+	out->verbose(CALL_INFO, 2, 0, "Round %" PRIu64 " done, next frontier has %" PRIu64 " vertices\n",
+		round, (uint64_t) nextFrontier.size());
+
+	q->push_back(new FenceOpRequest());
+
+	for(const uint32_t v : nextFrontier) {
+		inNextFrontier[v] = false;
+	}
+
+	frontier.swap(nextFrontier);
+	nextFrontier.clear();
+	currentFrontier = 1 - currentFrontier;
+	position = 0;
+	round++;
+
+	partition(frontier.size(), [this](const uint64_t i) { return graph->getDegree(frontier[i]); });
+
+	finished = frontier.empty();
+}
+
+bool SSSPGenerator::isFinished() {
+	return finished;
+}
+
+void SSSPGenerator::completed() {
+	out->verbose(CALL_INFO, 1, 0, "Paths completed after %" PRIu64 " rounds\n", round);
+}
@@ -0,0 +1,88 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_SSSP_GEN
+#define _H_SST_MIRANDA_SSSP_GEN
+
+#include <sst/elements/miranda/generators/graphgen.h>
+
+namespace SST {
+namespace Miranda {
+
+// Frontier based Bellman-Ford single source shortest paths.  For each
+// entry of the frontier the thread owns: read the frontier entry, the
+// distance and offsets of the vertex, then each edge, its weight and
+// the distance of the neighbour; shorter distances are written and the
+// neighbour is appended to the next frontier unless it is already in
+// it.  Edge weights are derived from the edge index.
+class SSSPGenerator : public GraphGenerator {
+
+public:
+	SSSPGenerator( ComponentId_t id, Params& params );
+	~SSSPGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		SSSPGenerator,
+		"miranda",
+		"SSSPGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the access pattern of single source shortest paths over a CSR graph",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		MIRANDA_GRAPH_ELI_PARAMS,
+		{ "source",           "Vertex the paths start from", "0" },
+		{ "max_weight",       "Edge weights are between 1 and max_weight", "255" },
+		{ "weight_width",     "Width of an entry of the edge weight array", "4" }
+	)
+
+private:
+	uint64_t getWeight(const uint64_t edgeIndex) const;
+	void relaxEdges(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t endEdge,
+		MemoryOpRequest* readStart, MemoryOpRequest* readEnd, MemoryOpRequest* readDistance);
+	void endRound(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	std::vector<uint64_t> distance;
+	std::vector<bool> inNextFrontier;
+	std::vector<uint32_t> frontier;
+	std::vector<uint32_t> nextFrontier;
+
+	uint64_t maxWeight;
+	uint64_t weightWidth;
+	uint64_t weightsAddr;
+	uint64_t distanceAddr;
+	uint64_t frontierAddr[2];
+	uint32_t currentFrontier;
+
+	// Frontier entry being relaxed
+	uint64_t position;
+	bool inVertex;
+	uint32_t vertex;
+	uint64_t edge;
+
+	uint64_t round;
+	bool finished;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,315 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/tracereplaygen.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Miranda;
+
+// cycles (8 bytes), type ('R' or 'W'), address (8 bytes), length (4 bytes)
+#define MIRANDA_TRACE_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+TraceReplayGenerator::TraceReplayGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+	build(params);
+}
+
+void TraceReplayGenerator::build(Params &params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+
+	out = new Output("TraceReplayGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string traceFile = params.find<std::string>("trace_file", "");
+	std::string traceFormat = params.find<std::string>("trace_format", "auto");
+	const uint64_t startRecord = params.find<uint64_t>("start_record", 0);
+
+	recordsLeft   = params.find<uint64_t>("max_records", 0);
+	limitRecords  = recordsLeft > 0;
+	traceEnded    = false;
+	batchRecords  = std::max(params.find<uint32_t>("batch_records", 32), (uint32_t) 1);
+	lineSize      = std::max(params.find<uint64_t>("line_size", 64), (uint64_t) 1);
+	prefetchRecords = std::max(params.find<uint64_t>("prefetch_records", 65536), (uint64_t) 1);
+
+	const std::string dependencies = params.find<std::string>("dependencies", "none");
+	if("none" == dependencies) {
+		depMode = DEPEND_NONE;
+	} else if("memory" == dependencies) {
+		depMode = DEPEND_MEMORY;
+	} else if("chain" == dependencies) {
+		depMode = DEPEND_CHAIN;
+	} else {
+		out->fatal(CALL_INFO, -1, "Unknown dependencies mode: %s, use none, memory or chain\n", dependencies.c_str());
+	}
+
+	traceFD = -1;
+	mapBase = NULL;
+	mapLength = 0;
+	recordCount = 0;
+	nextRecordIndex = 0;
+	advisedRecord = 0;
+	recordsReplayed = 0;
+	dependenciesInferred = 0;
+	haveLastLoad = false;
+
+	batch.reserve(batchRecords);
+
+	if("auto" == traceFormat) {
+		FILE* probe = fopen(traceFile.c_str(), "rb");
+
+		if(NULL == probe) {
+			out->fatal(CALL_INFO, -1, "Unable to open trace file: %s\n", traceFile.c_str());
+		}
+
+		char magic[8];
+		const bool isChunked = (1 == fread(magic, sizeof(magic), 1, probe)) && (0 == memcmp(magic, "SSTCTRC1", sizeof(magic)));
+		fclose(probe);
+
+		traceFormat = isChunked ? "chunked" : "binary";
+	}
+
+#ifdef HAVE_LIBZ
+	chunked = NULL;
+	chunkRecords = NULL;
+	chunkAvailable = 0;
+
+	if("chunked" == traceFormat) {
+		const uint32_t stream = params.find<uint32_t>("stream", 0);
+		std::string error;
+
+		chunked = new SST::Prospero::ChunkedTraceReader();
+
+		if(!chunked->open(traceFile, error)) {
+			out->fatal(CALL_INFO, -1, "Unable to open chunked trace %s: %s\n", traceFile.c_str(), error.c_str());
+		}
+
+		chunked->selectStream(stream);
+		chunked->seekToRecord(startRecord);
+
+		out->verbose(CALL_INFO, 1, 0, "Replaying stream %" PRIu32 " of chunked trace %s, %" PRIu64 " records\n",
+			stream, traceFile.c_str(), chunked->getRecordCount());
+	} else
+#endif
+	if("binary" == traceFormat) {
+		mapTrace(traceFile);
+		nextRecordIndex = std::min(startRecord, recordCount);
+		advisedRecord = nextRecordIndex;
+	} else {
+		out->fatal(CALL_INFO, -1, "Trace format %s is not supported, use binary or chunked (chunked requires zlib)\n",
+			traceFormat.c_str());
+	}
+
+	out->verbose(CALL_INFO, 1, 0, "Starting at record: %" PRIu64 "\n", startRecord);
+	out->verbose(CALL_INFO, 1, 0, "Batch size: %" PRIu32 " records\n", batchRecords);
+	out->verbose(CALL_INFO, 1, 0, "Dependencies: %s\n", dependencies.c_str());
+}
+
+TraceReplayGenerator::~TraceReplayGenerator() {
+#ifdef HAVE_LIBZ
+	delete chunked;
+#endif
+
+	if(NULL != mapBase) {
+		munmap((void*) mapBase, mapLength);
+	}
+
+	if(traceFD >= 0) {
+		close(traceFD);
+	}
+
+	delete out;
+}
+
+void TraceReplayGenerator::mapTrace(const std::string& traceFile) {
+	traceFD = open(traceFile.c_str(), O_RDONLY);
+
+	if(traceFD < 0) {
+		out->fatal(CALL_INFO, -1, "Unable to open trace file: %s\n", traceFile.c_str());
+	}
+
+	struct stat traceStat;
+	if(0 != fstat(traceFD, &traceStat)) {
+		out->fatal(CALL_INFO, -1, "Unable to stat trace file: %s\n", traceFile.c_str());
+	}
+
+	mapLength = (size_t) traceStat.st_size;
+	recordCount = mapLength / MIRANDA_TRACE_RECORD_LENGTH;
+
+	if(0 == mapLength) {
+		return;
+	}
+
+	void* mapping = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, traceFD, 0);
+
+	if(MAP_FAILED == mapping) {
+		out->fatal(CALL_INFO, -1, "Unable to memory map trace file: %s\n", traceFile.c_str());
+	}
+
+	mapBase = (const char*) mapping;
+	madvise(mapping, mapLength, MADV_SEQUENTIAL);
+
+	out->verbose(CALL_INFO, 1, 0, "Mapped binary trace %s, %" PRIu64 " records\n", traceFile.c_str(), recordCount);
+}
+
+// Returns the next record of the trace, NULL at the end
+const char* TraceReplayGenerator::nextRecord() {
+	if(limitRecords && 0 == recordsLeft) {
+		return NULL;
+	}
+
+	const char* record = NULL;
+
+#ifdef HAVE_LIBZ
+	if(NULL != chunked) {
+		if(0 == chunkAvailable) {
+			chunkRecords = chunked->readRecords(batchRecords * 64, chunkAvailable);
+		}
+
+		if(0 == chunkAvailable) {
+			return NULL;
+		}
+
+		record = chunkRecords;
+		chunkRecords += MIRANDA_TRACE_RECORD_LENGTH;
+		chunkAvailable--;
+	} else
+#endif
+	{
+		if(nextRecordIndex == recordCount) {
+			return NULL;
+		}
+
+		// Keep the OS reading ahead of the replay
+		if(nextRecordIndex + prefetchRecords > advisedRecord && advisedRecord < recordCount) {
+			const long pageSize = sysconf(_SC_PAGESIZE);
+			const uint64_t adviseEnd = std::min(std::max(advisedRecord, nextRecordIndex) + 2 * prefetchRecords, recordCount);
+			const size_t startOffset = std::max(advisedRecord, nextRecordIndex) * MIRANDA_TRACE_RECORD_LENGTH;
+			const size_t alignedStart = startOffset - (startOffset % pageSize);
+
+			madvise((void*) (mapBase + alignedStart), adviseEnd * MIRANDA_TRACE_RECORD_LENGTH - alignedStart, MADV_WILLNEED);
+			advisedRecord = adviseEnd;
+		}
+
+		record = mapBase + nextRecordIndex * MIRANDA_TRACE_RECORD_LENGTH;
+		nextRecordIndex++;
+	}
+
+	if(limitRecords) {
+		recordsLeft--;
+	}
+
+	return record;
+}
+
+void TraceReplayGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	batch.clear();
+	haveLastLoad = false;
+
+	for(uint32_t i = 0; i < batchRecords; ++i) {
+		const char* record = nextRecord();
+
+		if(NULL == record) {
+			out->verbose(CALL_INFO, 1, 0, "End of trace reached after %" PRIu64 " records\n", recordsReplayed);
+			traceEnded = true;
+			break;
+		}
+
+		char reqType = 'R';
+		uint64_t reqAddress = 0;
+		uint32_t reqLength = 0;
+
+		memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+		memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+		const ReqOperation op = (reqType == 'R' || reqType == 'r') ? READ : WRITE;
+
+		out->verbose(CALL_INFO, 8, 0, "Record %" PRIu64 ": %s at %" PRIu64 ", %" PRIu32 " bytes\n",
+			recordsReplayed, (READ == op) ? "READ" : "WRITE", reqAddress, reqLength);
+
+		MemoryOpRequest* req = new MemoryOpRequest(reqAddress, std::max(reqLength, (uint32_t) 1), op);
+
+		if(DEPEND_NONE != depMode) {
+			inferDependencies(req);
+		}
+
+		q->push_back(req);
+		recordsReplayed++;
+	}
+}
+
+// Stores wait for every earlier access to their line in the batch back
+// to the last store, loads wait for the last store to their line.  In
+// chain mode a load which jumps away from the previous load, off its
+// stride, is taken to use the value that load returned as an address.
+void TraceReplayGenerator::inferDependencies(MemoryOpRequest* req) {
+	const uint64_t line = req->getAddress() / lineSize;
+
+	for(size_t i = batch.size(); i > 0; --i) {
+		const BatchEntry& earlier = batch[i - 1];
+
+		if(line != earlier.line) {
+			continue;
+		}
+
+		if(req->isWrite() || earlier.isWrite) {
+			req->addDependency(earlier.reqID);
+			dependenciesInferred++;
+		}
+
+		if(earlier.isWrite) {
+			break;
+		}
+	}
+
+	if(DEPEND_CHAIN == depMode && req->isRead()) {
+		const int64_t stride = (int64_t) (req->getAddress() - lastLoadAddress);
+		const uint64_t lastLine = lastLoadAddress / lineSize;
+		const bool nearLastLoad = (line + 1 >= lastLine) && (line <= lastLine + 1);
+
+		if(haveLastLoad && !nearLastLoad && stride != lastLoadStride) {
+			req->addDependency(lastLoadID);
+			dependenciesInferred++;
+		}
+
+		lastLoadStride = haveLastLoad ? stride : 0;
+		lastLoadAddress = req->getAddress();
+		lastLoadID = req->getRequestID();
+		haveLastLoad = true;
+	}
+
+	BatchEntry entry;
+	entry.line = line;
+	entry.reqID = req->getRequestID();
+	entry.isWrite = req->isWrite();
+	batch.push_back(entry);
+}
+
+bool TraceReplayGenerator::isFinished() {
+	return traceEnded || (limitRecords && 0 == recordsLeft);
+}
+
+void TraceReplayGenerator::completed() {
+	out->verbose(CALL_INFO, 1, 0, "Replayed %" PRIu64 " records, %" PRIu64 " dependencies inferred\n",
+		recordsReplayed, dependenciesInferred);
+}
@@ -0,0 +1,132 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_TRACE_REPLAY_GEN
+#define _H_SST_MIRANDA_TRACE_REPLAY_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include "sst/elements/prospero/prostraceformat.h"
+#endif
+
+namespace SST {
+namespace Miranda {
+
+// Replays a binary address trace through the Miranda issue window.
+// Reads the binary traces of Prospero and ariel.BinaryTraceGenerator
+// (memory mapped) and, when built with zlib, the chunked traces of
+// ariel.ChunkedTraceGenerator.  Cycle stamps in the trace are ignored,
+// requests issue as fast as the window and dependencies allow.
+//
+// Traces hold no register dependencies, so ordering is optionally
+// inferred from the addresses.  Dependencies are only placed between
+// requests produced by the same call to generate(): the CPU satisfies
+// a dependency when the request it names completes, which it can only
+// do for requests that are still waiting in the window.
+class TraceReplayGenerator : public RequestGenerator {
+
+public:
+	TraceReplayGenerator( ComponentId_t id, Params& params );
+	void build(Params &params);
+	~TraceReplayGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		TraceReplayGenerator,
+		"miranda",
+		"TraceReplayGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Replays a Prospero/Ariel binary or chunked address trace",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "trace_file",       "Trace to replay", "" },
+		{ "trace_format",     "Format of the trace, binary, chunked or auto to detect it from the file", "auto" },
+		{ "stream",           "Stream (core) of a chunked trace to replay", "0" },
+		{ "start_record",     "Record of the trace to start the replay at", "0" },
+		{ "max_records",      "Number of records to replay, 0 replays to the end of the trace", "0" },
+		{ "batch_records",    "Number of records generated at a time, the window within which dependencies are inferred", "32" },
+		{ "dependencies",     "Ordering inferred between requests: none, memory (accesses to the same line are ordered when one is a store) or chain (memory, and a load which jumps away from the previous load, off its stride, depends on it, as in pointer chasing)", "none" },
+		{ "line_size",        "Line size used to match addresses when inferring dependencies", "64" },
+		{ "prefetch_records", "Number of records of a binary trace the OS is asked to read ahead", "65536" }
+	)
+
+private:
+	typedef enum {
+		DEPEND_NONE,
+		DEPEND_MEMORY,
+		DEPEND_CHAIN
+	} DependencyMode;
+
+	struct BatchEntry {
+		uint64_t line;
+		uint64_t reqID;
+		bool isWrite;
+	};
+
+	void mapTrace(const std::string& traceFile);
+	const char* nextRecord();
+	void inferDependencies(MemoryOpRequest* req);
+
+	Output* out;
+
+	uint64_t recordsLeft;
+	bool limitRecords;
+	bool traceEnded;
+	uint32_t batchRecords;
+	DependencyMode depMode;
+	uint64_t lineSize;
+
+	// Binary trace
+	int traceFD;
+	const char* mapBase;
+	size_t mapLength;
+	uint64_t recordCount;
+	uint64_t nextRecordIndex;
+	uint64_t advisedRecord;
+	uint64_t prefetchRecords;
+
+#ifdef HAVE_LIBZ
+	// Chunked trace
+	SST::Prospero::ChunkedTraceReader* chunked;
+	const char* chunkRecords;
+	uint32_t chunkAvailable;
+#endif
+
+	// Requests of the current batch, and the last load for chains
+	std::vector<BatchEntry> batch;
+	bool haveLastLoad;
+	uint64_t lastLoadID;
+	uint64_t lastLoadAddress;
+	int64_t lastLoadStride;
+
+	uint64_t recordsReplayed;
+	uint64_t dependenciesInferred;
+
+};
+
+}
+}
+
+#endif
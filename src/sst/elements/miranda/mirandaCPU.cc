@@ -40,6 +40,9 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 
         requestsPending[READ] = requestsPending[WRITE] = requestsPending[CUSTOM] = 0;
 
+        // Every outstanding request may be split over two cache lines
+        requestsInFlight.reserve(2 * (maxRequestsPending[READ] + maxRequestsPending[WRITE] + maxRequestsPending[CUSTOM]));
+
 	out->verbose(CALL_INFO, 1, 0, "Configured CPU to allow %" PRIu32 " maximum Load requests to be memory to be outstanding.\n",
 		maxRequestsPending[READ]);
 	out->verbose(CALL_INFO, 1, 0, "Configured CPU to allow %" PRIu32 " maximum Store requests to be memory to be outstanding.\n",
@@ -168,9 +171,28 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 }
 
 RequestGenCPU::~RequestGenCPU() {
+	for(CPURequest* req : freeCPURequests) {
+		delete req;
+	}
+
 	delete out;
 }
 
+CPURequest* RequestGenCPU::allocateCPURequest(const uint64_t origID) {
+	if(freeCPURequests.empty()) {
+		return new CPURequest(origID);
+	}
+
+	CPURequest* req = freeCPURequests.back();
+	freeCPURequests.pop_back();
+	req->reset(origID);
+	return req;
+}
+
+void RequestGenCPU::releaseCPURequest(CPURequest* req) {
+	freeCPURequests.push_back(req);
+}
+
 void RequestGenCPU::finish() {
 }
 
@@ -216,18 +238,16 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 	out->verbose(CALL_INFO, 2, 0, "Recv event for processing from interface\n");
 
         Interfaces::StandardMem::Request::id_t reqID = ev->getID();
-	std::map<Interfaces::StandardMem::Request::id_t, CPURequest*>::iterator reqFind = requestsInFlight.find(reqID);
+	CPURequest* cpuReq = requestsInFlight.remove(reqID);
 
-	if(reqFind == requestsInFlight.end()) {
+	if(nullptr == cpuReq) {
 		out->fatal(CALL_INFO, -1, "Unable to find request %" PRIu64 " in request map.\n", reqID);
 	} else{
-		CPURequest* cpuReq = reqFind->second;
 
 		out->verbose(CALL_INFO, 4, 0, "Miranda request located ID=%" PRIu64 ", contains %" PRIu32 " parts, issue time=%" PRIu64 ", time now=%" PRIu64 "\n",
 			cpuReq->getOriginalReqID(), cpuReq->countParts(), cpuReq->getIssueTime(), getCurrentSimTimeNano());
 
 		statReqLatency->addData((getCurrentSimTimeNano() - cpuReq->getIssueTime()));
-		requestsInFlight.erase(reqFind);
 
 		// Tell the CPU request one more of its parts are satisfied
 		cpuReq->decPartCount();
@@ -246,7 +266,7 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
 			}
 
-			delete cpuReq;
+			releaseCPURequest(cpuReq);
 		}
 
 		delete ev;
@@ -279,11 +299,11 @@ void RequestGenCPU::issueCustomRequest(CustomOpRequest* req) {
 
     Interfaces::StandardMem::CustomReq* request = new Interfaces::StandardMem::CustomReq(req->getPayload());
 
-    CPURequest* newCPUReq = new CPURequest(req->getRequestID());
+    CPURequest* newCPUReq = allocateCPURequest(req->getRequestID());
     newCPUReq->incPartCount();
     newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-    requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(request->getID(), newCPUReq) );
+    requestsInFlight.insert(request->getID(), newCPUReq);
     cache_link->send(request);
 
     requestsPending[CUSTOM]++;
@@ -337,13 +357,13 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
             reqUpper = new Interfaces::StandardMem::Write(upperAddress, upperLength, data);
         }
 
-        CPURequest* newCPUReq = new CPURequest(req->getRequestID());
+        CPURequest* newCPUReq = allocateCPURequest(req->getRequestID());
     	newCPUReq->incPartCount();
         newCPUReq->incPartCount();
     	newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-    	requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(reqLower->getID(), newCPUReq) );
-        requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(reqUpper->getID(), newCPUReq) );
+    	requestsInFlight.insert(reqLower->getID(), newCPUReq);
+        requestsInFlight.insert(reqUpper->getID(), newCPUReq);
 
     	out->verbose(CALL_INFO, 4, 0, "Issuing requesting into cache link...\n");
         cache_link->send(reqLower);
@@ -368,11 +388,11 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
             request = new Interfaces::StandardMem::Write(addr, reqLength, data, false, 0, addr);
         }
 
-        CPURequest* newCPUReq = new CPURequest(req->getRequestID());
+        CPURequest* newCPUReq = allocateCPURequest(req->getRequestID());
         newCPUReq->incPartCount();
         newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-        requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(request->getID(), newCPUReq) );
+        requestsInFlight.insert(request->getID(), newCPUReq);
         cache_link->send(request);
 
         requestsPending[operation]++;
@@ -437,7 +457,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
+    issuedRequests.clear();
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
@@ -471,7 +491,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 		out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
 
                 // Keep record we will delete fence at i
-    		delReqs.push_back(i);
+    		issuedRequests.push_back(i);
 
                 // Delete the fence
     		delete nxtRq;
@@ -494,7 +514,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
                             nxtRq->getRequestID(), reqsIssuedThisCycle);
 
     		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
+                    issuedRequests.push_back(i);
 
                     issueCustomRequest(static_cast<CustomOpRequest*>(nxtRq));
 
@@ -515,7 +535,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
                             nxtRq->getRequestID(), reqsIssuedThisCycle);
 
     		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
+                    issuedRequests.push_back(i);
 
                     issueRequest(memOpReq);
 
@@ -533,7 +553,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
         }
     }
 
-    pendingRequests.erase(delReqs);
+    pendingRequests.erase(issuedRequests);
 
     if(issued) {
 	statCyclesWithIssue->addData(1);
@@ -35,6 +35,11 @@ class CPURequest {
 public:
     CPURequest(const uint64_t origID) :
         originalID(origID), issueTime(0), outstandingParts(0) {}
+    void reset(const uint64_t origID) {
+        originalID = origID;
+        issueTime = 0;
+        outstandingParts = 0;
+    }
     void incPartCount() { outstandingParts++; }
     void decPartCount() { outstandingParts--; }
     bool completed() const { return 0 == outstandingParts; }
@@ -48,6 +53,101 @@ protected:
     uint32_t outstandingParts;
 };
 
+// Requests in flight indexed by the StandardMem request id.  Open
+// addressing with linear probing in a power-of-two table kept at most
+// half full; it is sized for the maximum number of outstanding
+// requests up front so it does not grow in the steady state.
+class CPURequestTable {
+public:
+    CPURequestTable() : count(0) {
+        reserve(16);
+    }
+
+    size_t size() const { return count; }
+
+    void reserve(const size_t entries) {
+        size_t newSize = 16;
+        while(newSize < 2 * entries) {
+            newSize *= 2;
+        }
+
+        if(newSize <= slots.size()) {
+            return;
+        }
+
+        std::vector<Slot> oldSlots(newSize);
+        oldSlots.swap(slots);
+        mask = newSize - 1;
+        count = 0;
+
+        for(auto& next : oldSlots) {
+            if(nullptr != next.req) {
+                insert(next.id, next.req);
+            }
+        }
+    }
+
+    void insert(const StandardMem::Request::id_t id, CPURequest* req) {
+        if(2 * (count + 1) > slots.size()) {
+            reserve(count + 1);
+        }
+
+        size_t index = hash(id);
+        while(nullptr != slots[index].req) {
+            index = (index + 1) & mask;
+        }
+
+        slots[index].id = id;
+        slots[index].req = req;
+        count++;
+    }
+
+    // Returns nullptr if the id is not in flight
+    CPURequest* remove(const StandardMem::Request::id_t id) {
+        size_t index = hash(id);
+        while(nullptr != slots[index].req && slots[index].id != id) {
+            index = (index + 1) & mask;
+        }
+
+        CPURequest* req = slots[index].req;
+        if(nullptr == req) {
+            return nullptr;
+        }
+
+        // Shift back the following entries of the probe sequence so
+        // no tombstones are needed
+        size_t hole = index;
+        size_t next = (index + 1) & mask;
+        while(nullptr != slots[next].req) {
+            const size_t home = hash(slots[next].id);
+            if(((next - home) & mask) >= ((next - hole) & mask)) {
+                slots[hole] = slots[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots[hole].req = nullptr;
+
+        count--;
+        return req;
+    }
+
+private:
+    struct Slot {
+        Slot() : id(0), req(nullptr) {}
+        StandardMem::Request::id_t id;
+        CPURequest* req;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t count;
+
+    size_t hash(const StandardMem::Request::id_t id) const {
+        return (id * UINT64_C(0x9E3779B97F4A7C15)) >> 17 & mask;
+    }
+};
+
 class RequestGenCPU : public SST::Component {
 public:
 
@@ -135,19 +235,23 @@ private:
     void issueRequest(MemoryOpRequest* req);
     void issueCustomRequest(CustomOpRequest* req);
     void handleSrcEvent( SST::Event* );
+    CPURequest* allocateCPURequest(const uint64_t origID);
+    void releaseCPURequest(CPURequest* req);
 
     Output* out;
 
     TimeConverter timeConverter;
     Clock::HandlerBase* clockHandler;
     RequestGenerator* reqGen;
-    std::map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
+    CPURequestTable requestsInFlight;
+    std::vector<CPURequest*> freeCPURequests;
     StandardMem* cache_link;
     Link* srcLink;
     MirandaReqEvent* srcReqEvent;
     StdMemHandler* stdMemHandlers;
 
     MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+    std::vector<uint32_t> issuedRequests;
     MirandaMemoryManager* memMgr;
 
     uint32_t maxRequestsPending[OPCOUNT];
@@ -23,7 +23,9 @@
 #include <sst/core/output.h>
 #include <sst/core/interfaces/stdMem.h>
 
+#include <atomic>
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Miranda {
@@ -39,7 +41,7 @@ typedef enum {
 
 class GeneratorRequest {
 public:
-	GeneratorRequest() {
+	GeneratorRequest() : issueTime(0), depCount(0) {
 		reqID = nextGeneratorRequestID++;
 	}
 
@@ -47,27 +49,73 @@ public:
 	virtual ReqOperation getOperation() const = 0;
 	uint64_t getRequestID() const { return reqID; }
 
+	// Generators create a request for every memory operation and the
+	// CPU deletes it once issued, so freed requests are kept on a
+	// per-thread free list for their size instead of going back to
+	// the heap
+	static void* operator new(size_t size) {
+		const size_t sizeClass = (size - 1) / POOL_GRANULE;
+
+		if(sizeClass >= POOL_CLASSES) {
+			return ::operator new(size);
+		}
+
+		PoolBlock*& freeList = getFreeList(sizeClass);
+		if(nullptr == freeList) {
+			return ::operator new((sizeClass + 1) * POOL_GRANULE);
+		}
+
+		PoolBlock* block = freeList;
+		freeList = block->next;
+		return block;
+	}
+
+	static void operator delete(void* ptr, size_t size) {
+		const size_t sizeClass = (size - 1) / POOL_GRANULE;
+
+		if(sizeClass >= POOL_CLASSES) {
+			::operator delete(ptr);
+			return;
+		}
+
+		PoolBlock*& freeList = getFreeList(sizeClass);
+		PoolBlock* block = static_cast<PoolBlock*>(ptr);
+		block->next = freeList;
+		freeList = block;
+	}
+
 	void addDependency(uint64_t depReq) {
-		dependsOn.push_back(depReq);
+		if(depCount < INLINE_DEPS) {
+			inlineDeps[depCount] = depReq;
+		} else {
+			overflowDeps.push_back(depReq);
+		}
+
+		depCount++;
 	}
 
 	void satisfyDependency(const GeneratorRequest* req) {
 		satisfyDependency(req->getRequestID());
 	}
 
+	// Dependencies are unordered, the last one takes the place of the
+	// one satisfied
 	void satisfyDependency(const uint64_t req) {
-		std::vector<uint64_t>::iterator searchDeps;
-
-		for(searchDeps = dependsOn.begin(); searchDeps != dependsOn.end(); searchDeps++) {
-			if( req == (*searchDeps) ) {
-				dependsOn.erase(searchDeps);
+		for(uint32_t i = 0; i < depCount; ++i) {
+			if( req == getDependency(i) ) {
+				getDependency(i) = getDependency(depCount - 1);
+				depCount--;
+
+				if(depCount >= INLINE_DEPS) {
+					overflowDeps.pop_back();
+				}
 				break;
 			}
 		}
 	}
 
 	bool canIssue() {
-		return dependsOn.empty();
+		return 0 == depCount;
 	}
 
 	uint64_t getIssueTime() const {
@@ -78,19 +126,47 @@ public:
 		issueTime = now;
 	}
 protected:
+	static const uint32_t INLINE_DEPS = 4;
+
 	uint64_t reqID;
 	uint64_t issueTime;
-	std::vector<uint64_t> dependsOn;
+
+	// The first INLINE_DEPS dependencies are held in the request,
+	// the rest (rare) in overflowDeps
+	uint32_t depCount;
+	uint64_t inlineDeps[INLINE_DEPS];
+	std::vector<uint64_t> overflowDeps;
+
+	uint64_t& getDependency(const uint32_t index) {
+		return (index < INLINE_DEPS) ? inlineDeps[index] : overflowDeps[index - INLINE_DEPS];
+	}
 private:
 	static std::atomic<uint64_t> nextGeneratorRequestID;
+
+	static const size_t POOL_GRANULE = 16;
+	static const size_t POOL_CLASSES = 16;
+
+	struct PoolBlock {
+		PoolBlock* next;
+	};
+
+	static PoolBlock*& getFreeList(const size_t sizeClass) {
+		static thread_local PoolBlock* freeLists[POOL_CLASSES] = {};
+		return freeLists[sizeClass];
+	}
 };
 
+// Window of generated requests waiting to be issued, at(0) is the
+// oldest.  The storage is a ring which only grows when a generator
+// pushes more requests than it holds, and erase() compacts in place,
+// so no memory is allocated in the steady state.
 template<typename QueueType>
 class MirandaRequestQueue {
 public:
        	MirandaRequestQueue() {
                         theQ = (QueueType*) malloc(sizeof(QueueType) * 16);
                         maxCapacity = 16;
+                        head = 0;
                         curSize = 0;
                 }
         ~MirandaRequestQueue() {
@@ -101,19 +177,24 @@ public:
                	return 0 == curSize;
         }
 
+        // The capacity is always a power of two
         void resize(const uint32_t newSize) {
-//		printf("Resizing MirandaQueue from: %" PRIu32 " to %" PRIu32 "\n",
-//			curSize, newSize);
+                uint32_t newCapacity = 1;
+                while(newCapacity < newSize) {
+                        newCapacity *= 2;
+                }
+
+               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newCapacity);
+                curSize = std::min(curSize, newSize);
 
-               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newSize);
                	for(uint32_t i = 0; i < curSize; ++i) {
-                       	newQ[i] = theQ[i];
+                       	newQ[i] = slot(i);
                 }
 
                 free(theQ);
                	theQ = newQ;
-               	maxCapacity = newSize;
-               	curSize = std::min(curSize, newSize);
+               	maxCapacity = newCapacity;
+                head = 0;
         }
 
 	uint32_t size() const {
@@ -125,53 +206,53 @@ public:
 	}
 
        	QueueType at(const uint32_t index) {
-               	return theQ[index];
+               	return slot(index);
        	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+        // eraseList holds the indices to remove in ascending order.
+        // Only the entries in front of the last one removed are moved:
+        // the survivors among them are shifted towards the back and the
+        // head advances past the freed slots.  The CPU only issues from
+        // the first max_reorder_lookups entries, so this is bounded by
+        // the reorder window rather than the queue size.
+       	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
-
-               	uint32_t nextSkipIndex = 0;
-               	uint32_t nextSkip = eraseList.at(nextSkipIndex);
-                uint32_t nextNewQIndex = 0;
+                int64_t nextErase = eraseList.size() - 1;
+                int64_t dest = eraseList.back();
 
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	if(nextSkip == i) {
-                                nextSkipIndex++;
-
-                                if(nextSkipIndex >= eraseList.size()) {
-                                       	nextSkip = curSize;
-                               	} else {
-                                       	nextSkip = eraseList.at(nextSkipIndex);
-                                }
+               	for(int64_t i = eraseList.back(); i >= 0; --i) {
+                       	if(nextErase >= 0 && eraseList[nextErase] == i) {
+                                nextErase--;
                        	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
-                                nextNewQIndex++;
+                               	slot(dest) = slot(i);
+                                dest--;
                        	}
                	}
 
-                free(theQ);
-
-               	theQ = newQ;
-		curSize = nextNewQIndex;
+                head = (head + eraseList.size()) & (maxCapacity - 1);
+		curSize -= eraseList.size();
         }
 
 	void push_back(QueueType t) {
                 if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
+                        resize(maxCapacity * 2);
                 }
 
-                theQ[curSize] = t;
+                slot(curSize) = t;
                 curSize++;
         }
 private:
         QueueType* theQ;
         uint32_t maxCapacity;
+        uint32_t head;
         uint32_t curSize;
+
+        QueueType& slot(const uint32_t index) {
+                return theQ[(head + index) & (maxCapacity - 1)];
+        }
 };
 
 class MemoryOpRequest : public GeneratorRequest {
@@ -17,6 +17,7 @@
 #define SIMPLE_MMU_H
 
 #include <sst/core/link.h>
+#include <cstring>
 #include "mmu.h"
 #include "mmuTypes.h"
 
@@ -101,10 +102,32 @@ class SimpleMMU : public MMU {
 
   private:
 
+    // Radix page table over the 32-bit vpn: 10 bits of directory, 10 bits of middle, 12 bits of leaf.
+    // Lookups are three array indexes, and walking the tree visits vpns in ascending order,
+    // so print() and checkpoint() produce the same output as the ordered map they replace.
     class PageTable {
+        static const int LeafBits = 12;
+        static const int MidBits = 10;
+        static const int DirBits = 10;
+        static const uint32_t LeafSize = 1 << LeafBits;
+        static const uint32_t MidSize = 1 << MidBits;
+        static const uint32_t DirSize = 1 << DirBits;
+
+        struct Leaf {
+            Leaf() { memset( present, 0, sizeof(present) ); }
+            bool test( uint32_t i ) { return ( present[i / 64] >> ( i % 64 ) ) & 1; }
+            uint64_t present[LeafSize / 64];
+            PTE pte[LeafSize];
+        };
+
+        struct Mid {
+            Mid() { memset( leaf, 0, sizeof(leaf) ); }
+            Leaf* leaf[MidSize];
+        };
+
       public:
-        PageTable() {}
-        PageTable( SST::Output* output, FILE* fp ) {
+        PageTable() : m_size(0) { memset( m_dir, 0, sizeof(m_dir) ); }
+        PageTable( SST::Output* output, FILE* fp ) : PageTable() {
             int size;
 
             assert( 1 == fscanf( fp, "pteMap.size() %d\n", &size ) );
@@ -115,41 +138,101 @@ class SimpleMMU : public MMU {
                 uint32_t perms;
                 assert( 3 == fscanf( fp, "vpn: %d, ppn: %d, perms: %x\n", &vpn, &ppn, &perms ) );
                 output->debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"vpn: %d, ppn: %d, perms: %x\n", vpn, ppn, perms );
-                pteMap[vpn] = PTE( ppn, perms );
+                add( vpn, PTE( ppn, perms ) );
+            }
+        }
+        PageTable( const PageTable& other ) : PageTable() {
+            other.forEach( [&]( uint32_t vpn, const PTE& pte ) { add( vpn, pte ); } );
+        }
+        PageTable& operator=( const PageTable& ) = delete;
+        ~PageTable() {
+            for ( auto mid : m_dir ) {
+                if ( mid ) {
+                    for ( auto leaf : mid->leaf ) {
+                        delete leaf;
+                    }
+                    delete mid;
+                }
             }
         }
 
         void add( uint32_t vpn, PTE pte ) {
-            pteMap[vpn] = pte;
+            Leaf* leaf = getLeaf( vpn, true );
+            uint32_t i = vpn & ( LeafSize - 1 );
+            if ( ! leaf->test( i ) ) {
+                leaf->present[i / 64] |= (uint64_t) 1 << ( i % 64 );
+                ++m_size;
+            }
+            leaf->pte[i] = pte;
         }
         void remove( uint32_t vpn ) {
-            pteMap.erase(vpn);
+            Leaf* leaf = getLeaf( vpn, false );
+            uint32_t i = vpn & ( LeafSize - 1 );
+            if ( leaf && leaf->test( i ) ) {
+                leaf->present[i / 64] &= ~( (uint64_t) 1 << ( i % 64 ) );
+                --m_size;
+            }
         }
         PTE* find( uint32_t vpn ) {
-            if ( pteMap.find( vpn ) == pteMap.end() ) {
+            Leaf* leaf = getLeaf( vpn, false );
+            uint32_t i = vpn & ( LeafSize - 1 );
+            if ( nullptr == leaf || ! leaf->test( i ) ) {
                 return nullptr;
             } else {
-                return &pteMap[vpn];
+                return &leaf->pte[i];
             }
         }
         void removeWrite(  ) {
-            for ( auto& kv : pteMap ) {
-                kv.second.perms &= ~0x2;
-            }
+            forEach( [&]( uint32_t vpn, const PTE& ) { find( vpn )->perms &= ~0x2; } );
         }
         void print( const std::string str) {
-            for ( auto& kv : pteMap ) {
-                printf("PageTabl::%s() %s vpn=%d ppn=%d perm=%#x\n",__func__,str.c_str(),kv.first,kv.second.ppn,kv.second.perms);
-            }
+            forEach( [&]( uint32_t vpn, const PTE& pte ) {
+                printf("PageTabl::%s() %s vpn=%d ppn=%d perm=%#x\n",__func__,str.c_str(),vpn,pte.ppn,pte.perms);
+            } );
         }
         void checkpoint( FILE* fp ) {
-            fprintf(fp,"pteMap.size() %zu\n",pteMap.size());
-            for ( auto & x : pteMap ) {
-                fprintf(fp,"vpn: %d, ppn: %d, perms: %d \n", x.first,x.second.ppn,x.second.perms );
-            }
+            fprintf(fp,"pteMap.size() %zu\n",m_size);
+            forEach( [&]( uint32_t vpn, const PTE& pte ) {
+                fprintf(fp,"vpn: %d, ppn: %d, perms: %d \n", vpn,pte.ppn,pte.perms );
+            } );
         }
       private:
-        std::map<uint32_t,PTE> pteMap;
+        Leaf* getLeaf( uint32_t vpn, bool create ) {
+            Mid*& mid = m_dir[ vpn >> ( LeafBits + MidBits ) ];
+            if ( nullptr == mid ) {
+                if ( ! create ) return nullptr;
+                mid = new Mid;
+            }
+            Leaf*& leaf = mid->leaf[ ( vpn >> LeafBits ) & ( MidSize - 1 ) ];
+            if ( nullptr == leaf && create ) {
+                leaf = new Leaf;
+            }
+            return leaf;
+        }
+
+        // visits every present entry in ascending vpn order
+        template< class F >
+        void forEach( F func ) const {
+            for ( uint32_t d = 0; d < DirSize; d++ ) {
+                Mid* mid = m_dir[d];
+                if ( nullptr == mid ) continue;
+                for ( uint32_t m = 0; m < MidSize; m++ ) {
+                    Leaf* leaf = mid->leaf[m];
+                    if ( nullptr == leaf ) continue;
+                    for ( uint32_t w = 0; w < LeafSize / 64; w++ ) {
+                        uint64_t bits = leaf->present[w];
+                        while ( bits ) {
+                            uint32_t i = w * 64 + __builtin_ctzll( bits );
+                            bits &= bits - 1;
+                            func( d << ( LeafBits + MidBits ) | m << LeafBits | i, leaf->pte[i] );
+                        }
+                    }
+                }
+            }
+        }
+
+        Mid* m_dir[DirSize];
+        size_t m_size;
     };
 
     void initPageTable( unsigned pid, PageTable* table = nullptr ) {
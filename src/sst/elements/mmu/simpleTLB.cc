@@ -58,13 +58,10 @@ SimpleTLB::SimpleTLB(SST::ComponentId_t id, SST::Params& params) : TLB(id,params
     }
 
     m_waitingMiss.resize( numHwThreads );
-    m_tlbData.resize( numHwThreads );
-    for ( int i=0; i < m_tlbData.size(); i++ ) {
-        m_tlbData[i].resize( m_tlbSize );
-        for ( int j=0; j < m_tlbData[i].size(); j++ ) {
-            m_tlbData[i][j].resize( m_tlbSetSize );
-        }
-    }
+    size_t numSlots = (size_t) numHwThreads * m_tlbSize * m_tlbSetSize;
+    m_tlbTags.resize( numSlots, 0 );
+    m_tlbPpns.resize( numSlots, 0 );
+    m_tlbPerms.resize( numSlots, 0 );
     m_dbg.debug(CALL_INFO,1,0,"numHwTHreads=%d tlbSize=%zu tlbSetSize=%d\n",numHwThreads,m_tlbSize,m_tlbSetSize);
     m_tlbIndexShift = log2( m_tlbSize );
 }
@@ -116,21 +113,22 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
     // send the first fill response
     m_selfLink->send( 0, new SelfEvent( record->reqId, physAddr ));
     auto& waiting = m_waitingMiss[record->hwThreadId];
-    waiting[vpn].pop();
+    auto& queue = waiting[vpn];
+    queue.pop();
     delete record;
 
     // while there are other misses for this page send them
-    while ( ! waiting[vpn].empty() ) {
-        auto record = reinterpret_cast<TlbRecord*>(waiting[vpn].front());
+    while ( ! queue.empty() ) {
+        auto record = reinterpret_cast<TlbRecord*>(queue.front());
 
         uint64_t physAddr = req->getPPN() << m_pageShift | blockOffset( record->virtAddr );
         if( ! req->isSuccess() ) {
             physAddr = -1;
         } else {
-            TlbEntry* entry = findTlbEntry( record->hwThreadId, vpn );
-            assert(entry);
-            if ( ! checkPerms( record->perms, entry->perms() ) ) {
-                m_dbg.debug(CALL_INFO,1,0,"miss vpn=%zu want=%#" PRIx32 " have=%#" PRIx32 "\n",vpn, record->perms, entry->perms());
+            ssize_t slot = findTlbEntry( record->hwThreadId, vpn );
+            assert( -1 != slot );
+            if ( ! checkPerms( record->perms, m_tlbPerms[slot] ) ) {
+                m_dbg.debug(CALL_INFO,1,0,"miss vpn=%zu want=%#" PRIx32 " have=%#" PRIx32 "\n",vpn, record->perms, m_tlbPerms[slot]);
 
                 auto id = reinterpret_cast<RequestID>( record );
                 m_mmuLink->send( 0, new TlbMissEvent( id, record->hwThreadId, vpn, record->perms, record->instPtr, record->virtAddr) );
@@ -142,7 +140,7 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
 
         m_selfLink->send( 0, new SelfEvent( record->reqId, physAddr ));
         delete record;
-        waiting[vpn].pop();
+        queue.pop();
     }
     waiting.erase(vpn);
 
@@ -153,6 +151,39 @@ void SimpleTLB::getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAdd
     size_t vpn = virtAddr >> m_pageShift;
     m_dbg.debug(CALL_INFO,1,0,"reqId=%#" PRIx64 ", hwThreadId=%d virtAddr=%#" PRIx64 " vpn=%zu perms=%#x\n", reqId, hwThreadId, virtAddr, vpn, perms);
 
+    translate( reqId, hwThreadId, virtAddr, perms, instPtr, findTlbEntry( hwThreadId, vpn ) );
+}
+
+void SimpleTLB::getVirtToPhysBatch( const std::vector<Translation>& reqs ) {
+    // The TLB arrays only change when a fill arrives, so one lookup serves every request to the same page in the batch.
+    // The first miss to a page goes to the MMU and the rest of the batch's requests to that page wait on it.
+    struct Page {
+        int hwThreadId;
+        size_t vpn;
+        ssize_t slot;
+    };
+    std::vector<Page> pages;
+    pages.reserve( reqs.size() );
+
+    for ( auto& req : reqs ) {
+        size_t vpn = req.virtAddr >> m_pageShift;
+        m_dbg.debug(CALL_INFO,1,0,"reqId=%#" PRIx64 ", hwThreadId=%d virtAddr=%#" PRIx64 " vpn=%zu perms=%#x\n", req.reqId, req.hwThreadId, req.virtAddr, vpn, req.perms);
+
+        auto page = pages.begin();
+        while ( page != pages.end() && ( page->hwThreadId != req.hwThreadId || page->vpn != vpn ) ) {
+            ++page;
+        }
+        if ( page == pages.end() ) {
+            page = pages.insert( page, Page{ req.hwThreadId, vpn, findTlbEntry( req.hwThreadId, vpn ) } );
+        }
+
+        translate( req.reqId, req.hwThreadId, req.virtAddr, req.perms, req.instPtr, page->slot );
+    }
+}
+
+void SimpleTLB::translate( RequestID reqId, int hwThreadId, uint64_t virtAddr, uint32_t perms, uint64_t instPtr, ssize_t slot ) {
+    size_t vpn = virtAddr >> m_pageShift;
+
     if ( virtAddr < m_minVirtAddr || virtAddr > m_maxVirtAddr ) {
         m_dbg.debug(CALL_INFO,1,0,"virtAddr=%#" PRIx64 " is out of virtual memory range, flag error\n", virtAddr);
         m_selfLink->send( m_hitLatency, new SelfEvent( reqId, -1 ));
@@ -160,13 +191,12 @@ void SimpleTLB::getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAdd
     }
 
     auto& waiting = m_waitingMiss[hwThreadId];
+    auto iter = waiting.find( vpn );
 
-    TlbEntry* entry = findTlbEntry( hwThreadId, vpn );
-
-    if ( nullptr != entry && checkPerms( perms, entry->perms() ) && waiting.find( vpn ) == waiting.end()) {
+    if ( -1 != slot && checkPerms( perms, m_tlbPerms[slot] ) && iter == waiting.end()) {
 
-        m_dbg.debug(CALL_INFO,1,0,"hit ppn=%zu\n", entry->ppn() );
-        uint64_t physAddr = entry->ppn() << m_pageShift | blockOffset( virtAddr );
+        m_dbg.debug(CALL_INFO,1,0,"hit ppn=%" PRIu64 "\n", m_tlbPpns[slot] );
+        uint64_t physAddr = m_tlbPpns[slot] << m_pageShift | blockOffset( virtAddr );
         m_selfLink->send( m_hitLatency, new SelfEvent( reqId, physAddr ));
 
     } else {
@@ -175,12 +205,13 @@ void SimpleTLB::getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAdd
 
         m_dbg.debug(CALL_INFO,1,0,"miss id=%#" PRIx64 "\n", id );
 
-        if ( waiting.find( vpn ) == waiting.end() ) {
+        if ( iter == waiting.end() ) {
             m_dbg.debug(CALL_INFO,1,0,"miss id=%#" PRIx64 " send to MMU\n", id );
             // we are passing the virtAddr as well as the vpn because we use it for debug with instPtr
             // this addition happened after the initial design and it makes VPN uneeded becuse VPN can be deduced at the MMU with virtAddr
             m_mmuLink->send( 0, new TlbMissEvent( id, hwThreadId, vpn, perms, instPtr, virtAddr) );
+            iter = waiting.emplace( vpn, std::queue<RequestID>() ).first;
         }
-        waiting[vpn].push( id );
+        iter->second.push( id );
     }
 }
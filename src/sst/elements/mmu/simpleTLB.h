@@ -22,6 +22,7 @@
 #include "mmuEvents.h"
 #include "tlb.h"
 #include <queue>
+#include <unordered_map>
 
 namespace SST {
 
@@ -29,31 +30,6 @@ namespace MMU_Lib {
 
 class SimpleTLB : public TLB {
 
-    class TlbEntry {
-      public:
-        TlbEntry() : m_valid(false) {}
-        ~TlbEntry() {}
-        void setInvalid() { m_valid = false; }
-        bool isValid() { return m_valid; }
-        bool isDirty() { return m_dirty; }
-        uint32_t perms() { return m_perms; }
-        size_t tag() { return m_tag; }
-        size_t ppn() { return m_ppn; }
-        void init( size_t tag, size_t ppn, uint32_t perms ) {
-            m_tag = tag;
-            m_ppn = ppn;
-            m_perms = perms;
-            m_dirty = false;
-            m_valid = true;
-        }
-      private:
-        int m_valid : 1;
-        int m_dirty : 1;
-        uint32_t m_perms: 3;
-        size_t m_tag : 52;
-        size_t m_ppn : 52;
-    };
-
     class TlbRecord {
       public:
         TlbRecord( RequestID reqId, int hwThreadId, uint64_t virtAddr, uint32_t perms, uint64_t instPtr )
@@ -105,8 +81,12 @@ class SimpleTLB : public TLB {
     }
 
     void getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAddr, uint32_t perms, uint64_t instPtr );
+    void getVirtToPhysBatch( const std::vector<Translation>& reqs );
 
   private:
+    // slot is what findTlbEntry() returned for the request's vpn
+    void translate( RequestID reqId, int hwThreadId, uint64_t virtAddr, uint32_t perms, uint64_t instPtr, ssize_t slot );
+
     void callback( Event* ev ) {
         auto selfEvent = dynamic_cast<SelfEvent*>(ev);
         m_callback( selfEvent->getReqId(), selfEvent->getAddr() );
@@ -123,62 +103,77 @@ class SimpleTLB : public TLB {
         return rng.generateNextUInt32() % m_tlbSetSize;
     }
 
-    void fillTlbEntry( int hwThreadId, size_t vpn, size_t ppn, uint32_t perms ) {
-        size_t tag = vpn >> m_tlbIndexShift;
-        int index = vpn & ( m_tlbSize - 1 );
-        auto& vec = m_tlbData[ hwThreadId ][ index ];
+    // The TLB for all threads is stored as flat arrays indexed by slot = ( hwThread * m_tlbSize + index ) * m_tlbSetSize + way.
+    // A valid entry's m_tlbTags value is its tag shifted left by one with the low bit set, so an invalid way can never match
+    // and a set lookup is a single compare per way over contiguous memory, which the compiler can vectorize.
+    size_t setBase( int hwThreadId, int index ) {
+        return ( (size_t) hwThreadId * m_tlbSize + index ) * m_tlbSetSize;
+    }
 
-        for ( int i = 0; i<vec.size(); i++ ) {
-            if ( vec[i].isValid() ) {
-                m_dbg.debug(CALL_INFO,1,0,"vpn=%zu, tag=%#" PRIx64 " ppn %#lx -> %zu, perms %#x -> %#x \n",
-                        vpn, (uint64_t) vec[i].tag(), vec[i].ppn(), ppn, vec[i].perms(), perms  );
+    static uint64_t tagKey( size_t tag ) {
+        return (uint64_t) tag << 1 | 1;
+    }
 
-                if ( tag == vec[i].tag() ) {
-                    vec[ i ].init( tag, ppn, perms );
-                    return;
-                }
-            }
+    // returns the way that holds tag, or -1
+    int matchWay( size_t base, uint64_t key ) {
+        const uint64_t* tags = &m_tlbTags[ base ];
+        int way = -1;
+        // no early exit, at most one way can match
+        for ( int i = 0; i < m_tlbSetSize; i++ ) {
+            way = tags[i] == key ? i : way;
         }
+        return way;
+    }
 
-        assert(vpn);
-        int slot = pickVictim();
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu ppn=%zu tag%#" PRIx64 " index=%#x slot=%d\n",hwThreadId,
-            vpn, ppn, (uint64_t) tag, index, slot );
-        vec[ slot ].init( tag, ppn, perms );
+    void fillTlbEntry( int hwThreadId, size_t vpn, size_t ppn, uint32_t perms ) {
+        size_t tag = vpn >> m_tlbIndexShift;
+        int index = vpn & ( m_tlbSize - 1 );
+        size_t base = setBase( hwThreadId, index );
+
+        int slot = matchWay( base, tagKey( tag ) );
+        if ( -1 != slot ) {
+            m_dbg.debug(CALL_INFO,1,0,"vpn=%zu, tag=%#" PRIx64 " ppn %#" PRIx64 " -> %zu, perms %#x -> %#x \n",
+                    vpn, (uint64_t) tag, m_tlbPpns[ base + slot ], ppn, m_tlbPerms[ base + slot ], perms  );
+        } else {
+            assert(vpn);
+            slot = pickVictim();
+            m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu ppn=%zu tag%#" PRIx64 " index=%#x slot=%d\n",hwThreadId,
+                vpn, ppn, (uint64_t) tag, index, slot );
+        }
+        m_tlbTags[ base + slot ] = tagKey( tag );
+        m_tlbPpns[ base + slot ] = ppn;
+        m_tlbPerms[ base + slot ] = perms;
     }
 
-    TlbEntry* findTlbEntry( int hwThreadId, size_t vpn ) {
+    // returns the slot holding vpn, or -1 on a miss
+    ssize_t findTlbEntry( int hwThreadId, size_t vpn ) {
         size_t tag = vpn >> m_tlbIndexShift;
         int index = vpn & ( m_tlbSize - 1 );
 
         m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu tag=%#" PRIx64 " index=%#x\n",
             hwThreadId, vpn, (uint64_t) tag, index );
 
-        auto& vec = m_tlbData[ hwThreadId ][ index ];
-        for ( int i = 0; i < vec.size(); i++ ) {
-
-            m_dbg.debug(CALL_INFO,2,0,"check valid=%d wantTag=%#" PRIx64 "\n",vec[i].isValid(), (uint64_t) tag );
-            if ( vec[i].isValid() && tag == vec[i].tag() ) {
-                m_dbg.debug(CALL_INFO,1,0,"found tag=%#" PRIx64 " index=%#x slot=%d\n",(uint64_t) tag, index, i );
-                return& vec[i];
-            }
+        size_t base = setBase( hwThreadId, index );
+        int way = matchWay( base, tagKey( tag ) );
+        if ( -1 == way ) {
+            return -1;
         }
-        return nullptr;
+        m_dbg.debug(CALL_INFO,1,0,"found tag=%#" PRIx64 " index=%#x slot=%d\n",(uint64_t) tag, index, way );
+        return base + way;
     }
 
     void flushThread( int hwThread ) {
 
-        auto& slice = m_tlbData[ hwThread ];
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d size=%zu\n",hwThread,slice.size() );
-
-        for ( int i = 0; i < slice.size(); i++ ) {
-            auto& set = slice[i];
-            //m_dbg.debug(CALL_INFO,1,0,"size=%zu\n",set.size() );
-            for ( int j = 0; j < set.size(); j++ ) {
-                if ( set[j].isValid() ) {
-                    m_dbg.debug(CALL_INFO,1,0,"hwThread=%d index=%d set=%d vpn=%zu\n",
-                            hwThread,i,j, (size_t) ( set[j].tag() << m_tlbIndexShift | i ));
-                    set[j].setInvalid();
+        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d size=%zu\n",hwThread,m_tlbSize );
+
+        size_t base = setBase( hwThread, 0 );
+        for ( size_t i = 0; i < m_tlbSize; i++ ) {
+            for ( int j = 0; j < m_tlbSetSize; j++ ) {
+                uint64_t& key = m_tlbTags[ base + i * m_tlbSetSize + j ];
+                if ( key ) {
+                    m_dbg.debug(CALL_INFO,1,0,"hwThread=%d index=%zu set=%d vpn=%zu\n",
+                            hwThread,i,j, (size_t) ( ( key >> 1 ) << m_tlbIndexShift | i ));
+                    key = 0;
                 }
             }
         }
@@ -193,13 +188,16 @@ class SimpleTLB : public TLB {
     int m_pageSize;
     int m_pageShift;
     int m_tlbIndexShift;
-    std::vector< std::vector< std::vector< TlbEntry > > > m_tlbData;
+    std::vector< uint64_t > m_tlbTags;
+    std::vector< uint64_t > m_tlbPpns;
+    std::vector< uint32_t > m_tlbPerms;
     RNG::XORShiftRNG rng;
 
     uint64_t m_minVirtAddr;
     uint64_t m_maxVirtAddr;
 
-    std::vector< std::map<size_t,std::queue<RequestID> > > m_waitingMiss;
+    // misses outstanding at the MMU, by vpn, with the requests waiting on each
+    std::vector< std::unordered_map<size_t,std::queue<RequestID> > > m_waitingMiss;
 };
 
 } //namespace MMU_Lib
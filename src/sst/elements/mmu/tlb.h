@@ -19,6 +19,7 @@
 #include <sst/core/sst_types.h>
 #include <sst/core/subcomponent.h>
 #include "mmuTypes.h"
+#include <vector>
 
 namespace SST {
 
@@ -43,6 +44,22 @@ class TLB : public SubComponent {
     virtual void registerCallback( Callback& callback  ) = 0;
     virtual void getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAddr, uint32_t perms, uint64_t instPtr ) = 0;
 
+    struct Translation {
+        RequestID reqId;
+        int hwThreadId;
+        uint64_t virtAddr;
+        uint32_t perms;
+        uint64_t instPtr;
+    };
+
+    // Translate requests that arrived together, e.g. the accesses a core's LSQ issued in one cycle.
+    // Each completes through the registered callback as if getVirtToPhys() had been called for it, in order.
+    virtual void getVirtToPhysBatch( const std::vector<Translation>& reqs ) {
+        for ( auto& req : reqs ) {
+            getVirtToPhys( req.reqId, req.hwThreadId, req.virtAddr, req.perms, req.instPtr );
+        }
+    }
+
   protected:
     Callback m_callback;
     Output m_dbg;
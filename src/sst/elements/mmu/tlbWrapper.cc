@@ -41,6 +41,12 @@ TLB_Wrapper::TLB_Wrapper(SST::ComponentId_t id, SST::Params& params): Component(
         m_dbg.fatal(CALL_INFO, -1, "Error: was unable to configure link `cache_if`\n");
     }
 
+    // A zero delay send on the self link lands after the cpu events already queued for this time
+    m_batchLink = nullptr;
+    if ( params.find<bool>("batch", false ) ) {
+        m_batchLink = configureSelfLink("batchLink", "1 ns", new Event::Handler2<TLB_Wrapper,&TLB_Wrapper::handleBatch>(this));
+    }
+
     m_tlb = loadUserSubComponent<SST::MMU_Lib::TLB>("tlb");
     if ( nullptr == m_tlb ) {
         m_dbg.fatal(CALL_INFO, -1, "Error: was unable to load subComponent `tlb`\n");
@@ -139,7 +145,26 @@ void TLB_Wrapper::handleCpuEvent( Event* ev )
     uint64_t instPtr = memEv->getInstructionPointer();
     uint32_t perms = getPerms( memEv );
 
-    m_tlb->getVirtToPhys( reqId, hwThread, virtAddr, perms, instPtr );
+    if ( nullptr == m_batchLink ) {
+        m_tlb->getVirtToPhys( reqId, hwThread, virtAddr, perms, instPtr );
+        return;
+    }
+
+    if ( m_batch.empty() ) {
+        m_batchLink->send( 0, new BatchEvent() );
+    }
+    m_batch.push_back( TLB::Translation{ reqId, hwThread, virtAddr, perms, instPtr } );
+}
+
+void TLB_Wrapper::handleBatch( Event* ev )
+{
+    delete ev;
+
+    std::vector<TLB::Translation> batch;
+    batch.swap( m_batch );
+
+    m_dbg.debug(CALL_INFO_LONG,1,0,"translating %zu requests\n", batch.size() );
+    m_tlb->getVirtToPhysBatch( batch );
 }
 
 void TLB_Wrapper::handleCacheEvent( Event* ev ) {
@@ -20,6 +20,7 @@
 #include <sst/core/sst_types.h>
 #include <sst/core/component.h>
 #include <sst/core/link.h>
+#include <vector>
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "tlb.h"
 
@@ -44,6 +45,7 @@ class TLB_Wrapper : public SST::Component {
     SST_ELI_DOCUMENT_PARAMS(
         {"dbg_level", "Level of verbosity in debug","1"},
         {"exe", "instruction TLB","0"},
+        {"batch", "Translate the requests that arrive from the cpu at the same time with one TLB call","0"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -81,7 +83,15 @@ class TLB_Wrapper : public SST::Component {
         return perms;
     }
 
+    class BatchEvent : public SST::Event {
+      public:
+        BatchEvent() : Event() { }
+
+        NotSerializable(BatchEvent)
+    };
+
     void tlbCallback( RequestID reqId, uint64_t physAddr );
+    void handleBatch( Event* );
 
     void handleCpuEvent( Event* );
     void handleCacheEvent( Event* );
@@ -91,6 +101,10 @@ class TLB_Wrapper : public SST::Component {
     TLB* m_tlb;
     uint32_t m_exe;
 
+    // requests held until every cpu event of the current time has arrived
+    Link* m_batchLink;
+    std::vector<TLB::Translation> m_batch;
+
     SST::Output m_dbg;
     int m_pending;
 
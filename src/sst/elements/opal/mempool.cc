@@ -74,21 +74,32 @@ Pool::Pool(Params params, SST::OpalComponent::MemType mem_type, int id)
 //Create free frames of size framesize, note that the size is in KB
 void Pool::build_mem()
 {
-	int i=0;
 	num_frames = ceil(size/frsize);
 	real_size = num_frames * frsize;
+	frame_bytes = (uint64_t) frsize*1024;
 
-	//std::vector<int> numbers;
-	//for(int i=0; i<num_frames; i++)       // add 0-99 to the vector
-    //	numbers.push_back(i);
-
-    // random allocation of frames
-	//unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-	//std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine(seed));
+	frames.resize(num_frames);
+	for(int i=0; i< num_frames; i++) {
+		frames[i].starting_address = ((uint64_t) i*frame_bytes) + start;
+		frames[i].frame_number = i;
+	}
 
-	for(i=0; i< num_frames; i++) {
-		freelist.push_back(((uint64_t) i*frsize*1024) + start);
+	for(int k=0; k<=MAX_ORDER; k++)
+		free_head[k] = -1;
+
+	// Carve the pool into maximal naturally aligned blocks. Push them highest first so that
+	// the lowest addresses sit at the head of each free list and are handed out first.
+	std::vector<std::pair<int,int>> blocks;
+	int i = 0;
+	while(i < num_frames) {
+		int order = 0;
+		while(order < MAX_ORDER && !(i & (1 << order)) && i + (2 << order) <= num_frames)
+			order++;
+		blocks.push_back(std::make_pair(i, order));
+		i += 1 << order;
 	}
+	for(auto it = blocks.rbegin(); it != blocks.rend(); it++)
+		push_free(it->first, it->second);
 
 	available_frames = num_frames;
 
@@ -96,52 +107,174 @@ void Pool::build_mem()
 
 }
 
+int Pool::order_for_size(uint64_t kb)
+{
+	int order = 0;
+	while(((uint64_t) frsize << order) < kb)
+		order++;
+	return order;
+}
+
+int Pool::frame_index(uint64_t address)
+{
+	if(address < start)
+		return -1;
+
+	uint64_t offset = address - start;
+	if(offset % frame_bytes)
+		return -1;
+
+	uint64_t index = offset / frame_bytes;
+	if(index >= (uint64_t) num_frames)
+		return -1;
+
+	return (int) index;
+}
+
+void Pool::push_free(int index, int order)
+{
+	Frame &frame = frames[index];
+	frame.free_order = order;
+	frame.prev = -1;
+	frame.next = free_head[order];
+	if(frame.next != -1)
+		frames[frame.next].prev = index;
+	free_head[order] = index;
+}
+
+void Pool::remove_free(int index)
+{
+	Frame &frame = frames[index];
+	if(frame.prev != -1)
+		frames[frame.prev].next = frame.next;
+	else
+		free_head[frame.free_order] = frame.next;
+	if(frame.next != -1)
+		frames[frame.next].prev = frame.prev;
+	frame.free_order = -1;
+	frame.next = -1;
+	frame.prev = -1;
+}
+
+int Pool::take_block(int order)
+{
+	// Among the list heads that can satisfy the request, take the lowest address. This keeps a fresh
+	// pool handing out frames in ascending order, the same as the original FIFO free list did.
+	int k = -1;
+	int index = -1;
+	for(int o = order; o <= MAX_ORDER; o++) {
+		if(free_head[o] != -1 && (index == -1 || free_head[o] < index)) {
+			index = free_head[o];
+			k = o;
+		}
+	}
+	if(index == -1)
+		return -1;
+
+	remove_free(index);
+
+	// Keep the lower half and return the upper half to the next order down
+	while(k > order) {
+		k--;
+		push_free(index + (1 << k), k);
+	}
+
+	frames[index].alloc_order = order;
+	available_frames -= 1 << order;
+	return index;
+}
+
+void Pool::release_block(int index, int order)
+{
+	frames[index].alloc_order = -1;
+	frames[index].metadata = 0;
+	available_frames += 1 << order;
+
+	while(order < MAX_ORDER) {
+		int buddy = index ^ (1 << order);
+		if(buddy + (1 << order) > num_frames || frames[buddy].free_order != order)
+			break;
+		remove_free(buddy);
+		index = std::min(index, buddy);
+		order++;
+	}
+
+	push_free(index, order);
+}
+
+REQRESPONSE Pool::allocate_block(int order)
+{
+	REQRESPONSE response;
+	response.status = 0;
+
+	if(order < 0 || order > MAX_ORDER)
+		return response;
+
+	int index = take_block(order);
+	if(index == -1)
+		return response;
+
+	response.address = frames[index].starting_address;
+	response.pages = 1 << order;
+	response.status = 1;
+	return response;
+}
+
+int Pool::allocate_frame_batch(int N, uint64_t* addresses)
+{
+	if(available_frames < N)
+		return 0;
+
+	// Every free block holds at least one frame, so with enough free frames this cannot fail
+	for(int i=0; i<N; i++)
+		addresses[i] = frames[take_block(0)].starting_address;
+
+	return N;
+}
+
 REQRESPONSE Pool::allocate_frames(int pages)
 {
 
 	REQRESPONSE response;
 	response.status =0;
 
-	if(available_frames < pages) {
+	if(pages <= 0 || available_frames < pages) {
 		return response;
 	}
 
-	int frames = pages;
-	std::list<Frame*> frames_allocated;
-
-	// Fixme: Shuffle memory to make continuous memory available
-	while(frames) {
-		// Make sure pool has free frames in the requested memory pool type. If not deallocate allocated frames (if number of frames to be allocated are > 1)
-		if(freelist.empty()) {
-			while(!frames_allocated.empty()) {
-				Frame *frame = frames_allocated.front();
-				freelist.push_back(frame->starting_address);
-				alloclist.erase(frame->starting_address);
-				frames_allocated.pop_front();
-				available_frames++;
-				delete frame;
-			}
-			break;
-		}
-		else
-		{
-			uint64_t frameAddr = freelist.front();
-			freelist.erase(freelist.begin());
-			Frame *frame = new Frame(frameAddr,0);
-			alloclist[frame->starting_address] = frame;
-			frames_allocated.push_back(frame);
-			available_frames--;
-		}
-		frames--;
+	// One naturally aligned block covers the request, so the frames are physically contiguous.
+	// Fragmentation can make this fail even though enough single frames are free.
+	int order = order_for_size((uint64_t) pages * frsize);
+	if(order > MAX_ORDER)
+		return response;
 
-	}
+	int index = take_block(order);
+	if(index == -1)
+		return response;
 
-	if(!frames_allocated.empty()) {
-		response.address = (frames_allocated.front())->starting_address;
-		response.pages = pages;
-		response.status = 1;
+	// Keep only the frames the request needs. The kept head is split into naturally aligned blocks
+	// so deallocate_frames can walk it block by block, and the rest of the block goes back free.
+	int used = index + pages;
+	int end = index + (1 << order);
+	frames[index].alloc_order = -1;
+
+	for(int i = index; i < end; ) {
+		int limit = (i < used) ? used : end;
+		int k = 0;
+		while(!(i & (1 << k)) && i + (2 << k) <= limit)
+			k++;
+
+		if(i < used)
+			frames[i].alloc_order = k;
+		else
+			release_block(i, k);
+
+		i += 1 << k;
 	}
 
+	response.address = frames[index].starting_address;
+	response.pages = pages;
+	response.status = 1;
 	return response;
 
 }
@@ -153,29 +286,15 @@ REQRESPONSE Pool::allocate_frame(int N)
 	REQRESPONSE response;
 	response.status = 0;
 
-
-	// Make sure we have free frames first
-	if(freelist.empty())
-		return response;
-
-	// For now, we will assume you can only allocate 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating contigous physical spaces
-	if(N>1)
+	// Contiguous allocations come from a single buddy block, so N must be a power of two
+	if(N <= 0 || (N & (N - 1)))
 		return response;
 
-	else
-	{
-		// Simply, pop the first free frame and assign it
-		uint64_t frameAddr = freelist.front();
-		freelist.erase(freelist.begin());
-		Frame *temp = new Frame(frameAddr,0);
-		alloclist[temp->starting_address] = temp;
-		available_frames--;
-		response.address = temp->starting_address;
-		response.pages = 1;
-		response.status = 1;
-		return response;
+	int order = 0;
+	while((1 << order) < N)
+		order++;
 
-	}
+	return allocate_block(order);
 
 }
 
@@ -186,34 +305,27 @@ REQRESPONSE Pool::deallocate_frames(int pages, uint64_t starting_pAddress)
 {
 
 	REQRESPONSE response;
-	int frames = pages;
+	int frames_left = pages;
 	uint64_t pAddress = starting_pAddress;
-	uint64_t frame_number;
 
-	while(frames) {
+	while(frames_left > 0) {
 
-		// If we can find the frame to be free in the allocated list
-		std::map<uint64_t, Frame*>::iterator it;
-		it = alloclist.find(pAddress);
-		if (it != alloclist.end())
+		// If we can find the block to be freed among the allocated blocks
+		int index = frame_index(pAddress);
+		if(index != -1 && frames[index].alloc_order >= 0)
 		{
-			//Remove from allocation map and add to free list
-			Frame *temp = it->second;
-			freelist.push_back(temp->starting_address);
-			alloclist.erase(pAddress);
-			delete temp;
+			int order = frames[index].alloc_order;
+			release_block(index, order);
+			frames_left -= 1 << order;
+			pAddress += (uint64_t) frame_bytes << order; //to get the next block physical address
 		}
 		else
 		{
 			response.address = pAddress; //physical address of the frame which failed to deallocate.
-			response.pages = frames; //This indicates number of frames that are not deallocated.
+			response.pages = frames_left; //This indicates number of frames that are not deallocated.
 			response.status = 0;
 			return response;
 		}
-
-		frame_number = (pAddress - start) / frsize * 1024;
-		pAddress += ((uint64_t) (frame_number+1)*frsize*1024) + start; //to get the next frame physical address
-		frames--;
 	}
 
 	response.status = 1; //successfully deallocated
@@ -227,37 +339,33 @@ REQRESPONSE Pool::deallocate_frame(uint64_t X, int N)
 	REQRESPONSE response;
 	response.status = 0;
 
-
-	// For now, we will assume you can free only 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating and freeing contigous physical spaces
-	if(N>1)
+	// X must head an allocated block of exactly N frames
+	int index = frame_index(X);
+	if(index == -1 || frames[index].alloc_order < 0 || (1 << frames[index].alloc_order) != N)
 		return response;
-	else
-	{
-		// If we can find the frame to be free in the allocated list
-		if(alloclist.find(X)!=alloclist.end())
-		{
-			// Remove from allocation map and add to free list
-			Frame * temp = alloclist[X];
-			freelist.push_back(temp->starting_address);
-			alloclist.erase(X);
-			delete temp;
-			available_frames++;
-			response.status = 1;
-		}
-		else // Means we couldn't find an allocated frame that is being unmapped
-			response.status = 0;
 
-	}
+	release_block(index, frames[index].alloc_order);
+	response.status = 1;
 
 	return response;
 }
 
+int Pool::deallocate_frame_batch(int N, const uint64_t* addresses)
+{
+	int freed = 0;
+	for(int i=0; i<N; i++)
+		freed += deallocate_frame(addresses[i], 1).status;
+
+	return freed;
+}
+
 bool Pool::isAllocated(uint64_t address)
 {
-	if(alloclist.find(address)==alloclist.end())
+	int index = frame_index(address);
+	if(index == -1)
 		return false;
 
-	return true;
+	return frames[index].alloc_order >= 0;
 }
 
 /*REQRESPONSE Pool::allocate_frame_address(uint64_t address)
@@ -14,6 +14,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 #include <cmath>
 
 
@@ -30,10 +31,10 @@ class Frame{
 
 	public:
 		// Constructor
-		Frame() { starting_address = 0; metadata = 0;}
+		Frame() { starting_address = 0; metadata = 0; frame_number = 0; free_order = -1; alloc_order = -1; next = -1; prev = -1;}
 
 		// Constructor with paramteres
-		Frame(uint64_t st, uint64_t md) { starting_address = st; metadata = 0;}
+		Frame(uint64_t st, uint64_t md) { starting_address = st; metadata = 0; frame_number = 0; free_order = -1; alloc_order = -1; next = -1; prev = -1;}
 
 		~Frame(){}
 
@@ -45,10 +46,25 @@ class Frame{
 
 		int frame_number;
 
+		// Order of the free block headed by this frame, or -1 if this frame does not head a free block
+		int8_t free_order;
+
+		// Order of the allocated block headed by this frame, or -1 if this frame does not head an allocated block
+		int8_t alloc_order;
+
+		// Links within the free list of free_order
+		int next;
+		int prev;
+
 };
 
 
 // This class defines a memory pool
+// Frames are managed by a binary buddy allocator. A block of order k spans 2^k contiguous frames,
+// so with the default 4KB frame size, order 9 is a 2MB frame and order 18 is a 1GB frame.
+// Frame descriptors live in a flat array indexed by frame number, and each order keeps an
+// intrusive doubly-linked free list through that array, so allocation and deallocation are O(1)
+// apart from splitting and coalescing.
 
 class Pool{
 
@@ -57,19 +73,7 @@ class Pool{
 		//Constructor for pool
 		Pool(Params parmas, SST::OpalComponent::MemType mem_type, int id);
 
-		~Pool() {
-/*			while(!freelist.empty()) {
-				Frame* frame = freelist.front();
-				freelist.erase(freelist.begin());
-				delete frame;
-			}
-*/
-			std::map<uint64_t, Frame*>::iterator it;
-			for(it=alloclist.begin();it!=alloclist.end();it++) {
-				Frame* frame = it->second;
-				delete frame;
-			}
-		}
+		~Pool() {}
 
 		void finish() {}
 
@@ -82,9 +86,15 @@ class Pool{
 		// Allocate N contigiuous frames, returns the starting address if successfull, or -1 if it fails!
 		REQRESPONSE allocate_frame(int N);
 
-		// Allocate 'size' contigiuous memory, returns a structure with starting address and number of frames allocated
+		// Allocate 'pages' contigiuous frames from one buddy block, returning the unused tail of the block to the free lists. Returns a structure with the starting address and the number of frames
 		REQRESPONSE allocate_frames(int pages);
 
+		// Allocate one block of 2^order contiguous, naturally aligned frames
+		REQRESPONSE allocate_block(int order);
+
+		// Allocate N single frames for a bulk fault. Frame addresses are written to 'addresses'. Returns the number allocated, which is either N or 0.
+		int allocate_frame_batch(int N, uint64_t* addresses);
+
 		REQRESPONSE allocate_frame_address(uint64_t address, int N);
 
 		// Freeing N frames starting from Address X, this will return -1 if we find that these frames were not allocated
@@ -93,10 +103,16 @@ class Pool{
 		// Deallocate 'size' contigiuous memory starting from physical address 'starting_pAddress', returns a structure which indicates success or not
 		REQRESPONSE deallocate_frames(int size, uint64_t starting_pAddress);
 
+		// Free N single frames, the counterpart of allocate_frame_batch. Returns the number freed.
+		int deallocate_frame_batch(int N, const uint64_t* addresses);
+
 		bool isAllocated(uint64_t address);
 
 		// Current number of free frames
-		int freeframes() { return freelist.size(); }
+		int freeframes() { return available_frames; }
+
+		// Smallest block order that covers 'kb' KBs, e.g. 2048 for a 2MB page
+		int order_for_size(uint64_t kb);
 
 		// Frame size in KBs
 		int frsize;
@@ -139,13 +155,29 @@ class Pool{
 		//Memory technology
 		SST::OpalComponent::MemTech memTech;
 
-		// The list of free frames
-		std::list<uint64_t> freelist;
+		// Largest block order, enough for 1GB blocks at the default frame size
+		static const int MAX_ORDER = 18;
 
-		//std::map<uint64_t, int> freelist_index;
+		// Frame descriptors, indexed by frame number
+		std::vector<Frame> frames;
 
-		// The list of allocated frames --- the key is the starting physical address
-		std::map<uint64_t, Frame*> alloclist;
+		// Head of the free list for each order, or -1 if empty
+		int free_head[MAX_ORDER + 1];
 
-};
+		// Size of a frame in bytes
+		uint64_t frame_bytes;
+
+		// Returns the frame number for a physical address, or -1 if it is outside the pool or not frame aligned
+		int frame_index(uint64_t address);
+
+		void push_free(int index, int order);
+
+		void remove_free(int index);
 
+		// Take a block of the given order from the free lists, splitting a larger block if needed. Returns -1 if none.
+		int take_block(int order);
+
+		// Return a block to the free lists, coalescing with its buddy where possible
+		void release_block(int index, int order);
+
+};
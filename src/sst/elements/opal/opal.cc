@@ -15,10 +15,31 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 using namespace SST;
 using namespace SST::OpalComponent;
 
+// Allocates the frames of a request and returns the address of the first one. The frames come from
+// one contiguous block when the pool has one, otherwise they are taken one at a time, so this only
+// fails when fewer than 'pages' frames are free.
+static REQRESPONSE allocatePages(Pool *pool, int pages)
+{
+	REQRESPONSE response = pool->allocate_frames(pages);
+
+	if(response.status || pool->freeframes() < pages)
+		return response;
+
+	std::vector<uint64_t> addresses(pages);
+	if(pool->allocate_frame_batch(pages, addresses.data()) == pages) {
+		response.address = addresses[0];
+		response.pages = pages;
+		response.status = 1;
+	}
+
+	return response;
+}
+
 
 #define OPAL_VERBOSE(LEVEL, OUTPUT) if(verbosity >= (LEVEL)) OUTPUT
 
@@ -258,13 +279,12 @@ REQRESPONSE Opal::allocateSharedMemory(int node, int coreId, uint64_t vAddress,
 			if( sharedMemoryInfo[i]->pool->available_frames >= pages )
 			{
 				Pool *pool = sharedMemoryInfo[i]->pool;
-				for(int j=0; j<pages; j++) {
-					response = pool->allocate_frame(1);
-					if(!response.status)
-						output->fatal(CALL_INFO, -1, "Opal: Allocating shared memory. This should never happen\n");
+				response = allocatePages(pool, pages);
+				if(!response.status)
+					output->fatal(CALL_INFO, -1, "Opal: Allocating shared memory. This should never happen\n");
 
+				for(int j=0; j<pages; j++)
 					nodeInfo[node]->profileEvent(SST::OpalComponent::MemType::SHARED);
-				}
 
 				response.pages = pages;
 				response.status = 1;
@@ -280,13 +300,12 @@ REQRESPONSE Opal::allocateSharedMemory(int node, int coreId, uint64_t vAddress,
 
 	if( sharedMemoryInfo[sharedMemPoolId]->pool->available_frames >= pages ) {
 		Pool *pool = sharedMemoryInfo[sharedMemPoolId]->pool;
-		for(int j=0; j<pages; j++) {
-			response = pool->allocate_frame(1);
-			if(!response.status)
-				output->fatal(CALL_INFO, -1, "Opal: Allocating shared memory. This should never happen\n");
+		response = allocatePages(pool, pages);
+		if(!response.status)
+			output->fatal(CALL_INFO, -1, "Opal: Allocating shared memory. This should never happen\n");
 
+		for(int j=0; j<pages; j++)
 			nodeInfo[node]->profileEvent(SST::OpalComponent::MemType::SHARED);
-		}
 
 		setNextMemPool( node,fault_level );
 		response.pages = pages;
@@ -304,13 +323,12 @@ REQRESPONSE Opal::allocateSharedMemory(int node, int coreId, uint64_t vAddress,
 
 			if( sharedMemoryInfo[sharedMemPoolId]->pool->available_frames >= pages ) {
 				Pool *pool = sharedMemoryInfo[sharedMemPoolId]->pool;
-				for(int j=0; j<pages; j++) {
-					response = pool->allocate_frame(1);
-					if(!response.status)
-						output->fatal(CALL_INFO, -1, "Opal: Allocating shared memory. This should never happen\n");
+				response = allocatePages(pool, pages);
+				if(!response.status)
+					output->fatal(CALL_INFO, -1, "Opal: Allocating shared memory. This should never happen\n");
 
+				for(int j=0; j<pages; j++)
 					nodeInfo[node]->profileEvent(SST::OpalComponent::MemType::SHARED);
-				}
 
 				setNextMemPool( node,fault_level );
 				response.pages = pages;
@@ -336,13 +354,12 @@ REQRESPONSE Opal::allocateLocalMemory(int node, int coreId, uint64_t vAddress, i
 
 	if(nodeInfo[node]->pool->available_frames >= pages) {
 		Pool *pool = nodeInfo[node]->pool;
-		for(int i=0; i<pages; i++) {
-			response = pool->allocate_frame(1);
-			if(!response.status)
-				output->fatal(CALL_INFO, -1, "Opal: Allocating local memory. This should never happen\n");
+		response = allocatePages(pool, pages);
+		if(!response.status)
+			output->fatal(CALL_INFO, -1, "Opal: Allocating local memory. This should never happen\n");
 
+		for(int i=0; i<pages; i++)
 			nodeInfo[node]->profileEvent(SST::OpalComponent::MemType::LOCAL);
-		}
 
 		response.pages = pages;
 		response.status = 1;
@@ -378,13 +395,9 @@ REQRESPONSE Opal::allocateFromReservedMemory(int node, uint64_t reserved_vAddres
 
 			if( sharedMemoryInfo[i]->pool->available_frames >= pages ) {
 				Pool *pool = sharedMemoryInfo[i]->pool;
-				for(int j=0; j<pages_reserved; j++) {
-					response = pool->allocate_frame(1);
-					reserved_pAddress->push_back( response.address );
-
-					if(!response.status)
-						output->fatal(CALL_INFO, -1, "Opal: Allocating reserved memory. This should never happen\n");
-				}
+				reserved_pAddress->resize( pages_reserved );
+				if( pool->allocate_frame_batch(pages_reserved, reserved_pAddress->data()) != pages_reserved )
+					output->fatal(CALL_INFO, -1, "Opal: Allocating reserved memory. This should never happen\n");
 
 				response.pages = pages;
 				response.status = 1;
@@ -425,9 +438,10 @@ bool Opal::processRequest(int node, int coreId, uint64_t vAddress, int fault_lev
 
 	int pages = ceil(size/(nodeInfo[node]->page_size));
 
-	// If multiple pages are requested how are the physical addresses sent to the requester as in future sue to opal parallelization continuous addresses cannot be allocated
-	if(pages != 1)
-		output->fatal(CALL_INFO, -1, "Opal: currently opal does not support multiple page allocations\n");
+	// A request larger than the node's frame size, e.g. 4KB pages over 1KB frames, takes several frames.
+	// They are contiguous unless the pool is too fragmented to hold them in one block.
+	if(pages < 1)
+		output->fatal(CALL_INFO, -1, "Opal: request of %d bytes is smaller than a page\n", size);
 
 	// if the page fault request is for CR3 register allocate the memory from local memory
 	if(4 == fault_level)
@@ -0,0 +1,140 @@
+import sst
+
+# Samba takes its page faults to Opal. Samba asks for 4KB per fault and the node's
+# local pool has 1KB frames, so every fault allocates 4 frames. The local pool
+# holds 16 faults, the rest spill into the shared pool.
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+memory_mb = 1024
+local_memory_kb = 64
+shared_memory_kb = 64 * 1024
+frame_size_kb = 1
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "miranda.BaseCPU")
+comp_cpu.addParams({
+	"verbose" : 1,
+})
+cpugen = comp_cpu.setSubComponent("generator", "miranda.GUPSGenerator")
+cpugen.addParams({
+	"verbose" : 0,
+	"count" : 1000,
+	"max_address" : ((memory_mb) // 2) * 1024 * 1024,
+})
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams({
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "L1" : "1",
+      "cache_size" : "8KB",
+})
+
+comp_memctrl = sst.Component("memory", "memHierarchy.MemController")
+comp_memctrl.addParams({
+      "clock" : "1GHz"
+})
+memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50 ns",
+    "mem_size" : str(memory_mb * 1024 * 1024) + "B",
+})
+
+mmu = sst.Component("mmu0", "Samba")
+mmu.addParams({
+        "os_page_size": 4,
+        "corecount": 1,
+        "sizes_L1": 3,
+        "page_size1_L1": 4,
+        "page_size2_L1": 2048,
+        "page_size3_L1": 1024*1024,
+        "assoc1_L1": 4,
+        "size1_L1": 64,
+        "assoc2_L1": 4,
+        "size2_L1": 32,
+        "assoc3_L1": 4,
+        "size3_L1": 4,
+        "sizes_L2": 3,
+        "page_size1_L2": 4,
+        "page_size2_L2": 2048,
+        "page_size3_L2": 1024*1024,
+        "assoc1_L2": 12,
+        "size1_L2": 1536,
+        "assoc2_L2": 12,
+        "size2_L2": 1536,
+        "assoc3_L2": 4,
+        "size3_L2": 16,
+        "clock": "2 Ghz",
+        "levels": 2,
+        "max_width_L1": 3,
+        "max_outstanding_L1": 2,
+        "latency_L1": 4,
+        "parallel_mode_L1": 1,
+        "max_outstanding_L2": 2,
+        "max_width_L2": 4,
+        "latency_L2": 10,
+        "parallel_mode_L2": 0,
+        "page_walk_latency": 30,
+        "size1_PTWC": 32,
+        "assoc1_PTWC": 4,
+        "size2_PTWC": 32,
+        "assoc2_PTWC": 4,
+        "size3_PTWC": 32,
+        "assoc3_PTWC": 4,
+        "size4_PTWC": 32,
+        "assoc4_PTWC": 4,
+        "latency_PTWC": 10,
+        "max_outstanding_PTWC": 4,
+        "emulate_faults": 1,
+})
+
+pagefaulthandler = mmu.setSubComponent("pagefaulthandler", "Opal.PageFaultHandler")
+pagefaulthandler.addParams({
+    "opal_latency" : "30ps"
+})
+
+opal = sst.Component("opal", "Opal")
+opal.addParams({
+	"clock"				: "2GHz",
+	"num_nodes"			: 1,
+	"verbose"			: 1,
+	"max_inst"			: 32,
+	"shared_mempools"		: 1,
+	"shared_mem.mempool0.start"	: local_memory_kb * 1024,
+	"shared_mem.mempool0.size"	: shared_memory_kb,
+	"shared_mem.mempool0.frame_size": frame_size_kb,
+	"shared_mem.mempool0.mem_type"	: 0,
+	"node0.cores"			: 1,
+	"node0.allocation_policy"	: 0,
+	"node0.latency"			: 2000,
+	"node0.memory.start"		: 0,
+	"node0.memory.size"		: local_memory_kb,
+	"node0.memory.frame_size"	: frame_size_kb,
+	"node0.memory.mem_type"		: 0,
+})
+opal.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+# Define the simulation links
+link_cpu_mmu_link = sst.Link("link_cpu_mmu_link")
+link_cpu_mmu_link.connect( (comp_cpu, "cache_link", "50ps"), (mmu, "cpu_to_mmu0", "50ps") )
+link_cpu_mmu_link.setNoCut()
+
+link_mmu_cache_link = sst.Link("link_mmu_cache_link")
+link_mmu_cache_link.connect( (mmu, "mmu_to_cache0", "50ps"), (comp_l1cache, "highlink", "50ps") )
+link_mmu_cache_link.setNoCut()
+
+link_ptw_opal_link = sst.Link("link_ptw_opal_link")
+link_ptw_opal_link.connect( (pagefaulthandler, "opal_link_0", "50ps"), (opal, "mmuLink0", "50ps") )
+link_ptw_opal_link.setNoCut()
+
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l1cache, "lowlink", "50ps"), (comp_memctrl, "highlink", "50ps") )
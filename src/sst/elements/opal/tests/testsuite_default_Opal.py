@@ -0,0 +1,59 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import re
+
+
+class testcase_Opal_Component(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        # Put test based setup code here. it is called once before every test
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    # Each 4KB page fault takes 4 of the pools' 1KB frames
+    def test_Opal_gupsgen_samba_multipage(self):
+        usage = self.Opal_test_template("gupsgen_samba_opal")
+
+        local = usage.get("local_mem_usage", 0)
+        shared = usage.get("shared_mem_usage", 0)
+        self.assertEqual(local, 64, "Opal should fill the 64 frame local pool, allocated {0} frames".format(local))
+        self.assertTrue(shared > 0, "Opal should spill into the shared pool once local memory is drained")
+        self.assertEqual(shared % 4, 0, "Opal allocated {0} shared frames, not a multiple of the 4 frames per fault".format(shared))
+
+#####
+
+    def Opal_test_template(self, testcase, testtimeout=120):
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        # Set the various file paths
+        testDataFileName="test_Opal_{0}".format(testcase)
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        testing_remove_component_warning_from_file(outfile)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("Opal test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # Frames allocated per statistic, e.g. " opal.local_mem_usage.0 : Accumulator : Sum.u64 = 64; ..."
+        usage = {}
+        with open(outfile, 'r') as f:
+            for line in f:
+                m = re.match(r"\s*opal\.(\w+_mem_usage)\.\d+ : Accumulator : Sum\.u64 = (\d+);", line)
+                if m:
+                    usage[m.group(1)] = usage.get(m.group(1), 0) + int(m.group(2))
+        return usage
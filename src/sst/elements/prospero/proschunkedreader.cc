@@ -0,0 +1,87 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proschunkedreader.h"
+
+using namespace SST::Prospero;
+
+ProsperoChunkedTraceReader::ProsperoChunkedTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	const uint32_t stream = params.find<uint32_t>("stream", 0);
+	const uint64_t startCycle = params.find<uint64_t>("start_cycle", 0);
+
+	std::string error;
+	if(!trace.open(traceFile, error)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening chunked trace file: %s, %s\n",
+			getName().c_str(), traceFile.c_str(), error.c_str());
+	}
+
+	if(stream >= trace.getStreamCount()) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: chunked trace %s has %" PRIu32 " streams, stream %" PRIu32 " requested\n",
+			getName().c_str(), traceFile.c_str(), trace.getStreamCount(), stream);
+	}
+
+	trace.selectStream(stream);
+
+	if(startCycle > 0) {
+		trace.seekToCycle(startCycle);
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Opened chunked trace %s, stream %" PRIu32 " holds %" PRIu64 " records.\n",
+		traceFile.c_str(), stream, trace.getRecordCount());
+}
+
+ProsperoChunkedTraceReader::~ProsperoChunkedTraceReader() {
+}
+
+ProsperoTraceEntry* ProsperoChunkedTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
+
+	if(0 == readEntries(&entry, 1)) {
+		return NULL;
+	}
+
+	return new ProsperoTraceEntry(entry);
+}
+
+uint32_t ProsperoChunkedTraceReader::readEntries(ProsperoTraceEntry* entries, const uint32_t count) {
+	uint32_t copied = 0;
+
+	while(copied < count) {
+		uint32_t available = 0;
+		const char* record = trace.readRecords(count - copied, available);
+
+		if(0 == available) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			break;
+		}
+
+		for(uint32_t i = 0; i < available; ++i) {
+			entries[copied++] = decodeProsperoBinaryRecord(record);
+			record += PROSPERO_BINARY_RECORD_LENGTH;
+		}
+	}
+
+	return copied;
+}
+
+bool ProsperoChunkedTraceReader::seekToRecord(const uint64_t record) {
+	trace.seekToRecord(record);
+	return true;
+}
@@ -0,0 +1,62 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_CHUNKED_READER
+#define _H_SST_PROSPERO_CHUNKED_READER
+
+#include "prosreader.h"
+#include "prostraceformat.h"
+
+namespace SST {
+namespace Prospero {
+
+// Reads one stream (core) of a chunked trace written by
+// ariel.ChunkedTraceGenerator.  Seeking uses the index of the trace and
+// only decompresses the chunk holding the target record, so samples
+// deep into a long trace start without replaying what comes before.
+class ProsperoChunkedTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoChunkedTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoChunkedTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+    uint32_t readEntries(ProsperoTraceEntry* entries, const uint32_t count);
+    bool seekToRecord(const uint64_t record);
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoChunkedTraceReader,
+        "prospero",
+        "ProsperoChunkedTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Chunked, indexed trace reader supporting seeks by record and by cycle",
+        SST::Prospero::ProsperoTraceReader
+	)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "file", "Sets the chunked trace file for the reader to use", "" },
+        { "stream", "Stream of the trace to replay, the core ID the trace was recorded for", "0" },
+        { "start_cycle", "Starts the replay at the first record issued at or after this cycle", "0" }
+    )
+
+private:
+	ChunkedTraceReader trace;
+
+};
+
+}
+}
+
+#endif
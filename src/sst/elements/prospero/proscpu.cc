@@ -85,8 +85,26 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
     }
 	output->verbose(CALL_INFO, 1, 0, "Configuration of memory interface completed.\n");
 
+	const uint32_t bufferEntries = std::max((uint32_t) params.find<uint32_t>("trace_buffer_entries", 1024), (uint32_t) 1);
+	entryBuffer.resize(bufferEntries);
+	entryBufferIndex = 0;
+	entryBufferCount = 0;
+	output->verbose(CALL_INFO, 1, 0, "Configured trace buffer for %" PRIu32 " entries\n", bufferEntries);
+
+	const uint64_t startRecord = params.find<uint64_t>("start_record", 0);
+	if(startRecord > 0) {
+		if(!reader->seekToRecord(startRecord)) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: start_record is set but the trace reader cannot seek\n", getName().c_str());
+		}
+		output->verbose(CALL_INFO, 1, 0, "Starting trace replay at record %" PRIu64 "\n", startRecord);
+	}
+
+	// Together with start_record this replays one segment of a trace
+	recordsLeft = params.find<uint64_t>("num_records", 0);
+	limitRecords = recordsLeft > 0;
+
 	output->verbose(CALL_INFO, 1, 0, "Reading first entry from the trace reader...\n");
-	currentEntry = reader->readNextEntry();
+	currentEntry = readNextEntry();
 	output->verbose(CALL_INFO, 1, 0, "Read of first entry complete.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Creating memory manager with page size %" PRIu64 "...\n", pageSize);
@@ -223,7 +241,7 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 				issueRequest(currentEntry);
 
 				// Obtain the next newest request
-				currentEntry = reader->readNextEntry();
+				currentEntry = readNextEntry();
 
 				// Trace reader has read all entries, time to begin draining
 				// the system, caches etc
@@ -327,7 +345,29 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 
 		currentOutstanding++;
 	}
+}
+
+// Entries are read from the reader in batches into entryBuffer, the
+// entry returned is valid until the next call
+const ProsperoTraceEntry* ProsperoComponent::readNextEntry() {
+	if(entryBufferIndex == entryBufferCount) {
+		uint32_t request = (uint32_t) entryBuffer.size();
+
+		if(limitRecords) {
+			request = (uint32_t) std::min((uint64_t) request, recordsLeft);
+		}
+
+		entryBufferCount = (request > 0) ? reader->readEntries(entryBuffer.data(), request) : 0;
+		entryBufferIndex = 0;
+
+		if(limitRecords) {
+			recordsLeft -= entryBufferCount;
+		}
+
+		if(0 == entryBufferCount) {
+			return NULL;
+		}
+	}
 
-	// Delete this entry, we are done converting it into a request
-	delete entry;
+	return &entryBuffer[entryBufferIndex++];
 }
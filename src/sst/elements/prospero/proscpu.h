@@ -28,6 +28,8 @@
 #include "prosreader.h"
 #include "prosmemmgr.h"
 
+#include <vector>
+
 #ifdef HAVE_LIBZ
 #include <zlib.h>
 #endif
@@ -65,6 +67,9 @@ public:
     	{ "clock", "Sets the clock of the core", "2GHz"} ,
     	{ "max_outstanding", "Sets the maximum number of outstanding transactions that the memory system will allow", "16"},
     	{ "max_issue_per_cycle", "Sets the maximum number of new transactions that the system can issue per cycle", "2"},
+    	{ "trace_buffer_entries", "Number of trace entries read from the reader at a time", "1024"},
+    	{ "start_record", "Record of the trace to start the replay at, the reader must support seeking", "0"},
+    	{ "num_records", "Number of records to replay, 0 replays to the end of the trace", "0"},
    )
 
    SST_ELI_DOCUMENT_PORTS(
@@ -83,10 +88,16 @@ private:
   void handleResponse( StandardMem::Request* ev );
   bool tick( Cycle_t );
   void issueRequest(const ProsperoTraceEntry* entry);
+  const ProsperoTraceEntry* readNextEntry();
 
   Output* output;
   ProsperoTraceReader* reader;
-  ProsperoTraceEntry* currentEntry;
+  const ProsperoTraceEntry* currentEntry;
+  std::vector<ProsperoTraceEntry> entryBuffer;
+  uint32_t entryBufferIndex;
+  uint32_t entryBufferCount;
+  uint64_t recordsLeft;
+  bool limitRecords;
   ProsperoMemoryManager* memMgr;
   StandardMem* cache_link;
   FILE* traceFile;
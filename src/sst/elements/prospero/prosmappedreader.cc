@@ -0,0 +1,309 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosmappedreader.h"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Prospero;
+
+// Records decoded by the background thread between two visits to the ring
+#define PROSPERO_DECODE_BATCH 4096
+
+ProsperoMappedTraceReader::ProsperoMappedTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out),
+	traceFD(-1), mapBase(NULL), mapLength(0), recordCount(0), nextRecord(0), advisedRecord(0) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	prefetchRecords = std::max(params.find<uint64_t>("prefetch_records", 65536), (uint64_t) 1);
+
+	FILE* probe = fopen(traceFile.c_str(), "rb");
+
+	if(NULL == probe) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in mapped reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	// gzip streams start with 0x1f 0x8b
+	unsigned char magic[2] = { 0, 0 };
+	const bool compressed = (2 == fread(magic, 1, 2, probe)) && (0x1f == magic[0]) && (0x8b == magic[1]);
+	fclose(probe);
+
+#ifdef HAVE_LIBZ
+	traceInput = NULL;
+
+	if(compressed) {
+		traceInput = gzopen(traceFile.c_str(), "rb");
+
+		if(Z_NULL == traceInput) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: attempted to open: %s but zlib returns error condition.\n",
+				getName().c_str(), traceFile.c_str());
+		}
+
+		gzbuffer(traceInput, 1024 * 1024);
+
+		ring.resize(std::max(prefetchRecords, (uint64_t) PROSPERO_DECODE_BATCH));
+		ringHead = 0;
+		ringCount = 0;
+		decoderAtEnd = false;
+		stopDecoder = false;
+		seekPending = false;
+		seekTarget = 0;
+		seekGeneration = 0;
+
+		decoder = std::thread(&ProsperoMappedTraceReader::decodeCompressed, this);
+
+		output->verbose(CALL_INFO, 1, 0, "Decompressing trace %s in a background thread, %" PRIu64 " records ahead.\n",
+			traceFile.c_str(), (uint64_t) ring.size());
+		return;
+	}
+#else
+	if(compressed) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file %s is compressed but Prospero was built without zlib support.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+#endif
+
+	mapTrace(traceFile);
+}
+
+ProsperoMappedTraceReader::~ProsperoMappedTraceReader() {
+#ifdef HAVE_LIBZ
+	if(NULL != traceInput) {
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			stopDecoder = true;
+		}
+		ringNotFull.notify_one();
+		decoder.join();
+
+		gzclose(traceInput);
+	}
+#endif
+
+	if(NULL != mapBase) {
+		munmap((void*) mapBase, mapLength);
+	}
+
+	if(traceFD >= 0) {
+		close(traceFD);
+	}
+}
+
+void ProsperoMappedTraceReader::mapTrace(const std::string& traceFile) {
+	traceFD = open(traceFile.c_str(), O_RDONLY);
+
+	if(traceFD < 0) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in mapped reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	struct stat traceStat;
+	if(0 != fstat(traceFD, &traceStat)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to stat trace file: %s\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	mapLength = (size_t) traceStat.st_size;
+	recordCount = mapLength / PROSPERO_BINARY_RECORD_LENGTH;
+
+	// An empty trace has nothing to map
+	if(0 == mapLength) {
+		return;
+	}
+
+	void* mapping = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, traceFD, 0);
+
+	if(MAP_FAILED == mapping) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to memory map trace file: %s\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	mapBase = (const char*) mapping;
+	madvise(mapping, mapLength, MADV_SEQUENTIAL);
+
+	output->verbose(CALL_INFO, 1, 0, "Mapped trace %s, %" PRIu64 " records.\n",
+		traceFile.c_str(), recordCount);
+}
+
+ProsperoTraceEntry* ProsperoMappedTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
+
+	if(0 == readEntries(&entry, 1)) {
+		return NULL;
+	}
+
+	return new ProsperoTraceEntry(entry);
+}
+
+uint32_t ProsperoMappedTraceReader::readEntries(ProsperoTraceEntry* entries, const uint32_t count) {
+#ifdef HAVE_LIBZ
+	if(NULL != traceInput) {
+		return readCompressed(entries, count);
+	}
+#endif
+
+	return readMapped(entries, count);
+}
+
+bool ProsperoMappedTraceReader::seekToRecord(const uint64_t record) {
+#ifdef HAVE_LIBZ
+	if(NULL != traceInput) {
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+
+			// Anything already decoded or being decoded is dropped
+			ringHead = 0;
+			ringCount = 0;
+			decoderAtEnd = false;
+			seekPending = true;
+			seekTarget = record;
+			seekGeneration++;
+		}
+		ringNotFull.notify_one();
+		return true;
+	}
+#endif
+
+	nextRecord = std::min(record, recordCount);
+	advisedRecord = nextRecord;
+	return true;
+}
+
+uint32_t ProsperoMappedTraceReader::readMapped(ProsperoTraceEntry* entries, const uint32_t count) {
+	const uint32_t available = (uint32_t) std::min((uint64_t) count, recordCount - nextRecord);
+
+	// Keep the OS reading ahead of the replay
+	if(nextRecord + available + prefetchRecords > advisedRecord && advisedRecord < recordCount) {
+		const long pageSize = sysconf(_SC_PAGESIZE);
+		const uint64_t adviseEnd = std::min(std::max(advisedRecord, nextRecord) + 2 * prefetchRecords, recordCount);
+		const size_t startOffset = std::max(advisedRecord, nextRecord) * PROSPERO_BINARY_RECORD_LENGTH;
+		const size_t alignedStart = startOffset - (startOffset % pageSize);
+		const size_t endOffset = adviseEnd * PROSPERO_BINARY_RECORD_LENGTH;
+
+		madvise((void*) (mapBase + alignedStart), endOffset - alignedStart, MADV_WILLNEED);
+		advisedRecord = adviseEnd;
+	}
+
+	const char* record = mapBase + nextRecord * PROSPERO_BINARY_RECORD_LENGTH;
+
+	for(uint32_t i = 0; i < available; ++i) {
+		entries[i] = decodeProsperoBinaryRecord(record);
+		record += PROSPERO_BINARY_RECORD_LENGTH;
+	}
+
+	nextRecord += available;
+	return available;
+}
+
+#ifdef HAVE_LIBZ
+uint32_t ProsperoMappedTraceReader::readCompressed(ProsperoTraceEntry* entries, const uint32_t count) {
+	std::unique_lock<std::mutex> guard(ringLock);
+
+	ringNotEmpty.wait(guard, [this] { return ringCount > 0 || decoderAtEnd; });
+
+	const uint32_t available = (uint32_t) std::min((size_t) count, ringCount);
+
+	for(uint32_t i = 0; i < available; ++i) {
+		entries[i] = ring[ringHead];
+		ringHead = (ringHead + 1 == ring.size()) ? 0 : ringHead + 1;
+	}
+
+	ringCount -= available;
+	guard.unlock();
+
+	if(available > 0) {
+		ringNotFull.notify_one();
+	} else {
+		output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+	}
+
+	return available;
+}
+
+// Background thread, decodes batches of records into the ring.  The
+// lock is not held while zlib runs; a seek that arrives in the
+// meantime bumps seekGeneration and the batch is dropped.
+void ProsperoMappedTraceReader::decodeCompressed() {
+	std::vector<char> raw(PROSPERO_DECODE_BATCH * PROSPERO_BINARY_RECORD_LENGTH);
+	std::vector<ProsperoTraceEntry> decoded(PROSPERO_DECODE_BATCH);
+
+	std::unique_lock<std::mutex> guard(ringLock);
+
+	while(true) {
+		ringNotFull.wait(guard, [this] {
+			return stopDecoder || seekPending || (!decoderAtEnd && ringCount < ring.size());
+		});
+
+		if(stopDecoder) {
+			return;
+		}
+
+		const uint64_t generation = seekGeneration;
+		const bool doSeek = seekPending;
+		const uint64_t target = seekTarget;
+		const size_t batch = std::min((size_t) PROSPERO_DECODE_BATCH, ring.size() - ringCount);
+		seekPending = false;
+
+		guard.unlock();
+
+		bool atEnd = false;
+
+		if(doSeek) {
+			// zlib decompresses up to the offset, which is the best a
+			// plain gzip stream allows
+			if(gzseek(traceInput, (z_off_t) (target * PROSPERO_BINARY_RECORD_LENGTH), SEEK_SET) < 0) {
+				atEnd = true;
+			}
+		}
+
+		size_t records = 0;
+
+		if(!atEnd) {
+			const int bytesRead = gzread(traceInput, raw.data(), (unsigned int) (batch * PROSPERO_BINARY_RECORD_LENGTH));
+			records = (bytesRead > 0) ? ((size_t) bytesRead / PROSPERO_BINARY_RECORD_LENGTH) : 0;
+			atEnd = records < batch;
+
+			for(size_t i = 0; i < records; ++i) {
+				decoded[i] = decodeProsperoBinaryRecord(raw.data() + i * PROSPERO_BINARY_RECORD_LENGTH);
+			}
+		}
+
+		guard.lock();
+
+		if(generation != seekGeneration) {
+			continue;
+		}
+
+		size_t tail = (ringHead + ringCount) % ring.size();
+		for(size_t i = 0; i < records; ++i) {
+			ring[tail] = decoded[i];
+			tail = (tail + 1 == ring.size()) ? 0 : tail + 1;
+		}
+
+		ringCount += records;
+		decoderAtEnd = atEnd;
+
+		ringNotEmpty.notify_one();
+	}
+}
+#endif
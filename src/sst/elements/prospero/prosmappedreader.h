@@ -0,0 +1,103 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_MAPPED_READER
+#define _H_SST_PROSPERO_MAPPED_READER
+
+#include "prosreader.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace SST {
+namespace Prospero {
+
+// Reads binary traces in the format of ProsperoBinaryTraceReader and
+// ProsperoCompressedBinaryTraceReader.  An uncompressed trace is
+// memory mapped and decoded straight from the mapping, with the pages
+// ahead of the replay advised to the OS.  A gzip compressed trace is
+// decompressed by a background thread into a ring of decoded entries.
+// Both support seeking to a record, which allows replaying samples of
+// a trace.
+class ProsperoMappedTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoMappedTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoMappedTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+    uint32_t readEntries(ProsperoTraceEntry* entries, const uint32_t count);
+    bool seekToRecord(const uint64_t record);
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoMappedTraceReader,
+        "prospero",
+        "ProsperoMappedTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Memory mapped binary trace reader, gzip compressed traces are decompressed in a background thread",
+        SST::Prospero::ProsperoTraceReader
+	)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "file", "Sets the file for the trace reader to use, compressed files are detected automatically", "" },
+        { "prefetch_records", "Number of records to read ahead of the replay", "65536" }
+    )
+
+private:
+	void mapTrace(const std::string& traceFile);
+	uint32_t readMapped(ProsperoTraceEntry* entries, const uint32_t count);
+
+	uint64_t prefetchRecords;
+
+	// Uncompressed trace
+	int traceFD;
+	const char* mapBase;
+	size_t mapLength;
+	uint64_t recordCount;
+	uint64_t nextRecord;
+	uint64_t advisedRecord;
+
+#ifdef HAVE_LIBZ
+	void decodeCompressed();
+	uint32_t readCompressed(ProsperoTraceEntry* entries, const uint32_t count);
+
+	// Compressed trace, the ring is shared with the decoder thread
+	gzFile traceInput;
+	std::thread decoder;
+	std::mutex ringLock;
+	std::condition_variable ringNotFull;
+	std::condition_variable ringNotEmpty;
+	std::vector<ProsperoTraceEntry> ring;
+	size_t ringHead;
+	size_t ringCount;
+	bool decoderAtEnd;
+	bool stopDecoder;
+	bool seekPending;
+	uint64_t seekTarget;
+	uint64_t seekGeneration;
+#endif
+
+};
+
+}
+}
+
+#endif
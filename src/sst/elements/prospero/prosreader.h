@@ -22,6 +22,8 @@
 #include <sst/core/subcomponent.h>
 #include <sst/core/params.h>
 
+#include <cstring>
+
 namespace SST {
 namespace Prospero {
 
@@ -32,6 +34,11 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() :
+		cycles(0), address(0), length(0), op(READ) {
+
+		}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -48,12 +55,31 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
+// Binary trace records are packed: cycles (8 bytes), type ('R' or 'W'),
+// address (8 bytes), length (4 bytes)
+#define PROSPERO_BINARY_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+inline ProsperoTraceEntry decodeProsperoBinaryRecord(const char* record) {
+	uint64_t reqCycles  = 0;
+	char reqType = 'R';
+	uint64_t reqAddress = 0;
+	uint32_t reqLength  = 0;
+
+	memcpy(&reqCycles,  record, sizeof(uint64_t));
+	memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+	memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	return ProsperoTraceEntry(reqCycles, reqAddress, reqLength,
+		(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+}
+
 class ProsperoTraceReader : public SubComponent {
 
 public:
@@ -65,6 +91,31 @@ public:
 
 	~ProsperoTraceReader() { };
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	// Copies up to count entries into entries and returns the number
+	// copied, 0 once the trace has ended.  Readers that can decode
+	// straight into the caller's buffer override this, the default
+	// goes through readNextEntry().
+	virtual uint32_t readEntries(ProsperoTraceEntry* entries, const uint32_t count) {
+		uint32_t i = 0;
+
+		for(; i < count; ++i) {
+			ProsperoTraceEntry* next = readNextEntry();
+
+			if(NULL == next) {
+				break;
+			}
+
+			entries[i] = *next;
+			delete next;
+		}
+
+		return i;
+	}
+
+	// Positions the reader so the next entry read is the given record
+	// of the trace.  Returns false if the reader cannot seek.
+	virtual bool seekToRecord(const uint64_t record) { return false; }
 	void setOutput(Output* out) { output = out; }
 
 protected:
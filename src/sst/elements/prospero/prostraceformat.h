@@ -0,0 +1,437 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_TRACE_FORMAT
+#define _H_SST_PROSPERO_TRACE_FORMAT
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Prospero {
+
+// Chunked trace container.  Written by the Ariel chunked trace
+// generator, read by Prospero and Miranda.
+//
+// Records use the Prospero binary record format (cycles, type, address,
+// length; 21 bytes).  Each stream (one per traced core) is cut into
+// chunks of a fixed number of records and every chunk is compressed
+// on its own, so a reader can start at any chunk.  An index at the end
+// of the file lists every chunk with the stream, the first record and
+// the cycle range it holds, so readers can seek by record or by cycle.
+//
+// Layout, in host byte order like the other Prospero formats:
+//   ChunkedTraceHeader
+//   chunks: ChunkedTraceChunkHeader followed by the compressed records
+//   ChunkedTraceIndexEntry for every chunk
+//   ChunkedTraceTrailer
+
+#define PROSPERO_CHUNKED_TRACE_MAGIC "SSTCTRC1"
+#define PROSPERO_CHUNKED_INDEX_MAGIC "SSTCIDX1"
+#define PROSPERO_CHUNKED_TRACE_VERSION 1
+#define PROSPERO_CHUNKED_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+struct ChunkedTraceHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t recordLength;
+	uint32_t chunkRecords;
+	uint32_t reserved;
+};
+
+struct ChunkedTraceChunkHeader {
+	uint32_t stream;
+	uint32_t records;
+	uint32_t compressedSize;
+	uint32_t reserved;
+};
+
+struct ChunkedTraceIndexEntry {
+	uint64_t offset;        // of the chunk header in the file
+	uint64_t firstRecord;   // number of the first record in its stream
+	uint64_t firstCycle;
+	uint64_t lastCycle;
+	uint32_t stream;
+	uint32_t records;
+	uint32_t compressedSize;
+	uint32_t reserved;
+};
+
+struct ChunkedTraceTrailer {
+	uint64_t indexOffset;
+	uint64_t indexEntries;
+	char magic[8];
+};
+
+class ChunkedTraceWriter {
+public:
+	ChunkedTraceWriter(const std::string& path, const uint32_t chunkRecords, const int compressionLevel) :
+		path(path), chunkRecords(std::max(chunkRecords, (uint32_t) 1)), compressionLevel(compressionLevel), offset(0) {
+
+		file = fopen(path.c_str(), "wb");
+
+		if(NULL != file) {
+			ChunkedTraceHeader header;
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, PROSPERO_CHUNKED_TRACE_MAGIC, sizeof(header.magic));
+			header.version = PROSPERO_CHUNKED_TRACE_VERSION;
+			header.recordLength = PROSPERO_CHUNKED_RECORD_LENGTH;
+			header.chunkRecords = this->chunkRecords;
+
+			write(&header, sizeof(header));
+		}
+	}
+
+	~ChunkedTraceWriter() {
+		close();
+	}
+
+	bool isOpen() const { return NULL != file; }
+
+	void append(const uint32_t stream, const uint64_t cycle, const uint64_t address,
+		const uint32_t length, const bool isRead) {
+
+		if(stream >= streams.size()) {
+			streams.resize(stream + 1);
+		}
+
+		StreamBuffer& buffer = streams[stream];
+
+		if(0 == buffer.count) {
+			buffer.records.resize((size_t) chunkRecords * PROSPERO_CHUNKED_RECORD_LENGTH);
+			buffer.firstCycle = cycle;
+		}
+
+		const char type = isRead ? 'R' : 'W';
+		char* record = buffer.records.data() + (size_t) buffer.count * PROSPERO_CHUNKED_RECORD_LENGTH;
+
+		memcpy(record, &cycle, sizeof(uint64_t));
+		memcpy(record + sizeof(uint64_t), &type, sizeof(char));
+		memcpy(record + sizeof(uint64_t) + sizeof(char), &address, sizeof(uint64_t));
+		memcpy(record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &length, sizeof(uint32_t));
+
+		buffer.lastCycle = cycle;
+		buffer.count++;
+
+		if(chunkRecords == buffer.count) {
+			flushStream(stream);
+		}
+	}
+
+	// Writes out the partial chunks and the index
+	void close() {
+		if(NULL == file) {
+			return;
+		}
+
+		for(uint32_t i = 0; i < streams.size(); ++i) {
+			flushStream(i);
+		}
+
+		ChunkedTraceTrailer trailer;
+		memset(&trailer, 0, sizeof(trailer));
+		trailer.indexOffset = offset;
+		trailer.indexEntries = index.size();
+		memcpy(trailer.magic, PROSPERO_CHUNKED_INDEX_MAGIC, sizeof(trailer.magic));
+
+		if(!index.empty()) {
+			write(index.data(), index.size() * sizeof(ChunkedTraceIndexEntry));
+		}
+		write(&trailer, sizeof(trailer));
+
+		const int closed = fclose(file);
+		file = NULL;
+
+		if(0 != closed) {
+			Output::getDefaultObject().fatal(CALL_INFO, -1, "Error: unable to complete chunked trace %s\n",
+				path.c_str());
+		}
+	}
+
+private:
+	struct StreamBuffer {
+		StreamBuffer() : count(0), nextRecord(0), firstCycle(0), lastCycle(0) {}
+
+		std::vector<char> records;
+		uint32_t count;
+		uint64_t nextRecord;
+		uint64_t firstCycle;
+		uint64_t lastCycle;
+	};
+
+	// A short write leaves the chunk offsets in the index wrong, so it is fatal
+	void write(const void* data, const size_t length) {
+		if(length != fwrite(data, 1, length, file)) {
+			Output::getDefaultObject().fatal(CALL_INFO, -1, "Error: unable to write %" PRIu64 " bytes to chunked trace %s\n",
+				(uint64_t) length, path.c_str());
+		}
+
+		offset += length;
+	}
+
+	void flushStream(const uint32_t stream) {
+		StreamBuffer& buffer = streams[stream];
+
+		if(0 == buffer.count) {
+			return;
+		}
+
+		const uLong rawLength = (uLong) buffer.count * PROSPERO_CHUNKED_RECORD_LENGTH;
+		uLongf compressedLength = compressBound(rawLength);
+		compressed.resize(compressedLength);
+
+		const int status = compress2(compressed.data(), &compressedLength, (const Bytef*) buffer.records.data(),
+			rawLength, compressionLevel);
+
+		if(Z_OK != status) {
+			Output::getDefaultObject().fatal(CALL_INFO, -1, "Error: zlib failed with status %d compressing a chunk of stream %" PRIu32 " for %s\n",
+				status, stream, path.c_str());
+		}
+
+		ChunkedTraceIndexEntry entry;
+		memset(&entry, 0, sizeof(entry));
+		entry.offset = offset;
+		entry.firstRecord = buffer.nextRecord;
+		entry.firstCycle = buffer.firstCycle;
+		entry.lastCycle = buffer.lastCycle;
+		entry.stream = stream;
+		entry.records = buffer.count;
+		entry.compressedSize = (uint32_t) compressedLength;
+		index.push_back(entry);
+
+		ChunkedTraceChunkHeader chunk;
+		memset(&chunk, 0, sizeof(chunk));
+		chunk.stream = stream;
+		chunk.records = buffer.count;
+		chunk.compressedSize = (uint32_t) compressedLength;
+
+		write(&chunk, sizeof(chunk));
+		write(compressed.data(), compressedLength);
+
+		buffer.nextRecord += buffer.count;
+		buffer.count = 0;
+	}
+
+	FILE* file;
+	const std::string path;
+	const uint32_t chunkRecords;
+	const int compressionLevel;
+	uint64_t offset;
+
+	std::vector<StreamBuffer> streams;
+	std::vector<ChunkedTraceIndexEntry> index;
+	std::vector<Bytef> compressed;
+};
+
+// Reads one stream of a chunked trace.  Records are handed out as
+// pointers into the current decompressed chunk, in the Prospero binary
+// record format.
+class ChunkedTraceReader {
+public:
+	ChunkedTraceReader() : file(NULL), chunkRecords(0), stream(0), nextChunk(0), chunkPosition(0), chunkCount(0) {}
+
+	~ChunkedTraceReader() {
+		if(NULL != file) {
+			fclose(file);
+		}
+	}
+
+	// Returns false and sets error if the file is not a chunked trace
+	bool open(const std::string& path, std::string& error) {
+		file = fopen(path.c_str(), "rb");
+
+		if(NULL == file) {
+			error = "unable to open file";
+			return false;
+		}
+
+		ChunkedTraceHeader header;
+		if(1 != fread(&header, sizeof(header), 1, file) ||
+				0 != memcmp(header.magic, PROSPERO_CHUNKED_TRACE_MAGIC, sizeof(header.magic))) {
+			error = "not a chunked trace";
+			return false;
+		}
+
+		if(PROSPERO_CHUNKED_TRACE_VERSION != header.version || PROSPERO_CHUNKED_RECORD_LENGTH != header.recordLength) {
+			error = "unsupported chunked trace version";
+			return false;
+		}
+
+		chunkRecords = header.chunkRecords;
+
+		ChunkedTraceTrailer trailer;
+		if(0 != fseeko(file, -((off_t) sizeof(trailer)), SEEK_END) ||
+				1 != fread(&trailer, sizeof(trailer), 1, file) ||
+				0 != memcmp(trailer.magic, PROSPERO_CHUNKED_INDEX_MAGIC, sizeof(trailer.magic))) {
+			error = "chunked trace has no index, the trace was not closed";
+			return false;
+		}
+
+		index.resize(trailer.indexEntries);
+		if(trailer.indexEntries > 0 && (0 != fseeko(file, (off_t) trailer.indexOffset, SEEK_SET) ||
+				trailer.indexEntries != fread(index.data(), sizeof(ChunkedTraceIndexEntry), trailer.indexEntries, file))) {
+			error = "unable to read the chunked trace index";
+			return false;
+		}
+
+		selectStream(0);
+		return true;
+	}
+
+	uint32_t getStreamCount() const {
+		uint32_t count = 0;
+
+		for(const ChunkedTraceIndexEntry& entry : index) {
+			count = std::max(count, entry.stream + 1);
+		}
+
+		return count;
+	}
+
+	uint64_t getRecordCount() const {
+		if(streamChunks.empty()) {
+			return 0;
+		}
+
+		const ChunkedTraceIndexEntry& last = index[streamChunks.back()];
+		return last.firstRecord + last.records;
+	}
+
+	// Chunks of the stream are listed in the order they were written,
+	// which is record order
+	void selectStream(const uint32_t newStream) {
+		stream = newStream;
+		streamChunks.clear();
+
+		for(size_t i = 0; i < index.size(); ++i) {
+			if(stream == index[i].stream) {
+				streamChunks.push_back(i);
+			}
+		}
+
+		seekToRecord(0);
+	}
+
+	void seekToRecord(const uint64_t record) {
+		// First chunk which ends after the record
+		const std::vector<size_t>::const_iterator found = std::upper_bound(streamChunks.begin(), streamChunks.end(), record,
+			[this](const uint64_t value, const size_t chunk) { return value < index[chunk].firstRecord + index[chunk].records; });
+
+		nextChunk = found - streamChunks.begin();
+		chunkPosition = 0;
+		chunkCount = 0;
+
+		if(found != streamChunks.end()) {
+			loadNextChunk();
+			chunkPosition = (uint32_t) (record - index[*found].firstRecord);
+		}
+	}
+
+	// Positions the reader at the first record issued at or after cycle
+	void seekToCycle(const uint64_t cycle) {
+		const std::vector<size_t>::const_iterator found = std::lower_bound(streamChunks.begin(), streamChunks.end(), cycle,
+			[this](const size_t chunk, const uint64_t value) { return index[chunk].lastCycle < value; });
+
+		if(found == streamChunks.end()) {
+			seekToRecord(getRecordCount());
+			return;
+		}
+
+		seekToRecord(index[*found].firstRecord);
+
+		while(chunkPosition < chunkCount && getRecordCycle(chunkPosition) < cycle) {
+			chunkPosition++;
+		}
+	}
+
+	// Returns a pointer to up to maxRecords consecutive records and sets
+	// count to the number available, count is 0 at the end of the stream
+	const char* readRecords(const uint32_t maxRecords, uint32_t& count) {
+		if(chunkPosition == chunkCount) {
+			if(!loadNextChunk()) {
+				count = 0;
+				return NULL;
+			}
+		}
+
+		count = std::min(maxRecords, chunkCount - chunkPosition);
+		const char* records = chunk.data() + (size_t) chunkPosition * PROSPERO_CHUNKED_RECORD_LENGTH;
+		chunkPosition += count;
+
+		return records;
+	}
+
+private:
+	uint64_t getRecordCycle(const uint32_t position) const {
+		uint64_t cycle = 0;
+		memcpy(&cycle, chunk.data() + (size_t) position * PROSPERO_CHUNKED_RECORD_LENGTH, sizeof(uint64_t));
+		return cycle;
+	}
+
+	bool loadNextChunk() {
+		if(nextChunk >= streamChunks.size()) {
+			return false;
+		}
+
+		const ChunkedTraceIndexEntry& entry = index[streamChunks[nextChunk++]];
+
+		compressed.resize(entry.compressedSize);
+		chunk.resize((size_t) entry.records * PROSPERO_CHUNKED_RECORD_LENGTH);
+
+		uLongf rawLength = chunk.size();
+
+		if(0 != fseeko(file, (off_t) (entry.offset + sizeof(ChunkedTraceChunkHeader)), SEEK_SET) ||
+				1 != fread(compressed.data(), entry.compressedSize, 1, file) ||
+				Z_OK != uncompress((Bytef*) chunk.data(), &rawLength, compressed.data(), entry.compressedSize) ||
+				rawLength != chunk.size()) {
+			// A damaged chunk ends the stream
+			nextChunk = streamChunks.size();
+			chunkPosition = 0;
+			chunkCount = 0;
+			return false;
+		}
+
+		chunkPosition = 0;
+		chunkCount = entry.records;
+		return true;
+	}
+
+	FILE* file;
+	uint32_t chunkRecords;
+	uint32_t stream;
+
+	std::vector<ChunkedTraceIndexEntry> index;
+	std::vector<size_t> streamChunks;
+
+	size_t nextChunk;
+	uint32_t chunkPosition;
+	uint32_t chunkCount;
+	std::vector<Bytef> compressed;
+	std::vector<char> chunk;
+};
+
+}
+}
+
+#endif
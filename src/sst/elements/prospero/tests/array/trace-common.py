@@ -35,6 +35,12 @@ def main():
                 # print "args are ", o, "and", a
                 Tracetype = "CompressedBinary"
                 traceFile = "sstprospero-0-0-gz.trace"
+            elif a == "chunked":
+                Tracetype = "Chunked"
+                traceFile = "sstprospero-0-0-chunked.trace"
+            elif a == "mapped":
+                Tracetype = "Mapped"
+                traceFile = "sstprospero-0-0-bin.trace"
             else:
                 print("no match a= ", a)
                 print("Found nothing for o", o)
@@ -4,6 +4,8 @@ from sst_unittest import *
 from sst_unittest_support import *
 import os
 import glob
+import struct
+import zlib
 
 USE_PIN_TRACES = True
 USE_TAR_TRACES = False
@@ -19,6 +21,7 @@ class testcase_prospero(SSTTestCase):
         self._setup_prospero_test_dirs()
         self._create_prospero_PIN_trace_files()
         self._download_prospero_TAR_trace_files()
+        self._create_prospero_chunked_trace_files()
 
     def tearDown(self):
         # Put test based teardown code here. it is called once after every test
@@ -38,6 +41,26 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_compressed_withtimingdram_using_TAR_traces(self):
         self.prospero_test_template("compressed", WITH_TIMINGDRAM, USE_TAR_TRACES)
 
+    # The chunked traces are converted from the binary ones, so they are
+    # checked against the binary reference files
+    @unittest.skipIf(libz_missing, "test_prospero_chunked_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    @unittest.skipIf(not testing_check_is_nightly(), "test_prospero_chunked_using_TAR_traces only runs on Nightly builds.")
+    def test_prospero_chunked_using_TAR_traces(self):
+        self.prospero_test_template("chunked", NO_TIMINGDRAM, USE_TAR_TRACES)
+
+    @unittest.skipIf(libz_missing, "test_prospero_chunked_withtimingdram_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_chunked_withtimingdram_using_TAR_traces(self):
+        self.prospero_test_template("chunked", WITH_TIMINGDRAM, USE_TAR_TRACES)
+
+    # The mapped reader replays the binary traces, so it is checked
+    # against the binary reference files
+    @unittest.skipIf(not testing_check_is_nightly(), "test_prospero_mapped_using_TAR_traces only runs on Nightly builds.")
+    def test_prospero_mapped_using_TAR_traces(self):
+        self.prospero_test_template("mapped", NO_TIMINGDRAM, USE_TAR_TRACES)
+
+    def test_prospero_mapped_withtimingdram_using_TAR_traces(self):
+        self.prospero_test_template("mapped", WITH_TIMINGDRAM, USE_TAR_TRACES)
+
     @unittest.skipIf(not testing_check_is_nightly(), "test_prospero_text_using_TAR_traces only runs on Nightly builds.")
     def test_prospero_text_using_TAR_traces(self):
         self.prospero_test_template("text", NO_TIMINGDRAM, USE_TAR_TRACES)
@@ -269,6 +292,47 @@ class testcase_prospero(SSTTestCase):
         os_extract_tar(filename, self.testProsperoTARTracesDir)
 
 
+####
+
+    def _create_prospero_chunked_trace_files(self):
+        # Rewrites sstprospero-0-0-bin.trace in the chunked format of
+        # prostraceformat.h: header, chunks of zlib compressed records,
+        # index and trailer.  Small chunks so the reader crosses many.
+        log_debug("_create_prospero_chunked_trace_files() Running")
+        record_length = 21
+        chunk_records = 4096
+
+        binfile = "{0}/sstprospero-0-0-bin.trace".format(self.testProsperoTARTracesDir)
+        chunkedfile = "{0}/sstprospero-0-0-chunked.trace".format(self.testProsperoTARTracesDir)
+        if not os.path.isfile(binfile):
+            log_debug("_create_prospero_chunked_trace_files() - {0} not found, no chunked trace".format(binfile))
+            return
+
+        with open(binfile, 'rb') as f:
+            records = f.read()
+        record_count = len(records) // record_length
+
+        with open(chunkedfile, 'wb') as f:
+            header = struct.pack("=8sIIII", b"SSTCTRC1", 1, record_length, chunk_records, 0)
+            f.write(header)
+            offset = len(header)
+            index = []
+            for first in range(0, record_count, chunk_records):
+                count = min(chunk_records, record_count - first)
+                raw = records[first * record_length:(first + count) * record_length]
+                data = zlib.compress(raw)
+                first_cycle = struct.unpack_from("=Q", raw, 0)[0]
+                last_cycle = struct.unpack_from("=Q", raw, (count - 1) * record_length)[0]
+
+                index.append(struct.pack("=QQQQIIII", offset, first, first_cycle, last_cycle, 0, count, len(data), 0))
+                chunk = struct.pack("=IIII", 0, count, len(data), 0)
+                f.write(chunk)
+                f.write(data)
+                offset += len(chunk) + len(data)
+
+            f.write(b"".join(index))
+            f.write(struct.pack("=QQ8s", offset, len(index), b"SSTCIDX1"))
+
     def _prettyPrintDiffs(self, stat_diff, oth_diff):
         out = ""
         if len(stat_diff) != 0:
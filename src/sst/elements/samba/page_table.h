@@ -0,0 +1,181 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#ifndef _H_SST_SAMBA_PAGE_TABLE
+#define _H_SST_SAMBA_PAGE_TABLE
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace SST {
+namespace SambaComponent {
+
+// A radix tree with 512-entry nodes, the same shape as an x86-64 page table.
+//
+// Samba keeps one of these per page-table level (PGD/PUD/PMD/PTE), keyed by the
+// virtual page number at that level, and also uses it as a set for the mapped-page
+// and pending-fault bookkeeping. A lookup is four array indexes, with no tree
+// rebalancing or per-entry allocation, and neighbouring pages share a leaf.
+//
+// Keys up to 36 bits (a 48-bit VA divided by 4KB) resolve through a single root.
+// Anything above that is rare and goes through a small hash of extra roots.
+template <typename T>
+class RadixTable
+{
+    static const int BITS = 9;
+    static const int FANOUT = 1 << BITS;
+    static const int LEVELS = 4;
+    static const int ROOT_SHIFT = BITS * LEVELS;
+
+    struct Leaf {
+        uint64_t present[FANOUT / 64];
+        T value[FANOUT];
+        Leaf() : value() { memset(present, 0, sizeof(present)); }
+    };
+
+    struct Node {
+        void * child[FANOUT];
+        Node() { memset(child, 0, sizeof(child)); }
+    };
+
+    Node * root;
+    std::unordered_map<uint64_t, Node *> high_roots;
+    uint64_t count;
+
+    Node * getRoot(uint64_t key, bool create)
+    {
+        uint64_t top = key >> ROOT_SHIFT;
+        if(top == 0)
+            return root;
+
+        auto it = high_roots.find(top);
+        if(it != high_roots.end())
+            return it->second;
+        if(!create)
+            return nullptr;
+
+        Node * n = new Node();
+        high_roots[top] = n;
+        return n;
+    }
+
+    Leaf * getLeaf(uint64_t key, bool create)
+    {
+        Node * n = getRoot(key, create);
+        for(int level = LEVELS - 1; n && level > 0; level--)
+        {
+            void *& child = n->child[(key >> (BITS * level)) & (FANOUT - 1)];
+            if(!child)
+            {
+                if(!create)
+                    return nullptr;
+                if(level > 1)
+                    child = new Node();
+                else
+                    child = new Leaf();
+            }
+            if(level == 1)
+                return (Leaf *) child;
+            n = (Node *) child;
+        }
+        return nullptr;
+    }
+
+    void destroy(Node * n, int level)
+    {
+        for(int i = 0; i < FANOUT; i++)
+        {
+            if(!n->child[i])
+                continue;
+            if(level > 1)
+                destroy((Node *) n->child[i], level - 1);
+            else
+                delete (Leaf *) n->child[i];
+        }
+        delete n;
+    }
+
+    public:
+
+    RadixTable() : root(new Node()), count(0) {}
+
+    ~RadixTable()
+    {
+        destroy(root, LEVELS - 1);
+        for(auto & it : high_roots)
+            destroy(it.second, LEVELS - 1);
+    }
+
+    RadixTable(const RadixTable &) = delete;
+    RadixTable & operator=(const RadixTable &) = delete;
+
+    bool contains(uint64_t key)
+    {
+        Leaf * leaf = getLeaf(key, false);
+        if(!leaf)
+            return false;
+        int i = key & (FANOUT - 1);
+        return (leaf->present[i / 64] >> (i % 64)) & 1;
+    }
+
+    // Returns the entry for key, or nullptr if it is not present
+    T * find(uint64_t key)
+    {
+        Leaf * leaf = getLeaf(key, false);
+        if(!leaf)
+            return nullptr;
+        int i = key & (FANOUT - 1);
+        if(!((leaf->present[i / 64] >> (i % 64)) & 1))
+            return nullptr;
+        return &leaf->value[i];
+    }
+
+    // Same as std::map: inserts a value-initialized entry if key is not present
+    T & operator[](uint64_t key)
+    {
+        Leaf * leaf = getLeaf(key, true);
+        int i = key & (FANOUT - 1);
+        uint64_t bit = (uint64_t) 1 << (i % 64);
+        if(!(leaf->present[i / 64] & bit))
+        {
+            leaf->present[i / 64] |= bit;
+            leaf->value[i] = T();
+            count++;
+        }
+        return leaf->value[i];
+    }
+
+    void erase(uint64_t key)
+    {
+        Leaf * leaf = getLeaf(key, false);
+        if(!leaf)
+            return;
+        int i = key & (FANOUT - 1);
+        uint64_t bit = (uint64_t) 1 << (i % 64);
+        if(leaf->present[i / 64] & bit)
+        {
+            leaf->present[i / 64] &= ~bit;
+            count--;
+        }
+    }
+
+    uint64_t size() const { return count; }
+};
+
+typedef RadixTable<uint64_t> PageTableLevel; // maps a virtual page number at one level to the physical address of the next table or page
+typedef RadixTable<int> PageSet; // used as a set of virtual page numbers
+
+} // namespace SambaComponent
+} // namespace SST
+
+#endif
@@ -185,13 +185,13 @@ void PageTableWalker::handleEvent( SST::Event* e )
             //if((*CR3) == -1)
             if(!(*cr3_init))
                 fault_level = 4;
-            else if((*PGD).find(temp_ptr->getAddress()/page_size[3]) == (*PGD).end())
+            else if(!PGD->contains(temp_ptr->getAddress()/page_size[3]))
                 fault_level = 3;
-            else if((*PUD).find(temp_ptr->getAddress()/page_size[2]) == (*PUD).end())
+            else if(!PUD->contains(temp_ptr->getAddress()/page_size[2]))
                 fault_level = 2;
-            else if((*PMD).find(temp_ptr->getAddress()/page_size[1]) == (*PMD).end())
+            else if(!PMD->contains(temp_ptr->getAddress()/page_size[1]))
                 fault_level = 1;
-            else if((*PTE).find(temp_ptr->getAddress()/page_size[0]) == (*PTE).end())
+            else if(!PTE->contains(temp_ptr->getAddress()/page_size[0]))
                 fault_level = 0;
             else
                 output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
@@ -200,10 +200,10 @@ void PageTableWalker::handleEvent( SST::Event* e )
         {
             uint64_t offset = (uint64_t)512*512*512*512;
             if(!(*cr3_init)) fault_level = 4;
-            else if((*PGD).find((temp_ptr->getAddress()/page_size[3])%512) == (*PGD).end()) fault_level = 3;
-            else if((*PUD).find((temp_ptr->getAddress()/page_size[2])%(512*512)) == (*PUD).end()) fault_level = 2;
-            else if((*PMD).find((temp_ptr->getAddress()/page_size[1])%(512*512*512)) == (*PMD).end()) fault_level = 1;
-            else if((*PTE).find((temp_ptr->getAddress()/page_size[0])%offset) == (*PTE).end()) fault_level = 0;
+            else if(!PGD->contains((temp_ptr->getAddress()/page_size[3])%512)) fault_level = 3;
+            else if(!PUD->contains((temp_ptr->getAddress()/page_size[2])%(512*512))) fault_level = 2;
+            else if(!PMD->contains((temp_ptr->getAddress()/page_size[1])%(512*512*512))) fault_level = 1;
+            else if(!PTE->contains((temp_ptr->getAddress()/page_size[0])%offset)) fault_level = 0;
             else output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
         }
 
@@ -238,7 +238,7 @@ void PageTableWalker::handleEvent( SST::Event* e )
                 (*PGD)[stall_addr/page_size[3]] = temp_ptr->getPaddress();
             else
             {
-                if((*PGD).find((stall_addr/page_size[3])%512) != (*PGD).end())
+                if(PGD->contains((stall_addr/page_size[3])%512))
                     output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PGD!!\n");
                 (*PGD)[(stall_addr/page_size[3])%512] = temp_ptr->getPaddress();
                 (*PENDING_PAGE_FAULTS_PGD).erase((stall_addr/page_size[3])%(512));
@@ -253,7 +253,7 @@ void PageTableWalker::handleEvent( SST::Event* e )
                 (*PUD)[stall_addr/page_size[2]] = temp_ptr->getPaddress();
             else
             {
-                if((*PUD).find((stall_addr/page_size[2])%(512*512)) != (*PUD).end())
+                if(PUD->contains((stall_addr/page_size[2])%(512*512)))
                     output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PUD!!\n");
                 (*PUD)[(stall_addr/page_size[2])%(512*512)] = temp_ptr->getPaddress();
                 (*PENDING_PAGE_FAULTS_PUD).erase((stall_addr/page_size[2])%(512*512));
@@ -279,7 +279,7 @@ void PageTableWalker::handleEvent( SST::Event* e )
             else
             {
                 uint64_t offset = 512*512*512;
-                if((*PMD).find((stall_addr/page_size[1])%offset) != (*PMD).end())
+                if(PMD->contains((stall_addr/page_size[1])%offset))
                     output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PMD!!\n");
                 (*PMD)[(stall_addr/page_size[1])%offset] = temp_ptr->getPaddress();
                 (*PENDING_PAGE_FAULTS_PMD).erase((stall_addr/page_size[1])%offset);
@@ -304,7 +304,7 @@ void PageTableWalker::handleEvent( SST::Event* e )
             else
             {
                 uint64_t offset = (uint64_t)512*512*512*512;
-                if((*PTE).find((stall_addr/page_size[0])%offset) != (*PTE).end())
+                if(PTE->contains((stall_addr/page_size[0])%offset))
                     output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PTE!!\n");
                 (*PTE)[(stall_addr/page_size[0])%offset] = temp_ptr->getPaddress();
             }
@@ -359,11 +359,8 @@ void PageTableWalker::recvResp(SST::Event * event)
     MemEvent * ev = static_cast<MemEvent*>(event);
 
 
-    long long int pw_id;
-    if(!self_connected)
-        pw_id = MEM_REQ[ev->getResponseToID()];
-    else
-        pw_id = MEM_REQ[ev->getID()];
+    id_type req_id = self_connected ? ev->getID() : ev->getResponseToID();
+    long long int pw_id = MEM_REQ[req_id];
 
     //WID_Add[] is virtual address, WSR_PT_LEVEL[] is level of page table
     insert_way(WID_Add[pw_id], find_victim_way(WID_Add[pw_id], WSR_PT_LEVEL[pw_id]), WSR_PT_LEVEL[pw_id]);
@@ -373,7 +370,7 @@ void PageTableWalker::recvResp(SST::Event * event)
     WSR_READY[pw_id]=true;
 
     // Avoiding memory leak by deleting the newly generated dummy requests
-    MEM_REQ.erase(ev->getID());
+    MEM_REQ.erase(req_id);
     delete ev;
 
     if(WSR_PT_LEVEL[pw_id]==0)
@@ -381,6 +378,12 @@ void PageTableWalker::recvResp(SST::Event * event)
         ready_by[WID_EV[pw_id]] =  currTime + latency + 2*upper_link_latency;
 
         ready_by_size[WID_EV[pw_id]] = os_page_size; // FIXME: This hardcoded for now assuming the OS maps virtual pages to 4KB pages only
+
+        // The walk is complete, so its tracking entries are no longer needed
+        WSR_PT_LEVEL.erase(pw_id);
+        WSR_READY.erase(pw_id);
+        WID_Add.erase(pw_id);
+        WID_EV.erase(pw_id);
     }
     else
     {
@@ -447,7 +450,7 @@ bool PageTableWalker::tick(SST::Cycle_t x)
         if(!ptw_confined)
         {
             //std::cout<< getName().c_str() << " Core: " << coreId << " stalled with stall address: " << stall_addr << std::endl;
-            if((*PENDING_PAGE_FAULTS).find(stall_addr/page_size[0])==(*PENDING_PAGE_FAULTS).end()) {
+            if(!PENDING_PAGE_FAULTS->contains(stall_addr/page_size[0])) {
                 stall = false;
                 *hold = 0;
             }
@@ -459,10 +462,10 @@ bool PageTableWalker::tick(SST::Cycle_t x)
             switch(stall_at_levels) {
             case 4:
             {
-                if((*PENDING_PAGE_FAULTS_PGD).find((stall_addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end() &&
-                    (*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end() &&
-                    (*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-                    (*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
+                if(!PENDING_PAGE_FAULTS_PGD->contains((stall_addr/page_size[3])%(512)) &&
+                    !PENDING_PAGE_FAULTS_PUD->contains((stall_addr/page_size[2])%(512*512)) &&
+                    !PENDING_PAGE_FAULTS_PMD->contains((stall_addr/page_size[1])%(512*512*512)) &&
+                    !PENDING_PAGE_FAULTS_PTE->contains((stall_addr/page_size[0])%(offset)))
                 {
                     release = 1;
                 }
@@ -471,9 +474,9 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 break;
             case 3:
             {
-                if((*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end() &&
-                    (*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-                    (*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
+                if(!PENDING_PAGE_FAULTS_PUD->contains((stall_addr/page_size[2])%(512*512)) &&
+                    !PENDING_PAGE_FAULTS_PMD->contains((stall_addr/page_size[1])%(512*512*512)) &&
+                    !PENDING_PAGE_FAULTS_PTE->contains((stall_addr/page_size[0])%(offset)))
                 {
                     release = 1;
                 }
@@ -481,8 +484,8 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 break;
             case 2:
             {
-                if((*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-                    (*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
+                if(!PENDING_PAGE_FAULTS_PMD->contains((stall_addr/page_size[1])%(512*512*512)) &&
+                    !PENDING_PAGE_FAULTS_PTE->contains((stall_addr/page_size[0])%(offset)))
                 {
                     release = 1;
                 }
@@ -490,10 +493,10 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 break;
             case 1:
             {
-                if(stall_at_PGD) {if((*PENDING_PAGE_FAULTS_PGD).find((stall_addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end()) release = 1;}
-                else if(stall_at_PUD) {if((*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end()) release = 1;}
-                else if(stall_at_PMD) {if((*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end()) release = 1;}
-                else if(stall_at_PTE) {if((*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) release = 1;}
+                if(stall_at_PGD) {if(!PENDING_PAGE_FAULTS_PGD->contains((stall_addr/page_size[3])%(512))) release = 1;}
+                else if(stall_at_PUD) {if(!PENDING_PAGE_FAULTS_PUD->contains((stall_addr/page_size[2])%(512*512))) release = 1;}
+                else if(stall_at_PMD) {if(!PENDING_PAGE_FAULTS_PMD->contains((stall_addr/page_size[1])%(512*512*512))) release = 1;}
+                else if(stall_at_PTE) {if(!PENDING_PAGE_FAULTS_PTE->contains((stall_addr/page_size[0])%(offset))) release = 1;}
                 else output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!.. stall at level not recognized..\n");
             }
                 break;
@@ -535,13 +538,13 @@ bool PageTableWalker::tick(SST::Cycle_t x)
             bool fault = true;
             if(!ptw_confined)
             {
-                if((*MAPPED_PAGE_SIZE4KB).find(addr/page_size[0])!=(*MAPPED_PAGE_SIZE4KB).end() || (*MAPPED_PAGE_SIZE2MB).find(addr/page_size[1])!=(*MAPPED_PAGE_SIZE2MB).end() || (*MAPPED_PAGE_SIZE1GB).find(addr/page_size[2])!=(*MAPPED_PAGE_SIZE1GB).end())
+                if(MAPPED_PAGE_SIZE4KB->contains(addr/page_size[0]) || MAPPED_PAGE_SIZE2MB->contains(addr/page_size[1]) || MAPPED_PAGE_SIZE1GB->contains(addr/page_size[2]))
                     fault = false;
 
                 if(fault)
                 {
                     stall_addr = addr;
-                    if((*PENDING_PAGE_FAULTS).find(addr/page_size[0])==(*PENDING_PAGE_FAULTS).end()) {
+                    if(!PENDING_PAGE_FAULTS->contains(addr/page_size[0])) {
                         (*PENDING_PAGE_FAULTS)[addr/page_size[0]] = 0;
                         SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
                         //std::cout<< getName().c_str() << " Core id: " << coreId << " Fault at address "<<addr<<std::endl;
@@ -559,20 +562,20 @@ bool PageTableWalker::tick(SST::Cycle_t x)
             else
             {
                 uint64_t offset = (uint64_t)512*512*512*512;
-                if((*MAPPED_PAGE_SIZE4KB).find((addr/page_size[0])%offset)!=(*MAPPED_PAGE_SIZE4KB).end() || (*MAPPED_PAGE_SIZE2MB).find((addr/page_size[1])%(512*512*512))!=(*MAPPED_PAGE_SIZE2MB).end() || (*MAPPED_PAGE_SIZE1GB).find((addr/page_size[2])%(512*512))!=(*MAPPED_PAGE_SIZE1GB).end())
+                if(MAPPED_PAGE_SIZE4KB->contains((addr/page_size[0])%offset) || MAPPED_PAGE_SIZE2MB->contains((addr/page_size[1])%(512*512*512)) || MAPPED_PAGE_SIZE1GB->contains((addr/page_size[2])%(512*512)))
                     fault = false;
 
                 if(fault)
                 {
                     stall_addr = addr;
                     if(to_mem!=NULL) {
-                    if((*PGD).find((addr/page_size[3])%512) == (*PGD).end()) {
+                    if(!PGD->contains((addr/page_size[3])%512)) {
                         stall_at_levels = 1;
                         stall_at_PGD = 1;
                         stall_at_PUD = 0;
                         stall_at_PMD = 0;
                         stall_at_PTE = 0;
-                        if((*PENDING_PAGE_FAULTS_PGD).find((addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end()) {
+                        if(!PENDING_PAGE_FAULTS_PGD->contains((addr/page_size[3])%(512))) {
                             (*PENDING_PAGE_FAULTS_PGD)[(addr/page_size[3])%512] = 0;
                             (*PENDING_PAGE_FAULTS_PUD)[(addr/page_size[2])%(512*512)] = 0;
                             (*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
@@ -586,13 +589,13 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                             return false;
                         }
                     }
-                    else if((*PUD).find((addr/page_size[2])%(512*512)) == (*PUD).end()) {
+                    else if(!PUD->contains((addr/page_size[2])%(512*512))) {
                         stall_at_levels = 1;
                         stall_at_PGD = 0;
                         stall_at_PUD = 1;
                         stall_at_PMD = 0;
                         stall_at_PTE = 0;
-                        if((*PENDING_PAGE_FAULTS_PUD).find((addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end()) {
+                        if(!PENDING_PAGE_FAULTS_PUD->contains((addr/page_size[2])%(512*512))) {
                             (*PENDING_PAGE_FAULTS_PUD)[(addr/page_size[2])%(512*512)] = 0;
                             (*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
                             (*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
@@ -605,13 +608,13 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                             return false;
                         }
                     }
-                    else if((*PMD).find((addr/page_size[1])%(512*512*512)) == (*PMD).end()) {
+                    else if(!PMD->contains((addr/page_size[1])%(512*512*512))) {
                         stall_at_levels = 1;
                         stall_at_PGD = 0;
                         stall_at_PUD = 0;
                         stall_at_PMD = 1;
                         stall_at_PTE = 0;
-                        if((*PENDING_PAGE_FAULTS_PMD).find((addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end()) {
+                        if(!PENDING_PAGE_FAULTS_PMD->contains((addr/page_size[1])%(512*512*512))) {
                             (*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
                             (*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
                             stall_at_levels += 1;
@@ -623,13 +626,13 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                             return false;
                         }
                     }
-                    else if((*PTE).find((addr/page_size[0])%(offset)) == (*PTE).end()) {
+                    else if(!PTE->contains((addr/page_size[0])%(offset))) {
                         stall_at_levels = 1;
                         stall_at_PGD = 0;
                         stall_at_PUD = 0;
                         stall_at_PMD = 0;
                         stall_at_PTE = 1;
-                        if((*PENDING_PAGE_FAULTS_PTE).find((addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) {
+                        if(!PENDING_PAGE_FAULTS_PTE->contains((addr/page_size[0])%(offset))) {
                             (*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
                             SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
                             tse->setResp(addr,0,4096);
@@ -649,7 +652,7 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                         stall_at_PUD = 0;
                         stall_at_PMD = 0;
                         stall_at_PTE = 1;
-                        if((*PENDING_PAGE_FAULTS_PTE).find((addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) {
+                        if(!PENDING_PAGE_FAULTS_PTE->contains((addr/page_size[0])%(offset))) {
                             (*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
                             SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
                             tse->setResp(addr,0,4096);
@@ -788,11 +791,9 @@ bool PageTableWalker::tick(SST::Cycle_t x)
     }
 
 
-    std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare>::iterator st, en;
-    st = ready_by.begin();
-    en = ready_by.end();
+    auto st = ready_by.begin();
 
-    while(st!=en)
+    while(st!=ready_by.end())
     {
 
         bool deleted=false;
@@ -819,7 +820,7 @@ bool PageTableWalker::tick(SST::Cycle_t x)
             {
                 if(!ptw_confined)
                 {
-                    if((*PTE).find(addr/4096)==(*PTE).end())
+                    if(!PTE->contains(addr/4096))
                     {
                         std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
                         std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
@@ -828,7 +829,7 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 else
                 {
                     uint64_t offset = (uint64_t)512*512*512*512;
-                    if((*PTE).find((addr/4096)%offset)==(*PTE).end())
+                    if(!PTE->contains((addr/4096)%offset))
                     {
                         std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
                         std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
@@ -863,12 +864,11 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 st2++;
             }
 
-            ready_by.erase(st);
+            // Carry on from the next entry, as in TLB::tick()
+            st = ready_by.erase(st);
 
         }
-        if(deleted)
-            st=ready_by.begin();
-        else
+        if(!deleted)
             st++;
 
     }
@@ -888,7 +888,7 @@ void PageTableWalker::initaitePageMigration(Address_t vaddress, Address_t paddre
     //std::cout << getName().c_str() << " Core ID: " << coreId << " sending TLB shootdown with address: " << std::hex << vaddress << " new paddress: " << paddress << std::endl;
     stall_addr = vaddress;
     /*
-    if((*PENDING_SHOOTDOWN_EVENTS).find(vaddress/page_size[0]) == (*PENDING_SHOOTDOWN_EVENTS).end()) {
+    if(!PENDING_SHOOTDOWN_EVENTS->contains(vaddress/page_size[0])) {
         (*PENDING_SHOOTDOWN_EVENTS)[vaddress/page_size[0]] = 0;
         (*PENDING_PAGE_FAULTS)[vaddress/page_size[0]] = 0;		//add to pending page faults list
         (*MAPPED_PAGE_SIZE4KB).erase(vaddress/page_size[0]); 	//unmap the page
@@ -23,9 +23,11 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "utils.h"
+#include "page_table.h"
 #include "page_fault_handler.h"
 
 // This file defines the page table walker
@@ -106,21 +108,21 @@ class PageTableWalker : public ComponentExtension
 
     // Holds the PGD, PUD, PMT, PTE physical pointers
     // PTE should give you the exact physical address of the page
-    std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-    std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-    std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-    std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
+    PageTableLevel * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
+    PageTableLevel * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
+    PageTableLevel * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
+    PageTableLevel * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
 
     // The structures below are used to quickly check if the page is mapped or not
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
+    PageSet * MAPPED_PAGE_SIZE4KB;
+    PageSet * MAPPED_PAGE_SIZE2MB;
+    PageSet * MAPPED_PAGE_SIZE1GB;
 
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
+    PageSet *PENDING_PAGE_FAULTS;
+    PageSet *PENDING_PAGE_FAULTS_PGD;
+    PageSet *PENDING_PAGE_FAULTS_PUD;
+    PageSet *PENDING_PAGE_FAULTS_PMD;
+    PageSet *PENDING_PAGE_FAULTS_PTE;
 
     // This link is used to send internal events within the page table walker
     SST::Link * s_EventChan;
@@ -138,11 +140,11 @@ class PageTableWalker : public ComponentExtension
     // === Holds incoming requests, "input queue"
     std::vector<MemHierarchy::MemEventBase *> not_serviced;
     std::vector<MemHierarchy::MemEventBase *> * service_back; // This is used to pass ready requests back to the previous level
-    std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // This is used to pass the size of the  requests back to the previous level
+    EventSizeMap * service_back_size; // This is used to pass the size of the  requests back to the previous level
 
     // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
     std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by;
-    std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+    EventSizeMap ready_by_size; // keeps track of requests' sizes inside this structure
     std::vector<MemHierarchy::MemEventBase *> pending_misses; // This the number of pending misses, only erased when pushed back from next level
 
     SST::Cycle_t currTime;
@@ -156,9 +158,9 @@ class PageTableWalker : public ComponentExtension
     PageTableWalker(ComponentId_t id, int page_size, int assoc, PageTableWalker * next_level, int size);
     PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker * Next_level,int level, SST::Params& params);
 
-    void setPageTablePointers( Address_t * cr3, std::map<Address_t, Address_t> * pgd,  std::map<Address_t, Address_t> * pud,  std::map<Address_t, Address_t> * pmd, std::map<Address_t, Address_t> * pte,
-            std::map<Address_t,int> * gb,  std::map<Address_t,int> * mb,  std::map<Address_t,int> * kb, std::map<Address_t,int> * pr, int *cr3I, std::map<Address_t,int> *pf_pgd,  std::map<Address_t,int> *pf_pud,
-            std::map<Address_t,int> *pf_pmd, std::map<Address_t,int> * pf_pte)
+    void setPageTablePointers( Address_t * cr3, PageTableLevel * pgd,  PageTableLevel * pud,  PageTableLevel * pmd, PageTableLevel * pte,
+            PageSet * gb,  PageSet * mb,  PageSet * kb, PageSet * pr, int *cr3I, PageSet *pf_pgd,  PageSet *pf_pud,
+            PageSet *pf_pmd, PageSet * pf_pte)
     {
         CR3 = cr3;
         PGD = pgd;
@@ -223,12 +225,12 @@ class PageTableWalker : public ComponentExtension
 
     bool recvPageFaultResp(PageFaultHandler::PageFaultHandlerPacket pkt);
 
-    void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
+    void setServiceBackSize( EventSizeMap * x) { service_back_size = x;}
 
 
     //==== JVOROBY: these appear to be unused? There's no lower-level TLB below the PTW, so noone to push-back to us
     //std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
-    //std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * getPushedBackSize(){return & pushed_back_size;}
+    //EventSizeMap * getPushedBackSize(){return & pushed_back_size;}
 
 
     //===== Memory-request tracking structs
@@ -240,15 +242,15 @@ class PageTableWalker : public ComponentExtension
     long long int mmu_id=0;
 
     // For a given page-walk memory request:
-    std::map<long long int, int> WSR_PT_LEVEL; // what level of the PT does it refer to (0 = PTE, 3 = PGD)
-    std::map<long long int, bool> WSR_READY;
+    std::unordered_map<long long int, int> WSR_PT_LEVEL; // what level of the PT does it refer to (0 = PTE, 3 = PGD)
+    std::unordered_map<long long int, bool> WSR_READY;
 
-    std::map<long long int, Address_t> WID_Add;
-    std::map<long long int, MemHierarchy::MemEventBase*> WID_EV;
+    std::unordered_map<long long int, Address_t> WID_Add;
+    std::unordered_map<long long int, MemHierarchy::MemEventBase*> WID_EV;
 
     // Each Walk request generates a MemEvent that is sent out;
     // This maps `memevent->getID()` to the corresponding `mmu_id`  used in the WSR_ and WID_ objects
-    std::map<id_type, long long int> MEM_REQ;
+    std::unordered_map<id_type, long long int, EventIdHash> MEM_REQ;
 
     //=== Etc
     Statistic<uint64_t>* statPageTableWalkerHits;
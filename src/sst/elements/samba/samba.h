@@ -104,21 +104,21 @@ class Samba : public SST::Component {
         // Note, the application might be multi-threaded, however, all threads will share the sambe page table components below
 
         Address_t CR3;
-        std::map<Address_t, Address_t> PGD;
-        std::map<Address_t, Address_t> PUD;
-        std::map<Address_t, Address_t> PMD;
-        std::map<Address_t, Address_t> PTE;
-        std::map<Address_t,int>  MAPPED_PAGE_SIZE4KB;
-        std::map<Address_t,int>  MAPPED_PAGE_SIZE2MB;
-        std::map<Address_t,int>  MAPPED_PAGE_SIZE1GB;
-
-        std::map<Address_t,int> PENDING_PAGE_FAULTS;
-        std::map<Address_t,int> PENDING_PAGE_FAULTS_PGD;
-        std::map<Address_t,int> PENDING_PAGE_FAULTS_PUD;
-        std::map<Address_t,int> PENDING_PAGE_FAULTS_PMD;
-        std::map<Address_t,int> PENDING_PAGE_FAULTS_PTE;
+        PageTableLevel PGD;
+        PageTableLevel PUD;
+        PageTableLevel PMD;
+        PageTableLevel PTE;
+        PageSet  MAPPED_PAGE_SIZE4KB;
+        PageSet  MAPPED_PAGE_SIZE2MB;
+        PageSet  MAPPED_PAGE_SIZE1GB;
+
+        PageSet PENDING_PAGE_FAULTS;
+        PageSet PENDING_PAGE_FAULTS_PGD;
+        PageSet PENDING_PAGE_FAULTS_PUD;
+        PageSet PENDING_PAGE_FAULTS_PMD;
+        PageSet PENDING_PAGE_FAULTS_PTE;
         int cr3I;
-        std::map<Address_t,int> PENDING_SHOOTDOWN_EVENTS;
+        PageSet PENDING_SHOOTDOWN_EVENTS;
 
 
     private:
@@ -253,7 +253,7 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 			Address_t vaddr = ((MemEvent*) event)->getVirtualAddress();
 			if(!ptw_confined)
 			{
-				if((*PTE).find(vaddr/4096)==(*PTE).end())
+				if(!PTE->contains(vaddr/4096))
 					std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
 
 				((MemEvent*) event)->setAddr((((*PTE)[vaddr / 4096] + vaddr % 4096) / 64) * 64);
@@ -262,7 +262,7 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 			else
 			{
 				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*PTE).find((vaddr/4096)%offset)==(*PTE).end())
+				if(!PTE->contains((vaddr/4096)%offset))
 				std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
 
 				((MemEvent*) event)->setAddr((((*PTE)[(vaddr / 4096)%offset] + vaddr % 4096)));
@@ -271,7 +271,7 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 
 			/*if(page_placement) {
 				if((*PTE)[vaddr / 4096] < memory_size ) {
-					//if((*PTR_map).find((*PTE)[vaddr / 4096]) == (*PTR_map).end())
+					//if(!PTR_map->contains((*PTE)[vaddr / 4096]))
 					//	std::cout<<"Error: page reference is not mapped, vaddress:" << vaddr / 4096 << " physical page: " << (*PTE)[vaddr / 4096] << " PTE " << std::endl;
 
 					//std::cerr << Owner->getName().c_str() << " Page table reference update address: " << (*PTR)[(*PTR_map)[(*PTE)[vaddr / 4096]]].first << " index: " <<
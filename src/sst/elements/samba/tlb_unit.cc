@@ -225,10 +225,11 @@ bool TLB::tick(SST::Cycle_t x)
 
 
 		// Check if there are other misses that were going to the same translation and waiting for the response of this miss
-		if((level==1) && (SAME_MISS.find(addr/4096)!=SAME_MISS.end()))
+		auto same_miss = (level==1) ? SAME_MISS.find(addr/4096) : SAME_MISS.end();
+		if(same_miss!=SAME_MISS.end())
 		{
-		   auto same_st = SAME_MISS[addr/4096].begin();
-		   auto same_en = SAME_MISS[addr/4096].end();
+		   auto same_st = same_miss->second.begin();
+		   auto same_en = same_miss->second.end();
 		   while(same_st!=same_en)
 		    {
 
@@ -236,7 +237,7 @@ bool TLB::tick(SST::Cycle_t x)
 	    		ready_by_size[same_st->first] = pushed_back_size[ev];
 			same_st++;
 		    }
-		  SAME_MISS.erase(addr/4096);
+		  SAME_MISS.erase(same_miss);
 		 // PENDING_MISS.erase(addr/4096);
 		}
 		PENDING_MISS.erase(addr/4096);
@@ -357,10 +358,9 @@ bool TLB::tick(SST::Cycle_t x)
 
 
 	auto st = ready_by.begin();
-	auto en = ready_by.end();
 
 	// We iterate over the list of being serviced request to see if any has finished by this cycle
-	while(st!=en)
+	while(st!=ready_by.end())
 	{
 
 		bool deleted=false;
@@ -413,12 +413,11 @@ bool TLB::tick(SST::Cycle_t x)
 				st2++;
 			}
 
-			ready_by.erase(st);
+			// Entries before this one were not ready and still are not, so carry on from the next entry rather than rescanning from the start
+			st = ready_by.erase(st);
 
 		}
-		if(deleted)
-			st=ready_by.begin();
-		else
+		if(!deleted)
 			st++;
 
 	}
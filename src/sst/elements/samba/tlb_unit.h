@@ -19,6 +19,7 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include "page_table_walker.h"
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include "utils.h"
 
@@ -74,8 +75,8 @@ class TLB : public ComponentExtension
     // === ???
 	std::map<long long int, int> SIZE_LOOKUP; // This structure checks if a size is supported inside the structure, and its index structure
 
-	std::map< Address_t, std::map< MemHierarchy::MemEventBase *, int, MemEventPtrCompare>> SAME_MISS; // This tracks the misses for the same location and deduplicates them
-	std::map<Address_t, int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
+	std::unordered_map< Address_t, std::map< MemHierarchy::MemEventBase *, int, MemEventPtrCompare>> SAME_MISS; // This tracks the misses for the same location and deduplicates them
+	std::unordered_map<Address_t, int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
 
 
     //=======================================================================
@@ -96,7 +97,7 @@ class TLB : public ComponentExtension
 
     // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
 	std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by;
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+	EventSizeMap ready_by_size; // keeps track of requests' sizes inside this structure
 
 
     // === Buffers for sending requests up/down TLB hierarchy:
@@ -105,12 +106,12 @@ class TLB : public ComponentExtension
 
     // completed requests from deeper in TLB hierarchy will be returned into `this->pushed_back`
 	std::vector<MemHierarchy::MemEventBase *> pushed_back; // translation for requests, returned from lower-level structures
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> pushed_back_size; // page_sizes of the returned translations
+	EventSizeMap pushed_back_size; // page_sizes of the returned translations
 
     // when we're finished with a request, we send it back up the hierarchy by inserting into `service_back`
     // - pointer is wired up to `pushed_back` buffers of the next level up at TLB in constructor of TLBHierarchy
 	std::vector<MemHierarchy::MemEventBase *> * service_back; // used to pass ready requests back to the previous level
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // page_size of ready requests for next level up
+	EventSizeMap * service_back_size; // page_size of ready requests for next level up
 
 
 
@@ -139,11 +140,11 @@ class TLB : public ComponentExtension
     // === Called by parent to wire up TLB levels to each other
     // this TLB will push completed requests into service_back (sending them back up the levels towards core)
 	void setServiceBack( std::vector<MemHierarchy::MemEventBase *> * x) { service_back = x;}
-	void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
+	void setServiceBackSize( EventSizeMap * x) { service_back_size = x;}
 
     // lower-levels will return answered requests into this->pushed_back
 	std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * getPushedBackSize(){return & pushed_back_size;}
+	EventSizeMap * getPushedBackSize(){return & pushed_back_size;}
 
 	void update_lru(Address_t vaddr, int struct_id);
 
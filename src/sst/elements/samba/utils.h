@@ -16,6 +16,8 @@
 #include <sst/core/event.h>
 #include <sst/elements/memHierarchy/memEventBase.h>
 
+#include <unordered_map>
+
 namespace SST {
 namespace SambaComponent {
 
@@ -29,6 +31,16 @@ namespace SambaComponent {
             }
         }
     };
+
+    // Per-request page sizes passed between TLB levels. Only ever looked up by pointer, never iterated, so no ordering is needed
+    typedef std::unordered_map<MemHierarchy::MemEventBase *, long long int> EventSizeMap;
+
+    // Hash for the (id, rank) pairs used as MemEvent IDs
+    struct EventIdHash {
+        size_t operator()(const std::pair<uint64_t, int> & id) const {
+            return std::hash<uint64_t>()(id.first) ^ ((size_t) id.second << 48);
+        }
+    };
 }
 }
 
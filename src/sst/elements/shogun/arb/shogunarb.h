@@ -17,6 +17,7 @@
 #define _H_SHOGUN_ARB_H
 
 #include "shogun_event.h"
+#include "shogun_port_mask.h"
 #include "shogun_q.h"
 
 using namespace SST::Shogun;
@@ -32,11 +33,17 @@ namespace Shogun {
         ShogunArbitrator() {}
         virtual ~ShogunArbitrator() {}
 
+    // Moves events from the input queues to the output slots.  Only the
+    // ports set in inputPending have events queued; ports which are
+    // given an event must be set in outputPending and ports whose queue
+    // is drained must be cleared from inputPending.
     virtual void moveEvents(const int num_events,
                             const int port_count,
                             ShogunQueue<ShogunEvent*>** inputQueues,
+                            ShogunPortMask& inputPending,
                             int32_t output_slots,
                             ShogunEvent*** outputEvents,
+                            ShogunPortMask& outputPending,
                             uint64_t cycle )
                             = 0;
 
@@ -31,65 +31,92 @@ ShogunRoundRobinArbitrator::~ShogunRoundRobinArbitrator() {}
 void ShogunRoundRobinArbitrator::moveEvents(const int num_events,
                                             const int port_count,
                                             ShogunQueue<ShogunEvent*>** inputQueues,
+                                            ShogunPortMask& inputPending,
                                             int32_t output_slots,
                                             ShogunEvent*** outputEvents,
+                                            ShogunPortMask& outputPending,
                                             uint64_t cycle ) {
 
     output->verbose(CALL_INFO, 4, 0, "BEGIN: Arbitration --------------------------------------------------\n");
-    output->verbose(CALL_INFO, 4, 0, "-> start: %" PRIi32 "\n", lastStart);
+    output->verbose(CALL_INFO, 4, 0, "-> start: %" PRIi32 ", ports with events: %" PRIi32 "\n", lastStart, inputPending.count());
 
-    int32_t currentPort = lastStart;
     int32_t moved_count = 0;
 
-    // RR, so iterate through the ports one at a time and process num_events from the queue
-    for (int32_t i = 0; i < port_count; ++i) {
-        auto nextQ = inputQueues[currentPort];
-        output->verbose(CALL_INFO, 4, 0, "-> processing port: %" PRIi32 ", event-count: %" PRIi32 " out of %" PRIi32 "\n", currentPort,
-                        nextQ->count(), num_events);
+    // RR, so iterate through the ports one at a time starting at lastStart and wrapping around,
+    // only the ports with queued events are visited. Moving events from a port only changes the
+    // pending bit of that port, so the scan can continue from the next one.
+    for (int32_t pass = 0; pass < 2; ++pass) {
+        const int32_t first = (0 == pass) ? lastStart : 0;
+        const int32_t end   = (0 == pass) ? port_count : lastStart;
+
+        for (int32_t currentPort = inputPending.findNext(first, end); currentPort < end;
+                currentPort = inputPending.findNext(currentPort + 1, end)) {
+
+            moved_count += movePortEvents(num_events, currentPort, inputQueues[currentPort], output_slots,
+                outputEvents, outputPending);
 
-        //Want to send num_events for each port
-        int32_t j = 0;
-        while (j < num_events || num_events == -1 ) {
             if (inputQueues[currentPort]->empty()) {
-                output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> input queue empty...\n", j);
-                break;
-            } else {
+                inputPending.clear(currentPort);
+            }
+        }
+    }
 
-                ShogunEvent* pendingEv = inputQueues[currentPort]->peek();
+    lastStart = nextPort(port_count, lastStart);
+
+    bundle->getPacketsMoved()->addData(moved_count);
+    output->verbose(CALL_INFO, 4, 0, "-> next-start: %" PRIi32 "\n", lastStart);
+    output->verbose(CALL_INFO, 4, 0, "END: Arbitration ----------------------------------------------------\n");
+}
 
-                int32_t k = 0;
-                while (k < output_slots) {
-                    output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> attempting send from: %" PRIi32 " to: %" PRIi32 ", remote status: %s\n",
-                        j, pendingEv->getSource(), pendingEv->getDestination(),
-                        outputEvents[pendingEv->getDestination()][k] == nullptr ? "empty" : "full");
+int32_t ShogunRoundRobinArbitrator::movePortEvents(const int num_events,
+                                                   const int port,
+                                                   ShogunQueue<ShogunEvent*>* inputQueue,
+                                                   int32_t output_slots,
+                                                   ShogunEvent*** outputEvents,
+                                                   ShogunPortMask& outputPending) {
 
-                    if (outputEvents[pendingEv->getDestination()][k] == nullptr) {
-                        output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> moving event to remote queue\n", j);
-                        pendingEv = inputQueues[currentPort]->pop();
-                        outputEvents[pendingEv->getDestination()][k] = pendingEv;
-                        moved_count++;
+    output->verbose(CALL_INFO, 4, 0, "-> processing port: %" PRIi32 ", event-count: %" PRIi32 " out of %" PRIi32 "\n", port,
+                    inputQueue->count(), num_events);
 
-                        break;
-                    }
+    int32_t moved_count = 0;
 
-                    ++k;
+    //Want to send num_events for each port
+    int32_t j = 0;
+    while (j < num_events || num_events == -1 ) {
+        if (inputQueue->empty()) {
+            output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> input queue empty...\n", j);
+            break;
+        } else {
+
+            ShogunEvent* pendingEv = inputQueue->peek();
+            const int dest = pendingEv->getDestination();
+
+            int32_t k = 0;
+            while (k < output_slots) {
+                output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> attempting send from: %" PRIi32 " to: %" PRIi32 ", remote status: %s\n",
+                    j, pendingEv->getSource(), dest,
+                    outputEvents[dest][k] == nullptr ? "empty" : "full");
+
+                if (outputEvents[dest][k] == nullptr) {
+                    output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> moving event to remote queue\n", j);
+                    outputEvents[dest][k] = inputQueue->pop();
+                    outputPending.set(dest);
+                    moved_count++;
+
+                    break;
                 }
 
-                if ( k == output_slots ) {
-                   output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> output queue full...\n", j);
-                   break;
-                }
+                ++k;
             }
 
-            ++j;
+            if ( k == output_slots ) {
+               output->verbose(CALL_INFO, 4, 0, "  (%" PRIi32 ")-> output queue full...\n", j);
+               break;
+            }
         }
-        // Increment to next port in sequence
-        currentPort = nextPort(port_count, currentPort);
-    }
 
-    lastStart = nextPort(port_count, lastStart);
+        ++j;
+    }
 
-    bundle->getPacketsMoved()->addData(moved_count);
-    output->verbose(CALL_INFO, 4, 0, "-> next-start: %" PRIi32 "\n", lastStart);
-    output->verbose(CALL_INFO, 4, 0, "END: Arbitration ----------------------------------------------------\n");
+    return moved_count;
 }
@@ -31,13 +31,22 @@ namespace Shogun {
         void moveEvents(const int num_events,
                         const int port_count,
                         ShogunQueue<ShogunEvent*>** inputQueues,
+                        ShogunPortMask& inputPending,
                         int32_t output_slots,
                         ShogunEvent*** outputEvents,
+                        ShogunPortMask& outputPending,
                         uint64_t cycle ) override;
 
     private:
         int lastStart;
 
+        int32_t movePortEvents(const int num_events,
+                               const int port,
+                               ShogunQueue<ShogunEvent*>* inputQueue,
+                               int32_t output_slots,
+                               ShogunEvent*** outputEvents,
+                               ShogunPortMask& outputPending);
+
         int nextPort(const int port_count, const int i) const
         {
             return (i + 1) % port_count;
@@ -86,19 +86,17 @@ ShogunComponent::ShogunComponent(ComponentId_t id, Params& params)
     inputQueues = (ShogunQueue<ShogunEvent*>**) malloc( sizeof(ShogunQueue<ShogunEvent*>*) * port_count );
     remote_output_slots = (int*) malloc( sizeof(int) * port_count );
     pendingOutputs = new ShogunEvent**[port_count];
+    outputSlots = new ShogunEvent*[port_count * output_message_slots];
 
     for (int32_t i = 0; i < port_count; ++i) {
         inputQueues[i] = new ShogunQueue<ShogunEvent*>( queue_slots );
         remote_output_slots[i] = 2;
 
-        pendingOutputs[i] = new ShogunEvent*[output_message_slots];
+        pendingOutputs[i] = outputSlots + (i * output_message_slots);
     }
 
-    for (int32_t i = 0; i < port_count; ++i) {
-        for (uint32_t j = 0; j < output_message_slots; ++j) {
-            pendingOutputs[i][j] = new ShogunEvent;
-        }
-    }
+    inputPending = new ShogunPortMask(port_count);
+    outputPending = new ShogunPortMask(port_count);
 
     stats = new ShogunStatisticsBundle(port_count);
     stats->registerStatistics(this);
@@ -117,11 +115,10 @@ ShogunComponent::~ShogunComponent()
     delete arb;
     delete stats;
 
-    for (int32_t i = 0; i < port_count; ++i) {
-        delete [] pendingOutputs[i];
-    }
-
     delete [] pendingOutputs;
+    delete [] outputSlots;
+    delete inputPending;
+    delete outputPending;
 
     //TODO add accumulation of remainder of zero cycles
 }
@@ -145,7 +142,8 @@ bool ShogunComponent::tick(SST::Cycle_t currentCycle)
     printStatus();
 
     // Migrate events across the cross-bar
-    arb->moveEvents( input_message_slots, port_count, inputQueues, output_message_slots, pendingOutputs, static_cast<uint64_t>( currentCycle ) );
+    arb->moveEvents( input_message_slots, port_count, inputQueues, *inputPending, output_message_slots, pendingOutputs, *outputPending,
+        static_cast<uint64_t>( currentCycle ) );
 
     printStatus();
 
@@ -157,10 +155,10 @@ bool ShogunComponent::tick(SST::Cycle_t currentCycle)
     output->verbose(CALL_INFO, 4, 0, "Pending event count: %" PRIi32 "\n", pending_events);
     // If we have pending events to process, then schedule another tick
     if (0 == pending_events) {
+        // Returning true removes the handler from the clock, handleIncoming registers it again
         if (handlerRegistered) {
             output->verbose(CALL_INFO, 4, 0, "De-registering clock handlers, no events pending.\n");
             handlerRegistered = false;
-            //unregisterClock( tc, clockTickHandler );
         }
 
         output->verbose(CALL_INFO, 4, 0, "TICK() END  *****************************************************\n");
@@ -214,9 +212,12 @@ void ShogunComponent::emitOutputs()
 {
     output->verbose(CALL_INFO, 4, 0, "BEGIN: emitOutputs -----------------------------------------------\n");
 
-    for (int32_t i = 0; i < port_count; ++i) {
+    // Only the ports with events in their output slots are visited
+    for (int32_t i = outputPending->findNext(0, port_count); i < port_count; i = outputPending->findNext(i + 1, port_count)) {
         output->verbose(CALL_INFO, 4, 0, "-> Processing port %" PRIi32 ":\n", i);
 
+        bool slotsInUse = false;
+
         for (uint32_t j = 0; j < output_message_slots; ++j) {
             if( nullptr != pendingOutputs[i][j] ) {
                 output->verbose(CALL_INFO, 4, 0, "  -> output is not null, remote-slot-count: %" PRIi32 ", src=%5" PRIi32 "\n", remote_output_slots[i],
@@ -233,9 +234,14 @@ void ShogunComponent::emitOutputs()
                     pending_events--;
                 } else {
                     output->verbose(CALL_INFO, 4, 0, "    -> no free slots, event send disabled for this round (slots: %" PRIi32 ")\n", remote_output_slots[i]);
+                    slotsInUse = true;
                 }
             }
         }
+
+        if (!slotsInUse) {
+            outputPending->clear(i);
+        }
     }
 
     output->verbose(CALL_INFO, 4, 0, "END: emitOutputs -------------------------------------------------\n");
@@ -249,6 +255,7 @@ void ShogunComponent::clearOutputs()
         }
 
         remote_output_slots[i] = inputQueues[i]->capacity();
+        outputPending->clear(i);
     }
 }
 
@@ -256,11 +263,17 @@ void ShogunComponent::clearInputs()
 {
     for (int32_t i = 0; i < port_count; ++i) {
         inputQueues[i]->clear();
+        inputPending->clear(i);
     }
 }
 
 void ShogunComponent::printStatus()
 {
+    // Called several times a cycle, skip walking the ports when nothing would be printed
+    if (output->getVerboseLevel() < 4) {
+        return;
+    }
+
     output->verbose(CALL_INFO, 4, 0, "BEGIN: processing x-bar inputs -----------------------------------------------\n");
     output->verbose(CALL_INFO, 4, 0, "BEGIN X-BAR STATUS REPORT ====================================================\n");
 
@@ -296,6 +309,7 @@ void ShogunComponent::handleIncoming(SST::Event* event)
             incomingShogunEv->getPayload()->dest);
 
         inputQueues[src_port]->push(incomingShogunEv);
+        inputPending->set(src_port);
         pending_events++;
         stats->getInputPacketCount(src_port)->addData(1);
 
@@ -23,6 +23,7 @@
 
 #include "arb/shogunarb.h"
 #include "shogun_event.h"
+#include "shogun_port_mask.h"
 #include "shogun_q.h"
 
 namespace SST {
@@ -107,6 +108,12 @@ private:
 
     ShogunQueue<ShogunEvent*>** inputQueues;
     ShogunEvent*** pendingOutputs;
+    // Backing store of pendingOutputs, output_message_slots entries per port
+    ShogunEvent** outputSlots;
+
+    // Ports with events in their input queue and ports with events in their output slots
+    ShogunPortMask* inputPending;
+    ShogunPortMask* outputPending;
     int32_t* remote_output_slots;
     ShogunArbitrator* arb;
 
@@ -0,0 +1,112 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_PORT_MASK
+#define _H_SHOGUN_PORT_MASK
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Shogun {
+
+    // One bit per crossbar port, used to track which ports have work so
+    // that a cycle only visits those ports.
+    class ShogunPortMask {
+
+    public:
+        ShogunPortMask(const int ports)
+            : port_count(ports)
+            , set_count(0)
+            , words((ports + 63) / 64, 0)
+        {
+        }
+
+        bool test(const int port) const
+        {
+            return 0 != (words[port >> 6] & bit(port));
+        }
+
+        void set(const int port)
+        {
+            if (!test(port)) {
+                words[port >> 6] |= bit(port);
+                set_count++;
+            }
+        }
+
+        void clear(const int port)
+        {
+            if (test(port)) {
+                words[port >> 6] &= ~bit(port);
+                set_count--;
+            }
+        }
+
+        bool none() const
+        {
+            return 0 == set_count;
+        }
+
+        int count() const
+        {
+            return set_count;
+        }
+
+        // Returns the first port in [from, end) whose bit is set, or end
+        // if there is none
+        int findNext(const int from, const int end) const
+        {
+            if (from >= end) {
+                return end;
+            }
+
+            int word = from >> 6;
+            uint64_t bits = words[word] & (~UINT64_C(0) << (from & 63));
+
+            while (true) {
+                if (0 != bits) {
+                    const int port = (word << 6) + __builtin_ctzll(bits);
+                    return port < end ? port : end;
+                }
+
+                if (++word >= (int) words.size() || (word << 6) >= end) {
+                    return end;
+                }
+
+                bits = words[word];
+            }
+        }
+
+        int size() const
+        {
+            return port_count;
+        }
+
+    private:
+        const int port_count;
+        int set_count;
+        std::vector<uint64_t> words;
+
+        static uint64_t bit(const int port)
+        {
+            return UINT64_C(1) << (port & 63);
+        }
+    };
+
+}
+}
+
+#endif
@@ -24,6 +24,9 @@
 #include "lsq/vlsq.h"
 #include "os/vcpuos.h"
 #include "vbranch/vbranchbasic.h"
+#include "vbranch/vbranchbtb.h"
+#include "vbranch/vbranchgshare.h"
+#include "vbranch/vbranchtage.h"
 #include "vbranch/vbranchunit.h"
 #include "velf/velfinfo.h"
 #include "vinsloader.h"
@@ -192,6 +195,7 @@ public:
         ip = newIP;
 
         // Do we need to clear here or not?
+        branch_predictor->recover();
     }
 
     virtual void setStackPointer( SST::Output* output, VanadisISATable* isa_tbl, VanadisRegisterFile* regFile, const uint64_t stack_start_address ) {assert(0);}
@@ -207,6 +211,9 @@ public:
 
         output->verbose(CALL_INFO, 16, 0, "[decoder] -> clear decode-q and set new ip: 0x%" PRI_ADDR "\n", newIP);
 
+        // anything the branch predictor speculated past the last retired branch is gone
+        branch_predictor->recover();
+
         // Clear out the decode queue, need to restart
         // decoded_q->clear();
 
@@ -547,56 +547,29 @@ public:
                                         VanadisSpeculatedInstruction* speculated_ins =
                                             dynamic_cast<VanadisSpeculatedInstruction*>(next_ins);
 
-                                        // Do we have an entry for the branch instruction we just
-                                        // issued
-                                        if ( branch_predictor->contains(ip) ) {
-                                            const uint64_t predicted_address = branch_predictor->predictAddress(ip);
-                                            speculated_ins->setSpeculatedAddress(predicted_address);
-
-                                            // This is essential a predicted not taken branch
-                                            if ( predicted_address == (ip + 8) ) {
-                                                output->verbose(
-                                                    CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                    "---> Branch 0x%" PRI_ADDR " predicted not "
-                                                    "taken, ip set to: 0x%0" PRI_ADDR "\n",
-                                                    ip, predicted_address);
-                                                //												speculated_ins->setSpeculatedDirection(
-                                                // BRANCH_NOT_TAKEN );
-                                            }
-                                            else {
-                                                output->verbose(
-                                                    CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                    "---> Branch 0x%" PRI_ADDR " predicted taken, "
-                                                    "jump to 0x%0" PRI_ADDR "\n",
-                                                    ip, predicted_address);
-                                                //												speculated_ins->setSpeculatedDirection(
-                                                // BRANCH_TAKEN );
-                                            }
-
-                                            ip = predicted_address;
+                                        // Ask the branching unit where the branch goes, if it
+                                        // has no entry we continue with ip += 8 (me + delay)
+                                        const uint64_t predicted_address =
+                                            branch_predictor->predict(ip, speculated_ins, ip + 8);
+                                        speculated_ins->setSpeculatedAddress(predicted_address);
+
+                                        // This is essential a predicted not taken branch
+                                        if ( predicted_address == (ip + 8) ) {
                                             output->verbose(
                                                 CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                "---> Forcing IP update according to branch "
-                                                "prediction table, new-ip: %0" PRI_ADDR "\n",
-                                                ip);
+                                                "---> Branch 0x%" PRI_ADDR " predicted not "
+                                                "taken, ip set to: 0x%0" PRI_ADDR "\n",
+                                                ip, predicted_address);
                                         }
                                         else {
                                             output->verbose(
                                                 CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                "---> Branch table does not contain an "
-                                                "entry for ins: 0x%0" PRI_ADDR ", continue with "
-                                                "normal ip += 8 = 0x%0" PRI_ADDR "\n",
-                                                ip, (ip + 8));
-
-                                            //											speculated_ins->setSpeculatedDirection(
-                                            // BRANCH_NOT_TAKEN );
-                                            speculated_ins->setSpeculatedAddress(ip + 8);
-
-                                            // We don't urgh.. let's just carry on
-                                            // remember we increment the IP by 2 instructions (me +
-                                            // delay)
-                                            ip += 8;
+                                                "---> Branch 0x%" PRI_ADDR " predicted taken, "
+                                                "jump to 0x%0" PRI_ADDR "\n",
+                                                ip, predicted_address);
                                         }
+
+                                        ip = predicted_address;
                                     }
                                 }
 
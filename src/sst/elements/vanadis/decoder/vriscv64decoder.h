@@ -167,39 +167,22 @@ public:
                                 VanadisSpeculatedInstruction* next_spec_ins =
                                     dynamic_cast<VanadisSpeculatedInstruction*>(next_ins);
 
-                                if ( branch_predictor->contains(ip) ) {
-                                    // We have an address predicton from the branching unit
-                                    const uint64_t predicted_address = branch_predictor->predictAddress(ip);
-                                    next_spec_ins->setSpeculatedAddress(predicted_address);
-
-                                    if(output->getVerboseLevel() >= 16) {
-                                        output->verbose(
-                                            CALL_INFO, 16, 0,
-                                            "----> contains a branch: 0x%" PRI_ADDR " / predicted "
-                                            "(found in predictor): 0x%" PRI_ADDR "\n",
-                                            ip, predicted_address);
-                                    }
-
-                                    ip                = predicted_address;
-                                    bundle_has_branch = true;
-                                }
-                                else {
-                                    // We don't have an address prediction
-                                    // so just speculate that we are going to drop through to the
-                                    // next instruction as we aren't sure where this will go yet
-
-                                    if(output->getVerboseLevel() >= 16) {
-                                        output->verbose(
-                                            CALL_INFO, 16, 0,
-                                            "----> contains a branch: 0x%" PRI_ADDR " / predicted "
-                                            "(not-found in predictor): 0x%" PRI_ADDR ", pc-increment: %" PRIu64 "\n",
-                                            ip, ip + 4, bundle->pcIncrement());
-                                    }
-
-                                    ip += bundle->pcIncrement();
-                                    next_spec_ins->setSpeculatedAddress(ip);
-                                    bundle_has_branch = true;
+                                // Ask the branching unit where to go, if it has no idea it
+                                // speculates that we drop through to the next instruction
+                                const uint64_t predicted_address =
+                                    branch_predictor->predict(ip, next_spec_ins, ip + bundle->pcIncrement());
+                                next_spec_ins->setSpeculatedAddress(predicted_address);
+
+                                if(output->getVerboseLevel() >= 16) {
+                                    output->verbose(
+                                        CALL_INFO, 16, 0,
+                                        "----> contains a branch: 0x%" PRI_ADDR " / predicted: 0x%" PRI_ADDR
+                                        ", pc-increment: %" PRIu64 "\n",
+                                        ip, predicted_address, bundle->pcIncrement());
                                 }
+
+                                ip                = predicted_address;
+                                bundle_has_branch = true;
                             }
 
                             thread_rob->push(next_ins->clone());
@@ -43,6 +43,12 @@ public:
 
     const char* getInstCode() const override { return "JL"; }
 
+    // a link to the ignored register (e.g. RISC-V jal x0) is a plain jump
+    VanadisBranchType getBranchType() const override
+    {
+        return (isa_int_regs_out[0] == isa_options->getRegisterIgnoreWrites()) ? VANADIS_BRANCH_JUMP : VANADIS_BRANCH_CALL;
+    }
+
     void printToBuffer(char* buffer, size_t buffer_size) override
     {
         snprintf(buffer, buffer_size, "JL      %" PRIu64 " (0x%" PRI_ADDR ")", takenAddress, takenAddress);
@@ -45,6 +45,12 @@ public:
 
     virtual const char* getInstCode() const { return "JLR"; }
 
+    // a link to the ignored register (e.g. RISC-V jalr x0 / ret) is a plain indirect jump
+    virtual VanadisBranchType getBranchType() const
+    {
+        return (isa_int_regs_out[0] == isa_options->getRegisterIgnoreWrites()) ? VANADIS_BRANCH_INDIRECT : VANADIS_BRANCH_CALL;
+    }
+
     virtual void printToBuffer(char* buffer, size_t buffer_size)
     {
         snprintf(
@@ -38,6 +38,8 @@ public:
 
     virtual const char* getInstCode() const { return "JR"; }
 
+    virtual VanadisBranchType getBranchType() const { return VANADIS_BRANCH_INDIRECT; }
+
     virtual void printToBuffer(char* buffer, size_t buffer_size)
     {
         snprintf(
@@ -24,6 +24,14 @@
 namespace SST {
 namespace Vanadis {
 
+// How a branch is treated by the branch predictors
+enum VanadisBranchType {
+    VANADIS_BRANCH_CONDITIONAL, // taken or not taken
+    VANADIS_BRANCH_JUMP,        // always taken, fixed target
+    VANADIS_BRANCH_CALL,        // always taken and writes a link (return address) register
+    VANADIS_BRANCH_INDIRECT     // always taken to a register address, this includes returns
+};
+
 class VanadisSpeculatedInstruction : public virtual VanadisInstruction
 {
 
@@ -59,6 +67,9 @@ public:
     virtual VanadisDelaySlotRequirement getDelaySlotType() const { return delayType; }
     uint64_t                            getInstructionWidth() const { return ins_width; }
 
+    virtual VanadisBranchType getBranchType() const { return VANADIS_BRANCH_CONDITIONAL; }
+    uint64_t                  getNotTakenAddress() { return calculateStandardNotTakenAddress(); }
+
 protected:
     uint64_t calculateStandardNotTakenAddress()
     {
@@ -22,6 +22,7 @@
 
 #include "lsq/vlsq.h"
 #include "lsq/vbasiclsqentry.h"
+#include "lsq/vstorehash.h"
 #include "util/vsignx.h"
 #include "inst/vstorecond.h"
 
@@ -52,8 +53,9 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 { "max_stores", "Set the maximum number of stores permitted in the queue", "8" },
                 { "max_loads", "Set the maximum number of loads permitted in the queue", "16" },
                 { "address_mask", "Can mask off address bits if needed during construction of a operation", "0xFFFFFFFFFFFFFFFF"},
-                { "issues_per_cycle", "Maximum number of issues the LSQ can attempt per cycle.", "2"},
-                { "cache_line_width", "Number of bytes in a (L1) cache line", "64"}
+                { "issues_per_cycle", "Maximum number of operations the LSQ can issue per cycle, a thread whose oldest operation cannot issue does not use up the issue slots of the others.", "2"},
+                { "cache_line_width", "Number of bytes in a (L1) cache line", "64"},
+                { "store_forwarding", "Forward the value of a pending store to a younger load it fully covers instead of stalling the load until the store has drained", "0"}
             )
 
         SST_ELI_DOCUMENT_STATISTICS({ "bytes_read", "Count all the bytes read for data operations", "bytes", 1 },
@@ -69,7 +71,9 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                                     { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
                                     { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1},
                                     { "split_stores", "Count the number of stores which are fractured due to cache boundaries", "operations", 1},
-                                    { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1})
+                                    { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1},
+                                    { "loads_forwarded", "Count the number of loads satisfied from a pending store", "operations", 1},
+                                    { "load_store_conflicts", "Count the number of times a load could not issue because it partly overlaps a pending store", "operations", 1})
 
 
         VanadisBasicLoadStoreQueue(ComponentId_t id, Params& params, int coreid, int hwthreads) : VanadisLoadStoreQueue(id, params, coreid, hwthreads),
@@ -95,6 +99,9 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             stores_pending_index = 0;
             stores_pending_size = 0;
 
+            store_hash.resize(hw_threads, VanadisStoreAddressHash(max_stores));
+            store_forwarding = params.find<bool>("store_forwarding", false);
+
             stat_loads_issued = registerStatistic<uint64_t>("loads_issued", "1");
             stat_stores_issued = registerStatistic<uint64_t>("stores_issued", "1");
             stat_fences_issued = registerStatistic<uint64_t>("fences_issued", "1");
@@ -110,6 +117,8 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
             stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
             stat_op_q_size = registerStatistic<uint64_t>("operations_pending");
+            stat_loads_forwarded = registerStatistic<uint64_t>("loads_forwarded", "1");
+            stat_load_store_conflicts = registerStatistic<uint64_t>("load_store_conflicts", "1");
         }
 
 
@@ -179,6 +188,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 delete (*store_itr);
                 store_itr = stores_pending[thread].erase(store_itr);
             }
+            store_hash[thread].clear();
         }
 
         // must be implemented to allow the memory system to initialize itself during
@@ -248,13 +258,26 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             stat_stores_pending->addData(std_stores_in_flight.size());
             stat_store_buffer_entries->addData(stores_pending_size);
 
-            // this can be called multiple times per cycle
-            for(uint32_t attempt = 0; attempt < max_issue_attempts_per_cycle; ++attempt) {
-                if (op_q_size == 0)
-                    break;
-                const bool attempt_result = attempt_to_issue(cycle, attempt, op_q_index);
-                op_q_index = (op_q_index + 1) % hw_threads;
+            // issue up to max_issue_attempts_per_cycle operations, taking one from each thread in
+            // turn. A thread whose queue front cannot issue will not be able to this cycle either,
+            // so it drops out and leaves the remaining slots to the other threads.
+            uint32_t issued_this_cycle = 0;
+            uint64_t blocked_threads = 0;
+            const uint64_t all_blocked = (hw_threads >= 64) ? UINT64_MAX : ((UINT64_C(1) << hw_threads) - 1);
+
+            for(int thr = op_q_index; (issued_this_cycle < max_issue_attempts_per_cycle) && (op_q_size > 0) && (blocked_threads != all_blocked); thr = (thr + 1) % hw_threads) {
+                const uint64_t thr_bit = UINT64_C(1) << (thr % 64);
+                if(blocked_threads & thr_bit) {
+                    continue;
+                }
+
+                if(attempt_to_issue(cycle, issued_this_cycle, thr)) {
+                    issued_this_cycle++;
+                } else {
+                    blocked_threads |= thr_bit;
+                }
             }
+            op_q_index = (op_q_index + 1) % hw_threads;
 
             // attempt to issue any front of ROB stores into memory system
             for (int i = 0; i < hw_threads; i++) {
@@ -422,37 +445,11 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
                         if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
                             reg_width = lsq->registerFiles->at(target_thread)->getIntRegWidth();
-                            std::vector<uint8_t> register_value(reg_width);
-                            // copy entire register here
-                            lsq->registerFiles->at(target_thread)->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
-
+                            assert(reg_width <= MAX_REGISTER_WIDTH);
                             assert((reg_offset + addr_offset + ev->size) <= reg_width);
 
-                            for(auto i = 0; i < ev->size; ++i) {
-                                register_value.at(reg_offset + addr_offset + i) = ev->data[i];
-                            }
-
-                            // if we are the last request to be processed for this load (if any were split)
-                            // and we promised to do sign extension, then perform it now
-                            if(load_entry->countRequests() == 1) {
-                                if(load_ins->performSignExtension()) {
-                                    if((register_value.at(reg_offset + addr_offset + load_width - 1) & 0x80) != 0) {
-                                        for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                            register_value.at(i) = 0xFF;
-                                        }
-                                    } else {
-                                        for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                            register_value.at(i) = 0x00;
-                                        }
-                                    }
-                                } else {
-                                    for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                        register_value.at(i) = 0x00;
-                                    }
-                                }
-                            }
-
-                            lsq->registerFiles->at(target_thread)->copyToIntRegister(target_reg, 0, &register_value[0], register_value.size());
+                            lsq->writeIntLoadValue(load_ins, target_thread, target_reg, reg_width, reg_offset + addr_offset,
+                                &ev->data[0], ev->size, (load_entry->countRequests() == 1) ? load_width : 0);
                         }
                         }
                     } break;
@@ -464,24 +461,26 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
 
                         reg_width = lsq->registerFiles->at(target_thread)->getFPRegWidth();
-                        std::vector<uint8_t> register_value(reg_width);
+                        assert(reg_width <= MAX_REGISTER_WIDTH);
+                        uint8_t register_value[MAX_REGISTER_WIDTH];
 
                         // copy entire register here
-                        lsq->registerFiles->at(target_thread)->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
+                        lsq->registerFiles->at(target_thread)->copyFromFPRegister(target_reg, 0, register_value, reg_width);
 
                         assert((reg_offset + addr_offset + ev->size) <= reg_width);
 
                         for(auto i = reg_offset + addr_offset; i < ev->size; ++i) {
-                            register_value.at(reg_offset + addr_offset + i) = ev->data[i];
+                            assert((reg_offset + addr_offset + i) < reg_width);
+                            register_value[reg_offset + addr_offset + i] = ev->data[i];
                         }
 
                         if(load_entry->countRequests() == 1) {
                             for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                register_value.at(i) = 0xff;
+                                register_value[i] = 0xff;
                             }
                         }
 
-                        lsq->registerFiles->at(target_thread)->copyToFPRegister(target_reg, 0, &register_value[0], reg_width);
+                        lsq->registerFiles->at(target_thread)->copyToFPRegister(target_reg, 0, register_value, reg_width);
                         }
                     } break;
                     default:
@@ -555,6 +554,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                                 processLLSC(ev,store_ins,store_entry);
 
                                 store_ins->markExecuted();
+                                lsq->store_hash[thr].remove(store_entry->getStoreAddress(), store_entry->getStoreWidth());
                                 lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                                 lsq->stores_pending_size--;
                                 delete store_entry;
@@ -563,6 +563,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                             case MEM_TRANSACTION_LOCK:
                             {
                                 store_ins->markExecuted();
+                                lsq->store_hash[thr].remove(store_entry->getStoreAddress(), store_entry->getStoreWidth());
                                 lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                                 lsq->stores_pending_size--;
                                 delete store_entry;
@@ -634,6 +635,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     // this was a standard store (not LLSC/LOCK) and we issued into system successfully
                     if(LIKELY(issue_result))
                     {
+                        store_hash[thr].remove(current_store->getStoreAddress(), current_store->getStoreWidth());
                         stores_pending[thr].pop_front();
                         stores_pending_size--;
 
@@ -967,20 +969,21 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
         {
             output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG,
                 "In sendLoadReq (ScalarLSQ) hw_thr:%d\n", load_ins->getHWThread());
-            std::vector<uint64_t> load_addresses;
-            std::vector<uint16_t> load_widths;
+            uint64_t load_address = 0;
+            uint16_t load_width = 0;
+            bool needs_memory = false;
 
             output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, " (ScalarLSQ) -> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 "\n",
             load_ins->getInstructionAddress(), load_ins->getHWThread());
             bool result = load_process(load_ins->getHWThread(),load_ins,
-                    load_addresses, load_widths);
+                    &load_address, &load_width, &needs_memory);
 
-            output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, " (ScalarLSQ) -> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " result=%s #load_address=%lu #load_widths=%lu...\n",
-                    load_ins->getInstructionAddress(), load_ins->getHWThread(), (result==true) ? "success":"fail", load_addresses.size(), load_widths.size());
+            output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, " (ScalarLSQ) -> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " result=%s memory-request=%s...\n",
+                    load_ins->getInstructionAddress(), load_ins->getHWThread(), (result==true) ? "success":"fail", needs_memory ? "yes" : "no");
 
-            if(LIKELY((load_addresses.size()>0) & (load_widths.size()>0)))
+            if(LIKELY(needs_memory))
             {
-                issueLoad(load_ins, load_addresses[0], load_widths[0]);
+                issueLoad(load_ins, load_address, load_width);
             }
             return result;
         }
@@ -1007,6 +1010,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, " (ScalarLSQ) -> queue front is store: ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " has issued so will process...\n",
                         new_pending_store->getStoreInstruction()->getInstructionAddress(), new_pending_store->getStoreInstruction()->getHWThread());
                 stores_pending[store_ins->getHWThread()].push_back(new_pending_store);
+                store_hash[store_ins->getHWThread()].add(new_pending_store->getStoreAddress(), new_pending_store->getStoreWidth());
                 stores_pending_size++;
             }
             return true;
@@ -1147,8 +1151,11 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             return false;
         }
 
+        // Computes the load address and checks it against the pending stores. Returns false if
+        // the load cannot issue yet. needs_memory is set when the load must be sent to the
+        // memory system, it is left clear when the load traps or was satisfied by a store.
         bool load_process(uint32_t sw_thr,VanadisLoadInstruction* load_ins,
-                        std::vector<uint64_t>& load_addresses, std::vector<uint16_t>& load_widths )
+                        uint64_t* load_address_out, uint16_t* load_width_out, bool* needs_memory)
         {
             VanadisRegisterFile* hw_thr_reg = registerFiles->at(sw_thr);
             uint64_t load_address = 0;
@@ -1165,8 +1172,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / hw_thr: %" PRIu32 "sw_thr: %" PRIu32 " traps error, will not process and allow pipeline to handle \n",
                         load_ins->getInstructionAddress(), load_ins->getHWThread(), sw_thr);
                     // load_ins->setNumLoads(0);
-                    load_addresses.clear();
-                    load_widths.clear();
+                    *needs_memory = false;
                     return true;
                 }
             }
@@ -1179,9 +1185,21 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 }
 
                 // check to see if loading from this address would conflict with a store which
-                // we have pending, if yes, wait for conflict to clear and then we can proceed
-                if(UNLIKELY(checkStoreConflict(load_ins->getHWThread(), load_address, load_width)))
+                // we have pending. If the youngest such store covers the whole load, take the
+                // value from it, otherwise wait for the conflict to clear and then we can proceed
+                VanadisBasicStorePendingEntry* conflict_store = checkStoreConflict(load_ins->getHWThread(), load_address, load_width);
+
+                if(UNLIKELY(nullptr != conflict_store) && forwardStore(load_ins, conflict_store, load_address, load_width))
+                {
+                    output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " satisfied from store ins: 0x%" PRI_ADDR "\n",
+                        load_ins->getInstructionAddress(), load_ins->getHWThread(), conflict_store->getInstructionAddress());
+                    *needs_memory = false;
+                    return true;
+                }
+                else if(UNLIKELY(nullptr != conflict_store))
                 {
+                    stat_load_store_conflicts->addData(1);
+
                     if(output->getVerboseLevel() >= 16)
                     {
                         output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " conflicts with store entry, will not issue until conflict is resolved (load-addr: 0x%" PRI_ADDR " / width: %" PRIu32 ")\n",
@@ -1205,8 +1223,9 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     {
                         output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> issue LLSC/LOCK LOAD possible sw_thr=%d\n", sw_thr);
                         // issueLoad(load_ins, load_address, load_width);
-                        load_addresses.push_back(load_address);
-                        load_widths.push_back(load_width);
+                        *load_address_out = load_address;
+                        *load_width_out = load_width;
+                        *needs_memory = true;
                     }
                 }
                 else
@@ -1214,8 +1233,9 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     // We are good to issue with all checks completed!
                     // issueLoad(load_ins, load_address, load_width);
                     output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "--> issue LOAD possible sw_thr=%d\n", sw_thr);
-                    load_addresses.push_back(load_address);
-                    load_widths.push_back(load_width);
+                    *load_address_out = load_address;
+                    *load_width_out = load_width;
+                    *needs_memory = true;
                 }
             }
             return true;
@@ -1304,26 +1324,134 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             return matchID;
         }
 
-        bool checkStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width)
+        // Returns the youngest pending store which overlaps the address range, or nullptr
+        VanadisBasicStorePendingEntry* checkStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width)
         {
-            bool conflicts = false;
+            // nothing in the store buffer touches these bytes
+            if(LIKELY(!store_hash[thread].mayOverlap(address, width))) {
+                return nullptr;
+            }
 
-            for(auto store_itr = stores_pending[thread].begin(); store_itr != stores_pending[thread].end(); store_itr++) {
+            for(auto store_itr = stores_pending[thread].rbegin(); store_itr != stores_pending[thread].rend(); store_itr++) {
                 VanadisBasicStorePendingEntry* current_entry = (*store_itr);
 
                 if(UNLIKELY(current_entry->storeAddressOverlaps(address, width))) {
-                    conflicts = true;
-                    break;
+                    return current_entry;
                 }
             }
 
-            return conflicts;
+            return nullptr;
+        }
+
+        // Satisfy a load from the youngest older store that overlaps it. Only plain stores which
+        // cover every byte of a plain load are forwarded, anything else waits for the store to
+        // drain. Returns true if the load has been executed.
+        bool forwardStore(VanadisLoadInstruction* load_ins, VanadisBasicStorePendingEntry* store_entry,
+            const uint64_t load_address, const uint16_t load_width)
+        {
+            VanadisStoreInstruction* store_ins = store_entry->getStoreInstruction();
+
+            const uint64_t store_address = store_entry->getStoreAddress();
+            const uint64_t store_width = store_entry->getStoreWidth();
+            const uint32_t reg_offset = load_ins->getRegisterOffset();
+
+            if(!store_forwarding || (load_ins->getTransactionType() != MEM_TRANSACTION_NONE) ||
+                (store_ins->getTransactionType() != MEM_TRANSACTION_NONE) ||
+                (load_address < store_address) || ((load_address + load_width) > (store_address + store_width)) ||
+                (store_width > MAX_REGISTER_WIDTH) || (load_width > MAX_REGISTER_WIDTH) ||
+                // these are flagged as errors when they reach the memory system
+                (load_address < 64) || operationStraddlesCacheLine(load_address, load_width)) {
+                return false;
+            }
+
+            uint16_t store_thread;
+            uint16_t store_reg;
+            uint8_t store_value[MAX_REGISTER_WIDTH];
+
+            getStoreTarget(store_entry, store_ins, &store_thread, &store_reg);
+            registerFiles->at(store_thread)->copyFromRegister(store_reg, store_ins->getRegisterOffset(), store_value, store_width,
+                store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
+            const uint8_t* load_value = &store_value[load_address - store_address];
+            const uint32_t load_thread = load_ins->getHWThread();
+
+            switch(load_ins->getValueRegisterType()) {
+            case LOAD_INT_REGISTER:
+            {
+                const uint16_t target_reg = load_ins->getPhysIntRegOut(0);
+                const uint32_t reg_width = registerFiles->at(load_thread)->getIntRegWidth();
+
+                if((reg_width > MAX_REGISTER_WIDTH) || ((reg_offset + load_width) > reg_width)) {
+                    return false;
+                }
+
+                if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
+                    writeIntLoadValue(load_ins, load_thread, target_reg, reg_width, reg_offset, load_value, load_width, load_width);
+                }
+            } break;
+            case LOAD_FP_REGISTER:
+            {
+                const uint16_t target_reg = load_ins->getPhysFPRegOut(0);
+                const uint32_t reg_width = registerFiles->at(load_thread)->getFPRegWidth();
+
+                // the memory path places FP data at offset 0 and fills the rest with ones
+                if((0 != reg_offset) || (reg_width > MAX_REGISTER_WIDTH) || (load_width > reg_width)) {
+                    return false;
+                }
+
+                uint8_t register_value[MAX_REGISTER_WIDTH];
+                std::memcpy(register_value, load_value, load_width);
+                std::memset(&register_value[load_width], 0xff, reg_width - load_width);
+
+                registerFiles->at(load_thread)->copyToFPRegister(target_reg, 0, register_value, reg_width);
+            } break;
+            default:
+                return false;
+            }
+
+            load_ins->markExecuted();
+            stat_loads_executed->addData(1);
+            stat_loads_forwarded->addData(1);
+            return true;
+        }
+
+        // Copies data into bytes [offset, offset + size) of an integer register. When the load is
+        // complete (extend_width is the full width of the load, otherwise 0) the bytes above the
+        // loaded value are sign or zero extended.
+        void writeIntLoadValue(VanadisLoadInstruction* load_ins, uint32_t thread, uint16_t target_reg, uint32_t reg_width,
+            uint64_t offset, const uint8_t* data, uint64_t size, uint64_t extend_width)
+        {
+            uint8_t register_value[MAX_REGISTER_WIDTH];
+
+            // copy entire register here
+            registerFiles->at(thread)->copyFromIntRegister(target_reg, 0, register_value, reg_width);
+
+            std::memcpy(&register_value[offset], data, size);
+
+            // if we are the last request to be processed for this load (if any were split)
+            // and we promised to do sign extension, then perform it now
+            if(extend_width > 0) {
+                const uint64_t extend_from = offset + extend_width;
+                assert(extend_from <= reg_width);
+                uint8_t fill = 0x00;
+
+                if(load_ins->performSignExtension() && ((register_value[extend_from - 1] & 0x80) != 0)) {
+                    fill = 0xFF;
+                }
+
+                for(auto i = extend_from; i < reg_width; ++i) {
+                    register_value[i] = fill;
+                }
+            }
+
+            registerFiles->at(thread)->copyToIntRegister(target_reg, 0, register_value, reg_width);
         }
 
 
         // Per-hardware-thread queues
         std::vector< std::deque<VanadisBasicLoadStoreEntry*> > op_q;
         std::vector< std::deque<VanadisBasicStorePendingEntry*> > stores_pending;
+        std::vector<VanadisStoreAddressHash> store_hash; // addresses covered by stores_pending, per thread
         std::deque<VanadisBasicLoadPendingEntry*> loads_pending;
         std::set<StandardMem::Request::id_t> std_stores_in_flight;
         int op_q_index; // Next hw_thread to check in op_q queues
@@ -1341,6 +1469,10 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
         uint64_t cache_line_width;
         uint64_t address_mask;
+        bool store_forwarding;
+
+        // widest register the load/store paths copy through
+        static constexpr uint32_t MAX_REGISTER_WIDTH = 16;
 
         Statistic<uint64_t>* stat_store_buffer_entries;
         Statistic<uint64_t>* stat_op_q_size;
@@ -1356,6 +1488,8 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
         Statistic<uint64_t>* stat_split_loads;
         Statistic<uint64_t>* stat_stored_bytes;
         Statistic<uint64_t>* stat_loaded_bytes;
+        Statistic<uint64_t>* stat_loads_forwarded;
+        Statistic<uint64_t>* stat_load_store_conflicts;
 };
 
 } // namespace SST
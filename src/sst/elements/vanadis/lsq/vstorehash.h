@@ -0,0 +1,78 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_STORE_ADDRESS_HASH
+#define _H_VANADIS_STORE_ADDRESS_HASH
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Counting hash of the addresses covered by the stores in a store buffer, at 8-byte
+// granularity. A load whose granules all have a zero count cannot overlap any store
+// in the buffer, so the common no-conflict case is answered with one or two table
+// reads rather than a walk of the buffer. A non-zero count may be a hash collision,
+// the caller then searches the buffer itself to find the overlapping store.
+class VanadisStoreAddressHash {
+public:
+    explicit VanadisStoreAddressHash(size_t max_stores) : bits(6) {
+        // keep the table sparse so collisions are rare
+        while ( (UINT64_C(1) << bits) < (max_stores * 8) ) {
+            bits++;
+        }
+        counts.assign(UINT64_C(1) << bits, 0);
+    }
+
+    void add(uint64_t address, uint64_t width) { update(address, width, 1); }
+    void remove(uint64_t address, uint64_t width) { update(address, width, -1); }
+
+    void clear() { std::fill(counts.begin(), counts.end(), 0); }
+
+    bool mayOverlap(uint64_t address, uint64_t width) const {
+        if ( 0 == width ) { return false; }
+
+        const uint64_t last = (address + width - 1) >> GRANULE_BITS;
+        for ( uint64_t granule = address >> GRANULE_BITS; granule <= last; ++granule ) {
+            if ( counts[slot(granule)] != 0 ) { return true; }
+        }
+        return false;
+    }
+
+private:
+    static constexpr uint32_t GRANULE_BITS = 3;
+
+    size_t slot(uint64_t granule) const { return (granule * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - bits); }
+
+    void update(uint64_t address, uint64_t width, int32_t delta) {
+        if ( 0 == width ) { return; }
+
+        const uint64_t last = (address + width - 1) >> GRANULE_BITS;
+        for ( uint64_t granule = address >> GRANULE_BITS; granule <= last; ++granule ) {
+            counts[slot(granule)] += delta;
+        }
+    }
+
+    uint32_t              bits;
+    std::vector<uint32_t> counts;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
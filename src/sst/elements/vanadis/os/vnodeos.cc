@@ -19,6 +19,13 @@
 
 #include <functional>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sst/core/util/filesystem.h>
+
 #include "vanadisDbgFlags.h"
 
 #include "os/vcheckpointreq.h"
@@ -29,13 +36,15 @@
 #include "os/voscallev.h"
 #include "os/velfloader.h"
 #include "os/vstartthreadreq.h"
+#include "os/vtranslatereq.h"
 #include "os/vdumpregsreq.h"
 #include "sst/elements/mmu/utils.h"
 
 using namespace SST::Vanadis;
 
 VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Params& params)
-    : SST::Component(id), m_mmu(nullptr), m_physMemMgr(nullptr), m_currentTid(100)
+    : SST::Component(id), m_mmu(nullptr), m_physMemMgr(nullptr), m_currentTid(100), m_backdoorMem(nullptr), m_backdoorLink(nullptr),
+        m_functionalCoreCount(0)
 {
 
     const uint32_t verbosity = params.find<uint32_t>("dbgLevel", 0);
@@ -70,6 +79,8 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
         output->fatal(CALL_INFO, -1, "Missing parameter (%s): 'cores' must be specified and at least 1.\n", getName().c_str());
     }
 
+    m_functionalCore.resize( m_coreCount, false );
+
     for ( int i = 0; i < m_coreCount; i++ ) {
         for ( int j = 0; j < m_hardwareThreadCount; j++ ) {
             m_availHwThreads.push( new OS::HwThreadID( i,j ) );
@@ -97,6 +108,22 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
 
     m_pageSize = params.find<uint64_t>("page_size", 4096);
     m_pageShift = log2( m_pageSize );
+    m_physMemSize = physMemSize.getRoundedValue();
+
+    m_backdoorFile = params.find<std::string>("backdoor_file", "");
+    m_backdoorBase = params.find<uint64_t>("backdoor_base_addr", 0);
+    if ( ! m_backdoorFile.empty() ) {
+        // find the file where the memory controller puts its backing_out_file
+        std::string backdoorInFile = params.find<std::string>("backdoor_in_file", "");
+        if ( ! backdoorInFile.empty() && backdoorInFile != m_backdoorFile ) {
+            m_backdoorFile = SST::Util::Filesystem::getAbsolutePath( m_backdoorFile, getOutputDirectory() );
+        }
+
+        std::string latency = params.find<std::string>("backdoor_page_latency", "100ns");
+        m_backdoorLink = configureSelfLink("backdoor", latency,
+            new Event::Handler2<VanadisNodeOSComponent,&VanadisNodeOSComponent::handleBackdoorDone>(this));
+        m_physPageInstalled.resize( m_physMemSize >> m_pageShift, false );
+    }
 
     if ( params.find<bool>("useMMU",false) ) { ;
         m_mmu = loadUserSubComponent<SST::MMU_Lib::MMU>("mmu");
@@ -203,6 +230,9 @@ if ( CHECKPOINT_LOAD != m_checkpoint ) {
 }
 
 VanadisNodeOSComponent::~VanadisNodeOSComponent() {
+    if ( nullptr != m_backdoorMem ) {
+        munmap( m_backdoorMem, m_physMemSize );
+    }
     delete output;
     delete m_physMemMgr;
 }
@@ -226,6 +256,11 @@ VanadisNodeOSComponent::init(unsigned int phase) {
 void
 VanadisNodeOSComponent::setup() {
 
+    // the memory controller creates (and truncates) its backing file in its constructor
+    if ( ! m_backdoorFile.empty() ) {
+        openBackdoor();
+    }
+
     if ( CHECKPOINT_LOAD == m_checkpoint ) return;
 
     // start all of the processes
@@ -315,6 +350,7 @@ VanadisNodeOSComponent::checkpoint( std::string dir )
 
     assert( m_pendingFault.empty() );
     assert( m_blockMemoryWriteReqQ.empty() );
+    assert( m_backdoorFlushMap.empty() && m_backdoorDone.empty() );
     assert( m_memRespMap.empty() );
 }
 
@@ -478,6 +514,18 @@ int VanadisNodeOSComponent::checkpointLoad( std::string dir )
 }
 
 void VanadisNodeOSComponent::handleIncomingMemoryCallback(StandardMem::Request* ev) {
+    auto backdoor_result = m_backdoorFlushMap.find(ev->getID());
+    if ( backdoor_result != m_backdoorFlushMap.end() ) {
+        BackdoorWrite* write = backdoor_result->second;
+        m_backdoorFlushMap.erase(backdoor_result);
+        delete ev;
+
+        if ( 0 == --write->pendingFlushes ) {
+            finishBackdoorWrite( write );
+        }
+        return;
+    }
+
     auto lookup_result = m_memRespMap.find(ev->getID());
 
     if ( lookup_result == m_memRespMap.end() )  {
@@ -510,13 +558,211 @@ void VanadisNodeOSComponent::handleIncomingMemoryCallback(StandardMem::Request*
     }
 }
 
-void VanadisNodeOSComponent::copyPage( uint64_t physFrom, uint64_t physTo, unsigned pageSize,Callback* callback )
+void VanadisNodeOSComponent::openBackdoor()
+{
+    int fd = open( m_backdoorFile.c_str(), O_RDWR );
+    if ( fd < 0 ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open backdoor_file %s, %s. It must be the memory controller's backing_out_file, set backdoor_in_file if the memory controller has a backing_in_file\n",
+            m_backdoorFile.c_str(), strerror(errno));
+    }
+
+    struct stat file_stat;
+    if ( 0 != fstat( fd, &file_stat ) || (uint64_t) file_stat.st_size < m_physMemSize ) {
+        output->fatal(CALL_INFO, -1, "Error: backdoor_file %s is smaller than physMemSize (%" PRIu64 " bytes), is it the memory controller's backing_out_file?\n",
+            m_backdoorFile.c_str(), m_physMemSize);
+    }
+
+    void* mem = mmap( nullptr, m_physMemSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+
+    if ( MAP_FAILED == mem ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to mmap backdoor_file %s, %s\n", m_backdoorFile.c_str(), strerror(errno));
+    }
+
+    m_backdoorMem = (uint8_t*) mem;
+
+    // we don't know which pages the restored processes are using
+    if ( CHECKPOINT_LOAD == m_checkpoint ) {
+        std::fill( m_physPageInstalled.begin(), m_physPageInstalled.end(), true );
+    }
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_INIT, "installing pages through backdoor %s\n", m_backdoorFile.c_str());
+}
+
+uint8_t* VanadisNodeOSComponent::backdoorAddr( uint64_t physAddr, uint64_t length )
+{
+    if ( physAddr < m_backdoorBase || physAddr + length > m_backdoorBase + m_physMemSize ) {
+        output->fatal(CALL_INFO, -1, "Error: physical address %#" PRIx64 " is outside of the backdoor\n", physAddr);
+    }
+    return m_backdoorMem + (physAddr - m_backdoorBase);
+}
+
+void VanadisNodeOSComponent::backdoorWritePage( uint64_t physAddr, uint8_t* data, unsigned pageSize, Callback* callback )
+{
+    backdoorAddr( physAddr, pageSize );
+
+    BackdoorWrite* write = new BackdoorWrite( physAddr, data, pageSize, callback );
+    uint64_t ppn = (physAddr - m_backdoorBase) >> m_pageShift;
+
+    if ( m_physPageInstalled[ppn] ) {
+        // the page was in use before so caches may hold its old contents, a dirty line would
+        // overwrite the new data when evicted. Write back and invalidate every line first.
+        for ( unsigned offset = 0; offset < pageSize; offset += 64 ) {
+            StandardMem::Request* req = new SST::Interfaces::StandardMem::FlushAddr( physAddr + offset, 64, true, 10 );
+            m_backdoorFlushMap[req->getID()] = write;
+            write->pendingFlushes++;
+            mem_if->send(req);
+        }
+    } else {
+        finishBackdoorWrite( write );
+    }
+}
+
+void VanadisNodeOSComponent::finishBackdoorWrite( BackdoorWrite* write )
+{
+    output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_PAGE_FAULT,"backdoor write physAddr=%#" PRIx64 " length=%u\n", write->physAddr, write->length);
+
+    memcpy( backdoorAddr( write->physAddr, write->length ), write->data, write->length );
+    m_physPageInstalled[(write->physAddr - m_backdoorBase) >> m_pageShift] = true;
+
+    // the page is complete once the modeled latency has passed
+    m_backdoorDone.push( write->callback );
+    m_backdoorLink->send( nullptr );
+
+    delete[] write->data;
+    delete write;
+}
+
+void VanadisNodeOSComponent::backdoorReadPage( uint64_t physAddr, uint8_t* data, unsigned pageSize, Callback* callback )
+{
+    output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_PAGE_FAULT,"backdoor read physAddr=%#" PRIx64 " length=%u\n", physAddr, pageSize);
+
+    memcpy( data, backdoorAddr( physAddr, pageSize ), pageSize );
+
+    m_backdoorDone.push( callback );
+    m_backdoorLink->send( nullptr );
+}
+
+void VanadisNodeOSComponent::handleFunctionalModeReq( VanadisFunctionalModeReq* req )
+{
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_INIT, "core %d %s functional execution\n", req->coreId, req->enable ? "starts" : "ends");
+
+    if ( req->enable && ( m_backdoorFile.empty() || nullptr == m_mmu ) ) {
+        output->fatal(CALL_INFO, -1, "Error: core %d fast-forwards functionally, the OS needs backdoor_file and useMMU\n", req->coreId);
+    }
+
+    if ( req->enable != m_functionalCore.at( req->coreId ) ) {
+        m_functionalCore.at( req->coreId ) = req->enable;
+        if ( req->enable ) {
+            ++m_functionalCoreCount;
+        } else {
+            --m_functionalCoreCount;
+        }
+    }
+
+    delete req;
+}
+
+void VanadisNodeOSComponent::handleTranslateReq( VanadisTranslateReq* req )
+{
+    unsigned core = req->coreId;
+    unsigned hwThread = req->hwThread;
+    uint64_t virtAddr = req->virtAddr;
+    uint32_t wantPerms = req->isWrite ? 1 << 1 : 1 << 2;
+    delete req;
+
+    auto process = m_coreInfoMap.at(core).getProcess( hwThread );
+    if ( nullptr == process ) {
+        output->fatal(CALL_INFO, -1, "Error: translation request from core %d, hwThread %d which has no process\n", core, hwThread);
+    }
+
+    unsigned pid = process->getpid();
+    uint32_t vpn = virtAddr >> m_pageShift;
+
+    output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_PAGE_FAULT, "core %d hwThread %d pid %d virtAddr=%#" PRIx64 " perms=%#x\n",
+        core, hwThread, pid, virtAddr, wantPerms);
+
+    int perms = m_mmu->getPerms( pid, vpn );
+    if ( perms > -1 && MMU_Lib::checkPerms( wantPerms, perms ) ) {
+        sendTranslateResp( core, hwThread, pid, vpn, wantPerms );
+        return;
+    }
+
+    // fault the page in as a TLB miss would, then look it up again
+    auto callback = new Callback( [=]() {
+        sendTranslateResp( core, hwThread, pid, vpn, wantPerms );
+    });
+    pageFaultHandler2( -1, -1, core, hwThread, pid, vpn, wantPerms, 0, virtAddr, nullptr, callback );
+}
+
+void VanadisNodeOSComponent::sendTranslateResp( unsigned core, unsigned hwThread, unsigned pid, uint32_t vpn, uint32_t wantPerms )
+{
+    int perms = -1;
+    if ( m_threadMap.find(pid) != m_threadMap.end() ) {
+        perms = m_mmu->getPerms( pid, vpn );
+    }
+
+    bool success = perms > -1 && MMU_Lib::checkPerms( wantPerms, perms );
+    uint64_t physAddr = success ? ( (uint64_t) m_mmu->virtToPhys( pid, (uint64_t) vpn ) ) << m_pageShift : 0;
+
+    core_links.at(core)->send( new VanadisTranslateResp( hwThread, (uint64_t) vpn << m_pageShift, physAddr, m_pageSize,
+        success ? perms : 0, success ) );
+}
+
+void VanadisNodeOSComponent::functionalMemoryEvent( VanadisSyscall* syscall, StandardMem::Request* req )
+{
+    m_functionalMemQ.push( std::make_pair( syscall, req ) );
+
+    // a response usually leads straight to the syscall's next request, serve those here
+    // rather than recursing through handleIncomingMemory()
+    if ( m_functionalMemQ.size() > 1 ) {
+        return;
+    }
+
+    while ( ! m_functionalMemQ.empty() ) {
+        VanadisSyscall* next_syscall = m_functionalMemQ.front().first;
+        StandardMem::Request* next_req = m_functionalMemQ.front().second;
+        StandardMem::Request* resp = next_req->makeResponse();
+
+        if ( auto read = dynamic_cast<StandardMem::Read*>( next_req ) ) {
+            auto read_resp = static_cast<StandardMem::ReadResp*>( resp );
+            read_resp->data.resize( read->size );
+            memcpy( read_resp->data.data(), backdoorAddr( read->pAddr, read->size ), read->size );
+        } else if ( auto load_link = dynamic_cast<StandardMem::LoadLink*>( next_req ) ) {
+            auto read_resp = static_cast<StandardMem::ReadResp*>( resp );
+            read_resp->data.resize( load_link->size );
+            memcpy( read_resp->data.data(), backdoorAddr( load_link->pAddr, load_link->size ), load_link->size );
+        } else if ( auto write = dynamic_cast<StandardMem::Write*>( next_req ) ) {
+            memcpy( backdoorAddr( write->pAddr, write->size ), write->data.data(), write->size );
+        } else if ( auto store_cond = dynamic_cast<StandardMem::StoreConditional*>( next_req ) ) {
+            // nothing else runs between the load-link and this
+            memcpy( backdoorAddr( store_cond->pAddr, store_cond->size ), store_cond->data.data(), store_cond->size );
+        } else {
+            output->fatal(CALL_INFO, -1, "Error: unexpected syscall memory request %s from a functional core\n", next_req->getString().c_str());
+        }
+
+        delete next_req;
+        handleIncomingMemory( next_syscall, resp );
+        m_functionalMemQ.pop();
+    }
+}
+
+void VanadisNodeOSComponent::handleBackdoorDone( SST::Event* ev )
+{
+    // every completion is sent with the same latency so they arrive in order
+    Callback* callback = m_backdoorDone.front();
+    m_backdoorDone.pop();
+
+    (*callback)();
+    delete callback;
+}
+
+void VanadisNodeOSComponent::copyPage( uint64_t physFrom, uint64_t physTo, unsigned pageSize, unsigned core, Callback* callback )
 {
     auto data = new uint8_t[m_pageSize];
     Callback* tmp = new Callback( [=](){
         writePage( physTo, data, pageSize, callback );
     });
-    readPage( physFrom, data, pageSize, tmp );
+    readPage( physFrom, data, pageSize, core, tmp );
 }
 
 void
@@ -593,6 +839,18 @@ VanadisNodeOSComponent::handleIncomingSyscallEvent(SST::Event* ev) {
     VanadisSyscallEvent* sys_ev = dynamic_cast<VanadisSyscallEvent*>(ev);
 
     if (nullptr == sys_ev) {
+        VanadisTranslateReq* translate_req = dynamic_cast<VanadisTranslateReq*>(ev);
+        if ( nullptr != translate_req ) {
+            handleTranslateReq( translate_req );
+            return;
+        }
+
+        VanadisFunctionalModeReq* mode_req = dynamic_cast<VanadisFunctionalModeReq*>(ev);
+        if ( nullptr != mode_req ) {
+            handleFunctionalModeReq( mode_req );
+            return;
+        }
+
         VanadisCoreEvent* event = dynamic_cast<VanadisCoreEvent*>(ev);
 
         if ( nullptr != event ) {
@@ -687,12 +945,13 @@ void VanadisNodeOSComponent::processOsPageFault( VanadisSyscall* syscall, uint64
 }
 
 void VanadisNodeOSComponent::pageFaultHandler2( MMU_Lib::RequestID reqId, unsigned link, unsigned core, unsigned hwThread,
-                unsigned pid,  uint32_t vpn, uint32_t faultPerms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall )
+                unsigned pid,  uint32_t vpn, uint32_t faultPerms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall,
+                Callback* callback )
 {
     output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT, "RequestID=%#" PRIx64 " link=%d pid=%d vpn=%d perms=%#x instPtr=%#" PRIx64 " syscall=%p\n",
             reqId, link, pid, vpn, faultPerms, instPtr, syscall );
 
-    auto tmp = new PageFault( reqId, link, core, hwThread, pid, vpn, faultPerms, instPtr, memVirtAddr, syscall );
+    auto tmp = new PageFault( reqId, link, core, hwThread, pid, vpn, faultPerms, instPtr, memVirtAddr, syscall, callback );
     m_pendingFault.push( tmp );
     if ( 1 == m_pendingFault.size() ) {
         pageFault( tmp );
@@ -706,7 +965,11 @@ void VanadisNodeOSComponent::pageFaultFini( PageFault* info, bool success )
     output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"link=%d pid=%d vpn=%d %#" PRIx32 " %s\n",
                 info->link,info->pid,info->vpn, info->vpn << m_pageShift, success ? "success":"fault" );
 
-    if( info->syscall ) {
+    if ( info->callback ) {
+        // a functional core's translation, the callback reads the page table itself
+        (*info->callback)();
+        delete info->callback;
+    } else if( info->syscall ) {
         auto ev = info->syscall->getMemoryRequest();
         assert(ev);
         sendMemoryEvent(info->syscall, ev );
@@ -800,7 +1063,9 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
             auto callback = new Callback( [=]() {
                 pageFaultFini( info );
             });
-            copyPage( origPPN << m_pageShift, newPage->getPPN() << m_pageShift, m_pageSize, callback );
+            // a syscall's fault carries no core, the syscall knows which one it came from
+            unsigned core = info->syscall ? info->syscall->getCoreId() : info->core;
+            copyPage( origPPN << m_pageShift, newPage->getPPN() << m_pageShift, m_pageSize, core, callback );
             return;
         }
 
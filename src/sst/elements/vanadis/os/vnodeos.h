@@ -26,6 +26,7 @@
 #include "os/include/hwThreadID.h"
 #include "os/voscallev.h"
 #include "os/vstartthreadreq.h"
+#include "os/vtranslatereq.h"
 #include "os/vappruntimememory.h"
 #include "os/vphysmemmanager.h"
 #include "os/include/process.h"
@@ -57,6 +58,10 @@ public:
                             { "physMemSize", "Size of available physical memory in bytes, with units. Ex: 2GiB", NULL },
                             { "page_size", "Size of a page, in bytes", "4096" },
                             { "useMMU", "Whether an MMU subcomponent is being used.", "False" },
+                            { "backdoor_file", "If set, pages the OS fills (ELF segments, zero pages, copy-on-write copies) are installed directly in this file rather than written through the memory hierarchy. It must be the backing_out_file of the memory controller (backing=mmap) holding all of physical memory", "" },
+                            { "backdoor_in_file", "The memory controller's backing_in_file, if it has one. The memory controller then places its backing_out_file in the output directory, and a relative backdoor_file is looked up there too", "" },
+                            { "backdoor_base_addr", "Physical address held at offset 0 of backdoor_file", "0" },
+                            { "backdoor_page_latency", "Latency charged for each page installed through the backdoor", "100ns" },
                             { "process%(processnum)d.env_count", "Number of environment variables to pass to the process", "0"},
                             { "process%(processnum)d.env%(argnum)d", "Environment variable to pass to the process. Example: 'OMPNUMTHREADS=64'. 'argnum' should be contiguous starting at 0 and ending at env_count-1", ""},
                             { "proccess%(processnum)d.exe", "Name of executable, including path", NULL},
@@ -126,9 +131,9 @@ private:
 
     struct PageFault {
         PageFault(MMU_Lib::RequestID reqId, unsigned link, unsigned core,unsigned hwThread, unsigned pid,  uint32_t vpn,
-                            uint32_t faultPerms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall )
+                            uint32_t faultPerms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall, Callback* callback )
             : reqId(reqId), link(link), core(core), hwThread(hwThread), pid(pid), vpn(vpn), faultPerms(faultPerms),
-                instPtr(instPtr), memVirtAddr(memVirtAddr), syscall(syscall) {}
+                instPtr(instPtr), memVirtAddr(memVirtAddr), syscall(syscall), callback(callback) {}
         MMU_Lib::RequestID reqId;
         unsigned link;
         unsigned core;
@@ -139,6 +144,7 @@ private:
         uint64_t instPtr;
         uint64_t memVirtAddr;
         VanadisSyscall* syscall;
+        Callback* callback;
     };
 
 
@@ -164,14 +170,26 @@ private:
     }
 
     void pageFaultHandler2( MMU_Lib::RequestID, unsigned link, unsigned core, unsigned hwThread,  unsigned pid,
-        uint32_t vpn, uint32_t perms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall = nullptr );
+        uint32_t vpn, uint32_t perms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall = nullptr,
+        Callback* callback = nullptr );
+
+    // A core fast-forwarding functionally reads and writes memory through the backing file,
+    // the OS hands it translations and serves its syscalls' memory accesses from the backdoor
+    void handleFunctionalModeReq( VanadisFunctionalModeReq* req );
+    void handleTranslateReq( VanadisTranslateReq* req );
+    void sendTranslateResp( unsigned core, unsigned hwThread, unsigned pid, uint32_t vpn, uint32_t wantPerms );
+    void functionalMemoryEvent( VanadisSyscall* syscall, StandardMem::Request* req );
 
     void pageFault( PageFault* );
     void pageFaultFini( PageFault*, bool success = true );
     void startProcess( OS::HwThreadID&, OS::ProcessInfo* process );
-    void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, Callback* );
+    void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, unsigned core, Callback* );
 
     void sendMemoryEvent(VanadisSyscall* syscall, StandardMem::Request* ev ) {
+        if ( m_functionalCoreCount > 0 && m_functionalCore.at( syscall->getCoreId() ) ) {
+            functionalMemoryEvent( syscall, ev );
+            return;
+        }
         m_memRespMap.insert(std::pair<StandardMem::Request::id_t, VanadisSyscall*>(ev->getID(), syscall));
         mem_if->send(ev);
     }
@@ -180,12 +198,40 @@ private:
 
     void writePage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
     {
-        queueBlockMemoryReq( new PageMemWriteReq( mem_if, physAddr, page_size, data, callback ) );
+        if ( nullptr != m_backdoorMem ) {
+            backdoorWritePage( physAddr, data, page_size, callback );
+        } else {
+            queueBlockMemoryReq( new PageMemWriteReq( mem_if, physAddr, page_size, data, callback ) );
+        }
     }
 
-    void readPage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
+    // A page being installed through the backdoor, waiting for any cached copies of
+    // its previous contents to be written back and invalidated
+    struct BackdoorWrite {
+        BackdoorWrite( uint64_t physAddr, uint8_t* data, unsigned length, Callback* callback ) :
+            physAddr(physAddr), data(data), length(length), callback(callback), pendingFlushes(0) {}
+        uint64_t physAddr;
+        uint8_t* data;
+        unsigned length;
+        Callback* callback;
+        unsigned pendingFlushes;
+    };
+
+    void openBackdoor();
+    uint8_t* backdoorAddr( uint64_t physAddr, uint64_t length );
+    void backdoorWritePage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback );
+    void backdoorReadPage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback );
+    void finishBackdoorWrite( BackdoorWrite* );
+    void handleBackdoorDone( SST::Event* );
+
+    void readPage( uint64_t physAddr, uint8_t* data, unsigned page_size, unsigned core, Callback* callback )
     {
-        queueBlockMemoryReq( new PageMemReadReq( mem_if, physAddr, page_size, data, callback ) );
+        // a functional core's writes are only in the backing file
+        if ( m_functionalCoreCount > 0 && m_functionalCore.at( core ) ) {
+            backdoorReadPage( physAddr, data, page_size, callback );
+        } else {
+            queueBlockMemoryReq( new PageMemReadReq( mem_if, physAddr, page_size, data, callback ) );
+        }
     }
 
     void queueBlockMemoryReq( PageMemReq* req ) {
@@ -408,6 +454,24 @@ private:
     void checkpoint( std::string dir );
     int checkpointLoad( std::string dir );
     std::deque<uint64_t> m_flushPages;
+
+    // backdoor into the memory controller's backing store, see writePage()
+    std::string                 m_backdoorFile;
+    uint64_t                    m_backdoorBase;
+    uint64_t                    m_physMemSize;
+    uint8_t*                    m_backdoorMem;
+    SST::Link*                  m_backdoorLink;
+    // physical pages that have been handed to a process, their lines may be in a cache
+    std::vector<bool>           m_physPageInstalled;
+    // completions waiting out backdoor_page_latency, in the order they were sent
+    std::queue<Callback*>       m_backdoorDone;
+    std::unordered_map<StandardMem::Request::id_t, BackdoorWrite*> m_backdoorFlushMap;
+
+    // cores executing functionally, see handleFunctionalModeReq()
+    std::vector<bool>           m_functionalCore;
+    unsigned                    m_functionalCoreCount;
+    // syscall memory requests being served from the backdoor, see functionalMemoryEvent()
+    std::queue< std::pair<VanadisSyscall*, StandardMem::Request*> > m_functionalMemQ;
 };
 
 } // namespace Vanadis
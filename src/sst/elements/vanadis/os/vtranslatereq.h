@@ -0,0 +1,105 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_TRANSLATE_REQ
+#define _H_VANADIS_TRANSLATE_REQ
+
+#include <sst/core/event.h>
+
+namespace SST {
+namespace Vanadis {
+
+// Sent by a core when it starts or stops executing functionally. While a core is
+// functional the OS serves its syscall memory accesses through the backdoor.
+class VanadisFunctionalModeReq : public SST::Event {
+public:
+    VanadisFunctionalModeReq() : SST::Event(), coreId(-1), enable(false) { }
+    VanadisFunctionalModeReq(int coreId, bool enable) : SST::Event(), coreId(coreId), enable(enable) { }
+
+    ~VanadisFunctionalModeReq() {}
+
+    int  coreId;
+    bool enable;
+
+private:
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        SST_SER(coreId);
+        SST_SER(enable);
+    }
+
+    ImplementSerializable(SST::Vanadis::VanadisFunctionalModeReq);
+};
+
+// A functional core asking for the page holding virtAddr, the OS takes the page fault if
+// the page is not mapped or, for a write, not writable
+class VanadisTranslateReq : public SST::Event {
+public:
+    VanadisTranslateReq() : SST::Event(), coreId(-1), hwThread(-1), virtAddr(0), isWrite(false) { }
+    VanadisTranslateReq(int coreId, int hwThread, uint64_t virtAddr, bool isWrite) :
+        SST::Event(), coreId(coreId), hwThread(hwThread), virtAddr(virtAddr), isWrite(isWrite) { }
+
+    ~VanadisTranslateReq() {}
+
+    int      coreId;
+    int      hwThread;
+    uint64_t virtAddr;
+    bool     isWrite;
+
+private:
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        SST_SER(coreId);
+        SST_SER(hwThread);
+        SST_SER(virtAddr);
+        SST_SER(isWrite);
+    }
+
+    ImplementSerializable(SST::Vanadis::VanadisTranslateReq);
+};
+
+class VanadisTranslateResp : public SST::Event {
+public:
+    VanadisTranslateResp() : SST::Event(), hwThread(-1), virtAddr(0), physAddr(0), pageSize(0), perms(0), success(false) { }
+    VanadisTranslateResp(int hwThread, uint64_t virtAddr, uint64_t physAddr, uint64_t pageSize, uint32_t perms, bool success) :
+        SST::Event(), hwThread(hwThread), virtAddr(virtAddr), physAddr(physAddr), pageSize(pageSize), perms(perms), success(success) { }
+
+    ~VanadisTranslateResp() {}
+
+    int      hwThread;
+    uint64_t virtAddr;  // start of the page
+    uint64_t physAddr;  // start of the physical page
+    uint64_t pageSize;
+    uint32_t perms;
+    bool     success;
+
+private:
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        SST_SER(hwThread);
+        SST_SER(virtAddr);
+        SST_SER(physAddr);
+        SST_SER(pageSize);
+        SST_SER(perms);
+        SST_SER(success);
+    }
+
+    ImplementSerializable(SST::Vanadis::VanadisTranslateResp);
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
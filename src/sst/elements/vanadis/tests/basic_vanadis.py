@@ -67,7 +67,11 @@ sst.setProgramOption("stop-at", "0 ns")
 
 # Tell SST what statistics handling we want
 sst.setStatisticLoadLevel(4)
-sst.setStatisticOutput("sst.statOutputConsole")
+stats_file = os.getenv("VANADIS_STATS_FILE", "")
+if stats_file != "":
+    sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : stats_file, "separator" : ","})
+else:
+    sst.setStatisticOutput("sst.statOutputConsole")
 
 full_exe_name = os.getenv("VANADIS_EXE", "./small/" + testDir + "/" + exe +  "/" + isa + "/" + exe )
 exe_name= full_exe_name.split("/")[-1]
@@ -88,12 +92,41 @@ integer_arith_units = int(os.getenv("VANADIS_INTEGER_ARITH_UNITS", 2))
 fp_arith_cycles = int(os.getenv("VANADIS_FP_ARITH_CYCLES", 8))
 fp_arith_units = int(os.getenv("VANADIS_FP_ARITH_UNITS", 2))
 branch_arith_cycles = int(os.getenv("VANADIS_BRANCH_ARITH_CYCLES", 2))
+branch_unit = os.getenv("VANADIS_BRANCH_UNIT", "VanadisBasicBranchUnit")
 
 cpu_clock = os.getenv("VANADIS_CPU_CLOCK", "2.3GHz")
 
 numCpus = int(os.getenv("VANADIS_NUM_CORES", 1))
 numThreads = int(os.getenv("VANADIS_NUM_HW_THREADS", 1))
 
+# Fast-forward functionally for this many instructions, then run warmup instructions in
+# detail before the statistics start. The cores, the OS and the memory controller then
+# share memory through an mmap'ed backing file.
+fast_forward_instructions = int(os.getenv("VANADIS_FAST_FORWARD_INSTRUCTIONS", 0))
+fast_forward_warmup = int(os.getenv("VANADIS_FAST_FORWARD_WARMUP", 0))
+fast_forward_memory_file = "vanadis_memory.bin"
+
+# The OS installs the pages it fills straight into that backing file rather than
+# writing them through the memory hierarchy, fast-forwarding needs it
+backdoor = fast_forward_instructions > 0 or int(os.getenv("VANADIS_BACKDOOR", 0)) > 0
+
+# SimPoint-style sampling (see tools/simpoint/vanadis-simpoint.py), 0 disables
+bbv_interval = int(os.getenv("VANADIS_BBV_INTERVAL", 0))
+detailed_instructions = int(os.getenv("VANADIS_DETAILED_INSTRUCTIONS", 0))
+
+# Each core, its TLBs and its caches are kept in one partition (setNoCut), so the
+# only links a parallel run can cut are the ones from a core to the node: the OS
+# link, the MMU links and the L2 to router link. SST synchronizes partitions once
+# per the smallest latency on a cut link, so raising these latencies to a common
+# lookahead lets the cores run that far ahead of each other between
+# synchronizations. The price is that much extra latency on every syscall, TLB miss
+# and L2 miss, which changes simulated timing. Setting VANADIS_LOOKAHEAD (e.g.
+# "20ns") applies it to all of these links. It is unset by default, and the links
+# keep their 5ns (OS) and 1ns latencies.
+lookahead = os.getenv("VANADIS_LOOKAHEAD", "")
+os_link_latency = lookahead if lookahead else "5ns"
+node_link_latency = lookahead if lookahead else "1ns"
+
 vanadis_cpu_type = "vanadis."
 vanadis_cpu_type += os.getenv("VANADIS_CPU_ELEMENT_NAME","dbg_VanadisCPU")
 
@@ -145,6 +178,9 @@ osParams = {
     "checkpoint" : checkpoint
 }
 
+if backdoor:
+    osParams["backdoor_file"] = fast_forward_memory_file
+
 processList = (
     ( 1, {
         "env_count" : 1,
@@ -214,6 +250,10 @@ memCtrlParams = {
       "checkpoint" : checkpoint
 }
 
+if backdoor:
+    memCtrlParams["backing"] = "mmap"
+    memCtrlParams["backing_out_file"] = fast_forward_memory_file
+
 memParams = {
       "mem_size" : "4GiB",
       "access_time" : "1 ns"
@@ -270,6 +310,17 @@ cpuParams = {
     "checkpoint" : checkpoint
 }
 
+if fast_forward_instructions > 0:
+    cpuParams["fast_forward_instructions"] = fast_forward_instructions
+    cpuParams["fast_forward_warmup_instructions"] = fast_forward_warmup
+    cpuParams["fast_forward_memory_file"] = fast_forward_memory_file
+
+if bbv_interval > 0:
+    cpuParams["bbv_interval"] = bbv_interval
+
+if detailed_instructions > 0:
+    cpuParams["detailed_instructions"] = detailed_instructions
+
 lsqParams = {
     "verbose" : verbosity,
     "address_mask" : 0xFFFFFFFF,
@@ -354,7 +405,7 @@ class CPU_Builder:
             os_hdlr.addParams( osHdlrParams )
 
             # CPU.decocer.branch_pred
-            branch_pred = decode.setSubComponent( "branch_unit", "vanadis.VanadisBasicBranchUnit" )
+            branch_pred = decode.setSubComponent( "branch_unit", "vanadis." + branch_unit )
             branch_pred.addParams( branchPredParams )
             branch_pred.enableAllStatistics()
 
@@ -393,6 +444,8 @@ class CPU_Builder:
         dtlbWrapper = sst.Component(prefix+".dtlb", "mmu.tlb_wrapper")
         dtlbWrapper.addParams(tlbWrapperParams)
 #        dtlbWrapper.addParam( "debug_level", 0)
+        # translate the loads/stores the LSQ issues in one cycle together
+        dtlbWrapper.addParam("batch",True)
         dtlb = dtlbWrapper.setSubComponent("tlb", "mmu." + tlbType );
         dtlb.addParams(tlbParams)
 
@@ -439,7 +492,7 @@ class CPU_Builder:
         link_bus_l2cache_link.connect( (cache_bus, "lowlink0", "1ns"), (cpu_l2cache, "highlink", "1ns") )
         link_bus_l2cache_link.setNoCut()
 
-        return (cpu, "os_link", "5ns"), (l2cache_2_mem, "port", "1ns") , (dtlb, "mmu", "1ns"), (itlb, "mmu", "1ns")
+        return (cpu, "os_link", os_link_latency), (l2cache_2_mem, "port", node_link_latency) , (dtlb, "mmu", node_link_latency), (itlb, "mmu", node_link_latency)
 
 
 def addParamsPrefix(prefix,params):
@@ -548,17 +601,17 @@ for cpu in range(numCpus):
 
     # MMU -> dtlb
     link_mmu_dtlb_link = sst.Link(prefix + ".link_mmu_dtlb_link")
-    link_mmu_dtlb_link.connect( (node_os_mmu, "core"+ str(cpu) +".dtlb", "1ns"), dtlb )
+    link_mmu_dtlb_link.connect( (node_os_mmu, "core"+ str(cpu) +".dtlb", node_link_latency), dtlb )
 
     # MMU -> itlb
     link_mmu_itlb_link = sst.Link(prefix + ".link_mmu_itlb_link")
-    link_mmu_itlb_link.connect( (node_os_mmu, "core"+ str(cpu) +".itlb", "1ns"), itlb )
+    link_mmu_itlb_link.connect( (node_os_mmu, "core"+ str(cpu) +".itlb", node_link_latency), itlb )
 
     # CPU os handler -> node OS
     link_core_os_link = sst.Link(prefix + ".link_core_os_link")
-    link_core_os_link.connect( os_hdlr, (node_os, "core" + str(cpu), "5ns") )
+    link_core_os_link.connect( os_hdlr, (node_os, "core" + str(cpu), os_link_latency) )
 
     # connect cpu L2 to router
     link_l2cache_2_rtr = sst.Link(prefix + ".link_l2cache_2_rtr")
-    link_l2cache_2_rtr.connect( l2cache, (comp_chiprtr, "port" + str(cpu), "1ns") )
+    link_l2cache_2_rtr.connect( l2cache, (comp_chiprtr, "port" + str(cpu), node_link_latency) )
 
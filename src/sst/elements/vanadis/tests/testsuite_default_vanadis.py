@@ -4,10 +4,15 @@ from sst_unittest import *
 from sst_unittest_support import *
 from sst_unittest_parameterized import parameterized
 import subprocess
+import sys
 
 module_init = 0
 module_sema = threading.Semaphore()
 vanadis_test_matrix = []
+vanadis_branch_test_matrix = []
+vanadis_fast_forward_test_matrix = []
+vanadis_backdoor_test_matrix = []
+vanadis_parallel_test_matrix = []
 
 MakeTests = False
 #MakeTests = True
@@ -124,10 +129,116 @@ def build_vanadis_test_matrix():
         test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec )
         vanadis_test_matrix.append(test_data)
 
+def build_vanadis_branch_test_matrix():
+    global vanadis_branch_test_matrix
+    vanadis_branch_test_matrix = []
+    testlist = []
+
+    # The program output does not depend on the predictor, so each predictor
+    # directory holds the same vanadis.stdout/stderr gold as its parent
+    branch_units = [["VanadisBTBBranchUnit", "btb"], ["VanadisGShareBranchUnit", "gshare"], ["VanadisTAGEBranchUnit", "tage"]]
+
+    location="small/basic-ops"
+    tests = ["test-branch"]
+    arch_list = ["mipsel","riscv64"]
+    for test in tests:
+        for arch in arch_list:
+            for unit, golddir in branch_units:
+                testlist.append(["basic_vanadis.py", location, test, arch, 1, 1, golddir, unit, 300])
+
+    # calls and returns through the return address stack
+    location="small/basic-io"
+    tests = ["hello-world-cpp"]
+    arch_list = ["riscv64"]
+    for test in tests:
+        for arch in arch_list:
+            for unit, golddir in branch_units:
+                testlist.append(["basic_vanadis.py", location, test, arch, 1, 1, golddir, unit, 300])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, branchUnit, timeout_sec = test_info
+        testname = "{0}_{1}_{2}_{3}".format(elftestdir.replace("/", "_"), elffile,isa,goldfiledir)
+
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, branchUnit, timeout_sec )
+        vanadis_branch_test_matrix.append(test_data)
+
+def build_vanadis_fast_forward_test_matrix():
+    global vanadis_fast_forward_test_matrix
+    vanadis_fast_forward_test_matrix = []
+    testlist = []
+
+    # Fast-forward functionally into the loop (the program retires about 600000
+    # instructions), then finish in detail. The program output must match the detailed
+    # run, so each fastforward directory holds the same vanadis.stdout/stderr gold as
+    # its parent
+    location="small/basic-ops"
+    tests = ["test-branch"]
+    arch_list = ["mipsel","riscv64"]
+    for test in tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test, arch, 1, 1, "fastforward", {"VANADIS_FAST_FORWARD_INSTRUCTIONS" : "300000", "VANADIS_FAST_FORWARD_WARMUP" : "20000"}, 300])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, timeout_sec = test_info
+        testname = "{0}_{1}_{2}_{3}".format(elftestdir.replace("/", "_"), elffile,isa,goldfiledir)
+
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, timeout_sec )
+        vanadis_fast_forward_test_matrix.append(test_data)
+
+def build_vanadis_backdoor_test_matrix():
+    global vanadis_backdoor_test_matrix
+    vanadis_backdoor_test_matrix = []
+    testlist = []
+
+    # The OS installs the pages it fills (ELF segments, zero pages, copy-on-write copies
+    # after fork) directly in the memory controller's backing file, the program output
+    # must not change so each backdoor directory holds the same gold as the detailed run
+    location="small/basic-io"
+    testlist.append(["basic_vanadis.py", location, "hello-world", "riscv64", 1, 1, "backdoor", {"VANADIS_BACKDOOR" : "1"}, 300])
+    location="small/misc"
+    testlist.append(["basic_vanadis.py", location, "fork", "riscv64", 2, 1, "backdoor", {"VANADIS_BACKDOOR" : "1"}, 300])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, timeout_sec = test_info
+        testname = "{0}_{1}_{2}_{3}".format(elftestdir.replace("/", "_"), elffile,isa,goldfiledir)
+
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, timeout_sec )
+        vanadis_backdoor_test_matrix.append(test_data)
+
+def build_vanadis_parallel_test_matrix():
+    global vanadis_parallel_test_matrix
+    vanadis_parallel_test_matrix = []
+    testlist = []
+
+    # Two cores on two threads, with the links between each core and the node raised to
+    # a common lookahead. The latencies change the timing but not the program output, so
+    # the lookahead directory holds the same gold as gold1
+    location="small/misc"
+    tests = ["pthread"]
+    arch_list = ["riscv64"]
+    for test in tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test, arch, 2, 1, "lookahead", {"VANADIS_LOOKAHEAD" : "20ns"}, 2, 300])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, numSimThreads, timeout_sec = test_info
+        testname = "{0}_{1}_{2}_{3}".format(elftestdir.replace("/", "_"), elffile,isa,goldfiledir)
+
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, numSimThreads, timeout_sec )
+        vanadis_parallel_test_matrix.append(test_data)
+
 ################################################################################
 
 # At startup, build the test matrix
 build_vanadis_test_matrix()
+build_vanadis_branch_test_matrix()
+build_vanadis_fast_forward_test_matrix()
+build_vanadis_backdoor_test_matrix()
+build_vanadis_parallel_test_matrix()
 
 def gen_custom_name(testcase_func, param_num, param):
 # Full TestCaseName
@@ -165,9 +276,130 @@ class testcase_vanadis(SSTTestCase):
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa, timeout_sec))
         self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec )
 
+    @parameterized.expand(vanadis_branch_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_branch_predictors(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, branchUnit, timeout_sec):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis branch predictor test #{0} ({1}): branch_unit={2}".format(testnum, testname, branchUnit))
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, branchUnit )
+
+    @parameterized.expand(vanadis_fast_forward_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_fast_forward(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, timeout_sec):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis fast-forward test #{0} ({1}): {2}".format(testnum, testname, extraEnv))
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, extraEnv=extraEnv )
+
+    @parameterized.expand(vanadis_backdoor_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_backdoor(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, timeout_sec):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis backdoor test #{0} ({1})".format(testnum, testname))
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, extraEnv=extraEnv )
+
+        # the OS mapped the memory controller's backing file
+        outdir = "{0}/vanadis_tests/{1}/{2}/{3}/{4}".format(self.get_test_output_run_dir(), elftestdir, elffile, isa, goldfiledir)
+        self.assertTrue(os.path.isfile("{0}/vanadis_memory.bin".format(outdir)), "backdoor_file was not created in {0}".format(outdir))
+
+    @parameterized.expand(vanadis_parallel_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_parallel(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, extraEnv, numSimThreads, timeout_sec):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis parallel test #{0} ({1}): {2} threads, {3}".format(testnum, testname, numSimThreads, extraEnv))
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, extraEnv=extraEnv, numSimThreads=numSimThreads )
+
+    def test_vanadis_simpoint(self):
+        isa = "riscv64"
+        self._checkSkipConditions( isa )
+
+        # Profile test-branch, pick simpoints from its basic-block vectors, run each one
+        # fast-forwarded with a detailed window and combine the statistics
+        interval = 100000
+        warmup = 10000
+        test_path = self.get_testsuite_dir()
+        elftestdir = "small/basic-ops"
+        elffile = "test-branch"
+        outdir = "{0}/vanadis_tests/simpoint".format(self.get_test_output_run_dir())
+        os.makedirs(outdir)
+
+        sdlfile = "{0}/basic_vanadis.py".format(test_path)
+        tool = "{0}/../tools/simpoint/vanadis-simpoint.py".format(test_path)
+        os.environ['VANADIS_EXE'] = "{0}/{1}/{2}/{3}/{2}".format(test_path, elftestdir, elffile, isa)
+        os.environ['VANADIS_ISA'] = "RISCV64"
+        os.environ['VANADIS_NUM_CORES'] = "1"
+        os.environ['VANADIS_NUM_HW_THREADS'] = "1"
+        os.environ['VANADIS_BRANCH_UNIT'] = "VanadisBasicBranchUnit"
+        for name in ["VANADIS_FAST_FORWARD_INSTRUCTIONS", "VANADIS_FAST_FORWARD_WARMUP", "VANADIS_DETAILED_INSTRUCTIONS", "VANADIS_BACKDOOR"]:
+            os.environ.pop(name, None)
+
+        # 1. profile, the program still runs to completion
+        profiledir = "{0}/profile".format(outdir)
+        os.makedirs(profiledir)
+        os.environ['VANADIS_BBV_INTERVAL'] = str(interval)
+        self.run_sst(sdlfile, "{0}/sst.out".format(profiledir), "{0}/sst.err".format(profiledir), set_cwd=profiledir, timeout_sec=300)
+        os.environ.pop('VANADIS_BBV_INTERVAL')
+
+        ref_os_outfile = "{0}/{1}/{2}/{3}/vanadis.stdout.gold".format(test_path, elftestdir, elffile, isa)
+        self.assertTrue(testing_compare_diff("simpoint_profile", "{0}/stdout-100".format(profiledir), ref_os_outfile),
+            "Vanadis profiling run output does not match {0}".format(ref_os_outfile))
+
+        bbvfile = "{0}/node0.cpu0.0.bb".format(profiledir)
+        with open(bbvfile) as f:
+            num_intervals = sum(1 for line in f if line.startswith("T"))
+        self.assertTrue(num_intervals > 1, "{0} holds {1} intervals".format(bbvfile, num_intervals))
+
+        # 2. cluster
+        rtn = OSCommand("{0} {1} cluster {2} --out {3}/app".format(sys.executable, tool, bbvfile, outdir), set_cwd=outdir).run()
+        self.assertTrue(rtn.result() == 0, "vanadis-simpoint.py cluster failed:\n{0}".format(rtn.output()))
+
+        rtn = OSCommand("{0} {1} params {2}/app.simpoints --interval {3} --warmup {4}".format(sys.executable, tool, outdir, interval, warmup), set_cwd=outdir).run()
+        self.assertTrue(rtn.result() == 0, "vanadis-simpoint.py params failed:\n{0}".format(rtn.output()))
+
+        # 3. simulate each simpoint
+        stats = []
+        last_interval = {}
+        for line in rtn.output().splitlines():
+            if not line.startswith("simpoint"):
+                continue
+            cluster = int(line.split()[1].rstrip(":"))
+            params = dict(field.split("=") for field in line.split()[2:])
+            start = int(params["fast_forward_instructions"]) + int(params["fast_forward_warmup_instructions"])
+            last_interval[cluster] = (start // interval) == (num_intervals - 1)
+
+            rundir = "{0}/simpoint{1}".format(outdir, cluster)
+            os.makedirs(rundir)
+            statsfile = "{0}/stats.csv".format(rundir)
+            os.environ['VANADIS_FAST_FORWARD_INSTRUCTIONS'] = params["fast_forward_instructions"]
+            os.environ['VANADIS_FAST_FORWARD_WARMUP'] = params["fast_forward_warmup_instructions"]
+            os.environ['VANADIS_DETAILED_INSTRUCTIONS'] = params["detailed_instructions"]
+            os.environ['VANADIS_STATS_FILE'] = statsfile
+            self.run_sst(sdlfile, "{0}/sst.out".format(rundir), "{0}/sst.err".format(rundir), set_cwd=rundir, timeout_sec=300)
+            stats.append("{0}={1}".format(cluster, statsfile))
+
+        for name in ["VANADIS_FAST_FORWARD_INSTRUCTIONS", "VANADIS_FAST_FORWARD_WARMUP", "VANADIS_DETAILED_INSTRUCTIONS", "VANADIS_STATS_FILE"]:
+            os.environ.pop(name, None)
+        self.assertTrue(len(stats) > 0, "vanadis-simpoint.py chose no simpoints")
+
+        # 4. combine, each run measured its window only (the last interval may be shorter)
+        for spec in stats:
+            cluster = int(spec.split("=")[0])
+            rtn = OSCommand("{0} {1} combine {2}/app.weights {3}".format(sys.executable, tool, outdir, spec), set_cwd=outdir).run()
+            self.assertTrue(rtn.result() == 0, "vanadis-simpoint.py combine failed:\n{0}".format(rtn.output()))
+            retired = [float(row.split(",")[-1]) for row in rtn.output().splitlines()
+                       if row.startswith("node0.cpu0,instructions_retired,") and ",Sum." in row]
+            self.assertTrue(len(retired) == 1, "no instructions_retired sum for simpoint {0}".format(cluster))
+            if last_interval[cluster]:
+                self.assertTrue(0 < retired[0] <= interval, "simpoint {0} retired {1} instructions".format(cluster, retired[0]))
+            else:
+                # the core stops at the end of the cycle the limit is reached in
+                self.assertTrue(interval <= retired[0] < interval + 16, "simpoint {0} retired {1} instructions, expected {2}".format(cluster, retired[0], interval))
+
+        rtn = OSCommand("{0} {1} combine {2}/app.weights {3}".format(sys.executable, tool, outdir, " ".join(stats)), set_cwd=outdir).run()
+        self.assertTrue(rtn.result() == 0, "vanadis-simpoint.py combine failed:\n{0}".format(rtn.output()))
+
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, testtimeout=120, branchUnit="VanadisBasicBranchUnit", extraEnv={}, numSimThreads=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}/{3}/{4}".format(self.get_test_output_run_dir(), elftestdir,elffile,isa,goldfiledir)
@@ -202,11 +434,18 @@ class testcase_vanadis(SSTTestCase):
 
         os.environ['VANADIS_NUM_CORES'] = str(numCores)
         os.environ['VANADIS_NUM_HW_THREADS'] = str(numHwThreads)
+        os.environ['VANADIS_BRANCH_UNIT'] = branchUnit
+
+        # knobs of basic_vanadis.py only some tests set, cleared for the others
+        for name in ["VANADIS_FAST_FORWARD_INSTRUCTIONS", "VANADIS_FAST_FORWARD_WARMUP", "VANADIS_BBV_INTERVAL",
+                     "VANADIS_DETAILED_INSTRUCTIONS", "VANADIS_STATS_FILE", "VANADIS_BACKDOOR", "VANADIS_LOOKAHEAD"]:
+            os.environ.pop(name, None)
+        os.environ.update(extraEnv)
 
         testfile_exists = os.path.exists(testfilepath) and os.path.isfile(testfilepath)
         self.assertTrue(testfile_exists, "Vanadis test {0} does not exist".format(testfilepath))
 
-        oscmd = self.run_sst(sdlfile, sst_outfile, sst_errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, timeout_sec=testtimeout)
+        oscmd = self.run_sst(sdlfile, sst_outfile, sst_errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, num_threads=numSimThreads, timeout_sec=testtimeout)
 
         # Perform the tests
         # Verify that the errfile from SST is empty
@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+"""SimPoint-style sampling for Vanadis.
+
+The workflow has three steps:
+
+1. Profile: run the workload once with the core parameter bbv_interval set, e.g.
+   bbv_interval=100000000. Each hardware thread writes <prefix>.<thread>.bb.
+
+2. Cluster: pick representative intervals and their weights.
+
+     vanadis-simpoint.py cluster app.0.bb --out app
+
+   This writes app.simpoints and app.weights in the SimPoint format.
+
+3. Simulate each simpoint in detail (the runs are independent and can be run in
+   parallel) and combine the statistics.
+
+     vanadis-simpoint.py params app.simpoints --interval 100000000 --warmup 10000000
+     vanadis-simpoint.py combine app.weights 0=stats0.csv 1=stats1.csv ...
+
+   'params' prints the fast-forward, warmup and detailed_instructions core
+   parameters for each simpoint. Fast-forward executes the instructions before the
+   interval functionally against the memory backing file (see the core's
+   fast_forward_memory_file), without the timed pipeline or the cache hierarchy.
+   There are no architectural checkpoints, so every run re-executes its prefix
+   functionally; --warmup then runs that many instructions of the prefix in detail
+   to warm the caches and branch predictors before the measured window.
+
+   A core's own statistics are off until its measured window starts; it records
+   that cycle in its measured_window_start statistic, and the last core to start
+   its window dumps every statistic. 'combine' reads the SST csv statistic output
+   of each run, subtracts that dump from the end-of-run values of every other
+   component so the fast-forward and warmup are not counted, and prints the
+   weighted per-interval value of each statistic's Sum and Count fields (Min, Max
+   and histogram bins cannot be split at the window start and are left out).
+"""
+
+import argparse
+import csv
+import math
+import random
+import sys
+
+
+def read_bbv(path):
+    vectors = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("T"):
+                continue
+            vec = {}
+            for field in line[1:].split():
+                _, block, count = field.split(":")
+                vec[int(block)] = int(count)
+            vectors.append(vec)
+    return vectors
+
+
+def project(vectors, dim, rng):
+    # Normalize each vector so intervals of different length compare by their mix
+    # of blocks, then reduce to 'dim' dimensions with a random linear projection
+    proj = {}
+    points = []
+    for vec in vectors:
+        total = float(sum(vec.values())) or 1.0
+        point = [0.0] * dim
+        for block, count in vec.items():
+            row = proj.get(block)
+            if row is None:
+                row = [rng.uniform(-1.0, 1.0) for _ in range(dim)]
+                proj[block] = row
+            w = count / total
+            for d in range(dim):
+                point[d] += w * row[d]
+        points.append(point)
+    return points
+
+
+def dist2(a, b):
+    return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+
+def kmeans(points, k, rng, iterations=100):
+    # k-means++ seeding
+    centers = [list(rng.choice(points))]
+    while len(centers) < k:
+        d = [min(dist2(p, c) for c in centers) for p in points]
+        total = sum(d)
+        if total == 0.0:
+            break
+        r = rng.uniform(0.0, total)
+        acc = 0.0
+        for p, dp in zip(points, d):
+            acc += dp
+            if acc >= r:
+                centers.append(list(p))
+                break
+
+    labels = [0] * len(points)
+    for _ in range(iterations):
+        changed = False
+        for i, p in enumerate(points):
+            best = min(range(len(centers)), key=lambda c: dist2(p, centers[c]))
+            if best != labels[i]:
+                labels[i] = best
+                changed = True
+
+        dim = len(points[0])
+        sums = [[0.0] * dim for _ in centers]
+        counts = [0] * len(centers)
+        for p, l in zip(points, labels):
+            counts[l] += 1
+            for d in range(dim):
+                sums[l][d] += p[d]
+        for c in range(len(centers)):
+            if counts[c]:
+                centers[c] = [s / counts[c] for s in sums[c]]
+
+        if not changed:
+            break
+
+    return centers, labels
+
+
+def bic(points, centers, labels):
+    # Bayesian information criterion of a clustering, as used by SimPoint to pick k
+    n = len(points)
+    k = len(centers)
+    dim = len(points[0])
+    if n <= k:
+        return float("-inf")
+
+    variance = sum(dist2(p, centers[l]) for p, l in zip(points, labels)) / (dim * (n - k))
+    if variance <= 0.0:
+        variance = 1e-300
+
+    likelihood = 0.0
+    for c in range(k):
+        nc = labels.count(c)
+        if nc == 0:
+            continue
+        likelihood += (nc * math.log(nc) - nc * math.log(n)
+                       - nc * dim / 2.0 * math.log(2.0 * math.pi * variance)
+                       - (nc - 1) * dim / 2.0)
+
+    params = k * (dim + 1)
+    return likelihood - params / 2.0 * math.log(n)
+
+
+def cmd_cluster(args):
+    rng = random.Random(args.seed)
+    vectors = read_bbv(args.bbv)
+    if not vectors:
+        sys.exit("no intervals in %s" % args.bbv)
+
+    points = project(vectors, args.dim, rng)
+
+    results = []
+    for k in range(1, min(args.max_k, len(points)) + 1):
+        centers, labels = kmeans(points, k, rng)
+        results.append((k, bic(points, centers, labels), centers, labels))
+
+    # smallest k whose score is within bic_threshold of the best, as SimPoint does
+    scores = [r[1] for r in results]
+    lo, hi = min(scores), max(scores)
+    chosen = results[-1]
+    for r in results:
+        if hi == lo or (r[1] - lo) >= args.bic_threshold * (hi - lo):
+            chosen = r
+            break
+
+    k, _, centers, labels = chosen
+
+    with open(args.out + ".simpoints", "w") as sp, open(args.out + ".weights", "w") as wt:
+        cluster = 0
+        for c in range(k):
+            members = [i for i, l in enumerate(labels) if l == c]
+            if not members:
+                continue
+            rep = min(members, key=lambda i: dist2(points[i], centers[c]))
+            sp.write("%d %d\n" % (rep, cluster))
+            wt.write("%.6f %d\n" % (len(members) / float(len(points)), cluster))
+            cluster += 1
+
+    print("%d intervals, %d simpoints written to %s.simpoints/.weights" % (len(points), cluster, args.out))
+
+
+def read_pairs(path):
+    pairs = []
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 2:
+                pairs.append((fields[0], int(fields[1])))
+    return pairs
+
+
+def cmd_params(args):
+    for interval, cluster in read_pairs(args.simpoints):
+        start = int(interval) * args.interval
+        warmup = min(args.warmup, start)
+        print("simpoint %d: fast_forward_instructions=%d fast_forward_warmup_instructions=%d detailed_instructions=%d"
+              % (cluster, start - warmup, warmup, args.interval))
+
+
+def read_stats(path):
+    # Only sums and counts can be split into the part before and after a point in time,
+    # min/max and histogram bins are left out
+    dumps = {}
+    with open(path) as f:
+        reader = csv.reader(f, skipinitialspace=True)
+        header = next(reader)
+        comp = header.index("ComponentName")
+        name = header.index("StatisticName")
+        subid = header.index("StatisticSubId")
+        time = header.index("SimTime")
+        fields = [(i, h) for i, h in enumerate(header) if h.startswith("Sum.") or h.startswith("Count.")]
+        for row in reader:
+            if len(row) < len(header):
+                continue
+            dump = dumps.setdefault(int(row[time]), {})
+            for i, field in fields:
+                dump[(row[comp], row[name], row[subid], field)] = float(row[i])
+
+    if not dumps:
+        return {}
+
+    # the last dump is the end of simulation, which also holds the cycle each core's
+    # measured window started at
+    stats = dumps[max(dumps)]
+    window_start = {}
+    for (c, n, _, field), value in stats.items():
+        if n == "measured_window_start" and field.startswith("Sum."):
+            window_start[c] = int(value)
+
+    if not window_start:
+        return stats
+
+    # A core's own statistics are off until its window starts. Everything else is
+    # measured from the dump the last core to start its window writes (any periodic
+    # output is ignored).
+    start_time = max(window_start.values())
+    if start_time not in dumps:
+        sys.exit("%s: no statistics dump at the start of the measured window (SimTime %d)" % (path, start_time))
+    start = dumps[start_time]
+
+    return {key: value if key[0] in window_start else value - start.get(key, 0.0)
+            for key, value in stats.items()}
+
+
+def cmd_combine(args):
+    weights = {cluster: float(w) for w, cluster in read_pairs(args.weights)}
+
+    combined = {}
+    used = 0.0
+    for spec in args.stats:
+        cluster, path = spec.split("=", 1)
+        w = weights[int(cluster)]
+        used += w
+        for key, value in read_stats(path).items():
+            combined[key] = combined.get(key, 0.0) + w * value
+
+    if used <= 0.0:
+        sys.exit("no statistics files given")
+
+    # renormalize when only some simpoints were simulated
+    out = csv.writer(sys.stdout)
+    out.writerow(["ComponentName", "StatisticName", "StatisticSubId", "Field", "WeightedValue"])
+    for key in sorted(combined):
+        out.writerow(list(key) + ["%.6f" % (combined[key] / used)])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+
+    p = sub.add_parser("cluster", help="choose simpoints and weights from a .bb file")
+    p.add_argument("bbv")
+    p.add_argument("--out", required=True, help="output prefix")
+    p.add_argument("--max-k", type=int, default=30)
+    p.add_argument("--dim", type=int, default=15, help="dimensions after random projection")
+    p.add_argument("--bic-threshold", type=float, default=0.9)
+    p.add_argument("--seed", type=int, default=493575226)
+    p.set_defaults(func=cmd_cluster)
+
+    p = sub.add_parser("params", help="print the core parameters for each simpoint")
+    p.add_argument("simpoints")
+    p.add_argument("--interval", type=int, required=True, help="bbv_interval used when profiling")
+    p.add_argument("--warmup", type=int, default=0, help="instructions before each interval run in detail to warm up")
+    p.set_defaults(func=cmd_params)
+
+    p = sub.add_parser("combine", help="weight and combine the statistics of each simpoint run")
+    p.add_argument("weights")
+    p.add_argument("stats", nargs="+", help="<simpoint>=<csv statistics file>")
+    p.set_defaults(func=cmd_combine)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -29,6 +29,8 @@
 using namespace SST::Vanadis;
 using namespace std;
 
+std::atomic<uint32_t> VANADIS_COMPONENT::cores_before_window(0);
+
 
 
 VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params) : Component(id), current_cycle(0),
@@ -222,14 +224,9 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     // max_fp_regs );
 
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        tmp_not_issued_int_reg_read.push_back( new uint8_t[max_int_regs] );
-        tmp_int_reg_write.push_back( new uint8_t[max_int_regs] );
-        tmp_not_issued_fp_reg_read.push_back( new uint8_t[max_fp_regs] );
-        tmp_fp_reg_write.push_back( new uint8_t[max_fp_regs] );
+        issue_queues.push_back(new VanadisIssueQueue(rob[i]->capacity(), max_int_regs, max_fp_regs));
     }
 
-    resetRegisterUseTemps(max_int_regs, max_fp_regs);
-
     //	memDataInterface =
     // loadUserSubComponent<Interfaces::SimpleMem>("mem_interface_data",
     // ComponentInfo::SHARE_NONE, cpuClockTC, 		new
@@ -367,6 +364,76 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     setVerboseWhenIssueAddress( params.find<std::string>("start_verbose_when_issue_address", "") );
 
+    fast_forward_ins_left      = params.find<uint64_t>("fast_forward_instructions", 0);
+    fast_forward_until_address = params.find<uint64_t>("fast_forward_until_address", 0);
+    fast_forward_width         = params.find<uint32_t>("fast_forward_width", 16);
+    fast_forward_retired       = 0;
+    fast_forward_done          = false;
+    warmup_ins_left            = params.find<uint64_t>("fast_forward_warmup_instructions", 0);
+    warming_up                 = false;
+    ff_memory                  = nullptr;
+    ff_lock_holder             = -1;
+
+    const std::string fast_forward_symbol = params.find<std::string>("fast_forward_until_symbol", "");
+    if ( ! fast_forward_symbol.empty() ) {
+        const std::string fast_forward_binary = params.find<std::string>("fast_forward_binary", "");
+        if ( fast_forward_binary.empty() ) {
+            output->fatal(CALL_INFO, -1, "Error: fast_forward_until_symbol is set but fast_forward_binary is not.\n");
+        }
+
+        VanadisELFInfo* ff_elf_info = readBinaryELFInfo(output, fast_forward_binary.c_str());
+
+        for ( size_t i = 0; i < ff_elf_info->countSymbols(); ++i ) {
+            if ( ff_elf_info->getSymbol(i)->getName() == fast_forward_symbol ) {
+                fast_forward_until_address = ff_elf_info->getSymbol(i)->getAddress();
+                break;
+            }
+        }
+
+        delete ff_elf_info;
+
+        if ( fast_forward_until_address == 0 ) {
+            output->fatal(CALL_INFO, -1, "Error: fast_forward_until_symbol %s was not found in %s.\n",
+                fast_forward_symbol.c_str(), fast_forward_binary.c_str());
+        }
+    }
+
+    fast_forwarding = (fast_forward_ins_left > 0) || (fast_forward_until_address > 0);
+
+    if ( fast_forward_width == 0 ) {
+        output->fatal(CALL_INFO, -1, "Error: fast_forward_width must be at least 1.\n");
+    }
+
+    if ( fast_forwarding ) {
+        const std::string ff_memory_file = params.find<std::string>("fast_forward_memory_file", "");
+        if ( ff_memory_file.empty() ) {
+            output->fatal(CALL_INFO, -1, "Error: fast-forwarding needs fast_forward_memory_file, the memory controller's backing_out_file.\n");
+        }
+
+        ff_memory = new VanadisFunctionalMemory(output, ff_memory_file, params.find<uint64_t>("fast_forward_memory_base", 0), hw_threads);
+        ff_translate_pending.resize(hw_threads, false);
+    }
+
+    const uint64_t detailed_instructions = params.find<uint64_t>("detailed_instructions", 0);
+    detailed_ins_left.resize(hw_threads, detailed_instructions);
+
+    const uint64_t bbv_interval = params.find<uint64_t>("bbv_interval", 0);
+    if ( bbv_interval > 0 ) {
+        std::string bbv_prefix = params.find<std::string>("bbv_file_prefix", getName());
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            bbv_profilers.push_back(new VanadisBasicBlockVectorProfiler(bbv_prefix + "." + std::to_string(i) + ".bb", bbv_interval));
+        }
+        output->verbose(CALL_INFO, 1, 0, "Writing basic-block vectors every %" PRIu64 " instructions to %s.<thread>.bb\n",
+            bbv_interval, bbv_prefix.c_str());
+    }
+
+    sample_on_retire = fast_forwarding || (detailed_instructions > 0) || (!bbv_profilers.empty());
+
+    if ( fast_forwarding ) {
+        output->verbose(CALL_INFO, 1, 0, "Fast-forwarding functionally until %" PRIu64 " instructions retire or address 0x%" PRI_ADDR " retires, width %" PRIu32 "\n",
+            fast_forward_ins_left, fast_forward_until_address, fast_forward_width);
+    }
+
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
     stat_ins_decoded          = registerStatistic<uint64_t>("instructions_decoded", "1");
@@ -381,6 +448,21 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_syscall_cycles       = registerStatistic<uint64_t>("syscall-cycles", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use  = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
+    stat_ff_ins_retired       = registerStatistic<uint64_t>("fast_forward_instructions", "1");
+    stat_ff_cycles            = registerStatistic<uint64_t>("fast_forward_cycles", "1");
+    stat_ff_translations      = registerStatistic<uint64_t>("fast_forward_translations", "1");
+    stat_window_start         = registerStatistic<uint64_t>("measured_window_start", "1");
+
+    detailed_stats = { stat_ins_retired, stat_ins_decoded, stat_ins_issued, stat_loads_issued, stat_stores_issued,
+        stat_branch_mispredicts, stat_branches, stat_cycles, stat_rob_entries, stat_rob_cleared_entries,
+        stat_syscall_cycles, stat_int_phys_regs_in_use, stat_fp_phys_regs_in_use };
+
+    if ( fast_forwarding ) {
+        for ( auto stat : detailed_stats ) {
+            stat->disable();
+        }
+        ++cores_before_window;
+    }
 
     //registerAsPrimaryComponent();
     //primaryComponentDoNotEndSim();
@@ -401,15 +483,18 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
 
     if ( pipelineTrace != nullptr ) { fclose(pipelineTrace); }
 
+    for ( auto profiler : bbv_profilers ) {
+        delete profiler;
+    }
+
+    delete ff_memory;
+
 	for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
 	}
 
-    for ( uint32_t i = 0; i < hw_threads; i++ ) {
-        delete[] tmp_not_issued_int_reg_read[i];
-        delete[] tmp_int_reg_write[i];
-        delete[] tmp_not_issued_fp_reg_read[i];
-        delete[] tmp_fp_reg_write[i];
+    for ( VanadisIssueQueue* next_iq : issue_queues ) {
+        delete next_iq;
     }
 }
 
@@ -459,6 +544,11 @@ VANADIS_COMPONENT::setHalt(uint32_t thr, int64_t halt_code)
             // Reset address to zero
             handleMisspeculate(thr, 0);
 
+            if ( nullptr != ff_memory ) {
+                ff_memory->clearTranslations(thr);
+                if ( ff_lock_holder == (int32_t)thr ) { ff_lock_holder = -1; }
+            }
+
             bool all_halted = true;
 
             for ( uint32_t i = 0; i < hw_threads; ++i ) {
@@ -501,19 +591,8 @@ VANADIS_COMPONENT::performDecode(const uint64_t cycle)
         return 0;
 }
 
-void
-VANADIS_COMPONENT::resetRegisterUseTemps(const uint16_t int_reg_count, const uint16_t fp_reg_count)
-{
-    for ( uint32_t i = 0; i < hw_threads; i++ ) {
-        std::memset(tmp_not_issued_int_reg_read[i], 0, int_reg_count);
-        std::memset(tmp_int_reg_write[i], 0, int_reg_count);
-        std::memset(tmp_not_issued_fp_reg_read[i], 0, fp_reg_count);
-        std::memset(tmp_fp_reg_write[i], 0, fp_reg_count);
-    }
-}
-
 int
-VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_start, int& unallocated_memory_op_seen)
+VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint64_t& issue_start)
 {
     #ifdef VANADIS_BUILD_DEBUG
     const int output_verbosity = output->getVerboseLevel();
@@ -532,155 +611,110 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
         #endif
         // we have not issued an instruction this cycle
         issued_an_ins = false;
-        VanadisCircularQueue<VanadisInstruction*>* thr_rob;
-        thr_rob = rob[hwThr];
-        // Find the next instruction which has not been issued yet
-        const auto rob_size = thr_rob->size();
-        int k_in=0;
-        for ( auto j = rob_start; j < rob_size; ++j )
+        VanadisIssueQueue* thr_iq = issue_queues[hwThr];
+        // Only instructions whose register dependencies have been resolved are
+        // candidates, walk them oldest first and issue the first one which can
+        // get registers and a functional unit
+        for ( uint64_t seq = thr_iq->nextReady(issue_start); seq != VanadisIssueQueue::NONE;
+              seq = thr_iq->nextReady(seq + 1) )
         {
-            VanadisInstruction* ins = thr_rob->peekAt(j);
+            VanadisInstruction* ins = thr_iq->getInstruction(seq);
 
-            if ( ! ins->completedIssue() )
+            #ifdef VANADIS_BUILD_DEBUG
+            if ( output_verbosity >= 8 )
             {
-                #ifdef VANADIS_BUILD_DEBUG
-                if ( output_verbosity >= 8 )
-                {
-                    if ( j == 0 )
-                    {
-                        ins->printToBuffer(instPrintBuffer, 1024);
-                        output->verbose(
-                            CALL_INFO, 8, 0, "%d: --> Attempting issue for: rob[%" PRIu32 "]: 0x%" PRI_ADDR " / %s\n", i, j,
-                            ins->getInstructionAddress(), instPrintBuffer);
-                    }
-                }
-                #endif
-                const int resource_check = checkInstructionResources(
-                    ins, int_register_stack, fp_register_stack, issue_isa_tables[i]);
+                ins->printToBuffer(instPrintBuffer, 1024);
+                output->verbose(
+                    CALL_INFO, 8, 0, "%d: --> Attempting issue for: 0x%" PRI_ADDR " / %s\n", i,
+                    ins->getInstructionAddress(), instPrintBuffer);
+            }
+            #endif
+            const int resource_check = checkInstructionResources(
+                ins, int_register_stack, fp_register_stack, issue_isa_tables[i]);
 
-                #ifdef VANADIS_BUILD_DEBUG
-                if ( output_verbosity >= 8 )
-                {
-                    if ( j == 0 )
-                    {
-                        output->verbose(
-                        CALL_INFO, 8, 0, "%d ----> Check if registers are usable? result: %d (%s)\n", i, resource_check,
-                        (0 == resource_check) ? "success" : "cannot issue");
-                    }
-                }
-                #endif
-                const auto ins_type = ins->getInstFuncType();
+            #ifdef VANADIS_BUILD_DEBUG
+            if ( output_verbosity >= 8 )
+            {
+                output->verbose(
+                    CALL_INFO, 8, 0, "%d ----> Check if registers are usable? result: %d (%s)\n", i, resource_check,
+                    (0 == resource_check) ? "success" : "cannot issue");
+            }
+            #endif
+            const auto ins_type = ins->getInstFuncType();
 
-                if ( 0 == resource_check )
+            if ( 0 == resource_check )
+            {
+                int allocate_fu = 1;
+                if (ins_type == INST_LOAD || ins_type == INST_STORE || ins_type == INST_FENCE ||
+                    ins_type == INST_ROCC0 || ins_type == INST_ROCC1 || ins_type == INST_ROCC2 || ins_type == INST_ROCC3)
                 {
-                    int allocate_fu = 1;
-                    if (ins_type == INST_LOAD || ins_type == INST_STORE || ins_type == INST_FENCE ||
-                        ins_type == INST_ROCC0 || ins_type == INST_ROCC1 || ins_type == INST_ROCC2 || ins_type == INST_ROCC3)
-                    {
-                        if(unallocated_memory_op_seen) {
-                            // the instruction should not be allocated because memory operations
-                            // must be issued to the LSQ in order to maintain memory ordering
-                            // semantics
-                            allocate_fu = 1;
-
-                        } else {
+                    if(thr_iq->olderMemoryOpPending(seq)) {
+                        // the instruction should not be allocated because memory operations
+                        // must be issued to the LSQ in order to maintain memory ordering
+                        // semantics
+                        allocate_fu = 1;
 
-                            allocate_fu = allocateFunctionalUnit(ins);
+                    } else {
 
-                        }
-                    }
-                    else
-                    {
                         allocate_fu = allocateFunctionalUnit(ins);
-                    }
-
-                    #ifdef VANADIS_BUILD_DEBUG
-                    if ( output_verbosity >= 8 ) {
-                        if ( j == 0 )
-                        {
-                        output->verbose(
-                            CALL_INFO, 8, 0, "%d: ----> allocated functional unit: %s\n",
-                            i, (0 == allocate_fu) ? "yes" : "no");
-                        }
-                    }
-                    #endif
-                    if ( 0 == allocate_fu )
-                    {
-                        int status = 0;
 
-                            status = assignRegistersToInstruction(
-                                thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(), ins,
-                                int_register_stack, fp_register_stack, issue_isa_tables[i]);
-                        #ifdef VANADIS_BUILD_DEBUG
-                            if ( checkVerboseAddr( ins->getInstructionAddress() ) )
-                            {
-                                output->setVerboseLevel(8);
-                            }
-                            if ( output_verbosity >= 8 )
-                            {
-                                ins->printToBuffer(instPrintBuffer, 1024);
-                                output->verbose(
-                                    CALL_INFO, 8, 0, "%d: ----> Issued for: %s / 0x%" PRI_ADDR " / status: %d\n",
-                                    ins->getHWThread(), instPrintBuffer, ins->getInstructionAddress(), status);
-                                if ( print_rob && i != 0) {
-                                    printRob(i,thr_rob);
-                                }
-                            }
-                        #endif
-                        ins->markIssued();
-                        ins_issued_this_cycle++;
-                        issued_an_ins = true;
-                    }
-                    else
-                    {
-                        if(ins_type == INST_LOAD || ins_type == INST_STORE || ins_type == INST_FENCE)
-                        {
-                            // we have seen a memory operation which is not issued, downstream operations
-                            // cannot issue yet to maintain ordering
-                            unallocated_memory_op_seen = true;
-                        }
                     }
                 }
                 else
                 {
-                    if(1 == resource_check)
-                    {
-                        ins->printToBuffer(instPrintBuffer, 1024);
-                        output->verbose(
-                            CALL_INFO, 8, 0, "%d: --> Failed to issue for: rob[%" PRIu32 "]: 0x%" PRI_ADDR " / %s\n", i, j,
-                            ins->getInstructionAddress(), instPrintBuffer);
-                    }
-
-                    if(ins_type == INST_LOAD || ins_type == INST_STORE || ins_type == INST_FENCE) {
-                        // we have seen a memory operation which is not issued, downstream operations
-                        // cannot issue yet to maintain ordering
-                        unallocated_memory_op_seen = true;
-                    }
+                    allocate_fu = allocateFunctionalUnit(ins);
                 }
 
-                // if the instruction is *not* issued yet, we need to keep track
-                // of which instructions are being read
-                for ( auto k = 0; k < ins->countISAIntRegIn(); ++k ) {
-                    tmp_not_issued_int_reg_read[i][ins->getISAIntRegIn(k)] = 1;
+                #ifdef VANADIS_BUILD_DEBUG
+                if ( output_verbosity >= 8 ) {
+                    output->verbose(
+                        CALL_INFO, 8, 0, "%d: ----> allocated functional unit: %s\n",
+                        i, (0 == allocate_fu) ? "yes" : "no");
                 }
+                #endif
+                if ( 0 == allocate_fu )
+                {
+                    int status = 0;
 
-                for ( auto k = 0; k < ins->countISAFPRegIn(); ++k ) {
-                    tmp_not_issued_fp_reg_read[i][ins->getISAFPRegIn(k)] = 1;
+                        status = assignRegistersToInstruction(
+                            thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(), ins,
+                            int_register_stack, fp_register_stack, issue_isa_tables[i]);
+                    #ifdef VANADIS_BUILD_DEBUG
+                        if ( checkVerboseAddr( ins->getInstructionAddress() ) )
+                        {
+                            output->setVerboseLevel(8);
+                        }
+                        if ( output_verbosity >= 8 )
+                        {
+                            ins->printToBuffer(instPrintBuffer, 1024);
+                            output->verbose(
+                                CALL_INFO, 8, 0, "%d: ----> Issued for: %s / 0x%" PRI_ADDR " / status: %d\n",
+                                ins->getHWThread(), instPrintBuffer, ins->getInstructionAddress(), status);
+                            if ( print_rob && i != 0) {
+                                printRob(i,rob[i]);
+                            }
+                        }
+                    #endif
+                    ins->markIssued();
+                    thr_iq->issue(seq);
+                    ins_issued_this_cycle++;
+                    issued_an_ins = true;
+
+                    // tell the caller where we got this from, nothing older can
+                    // become ready again this cycle
+                    issue_start = seq;
+                    break;
                 }
             }
-            // Collect up all integer registers we write to
-            for ( auto k = 0; k < ins->countISAIntRegOut(); ++k ) {
-                tmp_int_reg_write[i][ins->getISAIntRegOut(k)] = 1;
-            }
-            // Collect up all fp registers we write to
-            for ( auto k = 0; k < ins->countISAFPRegOut(); ++k ) {
-                tmp_fp_reg_write[i][ins->getISAFPRegOut(k)] = 1;
-            }
-            // We issued an instruction this cycle, so exit
-            if ( issued_an_ins ) {
-                // tell the caller where we got this from
-                rob_start = j;
-                break;
+            else
+            {
+                if(1 == resource_check)
+                {
+                    ins->printToBuffer(instPrintBuffer, 1024);
+                    output->verbose(
+                        CALL_INFO, 8, 0, "%d: --> Failed to issue for: 0x%" PRI_ADDR " / %s\n", i,
+                        ins->getInstructionAddress(), instPrintBuffer);
+                }
             }
         }
 
@@ -942,8 +976,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 }
                 }
                 #endif
-                thr_decoder->getBranchPredictor()->push(
-                spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                thr_decoder->getBranchPredictor()->update(spec_ins, pipeline_reset_addr);
 
                 if ( stop_verbose_when_retire_address > 0 && (rob_front->getInstructionAddress() == stop_verbose_when_retire_address) ) {
                     output->setVerboseLevel(0);
@@ -980,6 +1013,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
         if ( perform_cleanup )
         {
             rob->pop();
+            issue_queues[rob_num]->retire(rob_front);
 
             #ifdef VANADIS_BUILD_DEBUG
             if ( output->getVerboseLevel() >= 8 )
@@ -1030,10 +1064,16 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
 
             ins_retired_this_cycle++;
 
+            if ( UNLIKELY(sample_on_retire) ) {
+                retireSample(rob_front, !perform_delay_cleanup &&
+                    (rob_front->isSpeculated() || (INST_SYSCALL == rob_front->getInstFuncType())));
+            }
+
             if ( perform_delay_cleanup )
             {
 
                 VanadisInstruction* delay_ins = rob->pop();
+                issue_queues[rob_num]->retire(delay_ins);
                 #ifdef VANADIS_BUILD_DEBUG
                 output->verbose(
                     CALL_INFO, 8, VANADIS_DBG_RETIRE_FLG, "----> Retire delay: 0x%" PRI_ADDR " / %s\n", delay_ins->getInstructionAddress(),
@@ -1061,6 +1101,10 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 #endif
                 ins_retired_this_cycle++;
 
+                if ( UNLIKELY(sample_on_retire) ) {
+                    retireSample(delay_ins, true);
+                }
+
                 delete delay_ins;
             }
 
@@ -1340,6 +1384,9 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     #endif
 
     stat_cycles->addData(1);
+    if ( UNLIKELY(fast_forwarding) ) {
+        stat_ff_cycles->addData(1);
+    }
     ins_issued_this_cycle  = 0;
     ins_retired_this_cycle = 0;
     ins_decoded_this_cycle = 0;
@@ -1441,6 +1488,12 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
 
+    if ( UNLIKELY(fast_forwarding) ) {
+        for ( uint32_t i = 0; (i < hw_threads) && fast_forwarding; ++i ) {
+            performFunctionalExecute(i);
+        }
+    }
+
     // Execute
     // //////////////////////////////////////////////////////////////////////////
     #ifdef VANADIS_BUILD_DEBUG
@@ -1465,14 +1518,20 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
             "<==========================================================\n");
     }
     #endif
-    // Clear our temps on a per-thread basis
+    // Wake up the dependents of last cycle's issues and bring the issue queues up
+    // to date with what was decoded into the ROB. While fast-forwarding the ROB is executed
+    // functionally and only what performFunctionalExecute() hands over is dispatched.
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
+        VanadisIssueQueue* thr_iq = issue_queues[i];
+        thr_iq->startCycle();
+        if ( UNLIKELY(fast_forwarding) ) { continue; }
+        for ( size_t j = thr_iq->size(); j < rob[i]->size(); ++j ) {
+            thr_iq->dispatch(rob[i]->peekAt(j));
+        }
     }
 
     {
-    std::vector<uint32_t> rob_start(hw_threads,0);
-    std::vector<int> unallocated_memory_op_seen(hw_threads,false);
+    std::vector<uint64_t> issue_start(hw_threads,0);
 
     // Attempt to perform issues, cranking through the entire ROB call by call or until we
     // reach the max issues this cycle
@@ -1489,7 +1548,7 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         // we found a unblocked hardware thread
         if ( cnt ) {
             auto thr = m_curIssueHwThread;
-            rc[thr] = performIssue(cycle, thr, rob_start[thr], unallocated_memory_op_seen[thr]);
+            rc[thr] = performIssue(cycle, thr, issue_start[thr]);
             ++m_curIssueHwThread;
             m_curIssueHwThread %= (hw_threads);
             cnt = (hw_threads);
@@ -1513,7 +1572,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
             "<==========================================================\n");
     }
     #endif
-    for ( uint32_t i = 0; i < decodes_per_cycle; ++i ) {
+    const uint32_t decode_width = fast_forwarding ? fast_forward_width : decodes_per_cycle;
+    for ( uint32_t i = 0; i < decode_width; ++i ) {
         if ( performDecode(cycle) != 0 ) { break; }
     }
 
@@ -1580,11 +1640,9 @@ int
 VANADIS_COMPONENT::checkInstructionResources(
     VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs, VanadisISATable* isa_table)
 {
+    #ifdef VANADIS_BUILD_DEBUG
     const auto hwThr = ins->getHWThread();
-    auto int_reg_write = tmp_int_reg_write[hwThr];
-    auto not_issued_int_reg_read = tmp_not_issued_int_reg_read[hwThr];
-    auto fp_reg_write = tmp_fp_reg_write[hwThr];
-    auto not_issued_fp_reg_read = tmp_not_issued_fp_reg_read[hwThr];
+    #endif
 
     bool      resources_good   = true;
     #ifdef VANADIS_BUILD_DEBUG
@@ -1614,11 +1672,12 @@ VANADIS_COMPONENT::checkInstructionResources(
     }
 
     // If there are any pending writes against our reads, we can't issue until
-    // they are done
+    // they are done. Ordering against the other instructions in the ROB has
+    // already been resolved by the issue queue before we get here
 
     for ( uint16_t i = 0; i < int_reg_in_count; ++i ) {
         const uint16_t ins_isa_reg = ins->getISAIntRegIn(i);
-        resources_good &= (!isa_table->pendingIntWrites(ins_isa_reg)) && (!int_reg_write[ins_isa_reg]);
+        resources_good &= (!isa_table->pendingIntWrites(ins_isa_reg));
     }
 
     #ifdef VANADIS_BUILD_DEBUG
@@ -1628,11 +1687,11 @@ VANADIS_COMPONENT::checkInstructionResources(
     // }
     #endif
 
-    if ( LIKELY(!resources_good )) { return 2; }
+    if ( UNLIKELY(!resources_good )) { return 2; }
 
     for ( uint16_t i = 0; i < fp_reg_in_count; ++i ) {
         const uint16_t ins_isa_reg = ins->getISAFPRegIn(i);
-        resources_good &= (!isa_table->pendingFPWrites(ins_isa_reg)) & (!fp_reg_write[ins_isa_reg]);
+        resources_good &= (!isa_table->pendingFPWrites(ins_isa_reg));
     }
 
     #ifdef VANADIS_BUILD_DEBUG
@@ -1645,40 +1704,6 @@ VANADIS_COMPONENT::checkInstructionResources(
 
     if ( UNLIKELY(!resources_good )) { return 3; }
 
-    for ( uint16_t i = 0; i < int_reg_out_count; ++i ) {
-        const uint16_t ins_isa_reg = ins->getISAIntRegOut(i);
-
-        // Check there are no RAW in the pending instruction queue
-        resources_good &= (!not_issued_int_reg_read[ins_isa_reg]) && (!int_reg_write[ins_isa_reg]);
-    }
-
-    #ifdef VANADIS_BUILD_DEBUG
-    // if ( output_verbosity > 16 ) {
-    //     output->verbose(
-    //         CALL_INFO, 16, 0, "--> Check output integer registers, issue-status: %s\n",
-    //         (resources_good ? "yes" : "no"));
-    // }
-    #endif
-
-    if ( LIKELY(!resources_good )) { return 4; }
-
-    for ( uint16_t i = 0; i < fp_reg_out_count; ++i ) {
-        const uint16_t ins_isa_reg = ins->getISAFPRegOut(i);
-
-        // Check there are no RAW in the pending instruction queue
-        resources_good &= (!not_issued_fp_reg_read[ins_isa_reg]) && (!fp_reg_write[ins_isa_reg]);
-    }
-
-    #ifdef VANADIS_BUILD_DEBUG
-    // if ( output_verbosity > 16 ) {
-    //     output->verbose(
-    //         CALL_INFO, 16, 0, "--> Check output floating-point registers, issue-status: %s\n",
-    //         (resources_good ? "yes" : "no"));
-    // }
-    #endif
-
-    if ( UNLIKELY(!resources_good )) { return 5; }
-
     return 0;
 }
 
@@ -1962,6 +1987,11 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
 void
 VANADIS_COMPONENT::setup()
 {
+    // the OS serves this core's syscall memory accesses from its backdoor until the switch
+    if ( fast_forwarding ) {
+        os_link->send(new VanadisFunctionalModeReq(core_id, true));
+    }
+
     if ( CHECKPOINT_LOAD == m_checkpoint ) {
         std::stringstream filename;
         filename << m_checkpointDir << "/" << getName();
@@ -1976,6 +2006,10 @@ void
 VANADIS_COMPONENT::finish()
 {
 
+    for ( auto profiler : bbv_profilers ) {
+        profiler->close();
+    }
+
     if ( LIKELY( nullptr == m_checkpointing ) ) return;
 
     if ( CHECKPOINT_SAVE == m_checkpoint ) {
@@ -2139,6 +2173,7 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
 
     // clear the ROB entries and reset
     thr_rob->clear();
+    issue_queues[hw_thr]->clear();
 }
 
 void
@@ -2193,6 +2228,10 @@ void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
             output->verbose(CALL_INFO, 16, 0, "-> thread has not exited, syscall return %d\n", hw_thr);
             thread_decoders[hw_thr]->getOSHandler()->recvSyscallResp ( os_resp );
             ev = nullptr;
+            if ( nullptr != ff_memory ) {
+                // the syscall may have changed any mapping
+                ff_memory->clearTranslations();
+            }
             syscallReturn( hw_thr );
         }
         else
@@ -2208,8 +2247,11 @@ void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
 
     } else {
 
+        VanadisTranslateResp* translate_resp = dynamic_cast<VanadisTranslateResp*>(ev);
         VanadisStartThreadFirstReq* os_req = dynamic_cast<VanadisStartThreadFirstReq*>(ev);
-        if ( nullptr != os_req ) {
+        if ( nullptr != translate_resp ) {
+            recvTranslateResp( translate_resp );
+        } else if ( nullptr != os_req ) {
             startThread( os_req->getThread(), os_req->getStackAddr(), os_req->getInstPtr() );
         } else {
 
@@ -2509,6 +2551,11 @@ VANADIS_COMPONENT::resetHwThread(uint32_t thr)
     auto thr_rob = rob[thr];
 
     thr_rob->clear();
+    issue_queues[thr]->clear();
+
+    if ( nullptr != ff_memory ) {
+        ff_memory->clearTranslations(thr);
+    }
 
     #if 0
     output->setVerboseLevel( 16 );
@@ -2534,6 +2581,431 @@ VANADIS_COMPONENT::resetHwThread(uint32_t thr)
     #endif
 }
 
+void
+VANADIS_COMPONENT::performFunctionalExecute(uint32_t thr)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[thr];
+
+    for ( uint32_t i = 0; (i < fast_forward_width) && fast_forwarding; ++i ) {
+        // wait for an instruction handed to the detailed pipeline, a translation from the OS
+        // or another thread to finish its LOCK load/store pair
+        if ( halted_masks[thr] || thr_rob->empty() || (issue_queues[thr]->size() > 0) || ff_translate_pending[thr] ||
+             ((ff_lock_holder >= 0) && (ff_lock_holder != (int32_t)thr)) ) {
+            return;
+        }
+
+        VanadisInstruction* ins = thr_rob->peek();
+
+        switch ( ins->getInstFuncType() ) {
+        case INST_SYSCALL:
+        case INST_FAULT:
+        case INST_ROCC0:
+        case INST_ROCC1:
+        case INST_ROCC2:
+        case INST_ROCC3:
+            // the ROB holds nothing older so the pipeline runs it on its own and retires it
+            issue_queues[thr]->dispatch(ins);
+            return;
+        default:
+            break;
+        }
+
+        VanadisSpeculatedInstruction* spec_ins  = nullptr;
+        VanadisInstruction*           delay_ins = nullptr;
+
+        if ( ins->isSpeculated() ) {
+            spec_ins = dynamic_cast<VanadisSpeculatedInstruction*>(ins);
+
+            if ( nullptr == spec_ins ) {
+                output->fatal(
+                    CALL_INFO, -1,
+                    "Error - instruction is speculated, but not able to "
+                    "perform a cast to a speculated instruction.\n");
+            }
+
+            // the delay slot executes straight after the branch
+            if ( VANADIS_NO_DELAY_SLOT != spec_ins->getDelaySlotType() ) {
+                if ( thr_rob->size() < 2 ) { return; }
+                delay_ins = thr_rob->peekAt(1);
+            }
+        }
+
+        // a branch can be executed while its delay slot waits for a translation, it must not
+        // be executed twice
+        if ( ! ins->completedExecution() && ! executeFunctional(ins) ) { return; }
+        if ( (nullptr != delay_ins) && ! executeFunctional(delay_ins) ) { return; }
+
+        thr_rob->pop();
+        retireFunctional(ins, (nullptr != spec_ins) && (nullptr == delay_ins));
+
+        if ( nullptr != delay_ins ) {
+            thr_rob->pop();
+            retireFunctional(delay_ins, true);
+        }
+
+        if ( nullptr != spec_ins ) {
+            const uint64_t taken_addr = spec_ins->getTakenAddress();
+            thread_decoders[thr]->getBranchPredictor()->update(spec_ins, taken_addr);
+
+            if ( taken_addr != spec_ins->getSpeculatedAddress() ) {
+                handleMisspeculate(thr, taken_addr);
+            }
+        }
+
+        delete ins;
+        delete delay_ins;
+    }
+}
+
+bool
+VANADIS_COMPONENT::executeFunctional(VanadisInstruction* ins)
+{
+    const uint32_t   thr          = ins->getHWThread();
+    VanadisISATable* retire_table = retire_isa_tables[thr];
+
+    // nothing is renamed, instructions read and write the registers as retired
+    for ( uint16_t i = 0; i < ins->countISAIntRegIn(); ++i ) {
+        ins->setPhysIntRegIn(i, retire_table->getIntPhysReg(ins->getISAIntRegIn(i)));
+    }
+
+    for ( uint16_t i = 0; i < ins->countISAFPRegIn(); ++i ) {
+        ins->setPhysFPRegIn(i, retire_table->getFPPhysReg(ins->getISAFPRegIn(i)));
+    }
+
+    for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+        ins->setPhysIntRegOut(i, retire_table->getIntPhysReg(ins->getISAIntRegOut(i)));
+    }
+
+    for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+        ins->setPhysFPRegOut(i, retire_table->getFPPhysReg(ins->getISAFPRegOut(i)));
+    }
+
+    switch ( ins->getInstFuncType() ) {
+    case INST_LOAD:
+        if ( ! executeFunctionalLoad(dynamic_cast<VanadisLoadInstruction*>(ins)) ) { return false; }
+        break;
+
+    case INST_STORE:
+        if ( ! executeFunctionalStore(dynamic_cast<VanadisStoreInstruction*>(ins)) ) { return false; }
+        break;
+
+    case INST_NOOP:
+    case INST_FENCE:
+        // memory is accessed in program order
+        ins->markExecuted();
+        break;
+
+    case INST_SYSCALL:
+    case INST_FAULT:
+    case INST_ROCC0:
+    case INST_ROCC1:
+    case INST_ROCC2:
+    case INST_ROCC3:
+        output->fatal(
+            CALL_INFO, -1, "Error: instruction 0x%" PRI_ADDR " (%s) in a delay slot cannot be fast-forwarded.\n",
+            ins->getInstructionAddress(), ins->getInstCode());
+        break;
+
+    default:
+        ins->execute(output, register_files);
+        break;
+    }
+
+    if ( UNLIKELY(ins->trapsError() || ! ins->completedExecution()) ) {
+        output->fatal(
+            CALL_INFO, -1, "Error: instruction 0x%" PRI_ADDR " (%s) flags an error while fast-forwarding.\n",
+            ins->getInstructionAddress(), ins->getInstCode());
+    }
+
+    // writes to the zero register are dropped, as the pipeline does every cycle
+    const uint16_t zero_reg = isa_options[thr]->getRegisterIgnoreWrites();
+
+    if ( zero_reg < isa_options[thr]->countISAIntRegisters() ) {
+        register_files[thr]->setIntReg<uint64_t>(retire_table->getIntPhysReg(zero_reg), 0);
+    }
+
+    return true;
+}
+
+bool
+VANADIS_COMPONENT::executeFunctionalLoad(VanadisLoadInstruction* load_ins)
+{
+    const uint32_t       thr      = load_ins->getHWThread();
+    VanadisRegisterFile* reg_file = register_files[thr];
+    uint64_t             load_addr;
+    uint16_t             load_width;
+
+    load_ins->computeLoadAddress(output, reg_file, &load_addr, &load_width);
+
+    if ( ! functionalAccessReady(thr, load_addr, load_width, false) ) { return false; }
+
+    const uint32_t reg_offset = load_ins->getRegisterOffset();
+    uint8_t        register_value[VanadisFunctionalMemory::MAX_REGISTER_WIDTH];
+
+    // the register is filled the way the LSQ fills it
+    switch ( load_ins->getValueRegisterType() ) {
+    case LOAD_INT_REGISTER:
+    {
+        const uint16_t target_reg = load_ins->getPhysIntRegOut(0);
+        const uint32_t reg_width  = reg_file->getIntRegWidth();
+
+        if ( (reg_width > VanadisFunctionalMemory::MAX_REGISTER_WIDTH) || ((reg_offset + load_width) > reg_width) ) {
+            output->fatal(
+                CALL_INFO, -1, "Error: load 0x%" PRI_ADDR " of %" PRIu16 " bytes does not fit its register.\n",
+                load_ins->getInstructionAddress(), load_width);
+        }
+
+        reg_file->copyFromIntRegister(target_reg, 0, register_value, reg_width);
+        ff_memory->read(thr, load_addr, &register_value[reg_offset], load_width);
+
+        uint8_t fill = 0x00;
+
+        if ( load_ins->performSignExtension() && ((register_value[reg_offset + load_width - 1] & 0x80) != 0) ) {
+            fill = 0xFF;
+        }
+
+        std::memset(&register_value[reg_offset + load_width], fill, reg_width - reg_offset - load_width);
+        reg_file->copyToIntRegister(target_reg, 0, register_value, reg_width);
+    } break;
+    case LOAD_FP_REGISTER:
+    {
+        const uint16_t target_reg = load_ins->getPhysFPRegOut(0);
+        const uint32_t reg_width  = reg_file->getFPRegWidth();
+
+        if ( (0 != reg_offset) || (reg_width > VanadisFunctionalMemory::MAX_REGISTER_WIDTH) || (load_width > reg_width) ) {
+            output->fatal(
+                CALL_INFO, -1, "Error: load 0x%" PRI_ADDR " of %" PRIu16 " bytes does not fit its register.\n",
+                load_ins->getInstructionAddress(), load_width);
+        }
+
+        ff_memory->read(thr, load_addr, register_value, load_width);
+        std::memset(&register_value[load_width], 0xff, reg_width - load_width);
+        reg_file->copyToFPRegister(target_reg, 0, register_value, reg_width);
+    } break;
+    }
+
+    switch ( load_ins->getTransactionType() ) {
+    case MEM_TRANSACTION_LLSC_LOAD:
+        ff_memory->reserve(thr, load_addr);
+        break;
+    case MEM_TRANSACTION_LOCK:
+        ff_lock_holder = thr;
+        break;
+    default:
+        break;
+    }
+
+    load_ins->markExecuted();
+    return true;
+}
+
+bool
+VANADIS_COMPONENT::executeFunctionalStore(VanadisStoreInstruction* store_ins)
+{
+    const uint32_t       thr      = store_ins->getHWThread();
+    VanadisRegisterFile* reg_file = register_files[thr];
+    uint64_t             store_addr;
+    uint16_t             store_width;
+
+    store_ins->computeStoreAddress(output, reg_file, &store_addr, &store_width);
+
+    if ( ! functionalAccessReady(thr, store_addr, store_width, true) ) { return false; }
+
+    if ( store_width > VanadisFunctionalMemory::MAX_REGISTER_WIDTH ) {
+        output->fatal(
+            CALL_INFO, -1, "Error: store 0x%" PRI_ADDR " of %" PRIu16 " bytes is wider than a register.\n",
+            store_ins->getInstructionAddress(), store_width);
+    }
+
+    uint8_t store_value[VanadisFunctionalMemory::MAX_REGISTER_WIDTH];
+    reg_file->copyFromRegister(store_ins->getValueRegister(), store_ins->getRegisterOffset(), store_value, store_width,
+        store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
+    switch ( store_ins->getTransactionType() ) {
+    case MEM_TRANSACTION_LLSC_STORE:
+    {
+        VanadisStoreConditionalInstruction* store_cond_ins = dynamic_cast<VanadisStoreConditionalInstruction*>(store_ins);
+
+        if ( UNLIKELY(nullptr == store_cond_ins) ) {
+            output->fatal(CALL_INFO, -1, "Unable to cast an LLSC_STORE into a store-conditional, logic failure.\n");
+        }
+
+        if ( ff_memory->checkReservation(thr, store_addr) ) {
+            ff_memory->write(thr, store_addr, store_value, store_width);
+            reg_file->setIntReg<int64_t>(store_ins->getPhysIntRegOut(0), store_cond_ins->getResultSuccess());
+        }
+        else {
+            reg_file->setIntReg<int64_t>(store_ins->getPhysIntRegOut(0), store_cond_ins->getResultFailure());
+        }
+    } break;
+    case MEM_TRANSACTION_LOCK:
+        ff_memory->write(thr, store_addr, store_value, store_width);
+        ff_lock_holder = -1;
+        break;
+    default:
+        ff_memory->write(thr, store_addr, store_value, store_width);
+        break;
+    }
+
+    store_ins->markExecuted();
+    return true;
+}
+
+bool
+VANADIS_COMPONENT::functionalAccessReady(uint32_t thr, uint64_t addr, uint16_t width, bool is_write)
+{
+    uint64_t missing_addr;
+
+    if ( ff_memory->isTranslated(thr, addr, width, is_write, &missing_addr) ) { return true; }
+
+    // the OS takes any page fault, the instruction is executed again once the page arrives
+    stat_ff_translations->addData(1);
+    ff_translate_pending[thr] = true;
+    os_link->send(new VanadisTranslateReq(core_id, thr, missing_addr, is_write));
+
+    return false;
+}
+
+void
+VANADIS_COMPONENT::recvTranslateResp(VanadisTranslateResp* resp)
+{
+    const uint32_t thr = resp->hwThread;
+
+    output->verbose(
+        CALL_INFO, 16, 0, "hw_thread %" PRIu32 ": translation 0x%" PRI_ADDR " -> 0x%" PRI_ADDR " (success: %3s)\n", thr,
+        resp->virtAddr, resp->physAddr, resp->success ? "yes" : "no");
+
+    ff_translate_pending[thr] = false;
+
+    if ( resp->success ) {
+        ff_memory->addTranslation(thr, resp->virtAddr, resp->physAddr, resp->pageSize, resp->perms);
+    }
+    else if ( ! halted_masks[thr] ) {
+        output->fatal(
+            CALL_INFO, -1, "Error: hw_thread %" PRIu32 " accessed 0x%" PRI_ADDR " without permission while fast-forwarding (segmentation fault).\n",
+            thr, resp->virtAddr);
+    }
+}
+
+void
+VANADIS_COMPONENT::retireFunctional(VanadisInstruction* ins, bool end_block)
+{
+    if ( pipelineTrace != nullptr ) {
+        fprintf(pipelineTrace, "0x%08" PRI_ADDR " %s\n", ins->getInstructionAddress(), ins->getInstCode());
+    }
+
+    if ( UNLIKELY(ins->updatesFPFlags()) ) {
+        ins->updateFPFlags();
+    }
+
+    retireSample(ins, end_block);
+}
+
+void
+VANADIS_COMPONENT::retireSample(VanadisInstruction* ins, bool end_block)
+{
+    if ( !bbv_profilers.empty() ) {
+        bbv_profilers[ins->getHWThread()]->retire(ins->getInstructionAddress(), end_block);
+    }
+
+    if ( fast_forwarding ) {
+        retireFastForward(ins);
+    }
+    else if ( warming_up ) {
+        if ( --warmup_ins_left == 0 ) {
+            endWarmup();
+        }
+    }
+    else {
+        const uint32_t thr = ins->getHWThread();
+
+        if ( (detailed_ins_left[thr] > 0) && (--detailed_ins_left[thr] == 0) ) {
+            output->verbose(CALL_INFO, 1, 0, "Thread %" PRIu32 " reached the detailed instruction limit at cycle %" PRIu64 "\n", thr,
+                current_cycle);
+
+            // a thread past its limit keeps running (it may hold a lock the others wait
+            // on), the core stops once no thread is left to measure
+            bool all_done = true;
+            for ( uint32_t i = 0; i < hw_threads; ++i ) {
+                all_done = all_done && ((0 == detailed_ins_left[i]) || halted_masks[i]);
+            }
+
+            if ( all_done ) {
+                output->verbose(CALL_INFO, 1, 0, "Detailed instruction limit reached at cycle %" PRIu64 ", core stops processing.\n",
+                    current_cycle);
+                // stop through the same path as max_cycle
+                max_cycle = current_cycle;
+            }
+        }
+    }
+}
+
+void
+VANADIS_COMPONENT::retireFastForward(VanadisInstruction* ins)
+{
+    ++fast_forward_retired;
+    stat_ff_ins_retired->addData(1);
+
+    if ( (fast_forward_ins_left > 0) && (--fast_forward_ins_left == 0) ) {
+        fast_forward_done = true;
+    }
+
+    if ( (fast_forward_until_address > 0) && (ins->getInstructionAddress() == fast_forward_until_address) ) {
+        fast_forward_done = true;
+    }
+
+    if ( ! fast_forward_done ) { return; }
+
+    // the pipeline cannot pick up a LOCK load/store pair or a branch waiting for its delay
+    // slot half way through, finish them functionally first
+    if ( ff_lock_holder >= 0 ) { return; }
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        if ( !rob[i]->empty() && rob[i]->peek()->completedExecution() && !rob[i]->peek()->completedIssue() ) { return; }
+    }
+
+    endFastForward();
+}
+
+void
+VANADIS_COMPONENT::endFastForward()
+{
+    output->verbose(CALL_INFO, 1, 0, "Fast-forward complete after %" PRIu64 " instructions at cycle %" PRIu64 ", switching to detailed simulation\n",
+        fast_forward_retired, current_cycle);
+
+    fast_forwarding = false;
+
+    // syscalls go back to reaching memory through the hierarchy
+    os_link->send(new VanadisFunctionalModeReq(core_id, false));
+
+    if ( warmup_ins_left > 0 ) {
+        output->verbose(CALL_INFO, 1, 0, "Warming caches and predictors for %" PRIu64 " instructions before collecting statistics\n",
+            warmup_ins_left);
+        warming_up = true;
+    }
+    else {
+        endWarmup();
+    }
+}
+
+void
+VANADIS_COMPONENT::endWarmup()
+{
+    warming_up = false;
+
+    for ( auto stat : detailed_stats ) {
+        stat->enable();
+    }
+    stat_window_start->addData(getCurrentSimCycle());
+
+    // The core's own statistics count from here. Once every core is in its window, dump
+    // all statistics so the warmup of the shared components can be subtracted from the
+    // end-of-run values (see tools/simpoint/vanadis-simpoint.py combine)
+    if ( 0 == --cores_before_window ) {
+        performGlobalStatisticOutput();
+    }
+}
+
 
 
 // bool VANADIS_COMPONENT::judgeIns(VanadisInstruction* ins)
@@ -25,16 +25,21 @@
 #include "lsq/vlsq.h"
 #include "lsq/vbasiclsq.h"
 #include "velf/velfinfo.h"
+#include "vbbvprofile.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
+#include "vfunctionalmem.h"
+#include "vissuequeue.h"
 #include "rocc/vroccinterface.h"
 #include "rocc/vbasicrocc.h"
 
 #include "os/vgetthreadstate.h"
 #include "os/vdumpregsreq.h"
 #include "os/vcheckpointreq.h"
+#include "os/vtranslatereq.h"
 
 #include <array>
+#include <atomic>
 #include <limits>
 #include <set>
 #include <sst/core/component.h>
@@ -152,6 +157,17 @@ public:
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
                           "true if verbose > 16", "false" },
         { "print_rob", "Print reorder buffer state during issue and retire", "true"},
+        { "fast_forward_instructions", "Fast-forward until this many instructions have retired, then switch to detailed timing. 0 disables the instruction count trigger.", "0"},
+        { "fast_forward_until_address", "Fast-forward until the instruction at this address retires, then switch to detailed timing. 0 disables the address trigger.", "0"},
+        { "fast_forward_until_symbol", "Fast-forward until the instruction at this symbol of fast_forward_binary (a region-of-interest marker function) retires, then switch to detailed timing", ""},
+        { "fast_forward_binary", "Executable fast_forward_until_symbol is looked up in", ""},
+        { "fast_forward_width", "Number of instructions decoded and executed functionally per cycle while fast-forwarding", "16"},
+        { "fast_forward_memory_file", "Memory read and written while fast-forwarding, must be the backing_out_file of the memory controller (backing=mmap) and the backdoor_file of the OS. Every core sharing the memory must fast-forward.", ""},
+        { "fast_forward_memory_base", "Physical address held at offset 0 of fast_forward_memory_file", "0"},
+        { "fast_forward_warmup_instructions", "After fast-forwarding, run this many instructions through the detailed pipeline to warm the caches and branch predictors before statistics are collected", "0"},
+        { "detailed_instructions", "Stop the core once every hardware thread has retired this many instructions in detailed mode (after any fast-forward and warmup). 0 runs to completion.", "0"},
+        { "bbv_interval", "Write a SimPoint basic-block vector every this many retired instructions per hardware thread. 0 disables BBV profiling.", "0"},
+        { "bbv_file_prefix", "Prefix for the BBV files, written as <prefix>.<thread>.bb. Defaults to the component name.", ""},
         { "enable_simt", "Implement SIMT pipeline for multithread kernels", "false"}  )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -171,7 +187,11 @@ public:
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
-          1 })
+          1 },
+        { "fast_forward_instructions", "Number of instructions retired while fast-forwarding", "instructions", 1 },
+        { "fast_forward_cycles", "Number of cycles spent fast-forwarding", "cycles", 1 },
+        { "fast_forward_translations", "Number of page translations requested from the OS while fast-forwarding", "requests", 1 },
+        { "measured_window_start", "Simulated time (SST core cycles, as in the statistic output) at which the core's statistics were enabled after fast-forward and warmup", "cycles", 1 })
 
     SST_ELI_DOCUMENT_PORTS({ "icache_link", "Connects the CPU to the instruction cache", {} },
                            { "dcache_link", "Connects the CPU to the data cache", {} },
@@ -229,8 +249,6 @@ private:
 
     virtual bool tick(SST::Cycle_t);
 
-    void resetRegisterUseTemps(const uint16_t i_reg, const uint16_t f_reg);
-
     int assignRegistersToInstruction(
         const uint16_t int_reg_count, const uint16_t fp_reg_count, VanadisInstruction* ins,
         VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs, VanadisISATable* isa_table);
@@ -249,7 +267,7 @@ private:
 
     int  performFetch(const uint64_t cycle);
     int  performDecode(const uint64_t cycle);
-    int  performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_start, int& unallocated_memory_op_seen);
+    int  performIssue(const uint64_t cycle, int hwThr, uint64_t& issue_start);
     int  performExecute(const uint64_t cycle);
     int  performRetire(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
     int  allocateFunctionalUnit(VanadisInstruction* ins);
@@ -280,6 +298,27 @@ private:
 
     void resetHwThread(uint32_t thr);
 
+    // Fast-forward mode: decoded instructions are executed and retired in order straight from
+    // the ROB, without renaming, the issue queue or the LSQ. Loads and stores use
+    // ff_memory, the memory controller's backing file, with translations requested from the
+    // OS. Syscalls (and anything else that needs the pipeline) are handed to the detailed
+    // pipeline one at a time. Branch predictors are still trained, the caches are only warmed
+    // by fast_forward_warmup_instructions after the switch.
+    void performFunctionalExecute(uint32_t thr);
+    bool executeFunctional(VanadisInstruction* ins);
+    bool executeFunctionalLoad(VanadisLoadInstruction* load_ins);
+    bool executeFunctionalStore(VanadisStoreInstruction* store_ins);
+    bool functionalAccessReady(uint32_t thr, uint64_t addr, uint16_t width, bool is_write);
+    void retireFunctional(VanadisInstruction* ins, bool end_block);
+    void recvTranslateResp(VanadisTranslateResp* resp);
+    void retireFastForward(VanadisInstruction* ins);
+    void endFastForward();
+    void endWarmup();
+
+    // Sampled simulation support: BBV profiling for choosing intervals and a limit on the
+    // number of instructions simulated in detail once an interval has been reached
+    void retireSample(VanadisInstruction* ins, bool end_block);
+
     SST::Output* output;
 
     uint16_t core_id;
@@ -295,6 +334,28 @@ private:
     uint32_t m_curRetireHwThread;
     uint32_t m_curIssueHwThread;
 
+    bool     fast_forwarding;
+    bool     fast_forward_done;
+    bool     sample_on_retire;
+    uint64_t fast_forward_ins_left;
+    uint64_t fast_forward_until_address;
+    uint64_t fast_forward_retired;
+    uint32_t fast_forward_width;
+    uint64_t warmup_ins_left;
+    bool     warming_up;
+    // cores in this process that have not yet reached their measured window, the last
+    // one to get there dumps the statistics
+    static std::atomic<uint32_t> cores_before_window;
+    // per hardware thread, so one busy thread cannot spend the budget of the others
+    std::vector<uint64_t> detailed_ins_left;
+
+    VanadisFunctionalMemory* ff_memory;
+    std::vector<bool>        ff_translate_pending;
+    // hardware thread inside a LOCK load/store pair, the others wait for it
+    int32_t                  ff_lock_holder;
+
+    std::vector<VanadisBasicBlockVectorProfiler*> bbv_profilers;
+
     std::vector<VanadisCircularQueue<VanadisInstruction*>*> rob;
     std::vector<VanadisCircularQueue<VanadisInstruction*>*> v_warp_rob;
     std::vector<VanadisDecoder*>                            thread_decoders;
@@ -314,10 +375,7 @@ private:
     std::vector<VanadisISATable*> issue_isa_tables;
     std::vector<VanadisISATable*> retire_isa_tables;
 
-    std::vector<uint8_t*> tmp_not_issued_int_reg_read;
-    std::vector<uint8_t*> tmp_int_reg_write;
-    std::vector<uint8_t*> tmp_not_issued_fp_reg_read;
-    std::vector<uint8_t*> tmp_fp_reg_write;
+    std::vector<VanadisIssueQueue*> issue_queues;
 
     std::list<VanadisInsCacheLoadRecord*>* icache_load_records;
 
@@ -358,6 +416,12 @@ private:
     Statistic<uint64_t>* stat_syscall_cycles;
     Statistic<uint64_t>* stat_int_phys_regs_in_use;
     Statistic<uint64_t>* stat_fp_phys_regs_in_use;
+    Statistic<uint64_t>* stat_ff_ins_retired;
+    Statistic<uint64_t>* stat_ff_cycles;
+    Statistic<uint64_t>* stat_ff_translations;
+    Statistic<uint64_t>* stat_window_start;
+    // statistics that are only collected in detailed mode
+    std::vector<Statistic<uint64_t>*> detailed_stats;
 
     uint32_t ins_issued_this_cycle;
     uint32_t ins_retired_this_cycle;
@@ -0,0 +1,156 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BBV_PROFILE
+#define _H_VANADIS_BBV_PROFILE
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Collects basic-block vectors (BBVs) for one hardware thread from the retired
+// instruction stream and writes them in the SimPoint .bb format:
+//
+//   T:<block id>:<instructions> :<block id>:<instructions> ...
+//
+// one line per interval. A block starts at the first instruction retired after a
+// branch, jump or syscall, and block ids are numbered from 1 in the order blocks
+// are first seen, so the output is deterministic for a given run. The mapping of
+// ids to block start addresses is written to <file>.map when the profile closes.
+class VanadisBasicBlockVectorProfiler {
+public:
+    VanadisBasicBlockVectorProfiler(const std::string& path, uint64_t interval) :
+        path(path),
+        interval_len(interval),
+        interval_count(0),
+        intervals_written(0),
+        block_id(0),
+        block_count(0),
+        in_block(false),
+        bbv_file(nullptr) {}
+
+    ~VanadisBasicBlockVectorProfiler() { close(); }
+
+    // Called for every retired instruction in program order. end_block is set when
+    // the instruction is the last one in its basic block.
+    void retire(uint64_t ins_addr, bool end_block) {
+        if ( !in_block ) {
+            auto it = block_ids.find(ins_addr);
+            if ( it == block_ids.end() ) {
+                block_id = block_addrs.size() + 1;
+                block_ids.insert(std::make_pair(ins_addr, block_id));
+                block_addrs.push_back(ins_addr);
+            }
+            else {
+                block_id = it->second;
+            }
+            in_block = true;
+        }
+
+        block_count++;
+        interval_count++;
+
+        if ( end_block ) { endBlock(); }
+
+        if ( interval_count == interval_len ) {
+            endBlock();
+            writeInterval();
+        }
+    }
+
+    uint64_t getIntervalsWritten() const { return intervals_written; }
+
+    // Writes the partial last interval (if any) and the block address map
+    void close() {
+        endBlock();
+
+        if ( interval_count > 0 ) { writeInterval(); }
+
+        if ( nullptr != bbv_file ) {
+            fclose(bbv_file);
+            bbv_file = nullptr;
+
+            std::string map_path = path + ".map";
+            FILE*       map_file = fopen(map_path.c_str(), "wt");
+
+            if ( nullptr != map_file ) {
+                for ( size_t i = 0; i < block_addrs.size(); ++i ) {
+                    fprintf(map_file, "%zu 0x%" PRIx64 "\n", i + 1, block_addrs[i]);
+                }
+                fclose(map_file);
+            }
+        }
+    }
+
+private:
+    void endBlock() {
+        if ( in_block ) {
+            interval_blocks[block_id] += block_count;
+            block_count = 0;
+            in_block    = false;
+        }
+    }
+
+    void writeInterval() {
+        if ( nullptr == bbv_file ) {
+            bbv_file = fopen(path.c_str(), "wt");
+            if ( nullptr == bbv_file ) { return; }
+        }
+
+        sorted.assign(interval_blocks.begin(), interval_blocks.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        fprintf(bbv_file, "T");
+        for ( auto& next : sorted ) {
+            fprintf(bbv_file, ":%" PRIu64 ":%" PRIu64 " ", next.first, next.second);
+        }
+        fprintf(bbv_file, "\n");
+
+        interval_blocks.clear();
+        interval_count = 0;
+        intervals_written++;
+    }
+
+    const std::string path;
+    const uint64_t    interval_len;
+    uint64_t          interval_count;
+    uint64_t          intervals_written;
+
+    // the block currently being retired, counted locally so the hash is only
+    // touched once per block rather than once per instruction
+    uint64_t block_id;
+    uint64_t block_count;
+    bool     in_block;
+
+    std::unordered_map<uint64_t, uint64_t>     block_ids;
+    std::vector<uint64_t>                      block_addrs;
+    std::unordered_map<uint64_t, uint64_t>     interval_blocks;
+    std::vector<std::pair<uint64_t, uint64_t>> sorted;
+
+    FILE* bbv_file;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,74 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_BRANCH_UNIT_BTB
+#define _H_VANADIS_BRANCH_UNIT_BTB
+
+#include "vbranch/vbranchtable.h"
+
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisBTBBranchUnit : public VanadisTableBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisBTBBranchUnit, "vanadis", "VanadisBTBBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "Set-associative branch target buffer and return address stack with a bimodal "
+                                  "(per-branch two bit counter) direction predictor",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_TABLE_BRANCH_ELI_PARAMS,
+                            { "bimodal_log_entries", "Log2 of the number of two bit counters", "12" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_TABLE_BRANCH_ELI_STATS)
+
+    VanadisBTBBranchUnit(ComponentId_t id, Params& params) : VanadisTableBranchUnit(id, params, 0) {
+        const uint32_t log_entries = params.find<uint32_t>("bimodal_log_entries", 12);
+
+        // weakly not taken
+        counters.assign(UINT64_C(1) << log_entries, 1);
+        counter_mask = counters.size() - 1;
+    }
+
+protected:
+    bool predictDirection(const uint64_t addr, const VanadisBranchHistory& history) override {
+        return counters[index(addr)] >= 2;
+    }
+
+    void updateDirection(const uint64_t addr, const VanadisBranchHistory& history, const bool taken) override {
+        uint8_t& counter = counters[index(addr)];
+
+        if ( taken ) {
+            if ( counter < 3 ) { counter++; }
+        }
+        else {
+            if ( counter > 0 ) { counter--; }
+        }
+    }
+
+    size_t index(const uint64_t addr) const { return (addr >> 1) & counter_mask; }
+
+    std::vector<uint8_t> counters;
+    uint64_t             counter_mask;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
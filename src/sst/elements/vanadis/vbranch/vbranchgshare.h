@@ -0,0 +1,86 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_BRANCH_UNIT_GSHARE
+#define _H_VANADIS_BRANCH_UNIT_GSHARE
+
+#include "vbranch/vbranchtable.h"
+
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisGShareBranchUnit : public VanadisTableBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisGShareBranchUnit, "vanadis", "VanadisGShareBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "Set-associative branch target buffer and return address stack with a gshare "
+                                  "direction predictor (two bit counters indexed by address XOR global history)",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_TABLE_BRANCH_ELI_PARAMS,
+                            { "gshare_log_entries", "Log2 of the number of two bit counters", "14" },
+                            { "gshare_history", "Number of global history bits used, at most 64", "14" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_TABLE_BRANCH_ELI_STATS)
+
+    VanadisGShareBranchUnit(ComponentId_t id, Params& params) : VanadisTableBranchUnit(id, params, 64) {
+        log_entries    = params.find<uint32_t>("gshare_log_entries", 14);
+        history_length = params.find<uint32_t>("gshare_history", 14);
+
+        if ( history_length > 64 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "Error: gshare_history (%" PRIu32 ") must be at most 64.\n", history_length);
+        }
+
+        // weakly not taken
+        counters.assign(UINT64_C(1) << log_entries, 1);
+    }
+
+protected:
+    bool predictDirection(const uint64_t addr, const VanadisBranchHistory& history) override {
+        return counters[index(addr, history)] >= 2;
+    }
+
+    void updateDirection(const uint64_t addr, const VanadisBranchHistory& history, const bool taken) override {
+        uint8_t& counter = counters[index(addr, history)];
+
+        if ( taken ) {
+            if ( counter < 3 ) { counter++; }
+        }
+        else {
+            if ( counter > 0 ) { counter--; }
+        }
+    }
+
+    size_t index(const uint64_t addr, const VanadisBranchHistory& history) const {
+        uint64_t recent = history.getRecent();
+        if ( history_length < 64 ) { recent &= (UINT64_C(1) << history_length) - 1; }
+
+        return ((addr >> 1) ^ foldBits(recent, log_entries)) & (counters.size() - 1);
+    }
+
+    uint32_t             log_entries;
+    uint32_t             history_length;
+    std::vector<uint8_t> counters;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
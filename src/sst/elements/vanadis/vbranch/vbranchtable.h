@@ -0,0 +1,435 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TABLE
+#define _H_VANADIS_BRANCH_UNIT_TABLE
+
+#include "vbranch/vbranchunit.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Global history of conditional branch directions, newest first, with any number
+// of folded (compressed) copies of its most recent bits for table indexing. Each
+// fold is kept up to date one bit at a time as directions are pushed, so reading
+// one is O(1) however long the history it covers.
+class VanadisBranchHistory {
+public:
+    explicit VanadisBranchHistory(uint32_t max_length) : head(0), recent(0) {
+        size_t size = 64;
+        while ( size <= max_length ) {
+            size <<= 1;
+        }
+        bits.assign(size, 0);
+    }
+
+    // Fold the most recent length directions down to width bits, returns the
+    // index of the fold for getFold()
+    uint32_t addFold(uint32_t length, uint32_t width) {
+        folds.push_back(Fold(length, width));
+        return folds.size() - 1;
+    }
+
+    void push(bool taken) {
+        const size_t mask = bits.size() - 1;
+
+        head       = (head + 1) & mask;
+        bits[head] = taken ? 1 : 0;
+        recent     = (recent << 1) | (taken ? 1 : 0);
+
+        for ( Fold& next : folds ) {
+            next.value = (next.value << 1) | bits[head];
+            next.value ^= ((uint32_t)bits[(head - next.length) & mask]) << next.out_point;
+            next.value ^= next.value >> next.width;
+            next.value &= (UINT32_C(1) << next.width) - 1;
+        }
+    }
+
+    uint32_t getFold(uint32_t fold) const { return folds[fold].value; }
+
+    // The last 64 directions, the newest in bit 0
+    uint64_t getRecent() const { return recent; }
+
+private:
+    struct Fold {
+        Fold(uint32_t len, uint32_t w) : length(len), width(w), out_point(len % w), value(0) {}
+
+        uint32_t length;
+        uint32_t width;
+        uint32_t out_point;
+        uint32_t value;
+    };
+
+    std::vector<uint8_t> bits;
+    size_t               head;
+    uint64_t             recent;
+    std::vector<Fold>    folds;
+};
+
+// Circular return address stack, the oldest entries are overwritten when calls
+// nest deeper than the stack
+class VanadisReturnAddressStack {
+public:
+    explicit VanadisReturnAddressStack(uint32_t entries) : stack(entries, 0), top(0), count(0) {}
+
+    void push(uint64_t addr) {
+        if ( stack.empty() ) { return; }
+
+        top        = (top + 1) % stack.size();
+        stack[top] = addr;
+        if ( count < stack.size() ) { count++; }
+    }
+
+    bool pop(uint64_t& addr) {
+        if ( 0 == count ) { return false; }
+
+        addr = stack[top];
+        top  = (top + stack.size() - 1) % stack.size();
+        count--;
+        return true;
+    }
+
+private:
+    std::vector<uint64_t> stack;
+    size_t                top;
+    size_t                count;
+};
+
+// Set-associative branch target buffer held in one flat array, set-major, with
+// least-recently-used replacement inside a set. Entries are tagged with the full
+// instruction address so there is no aliasing between branches.
+class VanadisBranchTargetBuffer {
+public:
+    VanadisBranchTargetBuffer(uint32_t sets, uint32_t ways) :
+        ways(ways),
+        set_bits(0),
+        set_mask(sets - 1),
+        use_stamp(0),
+        entries((size_t)sets * ways) {
+        while ( (UINT64_C(1) << set_bits) < sets ) {
+            set_bits++;
+        }
+    }
+
+    bool contains(uint64_t addr) const { return nullptr != find(addr); }
+
+    bool lookup(uint64_t addr, uint64_t& target) {
+        Entry* entry = const_cast<Entry*>(find(addr));
+
+        if ( nullptr == entry ) { return false; }
+
+        entry->last_use = ++use_stamp;
+        target          = entry->target;
+        return true;
+    }
+
+    // Returns true if a valid entry had to be cast out to make space
+    bool insert(uint64_t addr, uint64_t target) {
+        Entry* set    = &entries[setIndex(addr) * ways];
+        Entry* victim = nullptr;
+
+        for ( uint32_t i = 0; i < ways; ++i ) {
+            Entry* next = &set[i];
+
+            if ( next->valid && (next->tag == addr) ) {
+                next->target   = target;
+                next->last_use = ++use_stamp;
+                return false;
+            }
+
+            if ( (nullptr == victim) ||
+                 (victim->valid && ((!next->valid) || (next->last_use < victim->last_use))) ) {
+                victim = next;
+            }
+        }
+
+        const bool castout = victim->valid;
+
+        victim->valid    = true;
+        victim->tag      = addr;
+        victim->target   = target;
+        victim->last_use = ++use_stamp;
+
+        return castout;
+    }
+
+private:
+    struct Entry {
+        Entry() : tag(0), target(0), last_use(0), valid(false) {}
+
+        uint64_t tag;
+        uint64_t target;
+        uint64_t last_use;
+        bool     valid;
+    };
+
+    size_t setIndex(uint64_t addr) const { return ((addr >> 1) ^ (addr >> (1 + set_bits))) & set_mask; }
+
+    const Entry* find(uint64_t addr) const {
+        const Entry* set = &entries[setIndex(addr) * ways];
+
+        for ( uint32_t i = 0; i < ways; ++i ) {
+            if ( set[i].valid && (set[i].tag == addr) ) { return &set[i]; }
+        }
+
+        return nullptr;
+    }
+
+    const uint32_t     ways;
+    uint32_t           set_bits;
+    const uint64_t     set_mask;
+    uint64_t           use_stamp;
+    std::vector<Entry> entries;
+};
+
+#define VANADIS_TABLE_BRANCH_ELI_PARAMS                                                                       \
+    { "btb_entries", "Number of entries in the branch target buffer, entries / ways must be a power of 2",    \
+      "4096" },                                                                                               \
+    { "btb_ways", "Associativity of the branch target buffer", "4" },                                         \
+    { "ras_entries", "Number of entries in the return address stack, 0 disables return prediction", "16" }
+
+#define VANADIS_TABLE_BRANCH_ELI_STATS                                                                        \
+    { "branch_cache_hit", "Counts the number of times a branch is found in the branch target buffer", "hits", \
+      1 },                                                                                                    \
+    { "branch_cache_miss", "Counts the number of times a branch is not found in the branch target buffer",    \
+      "misses", 1 },                                                                                          \
+    { "branch_cache_castout", "Counts the number of entries that are thrown out because of capacity limits",  \
+      "entries", 1 },                                                                                         \
+    { "conditional_correct", "Counts conditional branches fetched down the correct direction", "branches",    \
+      1 },                                                                                                    \
+    { "conditional_mispredict", "Counts conditional branches fetched down the wrong direction", "branches",   \
+      1 },                                                                                                    \
+    { "return_correct", "Counts returns correctly predicted by the return address stack", "returns", 1 },     \
+    { "return_mispredict", "Counts returns mispredicted by, or missing from, the return address stack",       \
+      "returns", 1 }
+
+// Common base for the table driven branch units.
+//
+// Branch targets come from a flat set-associative BTB and returns from a return
+// address stack. Conditional branch directions come from the subclass, which sees
+// the global history of conditional directions. Prediction happens at decode with
+// speculative copies of the history and the return stack, and the tables are
+// trained at retire with the committed copies. A pipeline flush restores the
+// speculative copies from the committed ones, so wrong-path branches never
+// pollute the history and every retiring branch is trained with exactly the
+// history it was predicted with.
+class VanadisTableBranchUnit : public VanadisBranchUnit {
+
+public:
+    VanadisTableBranchUnit(ComponentId_t id, Params& params, uint32_t history_length) :
+        VanadisBranchUnit(id, params),
+        btb(tableSets(params), params.find<uint32_t>("btb_ways", 4)),
+        spec_ras(params.find<uint32_t>("ras_entries", 16)),
+        commit_ras(params.find<uint32_t>("ras_entries", 16)),
+        spec_history(history_length),
+        commit_history(history_length),
+        link_regs(0) {
+
+        const uint32_t btb_entries = params.find<uint32_t>("btb_entries", 4096);
+        const uint32_t btb_ways    = params.find<uint32_t>("btb_ways", 4);
+
+        if ( (0 == btb_ways) || (0 != (btb_entries % btb_ways)) || (!isPowerOfTwo(btb_entries / btb_ways)) ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1,
+                "Error: btb_entries (%" PRIu32 ") / btb_ways (%" PRIu32 ") must be a power of 2.\n", btb_entries,
+                btb_ways);
+        }
+
+        stat_btb_hits          = registerStatistic<uint64_t>("branch_cache_hit", "1");
+        stat_btb_misses        = registerStatistic<uint64_t>("branch_cache_miss", "1");
+        stat_btb_castout       = registerStatistic<uint64_t>("branch_cache_castout", "1");
+        stat_cond_correct      = registerStatistic<uint64_t>("conditional_correct", "1");
+        stat_cond_mispredict   = registerStatistic<uint64_t>("conditional_mispredict", "1");
+        stat_return_correct    = registerStatistic<uint64_t>("return_correct", "1");
+        stat_return_mispredict = registerStatistic<uint64_t>("return_mispredict", "1");
+    }
+
+    virtual ~VanadisTableBranchUnit() {}
+
+    uint64_t predict(const uint64_t ins_addr, VanadisSpeculatedInstruction* ins, const uint64_t fall_through) override {
+        const VanadisBranchType branch_type = ins->getBranchType();
+
+        if ( VANADIS_BRANCH_INDIRECT == branch_type && isReturn(ins) ) {
+            uint64_t return_addr = 0;
+            if ( spec_ras.pop(return_addr) ) { return return_addr; }
+        }
+
+        uint64_t   target  = fall_through;
+        const bool btb_hit = btb.lookup(ins_addr, target);
+
+        if ( btb_hit ) { stat_btb_hits->addData(1); }
+        else {
+            stat_btb_misses->addData(1);
+        }
+
+        switch ( branch_type ) {
+        case VANADIS_BRANCH_CONDITIONAL:
+        {
+            const bool taken = predictDirection(ins_addr, spec_history);
+            spec_history.push(taken);
+            return (taken && btb_hit) ? target : fall_through;
+        }
+        case VANADIS_BRANCH_CALL:
+            spec_ras.push(ins->getNotTakenAddress());
+            learnLinkRegister(ins);
+            break;
+        default:
+            break;
+        }
+
+        return target;
+    }
+
+    void update(VanadisSpeculatedInstruction* ins, const uint64_t next_addr) override {
+        const uint64_t ins_addr  = ins->getInstructionAddress();
+        const uint64_t not_taken = ins->getNotTakenAddress();
+
+        switch ( ins->getBranchType() ) {
+        case VANADIS_BRANCH_CONDITIONAL:
+        {
+            const bool taken = (next_addr != not_taken);
+
+            if ( (ins->getSpeculatedAddress() != not_taken) == taken ) { stat_cond_correct->addData(1); }
+            else {
+                stat_cond_mispredict->addData(1);
+            }
+
+            updateDirection(ins_addr, commit_history, taken);
+            commit_history.push(taken);
+
+            if ( !taken ) { return; }
+        } break;
+        case VANADIS_BRANCH_CALL:
+            commit_ras.push(not_taken);
+            break;
+        case VANADIS_BRANCH_INDIRECT:
+            if ( isReturn(ins) ) {
+                uint64_t return_addr = 0;
+                if ( commit_ras.pop(return_addr) && (return_addr == next_addr) ) {
+                    stat_return_correct->addData(1);
+                }
+                else {
+                    stat_return_mispredict->addData(1);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+
+        push(ins_addr, next_addr);
+    }
+
+    void recover() override {
+        spec_history = commit_history;
+        spec_ras     = commit_ras;
+        recoverDirection();
+    }
+
+    void push(const uint64_t ins_addr, const uint64_t pred_addr) override {
+        if ( btb.insert(ins_addr, pred_addr) ) { stat_btb_castout->addData(1); }
+    }
+
+    uint64_t predictAddress(const uint64_t addr) override {
+        uint64_t target = 0;
+        btb.lookup(addr, target);
+        return target;
+    }
+
+    bool contains(const uint64_t addr) override { return btb.contains(addr); }
+
+protected:
+    // Direction of the conditional branch at addr given the history before it, called
+    // once for every conditional branch decoded (including wrong-path ones)
+    virtual bool predictDirection(const uint64_t addr, const VanadisBranchHistory& history) = 0;
+
+    // Train with the direction of a retired conditional branch, history is the
+    // committed history before the branch
+    virtual void updateDirection(const uint64_t addr, const VanadisBranchHistory& history, const bool taken) = 0;
+
+    // Discard any speculative state after a pipeline flush
+    virtual void recoverDirection() {}
+
+    // Both histories must carry the same folds
+    uint32_t addHistoryFold(uint32_t length, uint32_t width) {
+        spec_history.addFold(length, width);
+        return commit_history.addFold(length, width);
+    }
+
+    static bool isPowerOfTwo(uint64_t value) { return (value != 0) && (0 == (value & (value - 1))); }
+
+    // Fold a 64-bit value down to width bits
+    static uint64_t foldBits(uint64_t value, uint32_t width) {
+        if ( width >= 64 ) { return value; }
+
+        uint64_t folded = 0;
+        while ( value != 0 ) {
+            folded ^= value & ((UINT64_C(1) << width) - 1);
+            value >>= width;
+        }
+        return folded;
+    }
+
+private:
+    static uint32_t tableSets(Params& params) {
+        const uint32_t btb_entries = params.find<uint32_t>("btb_entries", 4096);
+        const uint32_t btb_ways    = params.find<uint32_t>("btb_ways", 4);
+
+        // checked in the constructor, keep the table valid until then
+        const uint32_t sets = (btb_ways > 0) ? (btb_entries / btb_ways) : 0;
+        return isPowerOfTwo(sets) ? sets : 1;
+    }
+
+    // Any register a call has linked through is treated as a return address
+    // register, so an indirect jump through it is a return. This covers jr $ra on
+    // MIPS and jalr x0, 0(ra) / jalr x0, 0(t0) on RISC-V.
+    void learnLinkRegister(VanadisSpeculatedInstruction* ins) {
+        if ( ins->countISAIntRegOut() > 0 ) {
+            const uint16_t link_reg = ins->getISAIntRegOut(0);
+            if ( link_reg < 64 ) { link_regs |= (UINT64_C(1) << link_reg); }
+        }
+    }
+
+    bool isReturn(VanadisSpeculatedInstruction* ins) const {
+        if ( 0 == ins->countISAIntRegIn() ) { return false; }
+
+        const uint16_t jump_reg = ins->getISAIntRegIn(0);
+        return (jump_reg < 64) && (0 != (link_regs & (UINT64_C(1) << jump_reg)));
+    }
+
+    VanadisBranchTargetBuffer btb;
+    VanadisReturnAddressStack spec_ras;
+    VanadisReturnAddressStack commit_ras;
+    VanadisBranchHistory      spec_history;
+    VanadisBranchHistory      commit_history;
+    uint64_t                  link_regs;
+
+    Statistic<uint64_t>* stat_btb_hits;
+    Statistic<uint64_t>* stat_btb_misses;
+    Statistic<uint64_t>* stat_btb_castout;
+    Statistic<uint64_t>* stat_cond_correct;
+    Statistic<uint64_t>* stat_cond_mispredict;
+    Statistic<uint64_t>* stat_return_correct;
+    Statistic<uint64_t>* stat_return_mispredict;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,580 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TAGE
+#define _H_VANADIS_BRANCH_UNIT_TAGE
+
+#include "vbranch/vbranchtable.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// TAGE-SC-L direction prediction (after Seznec, "TAGE-SC-L Branch Predictors").
+//
+// TAGE: a bimodal base table plus tagged tables indexed with geometrically longer
+// global histories. The longest matching table provides the prediction, unless
+// its entry is newly allocated and the alternate prediction has been doing better
+// on such entries. A misprediction allocates an entry in a longer table.
+//
+// SC: a statistical corrector that sums a bias table and a few short history
+// tables with the confidence of the TAGE prediction, and reverts the TAGE
+// prediction when the sum disagrees with it.
+//
+// L: a loop predictor that learns the trip count of regular loops and predicts
+// the exit once it has seen the same count several times in a row.
+class VanadisTAGEBranchUnit : public VanadisTableBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisTAGEBranchUnit, "vanadis", "VanadisTAGEBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "Set-associative branch target buffer and return address stack with a TAGE-SC-L "
+                                  "direction predictor",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_TABLE_BRANCH_ELI_PARAMS,
+                            { "bimodal_log_entries", "Log2 of the number of entries in the TAGE base table", "13" },
+                            { "tage_tables", "Number of tagged TAGE tables (1 to 16)", "7" },
+                            { "tage_log_entries", "Log2 of the number of entries in each tagged table", "10" },
+                            { "tage_tag_bits", "Width of the tags in the tagged tables (2 to 16)", "11" },
+                            { "tage_min_history", "History length of the shortest tagged table", "5" },
+                            { "tage_max_history", "History length of the longest tagged table", "640" },
+                            { "tage_u_reset_period", "Number of updates between agings of the useful bits", "262144" },
+                            { "use_loop", "Enable the loop predictor", "1" },
+                            { "loop_log_entries", "Log2 of the number of entries in the loop predictor", "6" },
+                            { "use_sc", "Enable the statistical corrector", "1" },
+                            { "sc_log_entries", "Log2 of the number of entries in each statistical corrector table",
+                              "10" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_TABLE_BRANCH_ELI_STATS,
+                                { "loop_override", "Counts retired branches predicted by the loop predictor",
+                                  "branches", 1 },
+                                { "sc_override",
+                                  "Counts retired branches where the statistical corrector reverted TAGE",
+                                  "branches", 1 })
+
+    VanadisTAGEBranchUnit(ComponentId_t id, Params& params) :
+        VanadisTableBranchUnit(id, params, params.find<uint32_t>("tage_max_history", 640)),
+        use_alt_on_na(0),
+        loop_use(0),
+        sc_threshold(35),
+        sc_threshold_ctr(0),
+        update_count(0),
+        lfsr(0x2545f491) {
+
+        const uint32_t bimodal_log = params.find<uint32_t>("bimodal_log_entries", 13);
+        num_tables                 = params.find<uint32_t>("tage_tables", 7);
+        log_entries                = params.find<uint32_t>("tage_log_entries", 10);
+        tag_bits                   = params.find<uint32_t>("tage_tag_bits", 11);
+        u_reset_period             = params.find<uint64_t>("tage_u_reset_period", 262144);
+        use_loop                   = params.find<bool>("use_loop", true);
+        loop_log                   = params.find<uint32_t>("loop_log_entries", 6);
+        use_sc                     = params.find<bool>("use_sc", true);
+        sc_log                     = params.find<uint32_t>("sc_log_entries", 10);
+
+        const uint32_t min_history = params.find<uint32_t>("tage_min_history", 5);
+        const uint32_t max_history = params.find<uint32_t>("tage_max_history", 640);
+
+        if ( (num_tables < 1) || (num_tables > MAX_TABLES) ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "Error: tage_tables (%" PRIu32 ") must be between 1 and %" PRIu32 ".\n", num_tables,
+                MAX_TABLES);
+        }
+        if ( (tag_bits < 2) || (tag_bits > 16) ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "Error: tage_tag_bits (%" PRIu32 ") must be between 2 and 16.\n", tag_bits);
+        }
+        if ( (log_entries < 1) || (log_entries > 24) || (sc_log > 24) || (loop_log > 16) || (bimodal_log > 30) ) {
+            getSimulationOutput().fatal(CALL_INFO, -1, "Error: TAGE-SC-L table sizes are out of range.\n");
+        }
+        if ( (min_history < 1) || (max_history < min_history) ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1,
+                "Error: tage_min_history (%" PRIu32 ") must be at least 1 and at most tage_max_history (%" PRIu32
+                ").\n",
+                min_history, max_history);
+        }
+
+        // geometric series of history lengths
+        for ( uint32_t i = 0; i < num_tables; ++i ) {
+            uint32_t length = min_history;
+            if ( num_tables > 1 ) {
+                length = (uint32_t)(min_history * std::pow((double)max_history / (double)min_history,
+                                                           (double)i / (double)(num_tables - 1)) +
+                                    0.5);
+            }
+
+            index_fold[i] = addHistoryFold(length, log_entries);
+            tag_fold[i]   = addHistoryFold(length, tag_bits);
+            tag_fold2[i]  = addHistoryFold(length, tag_bits - 1);
+        }
+
+        // weakly not taken
+        bimodal.assign(UINT64_C(1) << bimodal_log, 1);
+        tagged.resize((size_t)num_tables << log_entries);
+
+        if ( use_loop ) {
+            loops.resize(UINT64_C(1) << loop_log);
+            loop_spec_iter.assign(loops.size(), 0);
+        }
+
+        if ( use_sc ) {
+            sc_bias.assign(UINT64_C(1) << sc_log, 0);
+            for ( uint32_t i = 0; i < SC_TABLES; ++i ) {
+                sc_tables[i].assign(UINT64_C(1) << sc_log, 0);
+            }
+        }
+
+        stat_loop_override = registerStatistic<uint64_t>("loop_override", "1");
+        stat_sc_override   = registerStatistic<uint64_t>("sc_override", "1");
+    }
+
+protected:
+    static constexpr uint32_t MAX_TABLES = 16;
+    static constexpr uint32_t SC_TABLES  = 4;
+    static constexpr int32_t  LOOP_CONFIDENT = 3;
+
+    struct TaggedEntry {
+        TaggedEntry() : tag(0), ctr(0), u(0) {}
+
+        uint16_t tag;
+        int8_t   ctr; // 3-bit signed, taken when >= 0
+        uint8_t  u;   // 2-bit useful counter
+    };
+
+    struct LoopEntry {
+        LoopEntry() : tag(0), past_iter(0), current_iter(0), confidence(0), age(0), dir(false), valid(false) {}
+
+        uint16_t tag;
+        uint16_t past_iter;    // body iterations seen on the last trip
+        uint16_t current_iter; // body iterations so far on this trip
+        uint8_t  confidence;
+        uint8_t  age;
+        bool     dir;          // direction of the loop body
+        bool     valid;
+    };
+
+    struct Prediction {
+        // TAGE
+        uint32_t index[MAX_TABLES];
+        uint16_t tag[MAX_TABLES];
+        size_t   bimodal_index;
+        int32_t  provider;
+        int32_t  alt;
+        bool     provider_pred;
+        bool     alt_pred;
+        bool     provider_new;
+        bool     tage_pred;
+
+        // SC
+        int32_t sc_sum;
+        bool    sc_pred;
+        bool    sc_used;
+
+        // L
+        bool loop_hit;
+        bool loop_valid;
+        bool loop_pred;
+        bool loop_used;
+
+        bool prediction;
+    };
+
+    bool predictDirection(const uint64_t addr, const VanadisBranchHistory& history) override {
+        Prediction pred;
+        predictAll(addr, history, true, pred);
+
+        // advance the speculative trip count
+        if ( pred.loop_hit ) {
+            uint16_t& iter = loop_spec_iter[loopIndex(addr)];
+            iter           = (pred.prediction == loops[loopIndex(addr)].dir) ? (iter + 1) : 0;
+        }
+
+        return pred.prediction;
+    }
+
+    void updateDirection(const uint64_t addr, const VanadisBranchHistory& history, const bool taken) override {
+        Prediction pred;
+        predictAll(addr, history, false, pred);
+
+        if ( pred.loop_used ) { stat_loop_override->addData(1); }
+        if ( pred.sc_used ) { stat_sc_override->addData(1); }
+
+        if ( use_loop ) {
+            const bool pre_loop_pred = pred.sc_used ? pred.sc_pred : pred.tage_pred;
+
+            if ( pred.loop_valid && (pred.loop_pred != pre_loop_pred) ) {
+                saturate(loop_use, (pred.loop_pred == taken) ? 1 : -1, -64, 63);
+            }
+
+            updateLoop(addr, taken, pre_loop_pred != taken);
+        }
+
+        if ( use_sc ) { updateSC(addr, history, pred, taken); }
+
+        updateTAGE(pred, taken);
+    }
+
+    void recoverDirection() override {
+        for ( size_t i = 0; i < loops.size(); ++i ) {
+            loop_spec_iter[i] = loops[i].current_iter;
+        }
+    }
+
+    // speculative selects the loop trip counts advanced at decode rather than the
+    // committed ones
+    void predictAll(const uint64_t addr, const VanadisBranchHistory& history, const bool speculative, Prediction& pred) {
+        predictTAGE(addr, history, pred);
+
+        bool current = pred.tage_pred;
+
+        pred.sc_used = false;
+        if ( use_sc ) {
+            pred.sc_sum  = sumSC(addr, history, pred);
+            pred.sc_pred = (pred.sc_sum >= 0);
+
+            if ( pred.sc_pred != pred.tage_pred ) {
+                pred.sc_used = true;
+                current      = pred.sc_pred;
+            }
+        }
+
+        pred.loop_hit   = false;
+        pred.loop_valid = false;
+        pred.loop_used  = false;
+        if ( use_loop ) {
+            const size_t     index = loopIndex(addr);
+            const LoopEntry& entry = loops[index];
+
+            if ( entry.valid && (entry.tag == loopTag(addr)) ) {
+                pred.loop_hit   = true;
+                pred.loop_valid = (entry.confidence == LOOP_CONFIDENT) && (entry.past_iter > 0);
+                const uint16_t iter = speculative ? loop_spec_iter[index] : entry.current_iter;
+
+                pred.loop_pred = (iter == entry.past_iter) ? !entry.dir : entry.dir;
+
+                if ( pred.loop_valid && (loop_use >= 0) ) {
+                    pred.loop_used = true;
+                    current        = pred.loop_pred;
+                }
+            }
+        }
+
+        pred.prediction = current;
+    }
+
+    void predictTAGE(const uint64_t addr, const VanadisBranchHistory& history, Prediction& pred) {
+        const uint64_t pc         = addr >> 1;
+        const uint32_t index_mask = (UINT32_C(1) << log_entries) - 1;
+        const uint32_t tag_mask   = (UINT32_C(1) << tag_bits) - 1;
+
+        pred.provider = -1;
+        pred.alt      = -1;
+
+        for ( int32_t i = num_tables - 1; i >= 0; --i ) {
+            const uint32_t shift = std::abs((int32_t)log_entries - i) + 1;
+
+            pred.index[i] = (uint32_t)(pc ^ (pc >> shift) ^ history.getFold(index_fold[i])) & index_mask;
+            pred.tag[i] =
+                (uint16_t)((pc ^ history.getFold(tag_fold[i]) ^ (history.getFold(tag_fold2[i]) << 1)) & tag_mask);
+
+            if ( taggedEntry(i, pred.index[i]).tag == pred.tag[i] ) {
+                if ( pred.provider < 0 ) { pred.provider = i; }
+                else if ( pred.alt < 0 ) {
+                    pred.alt = i;
+                }
+            }
+        }
+
+        pred.bimodal_index = pc & (bimodal.size() - 1);
+
+        pred.alt_pred = (pred.alt >= 0) ? (taggedEntry(pred.alt, pred.index[pred.alt]).ctr >= 0)
+                                        : (bimodal[pred.bimodal_index] >= 2);
+
+        if ( pred.provider < 0 ) {
+            pred.provider_pred = pred.alt_pred;
+            pred.provider_new  = false;
+            pred.tage_pred     = pred.alt_pred;
+            return;
+        }
+
+        const TaggedEntry& entry = taggedEntry(pred.provider, pred.index[pred.provider]);
+
+        pred.provider_pred = (entry.ctr >= 0);
+        pred.provider_new  = ((entry.ctr == 0) || (entry.ctr == -1)) && (entry.u == 0);
+        pred.tage_pred     = (pred.provider_new && (use_alt_on_na >= 0)) ? pred.alt_pred : pred.provider_pred;
+    }
+
+    void updateTAGE(const Prediction& pred, const bool taken) {
+        // allocate in a longer table on a misprediction, skipping the first free
+        // candidate at random so that entries are not always taken from one table
+        if ( (pred.tage_pred != taken) && (pred.provider < (int32_t)num_tables - 1) ) {
+            uint32_t first = pred.provider + 1;
+            if ( (first + 1 < num_tables) && (nextRandom() & 1) ) { first++; }
+
+            bool allocated = false;
+            for ( uint32_t i = first; i < num_tables && !allocated; ++i ) {
+                allocated = allocate(i, pred, taken);
+            }
+            if ( !allocated && (first > (uint32_t)(pred.provider + 1)) ) {
+                allocated = allocate(pred.provider + 1, pred, taken);
+            }
+            if ( !allocated ) {
+                for ( uint32_t i = pred.provider + 1; i < num_tables; ++i ) {
+                    TaggedEntry& entry = taggedEntry(i, pred.index[i]);
+                    if ( entry.u > 0 ) { entry.u--; }
+                }
+            }
+        }
+
+        if ( pred.provider >= 0 ) {
+            TaggedEntry& entry = taggedEntry(pred.provider, pred.index[pred.provider]);
+
+            if ( pred.provider_new && (pred.provider_pred != pred.alt_pred) ) {
+                saturate(use_alt_on_na, (pred.alt_pred == taken) ? 1 : -1, -8, 7);
+            }
+
+            // a new entry has not proven itself, keep the alternate trained too
+            if ( entry.u == 0 ) {
+                if ( pred.alt >= 0 ) {
+                    int8_t& alt_ctr = taggedEntry(pred.alt, pred.index[pred.alt]).ctr;
+                    saturate(alt_ctr, taken ? 1 : -1, -4, 3);
+                }
+                else {
+                    updateBimodal(pred.bimodal_index, taken);
+                }
+            }
+
+            saturate(entry.ctr, taken ? 1 : -1, -4, 3);
+
+            if ( pred.provider_pred != pred.alt_pred ) {
+                if ( pred.provider_pred == taken ) {
+                    if ( entry.u < 3 ) { entry.u++; }
+                }
+                else if ( entry.u > 0 ) {
+                    entry.u--;
+                }
+            }
+        }
+        else {
+            updateBimodal(pred.bimodal_index, taken);
+        }
+
+        // age the useful counters so that stale entries can be replaced
+        if ( (u_reset_period > 0) && (0 == (++update_count % u_reset_period)) ) {
+            for ( TaggedEntry& entry : tagged ) {
+                entry.u >>= 1;
+            }
+        }
+    }
+
+    bool allocate(uint32_t table, const Prediction& pred, const bool taken) {
+        TaggedEntry& entry = taggedEntry(table, pred.index[table]);
+
+        if ( entry.u != 0 ) { return false; }
+
+        entry.tag = pred.tag[table];
+        entry.ctr = taken ? 0 : -1;
+        return true;
+    }
+
+    void updateBimodal(size_t index, const bool taken) {
+        uint8_t& counter = bimodal[index];
+
+        if ( taken ) {
+            if ( counter < 3 ) { counter++; }
+        }
+        else if ( counter > 0 ) {
+            counter--;
+        }
+    }
+
+    // Statistical corrector sum, the sign is the corrected prediction
+    int32_t sumSC(const uint64_t addr, const VanadisBranchHistory& history, const Prediction& pred) {
+        // centered TAGE confidence
+        int32_t sum = 0;
+        if ( pred.provider >= 0 ) { sum = 8 * (2 * taggedEntry(pred.provider, pred.index[pred.provider]).ctr + 1); }
+        else {
+            sum = 8 * (2 * (int32_t)bimodal[pred.bimodal_index] - 3);
+        }
+        // when TAGE used the alternate prediction its own sign is what counts
+        if ( (sum >= 0) != pred.tage_pred ) { sum = -sum; }
+
+        sum += 2 * sc_bias[scBiasIndex(addr, pred.tage_pred)] + 1;
+
+        for ( uint32_t i = 0; i < SC_TABLES; ++i ) {
+            sum += 2 * sc_tables[i][scIndex(addr, history, i)] + 1;
+        }
+
+        return sum;
+    }
+
+    void updateSC(const uint64_t addr, const VanadisBranchHistory& history, const Prediction& pred, const bool taken) {
+        if ( pred.sc_pred != taken ) {
+            if ( ++sc_threshold_ctr >= 63 ) {
+                sc_threshold++;
+                sc_threshold_ctr = 0;
+            }
+        }
+        else if ( std::abs(pred.sc_sum) < sc_threshold ) {
+            if ( --sc_threshold_ctr <= -64 ) {
+                if ( sc_threshold > 6 ) { sc_threshold--; }
+                sc_threshold_ctr = 0;
+            }
+        }
+
+        if ( (pred.sc_pred != taken) || (std::abs(pred.sc_sum) < sc_threshold) ) {
+            saturate(sc_bias[scBiasIndex(addr, pred.tage_pred)], taken ? 1 : -1, -32, 31);
+
+            for ( uint32_t i = 0; i < SC_TABLES; ++i ) {
+                saturate(sc_tables[i][scIndex(addr, history, i)], taken ? 1 : -1, -32, 31);
+            }
+        }
+    }
+
+    size_t scBiasIndex(const uint64_t addr, const bool tage_pred) const {
+        return (((addr >> 1) << 1) | (tage_pred ? 1 : 0)) & (sc_bias.size() - 1);
+    }
+
+    size_t scIndex(const uint64_t addr, const VanadisBranchHistory& history, uint32_t table) const {
+        static const uint32_t lengths[SC_TABLES] = { 4, 9, 17, 31 };
+
+        const uint64_t pc     = addr >> 1;
+        const uint64_t recent = history.getRecent() & ((UINT64_C(1) << lengths[table]) - 1);
+
+        return (pc ^ (pc >> (table + 2)) ^ foldBits(recent, sc_log)) & (sc_tables[table].size() - 1);
+    }
+
+    void updateLoop(const uint64_t addr, const bool taken, const bool mispredicted) {
+        const size_t index = loopIndex(addr);
+        LoopEntry&   entry = loops[index];
+
+        if ( entry.valid && (entry.tag == loopTag(addr)) ) {
+            if ( (entry.confidence == LOOP_CONFIDENT) && (entry.past_iter > 0) ) {
+                const bool loop_pred = (entry.current_iter == entry.past_iter) ? !entry.dir : entry.dir;
+
+                if ( loop_pred != taken ) {
+                    freeLoop(index);
+                    return;
+                }
+                if ( entry.age < 255 ) { entry.age++; }
+            }
+
+            if ( taken == entry.dir ) {
+                entry.current_iter++;
+
+                // ran past the trip count it learned, learn it again
+                if ( (entry.past_iter > 0) && (entry.current_iter > entry.past_iter) ) {
+                    entry.past_iter  = 0;
+                    entry.confidence = 0;
+                }
+                if ( entry.current_iter == UINT16_MAX ) { freeLoop(index); }
+            }
+            else {
+                if ( 0 == entry.current_iter ) {
+                    // left straight away, not a loop
+                    freeLoop(index);
+                    return;
+                }
+
+                if ( entry.current_iter == entry.past_iter ) {
+                    if ( entry.confidence < LOOP_CONFIDENT ) { entry.confidence++; }
+                }
+                else {
+                    entry.past_iter  = entry.current_iter;
+                    entry.confidence = 0;
+                }
+
+                entry.current_iter = 0;
+            }
+        }
+        else if ( mispredicted ) {
+            if ( entry.valid && (entry.age > 0) ) { entry.age--; }
+            else {
+                // treat the mispredicted direction as the exit of a loop
+                entry                 = LoopEntry();
+                entry.valid           = true;
+                entry.tag             = loopTag(addr);
+                entry.dir             = !taken;
+                entry.age             = 8;
+                loop_spec_iter[index] = 0;
+            }
+        }
+    }
+
+    void freeLoop(size_t index) {
+        loops[index]          = LoopEntry();
+        loop_spec_iter[index] = 0;
+    }
+
+    size_t   loopIndex(const uint64_t addr) const { return (addr >> 1) & (loops.size() - 1); }
+    uint16_t loopTag(const uint64_t addr) const { return (uint16_t)((addr >> (1 + loop_log)) & 0x3fff); }
+
+    TaggedEntry& taggedEntry(uint32_t table, uint32_t index) { return tagged[((size_t)table << log_entries) + index]; }
+
+    template <typename T>
+    static void saturate(T& counter, int32_t delta, int32_t min, int32_t max) {
+        const int32_t value = (int32_t)counter + delta;
+        counter             = (T)((value < min) ? min : ((value > max) ? max : value));
+    }
+
+    uint32_t nextRandom() {
+        lfsr ^= lfsr << 13;
+        lfsr ^= lfsr >> 17;
+        lfsr ^= lfsr << 5;
+        return lfsr;
+    }
+
+    uint32_t num_tables;
+    uint32_t log_entries;
+    uint32_t tag_bits;
+    uint64_t u_reset_period;
+    bool     use_loop;
+    uint32_t loop_log;
+    bool     use_sc;
+    uint32_t sc_log;
+
+    uint32_t index_fold[MAX_TABLES];
+    uint32_t tag_fold[MAX_TABLES];
+    uint32_t tag_fold2[MAX_TABLES];
+
+    std::vector<uint8_t>     bimodal;
+    std::vector<TaggedEntry> tagged;
+    int32_t                  use_alt_on_na;
+
+    std::vector<LoopEntry> loops;
+    std::vector<uint16_t>  loop_spec_iter;
+    int32_t                loop_use;
+
+    std::vector<int8_t> sc_bias;
+    std::vector<int8_t> sc_tables[SC_TABLES];
+    int32_t             sc_threshold;
+    int32_t             sc_threshold_ctr;
+
+    uint64_t update_count;
+    uint32_t lfsr;
+
+    Statistic<uint64_t>* stat_loop_override;
+    Statistic<uint64_t>* stat_sc_override;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -40,6 +40,22 @@ public:
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
     virtual bool contains(const uint64_t addr) = 0;
+
+    // Called by the decoder for each branch in program order, returns the address
+    // to continue fetching from. fall_through is the next address if the branch is
+    // not taken.
+    virtual uint64_t predict(const uint64_t ins_addr, VanadisSpeculatedInstruction* ins, const uint64_t fall_through) {
+        return contains(ins_addr) ? predictAddress(ins_addr) : fall_through;
+    }
+
+    // Called when a branch retires with the address execution continued at
+    virtual void update(VanadisSpeculatedInstruction* ins, const uint64_t next_addr) {
+        push(ins->getInstructionAddress(), next_addr);
+    }
+
+    // Called when the pipeline is flushed and fetch restarts, any branch predicted
+    // since the last one to retire has been discarded
+    virtual void recover() {}
 };
 
 } // namespace Vanadis
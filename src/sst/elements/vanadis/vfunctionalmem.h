@@ -0,0 +1,225 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_FUNCTIONAL_MEMORY
+#define _H_VANADIS_FUNCTIONAL_MEMORY
+
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SST {
+namespace Vanadis {
+
+// The memory a core reads and writes while fast-forwarding functionally. It maps the
+// memory controller's backing_out_file (backing=mmap), the same file the OS installs
+// pages in through its backdoor, so loads and stores bypass the memory hierarchy.
+//
+// Translations come from the OS one page at a time and are cached per hardware thread
+// until the next syscall, the cache is a subset of the page table so a missing entry
+// only costs a request to the OS.
+class VanadisFunctionalMemory {
+public:
+    static constexpr uint32_t PERM_WRITE = 1 << 1;
+    static constexpr uint32_t PERM_READ  = 1 << 2;
+
+    // widest register a load or store moves, as in the LSQ
+    static constexpr uint32_t MAX_REGISTER_WIDTH = 16;
+
+    VanadisFunctionalMemory(SST::Output* output, const std::string& path, uint64_t base, uint32_t hw_threads) :
+        output(output),
+        path(path),
+        base(base),
+        length(0),
+        mem(nullptr),
+        page_shift(0),
+        translations(hw_threads),
+        reservations(hw_threads, NO_RESERVATION)
+    {
+        int fd = open(path.c_str(), O_RDWR);
+        if ( fd < 0 ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to open fast_forward_memory_file %s, %s\n", path.c_str(), strerror(errno));
+        }
+
+        struct stat file_stat;
+        if ( 0 != fstat(fd, &file_stat) || 0 == file_stat.st_size ) {
+            output->fatal(CALL_INFO, -1, "Error: fast_forward_memory_file %s is empty, is it the memory controller's backing_out_file?\n",
+                path.c_str());
+        }
+
+        length = (uint64_t)file_stat.st_size;
+
+        void* map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if ( MAP_FAILED == map ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to mmap fast_forward_memory_file %s, %s\n", path.c_str(), strerror(errno));
+        }
+
+        mem = (uint8_t*)map;
+    }
+
+    ~VanadisFunctionalMemory() {
+        if ( nullptr != mem ) { munmap(mem, length); }
+    }
+
+    // Returns true if every page of [addr, addr + len) is translated with the permission the
+    // access needs, otherwise sets missing to the first page that is not
+    bool isTranslated(uint32_t thr, uint64_t addr, uint64_t len, bool is_write, uint64_t* missing) const {
+        if ( 0 == page_shift ) {
+            (*missing) = addr;
+            return false;
+        }
+
+        const uint32_t want = is_write ? PERM_WRITE : PERM_READ;
+
+        for ( uint64_t vpn = addr >> page_shift; vpn <= ((addr + len - 1) >> page_shift); ++vpn ) {
+            auto found = translations[thr].find(vpn);
+
+            if ( (found == translations[thr].end()) || (0 == (found->second.perms & want)) ) {
+                (*missing) = std::max(addr, vpn << page_shift);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void addTranslation(uint32_t thr, uint64_t virt_page, uint64_t phys_page, uint64_t page_size, uint32_t perms) {
+        if ( 0 == page_shift ) {
+            while ( (1ULL << page_shift) < page_size ) {
+                page_shift++;
+            }
+        }
+
+        const uint64_t vpn = virt_page >> page_shift;
+
+        // the page may have moved (copy-on-write), drop what other threads hold for it
+        for ( auto& thr_translations : translations ) {
+            thr_translations.erase(vpn);
+        }
+
+        translations[thr][vpn] = Translation{ phys_page, perms };
+    }
+
+    // Mappings and permissions may have changed (mmap, munmap, mprotect, brk, fork, ...)
+    void clearTranslations() {
+        for ( auto& thr_translations : translations ) {
+            thr_translations.clear();
+        }
+    }
+
+    void clearTranslations(uint32_t thr) { translations[thr].clear(); }
+
+    // Callers check isTranslated() first
+    void read(uint32_t thr, uint64_t addr, uint8_t* data, uint64_t len) {
+        while ( len > 0 ) {
+            const uint64_t chunk = pageChunk(addr, len);
+            memcpy(data, physical(thr, addr, chunk), chunk);
+            addr += chunk;
+            data += chunk;
+            len -= chunk;
+        }
+    }
+
+    void write(uint32_t thr, uint64_t addr, const uint8_t* data, uint64_t len) {
+        while ( len > 0 ) {
+            const uint64_t chunk = pageChunk(addr, len);
+            uint8_t*       dest  = physical(thr, addr, chunk);
+
+            breakReservations((uint64_t)(dest - mem), chunk);
+            memcpy(dest, data, chunk);
+
+            addr += chunk;
+            data += chunk;
+            len -= chunk;
+        }
+    }
+
+    // Load-linked/store-conditional, the reservation covers the line holding addr and any
+    // write to that line from any thread breaks it
+    void reserve(uint32_t thr, uint64_t addr) {
+        reservations[thr] = ((uint64_t)(physical(thr, addr, 1) - mem)) & ~(RESERVATION_LINE - 1);
+    }
+
+    bool checkReservation(uint32_t thr, uint64_t addr) {
+        const bool valid = (reservations[thr] == (((uint64_t)(physical(thr, addr, 1) - mem)) & ~(RESERVATION_LINE - 1)));
+        reservations[thr] = NO_RESERVATION;
+        return valid;
+    }
+
+private:
+    struct Translation {
+        uint64_t phys_page;
+        uint32_t perms;
+    };
+
+    static constexpr uint64_t RESERVATION_LINE = 64;
+    static constexpr uint64_t NO_RESERVATION   = UINT64_MAX;
+
+    uint64_t pageChunk(uint64_t addr, uint64_t len) const {
+        const uint64_t page_left = (1ULL << page_shift) - (addr & ((1ULL << page_shift) - 1));
+        return std::min(len, page_left);
+    }
+
+    // the chunk must not cross a page
+    uint8_t* physical(uint32_t thr, uint64_t addr, uint64_t chunk) {
+        const Translation& entry = translations[thr].at(addr >> page_shift);
+        const uint64_t     phys  = entry.phys_page + (addr & ((1ULL << page_shift) - 1));
+
+        if ( (phys < base) || ((phys + chunk) > (base + length)) ) {
+            output->fatal(CALL_INFO, -1, "Error: physical address 0x%" PRIx64 " (virtual 0x%" PRIx64 ") is outside of fast_forward_memory_file %s\n",
+                phys, addr, path.c_str());
+        }
+
+        return mem + (phys - base);
+    }
+
+    void breakReservations(uint64_t offset, uint64_t len) {
+        const uint64_t first = offset & ~(RESERVATION_LINE - 1);
+        const uint64_t last  = (offset + len - 1) & ~(RESERVATION_LINE - 1);
+
+        for ( auto& reservation : reservations ) {
+            if ( (reservation >= first) && (reservation <= last) ) { reservation = NO_RESERVATION; }
+        }
+    }
+
+    SST::Output*      output;
+    const std::string path;
+    const uint64_t    base;
+    uint64_t          length;
+    uint8_t*          mem;
+    uint32_t          page_shift;
+
+    std::vector<std::unordered_map<uint64_t, Translation>> translations;
+    std::vector<uint64_t>                                  reservations;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
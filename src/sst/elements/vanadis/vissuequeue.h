@@ -0,0 +1,310 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ISSUE_QUEUE
+#define _H_VANADIS_ISSUE_QUEUE
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "inst/vinst.h"
+
+namespace SST {
+namespace Vanadis {
+
+// Dependency-tracked issue queue for one hardware thread.
+//
+// Every instruction in the thread's ROB has an entry here, in program order. An
+// instruction may issue once:
+//   - every older instruction in the ROB that writes one of its ISA source or
+//     destination registers has retired, and
+//   - every older instruction that reads one of its destination registers has
+//     issued (seen from the next cycle on).
+// Rather than re-checking these conditions by walking the ROB every cycle, each
+// entry counts the instructions it waits on. A retiring writer or an issued reader
+// wakes its waiters, and an entry whose count reaches zero is marked ready. The
+// select stage then only looks at ready entries, oldest first.
+//
+// Only the youngest older writer of each register needs to be waited on because
+// the ROB retires in order, and a new writer only waits on the readers since the
+// previous writer of that register, so each instruction adds a constant number of
+// wakeup edges however large the ROB is.
+class VanadisIssueQueue {
+public:
+    static constexpr uint64_t NONE = UINT64_MAX;
+
+    VanadisIssueQueue(size_t capacity, uint16_t int_reg_count, uint16_t fp_reg_count) :
+        entries(capacity),
+        ready((capacity + 63) / 64, 0),
+        last_int_writer(int_reg_count, NONE),
+        last_fp_writer(fp_reg_count, NONE),
+        int_readers(int_reg_count),
+        fp_readers(fp_reg_count),
+        head_seq(0),
+        tail_seq(0) {}
+
+    size_t size() const { return tail_seq - head_seq; }
+
+    // Add the next instruction in program order (the instruction just behind the
+    // last one added in the ROB)
+    void dispatch(VanadisInstruction* ins) {
+        assert(size() < entries.size());
+
+        const uint64_t seq   = tail_seq++;
+        Entry&         entry = getEntry(seq);
+
+        entry.ins      = ins;
+        entry.blockers = 0;
+        entry.issued   = false;
+
+        const VanadisFunctionalUnitType ins_type = ins->getInstFuncType();
+        entry.ordered_memory = (INST_LOAD == ins_type) || (INST_STORE == ins_type) || (INST_FENCE == ins_type);
+
+        dispatchRegisters(
+            entry, seq, ins->countISAIntRegIn(), ins->countISAIntRegOut(), last_int_writer, int_readers,
+            [ins](uint16_t i) { return ins->getISAIntRegIn(i); }, [ins](uint16_t i) { return ins->getISAIntRegOut(i); });
+        dispatchRegisters(
+            entry, seq, ins->countISAFPRegIn(), ins->countISAFPRegOut(), last_fp_writer, fp_readers,
+            [ins](uint16_t i) { return ins->getISAFPRegIn(i); }, [ins](uint16_t i) { return ins->getISAFPRegOut(i); });
+
+        if ( entry.ordered_memory ) { unissued_memory.push_back(seq); }
+
+        if ( 0 == entry.blockers ) { setReady(seq); }
+    }
+
+    // The oldest instruction has left the ROB
+    void retire(VanadisInstruction* ins) {
+        assert(size() > 0);
+
+        Entry& entry = getEntry(head_seq);
+        assert(entry.ins == ins);
+
+        wake(entry.retire_waiters);
+        // normally released at the start of the next issue stage, but the reader may
+        // leave the ROB before then
+        wake(entry.issue_waiters);
+
+        if ( !entry.issued ) {
+            clearReady(head_seq);
+            if ( entry.ordered_memory ) { unissued_memory.pop_front(); }
+        }
+
+        entry.ins = nullptr;
+        head_seq++;
+    }
+
+    // The ROB has been emptied
+    void clear() {
+        for ( uint64_t seq = head_seq; seq < tail_seq; ++seq ) {
+            Entry& entry = getEntry(seq);
+            entry.ins    = nullptr;
+            entry.retire_waiters.clear();
+            entry.issue_waiters.clear();
+        }
+
+        std::fill(ready.begin(), ready.end(), 0);
+        std::fill(last_int_writer.begin(), last_int_writer.end(), NONE);
+        std::fill(last_fp_writer.begin(), last_fp_writer.end(), NONE);
+        for ( auto& next : int_readers ) {
+            next.clear();
+        }
+        for ( auto& next : fp_readers ) {
+            next.clear();
+        }
+        unissued_memory.clear();
+        issued_this_cycle.clear();
+
+        head_seq = tail_seq;
+    }
+
+    // Instructions that issued last cycle stop blocking younger writers of the
+    // registers they read
+    void startCycle() {
+        for ( const uint64_t seq : issued_this_cycle ) {
+            if ( seq >= head_seq ) { wake(getEntry(seq).issue_waiters); }
+        }
+        issued_this_cycle.clear();
+    }
+
+    // Sequence number of the oldest ready instruction at or after from, or NONE
+    uint64_t nextReady(uint64_t from) const {
+        const size_t capacity = entries.size();
+
+        if ( from < head_seq ) { from = head_seq; }
+
+        while ( from < tail_seq ) {
+            const size_t slot  = from % capacity;
+            const size_t bit   = slot % 64;
+            const size_t width = std::min((size_t)(64 - bit), capacity - slot);
+
+            uint64_t bits = ready[slot / 64] >> bit;
+            if ( width < 64 ) { bits &= (UINT64_C(1) << width) - 1; }
+
+            if ( bits != 0 ) {
+                const uint64_t seq = from + __builtin_ctzll(bits);
+                return (seq < tail_seq) ? seq : NONE;
+            }
+
+            from += width;
+        }
+
+        return NONE;
+    }
+
+    VanadisInstruction* getInstruction(uint64_t seq) { return getEntry(seq).ins; }
+
+    // Loads, stores and fences go to the LSQ in program order, and the RoCC
+    // instructions may not pass them either
+    bool olderMemoryOpPending(uint64_t seq) const {
+        return (!unissued_memory.empty()) && (unissued_memory.front() < seq);
+    }
+
+    void issue(uint64_t seq) {
+        Entry& entry = getEntry(seq);
+
+        entry.issued = true;
+        clearReady(seq);
+        issued_this_cycle.push_back(seq);
+
+        if ( entry.ordered_memory ) {
+            assert(unissued_memory.front() == seq);
+            unissued_memory.pop_front();
+        }
+    }
+
+private:
+    struct Entry {
+        Entry() : ins(nullptr), blockers(0), issued(false), ordered_memory(false) {}
+
+        VanadisInstruction* ins;
+        uint32_t            blockers;
+        bool                issued;
+        bool                ordered_memory;
+
+        // younger instructions to wake when this one retires (it writes one of their
+        // registers) or issues (it reads one of their destination registers)
+        std::vector<uint64_t> retire_waiters;
+        std::vector<uint64_t> issue_waiters;
+    };
+
+    Entry& getEntry(uint64_t seq) { return entries[seq % entries.size()]; }
+
+    void setReady(uint64_t seq) {
+        const size_t slot = seq % entries.size();
+        ready[slot / 64] |= (UINT64_C(1) << (slot % 64));
+    }
+
+    void clearReady(uint64_t seq) {
+        const size_t slot = seq % entries.size();
+        ready[slot / 64] &= ~(UINT64_C(1) << (slot % 64));
+    }
+
+    void wake(std::vector<uint64_t>& waiters) {
+        for ( const uint64_t seq : waiters ) {
+            Entry& waiter = getEntry(seq);
+            assert(waiter.blockers > 0);
+
+            if ( (0 == --waiter.blockers) && !waiter.issued ) { setReady(seq); }
+        }
+        waiters.clear();
+    }
+
+    // true if reg is one of the first index registers returned by get
+    template <typename Func>
+    static bool seenBefore(uint16_t index, uint16_t reg, Func get) {
+        for ( uint16_t i = 0; i < index; ++i ) {
+            if ( get(i) == reg ) { return true; }
+        }
+        return false;
+    }
+
+    template <typename InFunc, typename OutFunc>
+    void dispatchRegisters(
+        Entry& entry, uint64_t seq, uint16_t in_count, uint16_t out_count, std::vector<uint64_t>& last_writer,
+        std::vector<std::deque<uint64_t>>& readers, InFunc get_in, OutFunc get_out) {
+        // wait on the youngest older writer of every register read or written
+        for ( uint16_t i = 0; i < in_count; ++i ) {
+            const uint16_t reg = get_in(i);
+            if ( seenBefore(i, reg, get_in) ) { continue; }
+            waitOnWriter(entry, seq, last_writer[reg]);
+        }
+        for ( uint16_t i = 0; i < out_count; ++i ) {
+            const uint16_t reg = get_out(i);
+            if ( seenBefore(i, reg, get_out) || seenBefore(in_count, reg, get_in) ) { continue; }
+            waitOnWriter(entry, seq, last_writer[reg]);
+        }
+
+        // wait on unissued readers of the registers written, then become the last writer
+        for ( uint16_t i = 0; i < out_count; ++i ) {
+            const uint16_t reg = get_out(i);
+            if ( seenBefore(i, reg, get_out) ) { continue; }
+
+            for ( const uint64_t reader : readers[reg] ) {
+                if ( reader >= head_seq ) {
+                    Entry& reader_entry = getEntry(reader);
+                    if ( !reader_entry.issued ) {
+                        reader_entry.issue_waiters.push_back(seq);
+                        entry.blockers++;
+                    }
+                }
+            }
+
+            readers[reg].clear();
+            last_writer[reg] = seq;
+        }
+
+        for ( uint16_t i = 0; i < in_count; ++i ) {
+            const uint16_t reg = get_in(i);
+            if ( seenBefore(i, reg, get_in) ) { continue; }
+
+            std::deque<uint64_t>& reg_readers = readers[reg];
+            // readers that have retired are always at the front
+            while ( !reg_readers.empty() && reg_readers.front() < head_seq ) {
+                reg_readers.pop_front();
+            }
+            reg_readers.push_back(seq);
+        }
+    }
+
+    void waitOnWriter(Entry& entry, uint64_t seq, uint64_t writer) {
+        if ( (NONE != writer) && (writer >= head_seq) ) {
+            getEntry(writer).retire_waiters.push_back(seq);
+            entry.blockers++;
+        }
+    }
+
+    std::vector<Entry>    entries;
+    std::vector<uint64_t> ready;
+
+    std::vector<uint64_t>             last_int_writer;
+    std::vector<uint64_t>             last_fp_writer;
+    std::vector<std::deque<uint64_t>> int_readers;
+    std::vector<std::deque<uint64_t>> fp_readers;
+
+    std::deque<uint64_t> unissued_memory;
+    std::vector<uint64_t> issued_this_cycle;
+
+    uint64_t head_seq;
+    uint64_t tail_seq;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -17,6 +17,13 @@
 
 #include "siriusreader.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
+#include <string.h>
+#include <sys/stat.h>
+
 using namespace std;
 using namespace SST::Zodiac;
 
@@ -32,13 +39,140 @@ using namespace SST::Zodiac;
 #endif
 
 
-SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose)
+// Records decoded for one reader before the helper moves on to the next
+#define SIRIUS_DECODE_BATCH 256
+
+// Bytes read from the trace file at a time
+#define SIRIUS_READ_BUFFER (16 * 1024)
+
+namespace SST {
+namespace Zodiac {
+
+// Helper thread that keeps the rings of all the readers in the process
+// topped up.  It is started by the first reader and stopped when the
+// last one closes.  A reader is only decoded while its decodeLock is
+// held, the helper skips readers that the simulation thread is
+// decoding itself.
+class SiriusDecodeService {
+    public:
+	static SiriusDecodeService* instance() {
+		// Never destroyed, so no joinable thread is left behind by
+		// static destruction if the process exits without closing
+		// the readers
+		static SiriusDecodeService* service = new SiriusDecodeService();
+		return service;
+	}
+
+	void attach(SiriusReader* reader) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			readers.push_back(reader);
+
+			if(! worker.joinable()) {
+				stopWorker = false;
+				worker = std::thread(&SiriusDecodeService::run, this);
+			}
+
+			workPending = true;
+		}
+		pending.notify_one();
+	}
+
+	void detach(SiriusReader* reader) {
+		std::thread finished;
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			readers.erase(std::remove(readers.begin(), readers.end(), reader), readers.end());
+
+			if(readers.empty() && worker.joinable()) {
+				stopWorker = true;
+				finished = std::move(worker);
+			}
+		}
+		pending.notify_one();
+
+		if(finished.joinable()) {
+			finished.join();
+		}
+
+		// Wait for a batch of this reader that is already being decoded
+		std::lock_guard<std::mutex> decodeGuard(reader->decodeLock);
+	}
+
+	void wake() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			workPending = true;
+		}
+		pending.notify_one();
+	}
+
+    private:
+	SiriusDecodeService() : workPending(false), stopWorker(false) {}
+
+	std::mutex lock;
+	std::condition_variable pending;
+	std::vector<SiriusReader*> readers;
+	std::thread worker;
+	bool workPending;
+	bool stopWorker;
+
+	void run() {
+		std::unique_lock<std::mutex> guard(lock);
+
+		while(true) {
+			pending.wait(guard, [this] { return workPending || stopWorker; });
+
+			if(stopWorker) {
+				return;
+			}
+
+			workPending = false;
+
+			// Keep passing over the readers until none of them has
+			// room left in its ring.  The reader is locked before the
+			// service lock is dropped, so detach() can not return while
+			// it is being decoded.
+			bool progress = true;
+			while(progress && !stopWorker) {
+				progress = false;
+
+				for(size_t i = 0; i < readers.size(); ++i) {
+					SiriusReader* reader = readers[i];
+					std::unique_lock<std::mutex> decodeGuard(reader->decodeLock, std::try_to_lock);
+
+					if(! decodeGuard.owns_lock()) {
+						continue;
+					}
+
+					guard.unlock();
+
+					if(reader->decodeAhead(SIRIUS_DECODE_BATCH) > 0) {
+						progress = true;
+					}
+
+					decodeGuard.unlock();
+					guard.lock();
+				}
+			}
+		}
+	}
+};
+
+}
+}
+
+SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose,
+	uint32_t ringRecords, uint32_t interval) :
+	ringHead(0), ringTail(0), decodeDone(false)
 {
 
 	rank = focusOnRank;
 	eventQ = evQ;
 	qLimit = maxQLen;
 	foundFinalize = false;
+	recordsConsumed = 0;
 
 	trace = fopen(file, "rb");
 	if(NULL == trace) {
@@ -46,9 +180,38 @@ SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, s
 		exit(-1);
 	}
 
-	prevEventTime = 0;
+	struct stat traceStat;
+	traceSize = (0 == fstat(fileno(trace), &traceStat)) ? (uint64_t) traceStat.st_size : 0;
+
+	// Reads go through readBuffer
+	setvbuf(trace, NULL, _IONBF, 0);
+	readBuffer.resize(SIRIUS_READ_BUFFER);
+
+	uint64_t ringSize = 1;
+	while(ringSize < std::max(ringRecords, (uint32_t) 1)) {
+		ringSize <<= 1;
+	}
+
+	ring.resize(ringSize);
+	ringMask = ringSize - 1;
+	indexInterval = std::max(interval, (uint32_t) 1);
+
+	resetDecoder(0, 0, 0);
+
 	output = new Output("SiriusReader", verbose, 0, Output::STDOUT);
-	readInit();
+
+	// MPI_Init is not recorded in the trace
+	output->verbose(__LINE__, __FILE__, "SiriusReader", 8, 0, "Read an MPI_Init\n");
+	eventQ->push(new ZodiacInitEvent());
+
+	SiriusDecodeService::instance()->attach(this);
+}
+
+SiriusReader::~SiriusReader() {
+	if(NULL != trace) {
+		SiriusDecodeService::instance()->detach(this);
+		fclose(trace);
+	}
 }
 
 void SiriusReader::close() {
@@ -58,14 +221,41 @@ void SiriusReader::close() {
 		output->verbose(CALL_INFO, 4, 0, "Closing trace file.\n");
 	}
 
+	SiriusDecodeService::instance()->detach(this);
+
 	fclose(trace);
+	trace = NULL;
 }
 
 uint32_t SiriusReader::generateNextEvents() {
-//	int finalized_reached = 0;
 
 	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
-		generateNextEvent();
+		const uint64_t head = ringHead.load(std::memory_order_relaxed);
+
+		if(head == ringTail.load(std::memory_order_acquire)) {
+			// The helper has not kept up, decode a batch here
+			std::lock_guard<std::mutex> guard(decodeLock);
+
+			if((0 == decodeAhead(qLimit)) && (head == ringTail.load(std::memory_order_acquire))) {
+				if(decodeError.empty()) {
+					output->fatal(CALL_INFO, -1, "Error: the trace of rank %" PRIu32 " ended before MPI_Finalize\n", rank);
+				} else {
+					output->fatal(CALL_INFO, -1, "Error: %s\n", decodeError.c_str());
+				}
+			}
+
+			continue;
+		}
+
+		generateNextEvent(ring[head & ringMask]);
+		ringHead.store(head + 1, std::memory_order_release);
+		recordsConsumed++;
+	}
+
+	// Have the helper top the ring up once half of it has been used
+	if((! decodeDone.load(std::memory_order_acquire)) &&
+		((ringTail.load(std::memory_order_acquire) - ringHead.load(std::memory_order_relaxed)) <= (ring.size() / 2))) {
+		SiriusDecodeService::instance()->wake();
 	}
 
 	return (uint32_t) eventQ->size();
@@ -79,194 +269,296 @@ uint32_t SiriusReader::getCurrentQueueSize() {
 	return eventQ->size();
 }
 
-void SiriusReader::generateNextEvent() {
-	uint32_t call_type = readUINT32();
-	double callTime = readTime();
-	double evTimeDiff = callTime - prevEventTime;
+uint64_t SiriusReader::getRecordsConsumed() {
+	return recordsConsumed;
+}
 
-	if(evTimeDiff > 0) {
-		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", evTimeDiff);
-		ZodiacComputeEvent* ev = new ZodiacComputeEvent(evTimeDiff);
-		eventQ->push(ev);
-	} else {
-		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
-			"Did not generate next event timing prevTime=%f, callTime=%f, diff=%f\n",
-			prevEventTime, callTime, evTimeDiff);
+// Called with decodeLock held
+uint32_t SiriusReader::decodeAhead(uint32_t maxRecords) {
+	uint32_t decoded = 0;
+	uint64_t tail = ringTail.load(std::memory_order_relaxed);
+
+	while((decoded < maxRecords) && (! decodeDone.load(std::memory_order_relaxed)) &&
+		((tail - ringHead.load(std::memory_order_acquire)) < ring.size())) {
+
+		SiriusRecord& rec = ring[tail & ringMask];
+
+		if(! decodeRecord(rec)) {
+			decodeDone.store(true, std::memory_order_release);
+			break;
+		}
+
+		tail++;
+		decoded++;
+		ringTail.store(tail, std::memory_order_release);
+
+		if(SIRIUS_MPI_FINALIZE == rec.callType) {
+			decodeDone.store(true, std::memory_order_release);
+		}
+	}
+
+	return decoded;
+}
+
+bool SiriusReader::readBytes(void* dest, size_t bytes) {
+	if((readLen - readPos) < bytes) {
+		const size_t left = readLen - readPos;
+		memmove(readBuffer.data(), readBuffer.data() + readPos, left);
+
+		readBase += readPos;
+		readPos = 0;
+		readLen = left + fread(readBuffer.data() + left, 1, readBuffer.size() - left, trace);
+
+		if(readLen < bytes) {
+			return false;
+		}
 	}
 
+	memcpy(dest, readBuffer.data() + readPos, bytes);
+	readPos += bytes;
+	return true;
+}
+
+void SiriusReader::resetDecoder(uint64_t offset, double prevTime, uint64_t record) {
+	fseeko(trace, (off_t) offset, SEEK_SET);
+
+	readBase = offset;
+	readPos = 0;
+	readLen = 0;
+
+	prevEventTime = prevTime;
+	recordsDecoded = record;
+	decodeError.clear();
+	decodeDone.store(false, std::memory_order_release);
+}
+
+bool SiriusReader::decodeRecord(SiriusRecord& rec) {
+	const uint64_t offset = readBase + readPos;
+
+	if((0 == (recordsDecoded % indexInterval)) && ((recordsDecoded / indexInterval) == recordIndex.size())) {
+		SiriusIndexEntry entry = { offset, prevEventTime };
+		recordIndex.push_back(entry);
+	}
+
+	uint32_t call_type;
+	double callTime;
+
+	if(! readBytes(&call_type, sizeof(call_type))) {
+		// End of the trace
+		return false;
+	}
+
+	bool complete = readBytes(&callTime, sizeof(callTime));
+
+	const double evTimeDiff = callTime - prevEventTime;
+
+	rec.callType    = call_type;
+	rec.computeTime = (evTimeDiff > 0) ? evTimeDiff : 0;
+	rec.request     = 0;
+	rec.count       = 0;
+	rec.dtype       = 0;
+	rec.op          = 0;
+	rec.comm        = 0;
+	rec.peer        = 0;
+	rec.tag         = 0;
+
+	uint64_t buffer;
+	uint64_t status;
+
 	switch(call_type) {
 	case SIRIUS_MPI_SEND:
-		readSend();
-		break;
-
 	case SIRIUS_MPI_RECV:
-		readRecv();
-		break;
-
 	case SIRIUS_MPI_IRECV:
-		readIrecv();
+		complete = complete && readBytes(&buffer, sizeof(buffer)) && readBytes(&rec.count, sizeof(rec.count)) &&
+			readBytes(&rec.dtype, sizeof(rec.dtype)) && readBytes(&rec.peer, sizeof(rec.peer)) &&
+			readBytes(&rec.tag, sizeof(rec.tag)) && readBytes(&rec.comm, sizeof(rec.comm));
+
+		if(SIRIUS_MPI_IRECV == call_type) {
+			complete = complete && readBytes(&rec.request, sizeof(rec.request));
+		}
 		break;
 
 	case SIRIUS_MPI_ALLREDUCE:
-		readAllreduce();
+		complete = complete && readBytes(&buffer, sizeof(buffer)) && readBytes(&buffer, sizeof(buffer)) &&
+			readBytes(&rec.count, sizeof(rec.count)) && readBytes(&rec.dtype, sizeof(rec.dtype)) &&
+			readBytes(&rec.op, sizeof(rec.op)) && readBytes(&rec.comm, sizeof(rec.comm));
 		break;
 
 	case SIRIUS_MPI_BARRIER:
-		readBarrier();
+		complete = complete && readBytes(&rec.comm, sizeof(rec.comm));
 		break;
 
 	case SIRIUS_MPI_WAIT:
-		readWait();
+		complete = complete && readBytes(&rec.request, sizeof(rec.request)) && readBytes(&status, sizeof(status));
 		break;
 
 	case SIRIUS_MPI_INIT:
-		readInit();
-		break;
-
 	case SIRIUS_MPI_FINALIZE:
-		readFinalize();
 		break;
 
 	default:
-		std::cout << "Unknown MPI command in trace (" << call_type << ") position: " <<
-			ftell(trace) << std::endl;
-		exit(-1);
-		break;
+		decodeError = "Unknown MPI command in trace (" + std::to_string(call_type) + ") position: " + std::to_string(offset);
+		return false;
 	}
 
+	// Read the profiled MPI time and the MPI function result
+	int32_t result;
+	complete = complete && readBytes(&prevEventTime, sizeof(prevEventTime)) && readBytes(&result, sizeof(result));
 
-	// Read the profiled MPI time
-	prevEventTime = readTime();
-	// read the MPI function result
-	readINT32();
-}
+	if(! complete) {
+		decodeError = "the trace of rank " + std::to_string(rank) + " is truncated at position " + std::to_string(offset);
+		return false;
+	}
 
-void SiriusReader::readAllreduce() {
-	uint64_t sbuff = readUINT64();
-	uint64_t rbuff = readUINT64();
-	uint32_t length = readUINT32();
-	uint32_t dtype = readUINT32();
-	uint32_t op    = readUINT32();
-	uint32_t comm  = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
-
-	ZodiacAllreduceEvent* ev = new ZodiacAllreduceEvent(
-			length,
-			convertToHermesType(dtype),
-			convertToHermesOp(op),
-			comm);
-	eventQ->push(ev);
+	recordsDecoded++;
+	return true;
 }
 
-void SiriusReader::readSend() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  dest   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
+void SiriusReader::generateNextEvent(const SiriusRecord& rec) {
+	if(rec.computeTime > 0) {
+		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", rec.computeTime);
+		ZodiacComputeEvent* ev = new ZodiacComputeEvent(rec.computeTime);
+		eventQ->push(ev);
+	} else {
+		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
+			"Did not generate a compute event, the call started when the previous one ended\n");
+	}
 
-	output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
+	switch(rec.callType) {
+	case SIRIUS_MPI_SEND:
+		output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
+		eventQ->push(new ZodiacSendEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm));
+		break;
 
-	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) dest, count,
-		convertToHermesType(dtype), tag, comm);
-	eventQ->push(ev);
-}
+	case SIRIUS_MPI_RECV:
+		output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
+		eventQ->push(new ZodiacRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm));
+		break;
 
-void SiriusReader::readRecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
+	case SIRIUS_MPI_IRECV:
+		output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
+		eventQ->push(new ZodiacIRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm, rec.request));
+		break;
 
-	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
+	case SIRIUS_MPI_ALLREDUCE:
+		output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
+		eventQ->push(new ZodiacAllreduceEvent(rec.count,
+			convertToHermesType(rec.dtype),
+			convertToHermesOp(rec.op),
+			rec.comm));
+		break;
 
-	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm);
-	eventQ->push(ev);
-}
+	case SIRIUS_MPI_BARRIER:
+		output->verbose(__LINE__, __FILE__, "readBarrier", 8, 0, "Read an MPI_Barrier\n");
+		eventQ->push(new ZodiacBarrierEvent(rec.comm));
+		break;
 
-void SiriusReader::readIrecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-	uint64_t req    = readUINT64();
+	case SIRIUS_MPI_WAIT:
+		output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
+		eventQ->push(new ZodiacWaitEvent(rec.request));
+		break;
 
-	output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
+	case SIRIUS_MPI_INIT:
+		output->verbose(__LINE__, __FILE__, "readInit", 8, 0, "Read an MPI_Init\n");
+		eventQ->push(new ZodiacInitEvent());
+		break;
 
-	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm, req);
-	eventQ->push(ev);
+	case SIRIUS_MPI_FINALIZE:
+		output->verbose(__LINE__, __FILE__, "readFinalize", 8, 0, "Read an MPI_Finalize\n");
+		eventQ->push(new ZodiacFinalizeEvent());
+		foundFinalize = true;
+		break;
+	}
 }
 
-void SiriusReader::readWait() {
-	uint64_t reqID = readUINT64();
-	uint64_t status = readUINT64();
+bool SiriusReader::seekToRecord(uint64_t record) {
+	std::lock_guard<std::mutex> guard(decodeLock);
 
-	output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
+	// Start at the closest indexed record before the target
+	if(recordIndex.empty()) {
+		resetDecoder(0, 0, 0);
+	} else {
+		const size_t entry = (size_t) std::min(record / indexInterval, (uint64_t) (recordIndex.size() - 1));
+		resetDecoder(recordIndex[entry].offset, recordIndex[entry].prevEventTime, entry * indexInterval);
+	}
 
-	ZodiacWaitEvent* ev = new ZodiacWaitEvent(reqID);
-	eventQ->push(ev);
-}
+	ringHead.store(ringTail.load(std::memory_order_relaxed), std::memory_order_release);
+	foundFinalize = false;
 
-void SiriusReader::readInit() {
-	output->verbose(__LINE__, __FILE__, "readInit", 8, 0, "Read an MPI_Init\n");
-	ZodiacInitEvent* ev = new ZodiacInitEvent();
-	eventQ->push(ev);
+	// and decode up to it
+	SiriusRecord skipped;
+	while(recordsDecoded < record) {
+		if((! decodeRecord(skipped)) || (SIRIUS_MPI_FINALIZE == skipped.callType)) {
+			output->verbose(CALL_INFO, 1, 0, "Unable to seek to record %" PRIu64 ", the trace ends at record %" PRIu64 "\n",
+				record, recordsDecoded);
+			return false;
+		}
+	}
+
+	recordsConsumed = record;
+	return true;
 }
 
-void SiriusReader::readFinalize() {
-	output->verbose(__LINE__, __FILE__, "readFinalize", 8, 0, "Read an MPI_Finalize\n");
+// The index file holds a header of magic, index interval, trace size and
+// entry count followed by the entries
+#define SIRIUS_INDEX_MAGIC "SIRIDX01"
 
-	ZodiacFinalizeEvent* ev = new ZodiacFinalizeEvent();
-	eventQ->push(ev);
+bool SiriusReader::loadIndex(const std::string& indexFile) {
+	FILE* index = fopen(indexFile.c_str(), "rb");
 
-	foundFinalize = true;
-}
+	if(NULL == index) {
+		return false;
+	}
 
-void SiriusReader::readBarrier() {
-	uint32_t comm = readUINT32();
+	char magic[8];
+	uint64_t header[3];
+	bool valid = (1 == fread(magic, sizeof(magic), 1, index)) && (0 == memcmp(magic, SIRIUS_INDEX_MAGIC, sizeof(magic))) &&
+		(1 == fread(header, sizeof(header), 1, index)) && (header[0] > 0) && (header[1] == traceSize);
 
-	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Barrier\n");
+	std::vector<SiriusIndexEntry> entries;
+	if(valid) {
+		entries.resize(header[2]);
+		valid = (entries.empty() || (1 == fread(entries.data(), sizeof(SiriusIndexEntry) * entries.size(), 1, index)));
+	}
 
-	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(comm);
-	eventQ->push(ev);
-}
+	fclose(index);
 
-uint32_t SiriusReader::readUINT32() {
-	uint32_t temp;
-	fread(&temp, 1, sizeof(uint32_t), trace);
-	return temp;
-}
+	if(! valid) {
+		output->verbose(CALL_INFO, 1, 0, "Ignoring index %s, it does not match the trace\n", indexFile.c_str());
+		return false;
+	}
 
-uint64_t SiriusReader::readUINT64() {
-	uint64_t temp;
-	fread(&temp, 1, sizeof(uint64_t), trace);
-	return temp;
-}
+	std::lock_guard<std::mutex> guard(decodeLock);
 
-double SiriusReader::readTime() {
-	double temp;
-	fread(&temp, 1, sizeof(double), trace);
-	return temp;
-}
+	// Keep whichever covers more of the trace
+	if(entries.size() * header[0] > recordIndex.size() * indexInterval) {
+		indexInterval = (uint32_t) header[0];
+		recordIndex.swap(entries);
+	}
 
-int32_t SiriusReader::readINT32() {
-	int32_t temp;
-	fread(&temp, 1, sizeof(int32_t), trace);
-	return temp;
+	output->verbose(CALL_INFO, 2, 0, "Loaded %" PRIu64 " index entries from %s\n", (uint64_t) recordIndex.size(), indexFile.c_str());
+	return true;
 }
 
-int64_t SiriusReader::readINT64() {
-	int64_t temp;
-	fread(&temp, 1, sizeof(int64_t), trace);
-	return temp;
+bool SiriusReader::writeIndex(const std::string& indexFile) {
+	std::lock_guard<std::mutex> guard(decodeLock);
+
+	FILE* index = fopen(indexFile.c_str(), "wb");
+
+	if(NULL == index) {
+		output->verbose(CALL_INFO, 1, 0, "Unable to write index %s\n", indexFile.c_str());
+		return false;
+	}
+
+	const uint64_t header[3] = { indexInterval, traceSize, (uint64_t) recordIndex.size() };
+	bool written = (1 == fwrite(SIRIUS_INDEX_MAGIC, 8, 1, index)) && (1 == fwrite(header, sizeof(header), 1, index)) &&
+		(recordIndex.empty() || (1 == fwrite(recordIndex.data(), sizeof(SiriusIndexEntry) * recordIndex.size(), 1, index)));
+
+	fclose(index);
+	return written;
 }
 
 PayloadDataType SiriusReader::convertToHermesType(uint32_t dtype) {
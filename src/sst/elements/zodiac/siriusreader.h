@@ -25,6 +25,9 @@
 #include <string>
 #include <iostream>
 #include <queue>
+#include <vector>
+#include <atomic>
+#include <mutex>
 
 #include "sst/core/output.h"
 #include "sst/elements/hermes/msgapi.h"
@@ -49,9 +52,46 @@ using namespace SST::Hermes::MP;
 namespace SST {
 namespace Zodiac {
 
+// One decoded trace record, only the fields the events are built from
+// are kept.  peer is the destination of a send and the source of a
+// receive, request is the request of an irecv or a wait.
+struct SiriusRecord {
+	double   computeTime;
+	uint64_t request;
+	uint32_t callType;
+	uint32_t count;
+	uint32_t dtype;
+	uint32_t op;
+	uint32_t comm;
+	int32_t  peer;
+	int32_t  tag;
+};
+
+// Offset of a trace record in the file and the end time of the call
+// before it, which is what is needed to resume decoding there
+struct SiriusIndexEntry {
+	uint64_t offset;
+	double   prevEventTime;
+};
+
+class SiriusDecodeService;
+
+// Decoding of the trace runs ahead of the simulation.  Records are
+// decoded into a single producer/single consumer ring, by a helper
+// thread shared by all the readers of the process or, when the helper
+// has fallen behind, by the simulation thread itself.  The ring holds
+// at most ringRecords records, so the memory per rank is bounded, and
+// events are only allocated when the component asks for them.
+//
+// While decoding, the file offset of every indexInterval-th record is
+// recorded.  The index can be written next to the trace and loaded
+// again, so that a restarted simulation can seek to a record without
+// decoding the trace up to it.
 class SiriusReader {
     public:
-	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose,
+		uint32_t ringRecords = 512, uint32_t indexInterval = 4096);
+	~SiriusReader();
         void close();
 	void setOutput(Output* oput);
 	uint32_t generateNextEvents();
@@ -59,28 +99,55 @@ class SiriusReader {
 	uint32_t getCurrentQueueSize();
 	bool hasReachedFinalize();
 
+	// Number of trace records turned into events so far
+	uint64_t getRecordsConsumed();
+	// Drops the decoded records and continues at the given record,
+	// events already in the queue are left to the caller
+	bool seekToRecord(uint64_t record);
+	bool loadIndex(const std::string& indexFile);
+	bool writeIndex(const std::string& indexFile);
+
     private:
+	friend class SiriusDecodeService;
+
 	Output* output;
 	uint32_t rank;
 	uint32_t qLimit;
 	bool foundFinalize;
 	std::queue<ZodiacEvent*>* eventQ;
 	FILE* trace;
+	uint64_t traceSize;
+
+	// Consumer side
+	uint64_t recordsConsumed;
+
+	// Ring, ringHead is only written by the consumer and ringTail by
+	// whoever holds decodeLock
+	std::vector<SiriusRecord> ring;
+	uint64_t ringMask;
+	std::atomic<uint64_t> ringHead;
+	std::atomic<uint64_t> ringTail;
+
+	// Producer side, protected by decodeLock
+	std::mutex decodeLock;
 	double prevEventTime;
-	void generateNextEvent();
-	inline uint32_t readUINT32();
-	inline uint64_t readUINT64();
-	inline double readTime();
-	inline int32_t readINT32();
-	inline int64_t readINT64();
-	void readSend();
-	void readIrecv();
-	void readRecv();
-	void readInit();
-	void readFinalize();
-	void readBarrier();
-	void readWait();
-	void readAllreduce();
+	uint64_t recordsDecoded;
+	uint32_t indexInterval;
+	std::vector<SiriusIndexEntry> recordIndex;
+	std::string decodeError;
+	std::atomic<bool> decodeDone;
+
+	// Reads are buffered here, readBase is the file offset of the start
+	std::vector<char> readBuffer;
+	size_t readPos;
+	size_t readLen;
+	uint64_t readBase;
+
+	uint32_t decodeAhead(uint32_t maxRecords);
+	bool decodeRecord(SiriusRecord& rec);
+	inline bool readBytes(void* dest, size_t bytes);
+	void resetDecoder(uint64_t offset, double prevTime, uint64_t record);
+	void generateNextEvent(const SiriusRecord& rec);
 
 	PayloadDataType convertToHermesType(uint32_t dtype);
 	ReductionOperation convertToHermesOp(uint32_t op);
@@ -8,6 +8,8 @@ iterations = 1;
 msgSize = 0;
 shape = "2"
 num_vNics = 1
+traceIndexInterval = 0
+decodeAhead = 512
 
 netPktSizeBytes="64B"
 netFlitSize="8B"
@@ -17,8 +19,10 @@ def main():
     global msgSize
     global shape
     global num_vNics
+    global traceIndexInterval
+    global decodeAhead
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores=","traceIndexInterval=","decodeAhead="])
     except getopt.GetopError as err:
         print (str(err))
         sys.exit(2)
@@ -31,6 +35,10 @@ def main():
             num_vNics = a
         elif o in ("--shape"):
             shape = a
+        elif o in ("--traceIndexInterval"):
+            traceIndexInterval = int(a)
+        elif o in ("--decodeAhead"):
+            decodeAhead = int(a)
         else:
             assert False, "unhandle option"
 
@@ -102,6 +110,9 @@ driverParams = ({
 		"sharedTrace" : "allred-128.stf",
 		"printStats" : 1,
 		"buffersize" : 140,
+		"decode_ahead" : decodeAhead,
+		"trace_index" : int(traceIndexInterval > 0),
+		"trace_index_interval" : max(traceIndexInterval, 1),
 		"os.name" : "hermesParams",
 		"hermesParams.debug" : 0,
 		"hermesParams.verboseLevel" : 1,
@@ -3,6 +3,8 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+import glob
+
 #import os
 #import shutil
 
@@ -33,9 +35,24 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
     def test_Sirius_Zodiac_128(self):
         self.SiriusZodiacTrace_test_template("8x8x2")
 
+    # The first run writes the record index of each trace with an entry for
+    # every record, the second run loads it, both match the reference
+    def test_Sirius_Zodiac_16_trace_index(self):
+        self.SiriusZodiacTrace_test_template("4x4", extraargs="--traceIndexInterval=1", testsuffix="_index_write")
+
+        indexfiles = glob.glob("{0}/npe-16/*.idx".format(self.testSiriusZodiacTraceTestsDir))
+        self.assertEqual(len(indexfiles), 16, "SiriusZodiacTrace: expected 16 trace index files, found {0}".format(len(indexfiles)))
+
+        self.SiriusZodiacTrace_test_template("4x4", extraargs="--traceIndexInterval=1", testsuffix="_index_read")
+
+    # With a single record decoded ahead the replay keeps catching up with
+    # the decoder thread and decodes on the simulation thread
+    def test_Sirius_Zodiac_16_decode_ahead(self):
+        self.SiriusZodiacTrace_test_template("4x4", extraargs="--decodeAhead=1", testsuffix="_decode_ahead")
+
 #####
 
-    def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60):
+    def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60, extraargs = "", testsuffix = ""):
 
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -51,6 +68,7 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
         testDataFileName="test_Sirius_allred_{0}".format(testcase)
 
         reffile = "{0}/sirius/tests/refFiles/{1}.out".format(self.SiriusZodiacTraceElementDir, testDataFileName)
+        testDataFileName = testDataFileName + testsuffix
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         tmpfile1 = "{0}/{1}_grepped.tmp".format(outdir, testDataFileName)
@@ -58,7 +76,7 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
         sdlfile = "{0}/allreduce/allreduce.py".format(test_path)
-        otherargs = '--model-options \"--shape={0}\"'.format(testcase)
+        otherargs = '--model-options \"--shape={0} {1}\"'.format(testcase, extraargs)
 
         # Run SST
         self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
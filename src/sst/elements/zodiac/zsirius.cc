@@ -79,6 +79,11 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
     tConv = getTimeConverter("1ns");
 
     emptyBufferSize = (uint32_t) params.find("buffer", 4096);
+
+    decodeAhead = params.find<uint32_t>("decode_ahead", 512);
+    useTraceIndex = params.find<bool>("trace_index", false);
+    traceIndexInterval = params.find<uint32_t>("trace_index_interval", 4096);
+    startRecord = params.find<uint64_t>("start_record", 0);
     emptyBuffer = (char*) malloc(sizeof(char) * emptyBufferSize);
 
     // Make sure we don't stop the simulation until we are ready
@@ -102,9 +107,21 @@ void ZodiacSiriusTraceReader::setup() {
     snprintf(trace_name.get(), trace_file.length() + 20, "%s.%d", trace_file.c_str(), rank);
 
     printf("Opening trace file: %s\n", trace_name.get());
-    trace = new SiriusReader(trace_name.get(), rank, 64, eventQ, verbosityLevel);
+    trace = new SiriusReader(trace_name.get(), rank, 64, eventQ, verbosityLevel, decodeAhead, traceIndexInterval);
     trace->setOutput(&zOut);
 
+    if(useTraceIndex) {
+	trace_index_file = string(trace_name.get()) + ".idx";
+	trace->loadIndex(trace_index_file);
+    }
+
+    if(startRecord > 0) {
+	if(! trace->seekToRecord(startRecord)) {
+		zOut.fatal(CALL_INFO, -1, "Error: unable to start the replay at record %" PRIu64 " of %s\n",
+			startRecord, trace_name.get());
+	}
+    }
+
     int count = trace->generateNextEvents();
     std::cout << "Obtained: " << count << " events" << std::endl;
 
@@ -182,6 +199,10 @@ ZodiacSiriusTraceReader::~ZodiacSiriusTraceReader() {
             zOut.output("WARNING: Component did not reach a finalize event, yet the component destructor has been called.\n");
         }
 
+        if(! trace_index_file.empty()) {
+            trace->writeIndex(trace_index_file);
+        }
+
         trace->close();
     }
 }
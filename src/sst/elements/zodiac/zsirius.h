@@ -62,6 +62,10 @@ public:
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
 	{ "buffer", "Sets the size of the buffer to use for message data backing, default is 4096 bytes", "4096" },
+	{ "decode_ahead", "Number of trace records decoded ahead of the replay by the decoder thread", "512" },
+	{ "trace_index", "Load the record index of the trace from <trace>.idx if it exists and write it back when done", "0" },
+	{ "trace_index_interval", "Number of trace records between two entries of the index", "4096" },
+	{ "start_record", "Trace record to start the replay at, the index is used to seek there", "0" },
     	{ "name","used internally","" },
     	{ "module","used internally","" }
   )
@@ -129,6 +133,11 @@ private:
   MessageResponse* currentRecv;
   int rank;
   string trace_file;
+  string trace_index_file;
+  uint32_t decodeAhead;
+  uint32_t traceIndexInterval;
+  uint64_t startRecord;
+  bool useTraceIndex;
   int verbosityLevel;
 
   uint64_t zSendCount;